@@ -26,6 +26,7 @@
 #include <cstdint>
 #endif
 #include <bit>
+#include <span>
 
 #if !defined(FLOOR_NO_MATH_STR)
 #include <string>
@@ -210,6 +211,16 @@ struct soft_f16 {
 
 using half = soft_f16;
 
+//! converts "src" to half-precision values and stores them in "dst" (rounds to nearest even),
+//! returns the amount of converted values (min(src.size(), dst.size()))
+//! NOTE: uses F16C/AVX-512 or NEON conversion instructions when available
+size_t convert_f32_to_f16(std::span<const float> src, std::span<soft_f16> dst);
+
+//! converts the half-precision values in "src" to single-precision values and stores them in "dst",
+//! returns the amount of converted values (min(src.size(), dst.size()))
+//! NOTE: uses F16C/AVX-512 or NEON conversion instructions when available
+size_t convert_f16_to_f32(std::span<const soft_f16> src, std::span<float> dst);
+
 } // namespace fl
 
 #endif
@@ -0,0 +1,119 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/core/essentials.hpp>
+#include <string>
+#include <vector>
+#include <span>
+#include <memory>
+#include <future>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+namespace fl {
+
+//! asynchronous bulk file I/O:
+//! all requests are executed by a pool of I/O threads, so that many file reads/writes can be in flight at once
+//! (e.g. when loading a large amount of assets at startup) and the calling thread is never blocked by the file system
+//! NOTE: requests are started in submission order, but may complete in any order
+class async_file_io {
+public:
+	//! result of a file read
+	struct read_result_t {
+		//! file contents, nullptr on failure
+		std::unique_ptr<uint8_t[]> data;
+		//! size of "data" in bytes
+		size_t size { 0u };
+		//! true if the file was read successfully
+		//! NOTE: like file_io::file_to_buffer, reading an empty file is considered a failure
+		bool success { false };
+	};
+	
+	//! called with the result of a file read (on an I/O thread)
+	using read_completion_handler_t = std::function<void(const std::string& filename, read_result_t&& result)>;
+	
+	//! creates a new I/O thread pool with "thread_count" threads,
+	//! if "thread_count" is 0, the amount of threads is determined automatically (based on the logical CPU count)
+	explicit async_file_io(const uint32_t thread_count = 0u);
+	//! finishes all pending requests and then destroys all I/O threads
+	~async_file_io();
+	
+	async_file_io(const async_file_io&) = delete;
+	async_file_io& operator=(const async_file_io&) = delete;
+	
+	//! asynchronously reads the complete file
+	std::future<read_result_t> read_file(const std::string& filename);
+	
+	//! asynchronously reads all specified files, the returned futures are in the same order as "filenames"
+	std::vector<std::future<read_result_t>> read_files(const std::vector<std::string>& filenames);
+	
+	//! asynchronously reads the complete file and calls "completion_handler" with the result once done
+	void read_file(const std::string& filename, read_completion_handler_t completion_handler);
+	
+	//! asynchronously writes "data" to the specified file (the file is created or overwritten)
+	std::future<bool> write_file(const std::string& filename, std::vector<uint8_t>&& data);
+	
+	//! asynchronously writes "data" to the specified file (the file is created or overwritten)
+	//! NOTE: "data" must remain valid until the write has completed
+	std::future<bool> write_file(const std::string& filename, const std::span<const uint8_t> data);
+	
+	//! blocks until all currently pending requests have completed
+	void wait_idle();
+	
+	//! returns the amount of requests that are currently queued or executing
+	uint32_t get_pending_count() const {
+		return pending_count.load(std::memory_order_acquire);
+	}
+	
+	//! returns the amount of I/O threads
+	uint32_t get_thread_count() const {
+		return uint32_t(threads.size());
+	}
+	
+protected:
+	using request_t = std::function<void()>;
+	
+	std::vector<std::thread> threads;
+	
+	//! required lock for "request_cv"/"idle_cv" and access to "requests"
+	std::mutex request_lock;
+	//! will be signaled once there is a new request (or on shutdown)
+	std::condition_variable request_cv;
+	//! will be signaled once all pending requests have completed
+	std::condition_variable idle_cv;
+	//! currently queued requests
+	std::queue<request_t> requests;
+	bool shutdown { false };
+	
+	std::atomic<uint32_t> pending_count { 0u };
+	
+	//! adds a request to the queue and wakes up an I/O thread
+	void submit(request_t&& request);
+	//! I/O thread loop
+	void run(const uint32_t thread_idx);
+	
+};
+
+} // namespace fl
@@ -0,0 +1,194 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/core/essentials.hpp>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <bit>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace fl {
+
+//! binary reader over a memory region (e.g. a mapped_file or a buffer from file_io::file_to_buffer),
+//! all reads are inlined bounds-checked loads from memory (no per-read calls into a stream)
+//! NOTE: the typed getters mirror the ones of file_io, i.e. get_uint() etc. read big-endian values,
+//!       get_swapped_uint() etc. read little-endian values
+//! NOTE: reading past the end returns zero-initialized values/empty spans and flags the reader as failed
+class binary_reader {
+public:
+	constexpr binary_reader() noexcept = default;
+	constexpr explicit binary_reader(const std::span<const uint8_t> data_) noexcept : data(data_) {}
+	
+	//! reads a single trivially copyable value in native byte order
+	template <typename T> requires (std::is_trivially_copyable_v<T>)
+	floor_inline_always T read() {
+		T ret {};
+		if (!check_size(sizeof(T))) {
+			return ret;
+		}
+		memcpy(&ret, data.data() + offset, sizeof(T));
+		offset += sizeof(T);
+		return ret;
+	}
+	
+	//! reads a single integral value that is stored in big-endian byte order
+	template <typename T> requires (std::is_integral_v<T>)
+	floor_inline_always T read_be() {
+		if constexpr (std::endian::native == std::endian::big || sizeof(T) == 1) {
+			return read<T>();
+		} else {
+			return byteswap(read<T>());
+		}
+	}
+	
+	//! reads a single integral value that is stored in little-endian byte order
+	template <typename T> requires (std::is_integral_v<T>)
+	floor_inline_always T read_le() {
+		if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+			return read<T>();
+		} else {
+			return byteswap(read<T>());
+		}
+	}
+	
+	//! reads "count" values of type T into "dst"
+	template <typename T> requires (std::is_trivially_copyable_v<T>)
+	bool read_array(T* dst, const size_t count) {
+		if (!check_size(sizeof(T) * count)) {
+			return false;
+		}
+		memcpy(dst, data.data() + offset, sizeof(T) * count);
+		offset += sizeof(T) * count;
+		return true;
+	}
+	
+	//! returns the next "size" bytes without copying them and advances the read offset
+	std::span<const uint8_t> get_span(const size_t size) {
+		if (!check_size(size)) {
+			return {};
+		}
+		const auto ret = data.subspan(offset, size);
+		offset += size;
+		return ret;
+	}
+	
+	//! reads a block of "size" bytes
+	void get_block(char* dst, const size_t size) {
+		(void)read_array(dst, size);
+	}
+	
+	//! returns all bytes until "terminator" (or the end of the data) without copying them,
+	//! the read offset is advanced past the terminator
+	std::string_view get_terminated_view(const uint8_t terminator) {
+		const auto remaining = data.size() - offset;
+		if (remaining == 0) {
+			return {};
+		}
+		const auto start_ptr = data.data() + offset;
+		const auto term_ptr = (const uint8_t*)memchr(start_ptr, terminator, remaining);
+		const auto size = (term_ptr != nullptr ? size_t(term_ptr - start_ptr) : remaining);
+		offset += size + (term_ptr != nullptr ? 1u : 0u);
+		return { (const char*)start_ptr, size };
+	}
+	void get_terminated_block(std::string& str, const uint8_t terminator) {
+		str = get_terminated_view(terminator);
+	}
+	std::string get_terminated_block(const uint8_t terminator) {
+		return std::string(get_terminated_view(terminator));
+	}
+	
+	uint8_t get_char() { return read<uint8_t>(); }
+	uint16_t get_usint() { return read_be<uint16_t>(); }
+	uint32_t get_uint() { return read_be<uint32_t>(); }
+	uint64_t get_ullint() { return read_be<uint64_t>(); }
+	uint16_t get_swapped_usint() { return read_le<uint16_t>(); }
+	uint32_t get_swapped_uint() { return read_le<uint32_t>(); }
+	uint64_t get_swapped_ullint() { return read_le<uint64_t>(); }
+	float get_float() { return read<float>(); }
+	
+	//! sets the read offset (clamped to the data size)
+	void seek(const size_t offset_) {
+		offset = std::min(offset_, data.size());
+	}
+	//! skips "size" bytes
+	void skip(const size_t size) {
+		if (check_size(size)) {
+			offset += size;
+		}
+	}
+	//! returns the current read offset
+	size_t get_current_offset() const {
+		return offset;
+	}
+	//! returns the amount of bytes that haven't been read yet
+	size_t get_remaining_size() const {
+		return data.size() - offset;
+	}
+	//! returns the complete data of this reader
+	std::span<const uint8_t> get_data() const {
+		return data;
+	}
+	
+	//! returns true if all data has been read
+	bool eof() const {
+		return (offset >= data.size());
+	}
+	//! returns true if no read has failed so far
+	bool good() const {
+		return !failed;
+	}
+	//! returns true if a read past the end has been attempted
+	bool fail() const {
+		return failed;
+	}
+	
+protected:
+	std::span<const uint8_t> data;
+	size_t offset { 0u };
+	bool failed { false };
+	
+	floor_inline_always bool check_size(const size_t size) {
+		if (size > data.size() - offset) [[unlikely]] {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+	
+	template <typename T>
+	static floor_inline_always T byteswap(const T value) {
+		if constexpr (sizeof(T) == 2) {
+			return T(__builtin_bswap16(uint16_t(value)));
+		} else if constexpr (sizeof(T) == 4) {
+			return T(__builtin_bswap32(uint32_t(value)));
+		} else if constexpr (sizeof(T) == 8) {
+			return T(__builtin_bswap64(uint64_t(value)));
+		} else {
+			return value;
+		}
+	}
+	
+};
+
+} // namespace fl
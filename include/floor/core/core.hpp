@@ -136,6 +136,42 @@ using namespace std::literals;
 		}
 		return ret;
 	}
+	//! in-memory file that can be written/read by child processes (e.g. started via core::system) through its path,
+	//! allowing the retrieval of outputs without a round trip through the (possibly slow or read-only) filesystem
+	//! NOTE: on Linux this is backed by memfd_create, on all other platforms this falls back to a temporary file
+	class memory_file {
+	public:
+		//! creates a new empty in-memory file, "prefix" and "suffix" are used for the name of the file
+		//! (only visible when debugging) and for the temporary file fallback,
+		//! if "keep_file" is set, this will always create a temporary file that is not removed on destruction
+		memory_file(const std::string prefix = "", const std::string suffix = "", const bool keep_file = false);
+		//! closes and removes the file
+		~memory_file();
+		
+		//! returns true if the file could be created
+		bool is_valid() const {
+			return !path.empty();
+		}
+		//! returns true if this is an actual in-memory file and not a temporary file fallback
+		bool is_in_memory() const {
+			return (fd >= 0);
+		}
+		//! returns the path that can be used to open this file (e.g. "/proc/<pid>/fd/<fd>")
+		const std::string& get_path() const {
+			return path;
+		}
+		//! reads the current contents of the file into "dst", returns true on success
+		bool read(std::string& dst) const;
+		
+		memory_file(const memory_file&) = delete;
+		memory_file& operator=(const memory_file&) = delete;
+		
+	protected:
+		std::string path;
+		int fd { -1 };
+		const bool keep_file { false };
+	};
+	
 	//! converts an input string to a string that can be used as a file name (mostly ASCII)
 	std::string to_file_name(const std::string& str);
 	//! for use on windows: expands %ENV% variables in the given path/string
@@ -20,10 +20,15 @@
 
 #include <floor/threading/thread_base.hpp>
 #include <floor/threading/atomic_spin_lock.hpp>
+#include <floor/threading/mpsc_queue.hpp>
 #include <floor/core/event_objects.hpp>
 #include <SDL3/SDL_events.h>
-#include <queue>
 #include <memory>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <optional>
+#include <vector>
 #include <set>
 
 namespace fl {
@@ -39,8 +44,10 @@ public:
 	~event() override;
 	
 	//! handles the SDL events
-	void handle_events() REQUIRES(!queued_events_lock, !handler_lock);
-	void add_event(const EVENT_TYPE type, std::shared_ptr<event_object> obj) REQUIRES(!queued_events_lock);
+	void handle_events() REQUIRES(!handler_lock);
+	//! queues an event that will be handled by the next handle_events() call
+	//! NOTE: this is lock-free and can be called from any thread
+	void add_event(const EVENT_TYPE type, std::shared_ptr<event_object> obj);
 	
 	void set_vr_context(vr_context* vr_ctx_) {
 		vr_ctx = vr_ctx_;
@@ -68,10 +75,13 @@ public:
 	}
 	
 	//! completely remove an event handler or only remove event types that are handled by an event handler
-	void remove_event_handler(const handler_f& handler_) REQUIRES(!handler_lock);
-	void remove_inline_event_handler(const handler_f& handler_) REQUIRES(!handler_lock);
-	void remove_event_types_from_handler(const handler_f& handler_, const std::set<EVENT_TYPE>& types) REQUIRES(!handler_lock);
-	void remove_event_types_from_inline_handler(const handler_f& handler_, const std::set<EVENT_TYPE>& types) REQUIRES(!handler_lock);
+	//! NOTE: once these return, the removed handler will no longer be called (waits for dispatches that may still use it to finish)
+	//! NOTE: when called from within an event handler, the wait is deferred (it would otherwise wait on the current dispatch),
+	//!       i.e. the removed handler may still be called by dispatches that are currently in progress
+	void remove_event_handler(const handler_f& handler_) REQUIRES(!handler_lock, !synchronize_lock);
+	void remove_inline_event_handler(const handler_f& handler_) REQUIRES(!handler_lock, !synchronize_lock);
+	void remove_event_types_from_handler(const handler_f& handler_, const std::set<EVENT_TYPE>& types) REQUIRES(!handler_lock, !synchronize_lock);
+	void remove_event_types_from_inline_handler(const handler_f& handler_, const std::set<EVENT_TYPE>& types) REQUIRES(!handler_lock, !synchronize_lock);
 	
 	//! returns the mouse position
 	float2 get_mouse_pos() const;
@@ -96,24 +106,93 @@ protected:
 		// unwind types, always call the simple add handler for each type
 		unwind_add_internal_event_handler(handler_, std::forward<event_types>(types)...);
 	}
-	void remove_internal_event_handler(const internal_handler_f& handler_) REQUIRES(!handler_lock);
-	void remove_internal_event_types_from_handler(const internal_handler_f& handler_, const std::set<EVENT_TYPE>& types) REQUIRES(!handler_lock);
+	void remove_internal_event_handler(const internal_handler_f& handler_) REQUIRES(!handler_lock, !synchronize_lock);
+	void remove_internal_event_types_from_handler(const internal_handler_f& handler_, const std::set<EVENT_TYPE>& types) REQUIRES(!handler_lock, !synchronize_lock);
+	
+	//! all handlers of a specific event type
+	//! NOTE: these are never modified once published (copy-on-write), so that events can be dispatched without any locks
+	struct handler_list_t {
+		std::vector<handler_f*> handlers;
+		std::vector<handler_f*> inline_handlers;
+		std::vector<internal_handler_f*> internal_handlers;
+		
+		bool empty() const {
+			return (handlers.empty() && inline_handlers.empty() && internal_handlers.empty());
+		}
+	};
+	//! handler lists of event types that don't fit into the flat handler table, sorted by event type
+	using overflow_handler_table_t = std::vector<std::pair<EVENT_TYPE, handler_list_t>>;
+	
+	//! the flat handler table has one entry per event type index in each event category (__*_EVENT)
+	static constexpr const uint32_t handler_table_category_count { 8u };
+	static constexpr const uint32_t handler_table_types_per_category { 64u };
+	//! returns the flat handler table index of the specified event type
+	//! or an empty optional if the event type doesn't fit into the table
+	static constexpr std::optional<uint32_t> get_handler_table_index(const EVENT_TYPE type) {
+		const auto category = uint32_t(type) >> 24u;
+		const auto type_index = uint32_t(type) & 0xFF'FFFFu;
+		if (std::popcount(category) != 1 || type_index >= handler_table_types_per_category) {
+			return {};
+		}
+		return uint32_t(std::countr_zero(category)) * handler_table_types_per_category + type_index;
+	}
 	
-	//
+	//! must be held when modifying handlers (not required for dispatching)
 	atomic_spin_lock handler_lock;
-	std::unordered_multimap<EVENT_TYPE, internal_handler_f&> internal_handlers GUARDED_BY(handler_lock);
-	std::unordered_multimap<EVENT_TYPE, handler_f&> handlers GUARDED_BY(handler_lock);
-	std::unordered_multimap<EVENT_TYPE, handler_f&> inline_handlers GUARDED_BY(handler_lock);
-	std::queue<std::pair<EVENT_TYPE, std::shared_ptr<event_object>>> user_event_queue, user_event_queue_processing;
-	std::recursive_mutex user_queue_lock;
+	std::array<std::atomic<const handler_list_t*>, handler_table_category_count * handler_table_types_per_category> handler_table {};
+	std::atomic<const overflow_handler_table_t*> overflow_handler_table { nullptr };
+	//! dispatch epoch: advanced by each handler synchronization (-> synchronize_handlers()),
+	//! each dispatch is counted in the slot of the epoch it started in (epoch & 1)
+	std::atomic<uint64_t> dispatch_epoch { 0u };
+	//! amount of currently active dispatches per epoch slot: replaced handler lists can only be deleted once all
+	//! dispatches that started before they were replaced have finished
+	std::array<std::atomic<uint32_t>, 2> active_dispatch_counts {};
+	//! serializes handler synchronizations, so that the slot of the previous epoch only drains while waiting on it
+	safe_mutex synchronize_lock;
+	//! replaced handler lists that may still be in use by an active dispatch
+	std::vector<std::unique_ptr<const handler_list_t>> retired_handler_lists GUARDED_BY(handler_lock);
+	std::vector<std::unique_ptr<const overflow_handler_table_t>> retired_overflow_handler_tables GUARDED_BY(handler_lock);
+	
+	//! returns the handler list of the specified event type or nullptr if there are no handlers
+	//! NOTE: must only be called during a dispatch (i.e. while it is counted in "active_dispatch_counts")
+	const handler_list_t* get_handler_list(const EVENT_TYPE type) const;
+	//! creates a copy of the handler list of the specified event type, modifies it via "modifier(handler_list_t&)" and publishes it
+	template <typename F> void modify_handler_list(const EVENT_TYPE type, F&& modifier) REQUIRES(handler_lock);
+	//! calls modify_handler_list() for all event types that currently have handlers
+	template <typename F> void modify_all_handler_lists(F&& modifier) REQUIRES(handler_lock);
+	//! deletes all retired handler lists if there are no active dispatches at all (non-blocking)
+	void reclaim_handler_lists() REQUIRES(handler_lock);
+	//! waits until all dispatches that may still use retired handler lists have finished, then deletes these lists
+	//! NOTE: only waits on dispatches that started before this call, not on ones that start while waiting
+	//! NOTE: if called from within a dispatch (i.e. from an event handler), this doesn't wait, the retired handler lists
+	//!       are then deleted by a later add/remove call
+	void synchronize_handlers() REQUIRES(!handler_lock, !synchronize_lock);
+	
+	//! user events are handled asynchronously on the event thread
+	mpsc_queue<std::pair<EVENT_TYPE, std::shared_ptr<event_object>>> user_event_queue;
 	void handle_user_events() REQUIRES(!handler_lock);
 	void handle_event(const EVENT_TYPE& type, std::shared_ptr<event_object> obj) REQUIRES(!handler_lock);
 	
-	safe_mutex queued_events_lock;
-	std::vector<std::pair<EVENT_TYPE, std::shared_ptr<event_object>>> queued_events;
-	
-	//
-	std::unordered_map<EVENT_TYPE, std::shared_ptr<event_object>> prev_events;
+	//! events added via add_event() (from any thread)
+	mpsc_queue<std::pair<EVENT_TYPE, std::shared_ptr<event_object>>> queued_events;
+	
+	//! last mouse button down/up events (required for click events)
+	std::array<std::shared_ptr<event_object>, 6> prev_mouse_events;
+	//! returns the index in "prev_mouse_events" of the specified event type or an empty optional if it isn't a mouse button down/up event
+	static constexpr std::optional<uint32_t> get_prev_mouse_event_index(const EVENT_TYPE type) {
+		switch (type) {
+			case EVENT_TYPE::MOUSE_LEFT_DOWN: return 0u;
+			case EVENT_TYPE::MOUSE_LEFT_UP: return 1u;
+			case EVENT_TYPE::MOUSE_RIGHT_DOWN: return 2u;
+			case EVENT_TYPE::MOUSE_RIGHT_UP: return 3u;
+			case EVENT_TYPE::MOUSE_MIDDLE_DOWN: return 4u;
+			case EVENT_TYPE::MOUSE_MIDDLE_UP: return 5u;
+			default: return {};
+		}
+	}
+	const std::shared_ptr<event_object>& get_prev_mouse_event(const EVENT_TYPE type) const {
+		return prev_mouse_events[*get_prev_mouse_event_index(type)];
+	}
 	
 	//! timer that decides if there is a * mouse double click
 	uint64_t lm_double_click_timer { 0u };
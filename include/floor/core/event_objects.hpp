@@ -145,6 +145,42 @@ template<EVENT_TYPE event_type> struct event_object_base : public event_object {
 	event_object_base(const uint64_t& time_) : event_object(time_), type(event_type) {}
 };
 
+//! pooled event object storage:
+//! event objects are created and destroyed at a high frequency (e.g. mouse/touch/VR controller movement),
+//! so these are allocated from size-class free lists (that are only ever grown) instead of from the heap
+namespace event_pool {
+	//! returns a block of at least "size" bytes (aligned to at least 16 bytes)
+	void* allocate(const size_t size);
+	//! returns a block that was previously allocated with the same "size" to the pool
+	void deallocate(void* ptr, const size_t size) noexcept;
+} // namespace event_pool
+
+//! allocator that allocates from the event_pool
+template <typename T> struct event_pool_allocator {
+	using value_type = T;
+	
+	constexpr event_pool_allocator() noexcept = default;
+	template <typename U> constexpr event_pool_allocator(const event_pool_allocator<U>&) noexcept {}
+	
+	T* allocate(const size_t n) {
+		static_assert(alignof(T) <= 16u, "unsupported alignment");
+		return (T*)event_pool::allocate(n * sizeof(T));
+	}
+	void deallocate(T* ptr, const size_t n) noexcept {
+		event_pool::deallocate(ptr, n * sizeof(T));
+	}
+	
+	template <typename U> constexpr bool operator==(const event_pool_allocator<U>&) const noexcept {
+		return true;
+	}
+};
+
+//! creates a new event object of the specified type (the object and its control block are allocated from the event_pool)
+template <typename event_type, typename... Args>
+static inline std::shared_ptr<event_type> make_event(Args&&... args) {
+	return std::allocate_shared<event_type>(event_pool_allocator<event_type> {}, std::forward<Args>(args)...);
+}
+
 // mouse events
 template<EVENT_TYPE event_type> struct mouse_event_base : public event_object_base<event_type> {
 	const float2 position;
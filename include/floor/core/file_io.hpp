@@ -20,6 +20,7 @@
 
 #include <floor/core/platform.hpp>
 #include <floor/core/aligned_ptr.hpp>
+#include <floor/core/mapped_file.hpp>
 #include <fstream>
 #include <span>
 
@@ -58,6 +59,9 @@ public:
 	static std::pair<std::unique_ptr<uint8_t[]>, size_t> file_to_buffer(const std::string& filename);
 	static std::pair<aligned_ptr<uint8_t>, size_t> file_to_buffer_aligned(const std::string& filename);
 	static std::pair<aligned_ptr<uint8_t>, size_t> file_to_buffer_uncached(const std::string& filename);
+	//! memory-maps the specified file (read-only), the contents are then accessible as a span without any copies
+	static mapped_file map_file(const std::string& filename,
+								const mapped_file::ACCESS_PATTERN access_pattern = mapped_file::ACCESS_PATTERN::NORMAL);
 	static bool file_to_string(const std::string& filename, std::string& str);
 	static std::string file_to_string(const std::string& filename);
 	
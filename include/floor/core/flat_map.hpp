@@ -23,6 +23,8 @@
 
 #if (defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 200100)
 #include <flat_map>
+#include <vector>
+#include <utility>
 #else
 #include <functional>
 #include <algorithm>
@@ -30,16 +32,45 @@
 #include <exception>
 #include <string>
 #include <stdexcept>
+#include <ranges>
+#include <utility>
 #endif
 
 namespace fl {
 
 // make use of std::flat_map when available (libc++ 20.1+)
 #if (defined(_LIBCPP_VERSION) && _LIBCPP_VERSION >= 200100)
-template <typename key_type, typename value_type> using flat_map = std::flat_map<key_type, value_type>;
+//! std::flat_map with transparent key comparison (i.e. allows heterogeneous lookup, e.g. std::string_view keys for std::string storage)
+//! NOTE: iteration is in key order (not insertion order)
+template <typename key_type, typename value_type> class flat_map : public std::flat_map<key_type, value_type, std::less<>> {
+public:
+	using std::flat_map<key_type, value_type, std::less<>>::flat_map;
+	
+	//! single <key, value> entry in this map
+	using entry_type = std::pair<key_type, value_type>;
+	
+	//! replaces the contents of this map with the specified entries,
+	//! NOTE: entries must already be sorted by key and must not contain any duplicate keys
+	void adopt_sorted(std::vector<entry_type>&& entries) {
+		typename std::flat_map<key_type, value_type, std::less<>>::key_container_type keys;
+		typename std::flat_map<key_type, value_type, std::less<>>::mapped_container_type values;
+		keys.reserve(entries.size());
+		values.reserve(entries.size());
+		for (auto& entry : entries) {
+			keys.emplace_back(std::move(entry.first));
+			values.emplace_back(std::move(entry.second));
+		}
+		entries.clear();
+		this->replace(std::move(keys), std::move(values));
+	}
+	
+};
 #else // otherwise use our implementation
 //! simple <key, value> map backed by a vector stored contiguously in memory (hence flat map),
-//! technically O(n) lookup and insert, but usually faster than unordered_map or map for small maps
+//! entries are kept sorted by key -> O(log n) lookup, O(n) insert (moves all following entries), but usually faster than
+//! unordered_map or map for small maps, use insert_range() or adopt_sorted() to construct large maps in O(n log n) / O(n)
+//! NOTE: keys are compared with std::less<>, i.e. heterogeneous lookup is supported (e.g. std::string_view keys for std::string storage)
+//! NOTE: iteration is in key order (not insertion order), same as with std::flat_map
 template <typename key_type, typename value_type> class flat_map {
 public:
 	//! returns true if the key is a reference
@@ -55,15 +86,19 @@ public:
 	using entry_type = std::pair<storage_key_type, value_type>;
 	
 protected:
-	//! map storage
+	//! map storage (sorted by key)
 	std::vector<entry_type> data;
 	
-	//! removes all duplicate entries for each unique key in this map
-	void unique() {
-		const auto end_iter = std::unique(begin(), end(), [](const entry_type& kv_1, const entry_type& kv_2) {
-			return (kv_1.first == kv_2.first);
+	//! sorts all entries by key and removes all duplicate entries for each unique key in this map,
+	//! NOTE: the first entry for each key is kept
+	void sort_and_unique() {
+		std::stable_sort(data.begin(), data.end(), [](const entry_type& kv_1, const entry_type& kv_2) {
+			return std::less<> {}(get_key(kv_1.first), get_key(kv_2.first));
+		});
+		const auto end_iter = std::unique(data.begin(), data.end(), [](const entry_type& kv_1, const entry_type& kv_2) {
+			return !std::less<> {}(get_key(kv_1.first), get_key(kv_2.first));
 		});
-		data.erase(end_iter, end());
+		data.erase(end_iter, data.end());
 	}
 	
 	//! helper function to get the underlying key type from the storage_key_type
@@ -84,6 +119,44 @@ protected:
 		}
 	}
 	
+	//! returns the index of the first entry whose key is not less than 'key'
+	//! NOTE: this is a branchless binary search (the loop only depends on the size, comparisons turn into conditional moves)
+	template <typename lookup_key_type>
+	size_t lower_bound_index(const lookup_key_type& key) const {
+		const entry_type* base = data.data();
+		size_t remaining = data.size();
+		if (remaining == 0u) {
+			return 0u;
+		}
+		while (remaining > 1u) {
+			const auto half = remaining / 2u;
+			base += (std::less<> {}(get_key(base[half].first), key) ? half : 0u);
+			remaining -= half;
+		}
+		base += (std::less<> {}(get_key(base->first), key) ? 1u : 0u);
+		return size_t(base - data.data());
+	}
+	
+	//! returns the index of the entry for 'key', or size() if not found
+	template <typename lookup_key_type>
+	size_t find_index(const lookup_key_type& key) const {
+		const auto idx = lower_bound_index(key);
+		if (idx < data.size() && !std::less<> {}(key, get_key(data[idx].first))) {
+			return idx;
+		}
+		return data.size();
+	}
+	
+	//! throws std::out_of_range for the specified 'key'
+	template <typename lookup_key_type>
+	[[noreturn]] static void throw_key_not_found(const lookup_key_type& key) {
+		if constexpr (std::is_constructible_v<std::string, const lookup_key_type&>) {
+			throw std::out_of_range("key not found: " + std::string(key));
+		} else {
+			throw std::out_of_range("key not found");
+		}
+	}
+	
 public:
 	using iterator = typename decltype(data)::iterator;
 	using const_iterator = typename decltype(data)::const_iterator;
@@ -109,100 +182,116 @@ public:
 		return *this;
 	}
 	
-	//! construct through a initializer_list, note that all entries will be uniqued
+	//! construct through a initializer_list, note that all entries will be sorted and uniqued
 	flat_map(std::initializer_list<entry_type> ilist) : data(ilist) {
-		unique();
+		sort_and_unique();
 	}
 	
-	//! move construct through a vector, note that all entries will be uniqued
+	//! move construct through a vector, note that all entries will be sorted and uniqued
 	flat_map(std::vector<entry_type>&& vec) : data(std::move(vec)) {
-		unique();
+		sort_and_unique();
 	}
 	
-	//! copy construct through a vector, note that all entries will be uniqued
+	//! copy construct through a vector, note that all entries will be sorted and uniqued
 	flat_map(const std::vector<entry_type>& vec) : data(vec) {
-		unique();
+		sort_and_unique();
 	}
 	
 	//! look up 'key' and if found, return its associated value, if not found,
 	//! insert a new <key, value> pair using the value_types default constructor and return it
 	value_type& operator[](const key_type& key) {
-		const auto iter = find(key);
-		if(iter != end()) {
-			return iter->second;
+		const auto idx = lower_bound_index(key);
+		if (idx < data.size() && !std::less<> {}(key, get_key(data[idx].first))) {
+			return data[idx].second;
 		}
-		return insert_or_assign(key, value_type {})->second;
+		return data.emplace(data.begin() + ptrdiff_t(idx), key, value_type {})->second;
 	}
 	
 	//! look up 'key' and if found, return its associated value,
 	//! if not found, throws std::out_of_range
-	value_type& at(const key_type& key) {
-		const auto iter = find(key);
-		if (iter == end()) {
-			if constexpr (std::is_same_v<key_type, std::string> || std::is_same_v<key_type, std::string_view>) {
-				throw std::out_of_range("key not found: " + string(key));
-			} else {
-				throw std::out_of_range("key not found");
-			}
+	template <typename lookup_key_type = key_type>
+	value_type& at(const lookup_key_type& key) {
+		const auto idx = find_index(key);
+		if (idx == data.size()) {
+			throw_key_not_found(key);
 		}
-		return iter->second;
+		return data[idx].second;
 	}
 	
 	//! look up 'key' and if found, return its associated value,
 	//! if not found, throws std::out_of_range
-	const value_type& at(const key_type& key) const {
-		const auto iter = find(key);
-		if (iter == end()) {
-			if constexpr (std::is_same_v<key_type, std::string> || std::is_same_v<key_type, std::string_view>) {
-				throw std::out_of_range("key not found: " + std::string(key));
-			} else {
-				throw std::out_of_range("key not found");
-			}
+	template <typename lookup_key_type = key_type>
+	const value_type& at(const lookup_key_type& key) const {
+		const auto idx = find_index(key);
+		if (idx == data.size()) {
+			throw_key_not_found(key);
 		}
-		return iter->second;
+		return data[idx].second;
 	}
 	
 	//! inserts a new <key, value> pair if no entry for 'key' exists yet, or replaces the current <key, value> entry if it does,
 	//! returns an iterator to the <key, value> pair, as well as a bool signaling whether insertion (true) or assignment (false) took place
 	std::pair<iterator, bool> insert_or_assign(const key_type& key, const value_type& value) {
-		auto iter = find(key);
-		if(iter != end()) {
-			iter->second = value;
-			return { iter, false };
+		const auto idx = lower_bound_index(key);
+		if (idx < data.size() && !std::less<> {}(key, get_key(data[idx].first))) {
+			data[idx].second = value;
+			return { data.begin() + ptrdiff_t(idx), false };
 		}
-		return { data.emplace(end(), key, value), true };
+		return { data.emplace(data.begin() + ptrdiff_t(idx), key, value), true };
 	}
 	
 	//! inserts a new <key, value> pair if no entry for 'key' exists yet, or replaces the current <key, value> entry if it does,
 	//! returns an iterator to the <key, value> pair, as well as a bool signaling whether insertion (true) or assignment (false) took place
 	std::pair<iterator, bool> insert_or_assign(const key_type& key, value_type&& value) {
-		auto iter = find(key);
-		if (iter != end()) {
-			iter->second = std::move(value);
-			return { iter, false };
+		const auto idx = lower_bound_index(key);
+		if (idx < data.size() && !std::less<> {}(key, get_key(data[idx].first))) {
+			data[idx].second = std::move(value);
+			return { data.begin() + ptrdiff_t(idx), false };
 		}
-		return { data.emplace(end(), key, std::forward<value_type>(value)), true };
+		return { data.emplace(data.begin() + ptrdiff_t(idx), key, std::forward<value_type>(value)), true };
 	}
 	
 	//! inserts a new <key, value> pair if no entry for 'key' exists yet and returns std::pair<iterator to it, true>,
 	//! or returns std::pair<iterator to the current <key, value> entry, false> if it already exists
 	std::pair<iterator, bool> insert(const key_type& key, const value_type& value) {
-		auto iter = find(key);
-		if(iter != end()) {
-			return { iter, false };
+		const auto idx = lower_bound_index(key);
+		if (idx < data.size() && !std::less<> {}(key, get_key(data[idx].first))) {
+			return { data.begin() + ptrdiff_t(idx), false };
 		}
-		return { data.emplace(end(), key, value), true };
+		return { data.emplace(data.begin() + ptrdiff_t(idx), key, value), true };
 	}
 	
 	//! inserts a new <key, value> pair if no entry for 'key' exists yet and returns std::pair<iterator to it, true>,
 	//! or returns std::pair<iterator to the current <key, value> entry, false> if it already exists
 	template <typename empl_key_type, typename empl_value_type>
 	std::pair<iterator, bool> emplace(empl_key_type&& key, empl_value_type&& value) {
-		auto iter = find(key);
-		if(iter != end()) {
-			return { iter, false };
+		const auto idx = lower_bound_index(key);
+		if (idx < data.size() && !std::less<> {}(key, get_key(data[idx].first))) {
+			return { data.begin() + ptrdiff_t(idx), false };
+		}
+		return { data.emplace(data.begin() + ptrdiff_t(idx), std::forward<empl_key_type>(key), std::forward<empl_value_type>(value)), true };
+	}
+	
+	//! inserts all <key, value> pairs of the specified range for which no entry exists yet,
+	//! NOTE: for duplicate keys within the range, only the first entry is inserted
+	//! NOTE: unlike repeated insert()/emplace() calls, this only sorts once (O((n + m) log(n + m)) instead of O(n * m))
+	template <typename range_type> requires (std::ranges::input_range<range_type>)
+	void insert_range(range_type&& range) {
+		if constexpr (std::ranges::sized_range<range_type>) {
+			data.reserve(data.size() + size_t(std::ranges::size(range)));
 		}
-		return { data.emplace(end(), std::forward<empl_key_type>(key), std::forward<empl_value_type>(value)), true };
+		for (auto&& entry : range) {
+			data.emplace_back(std::forward<decltype(entry)>(entry));
+		}
+		// NOTE: existing entries are placed before new ones and the sort is stable -> existing entries are kept
+		sort_and_unique();
+	}
+	
+	//! replaces the contents of this map with the specified entries (without sorting them),
+	//! NOTE: entries must already be sorted by key and must not contain any duplicate keys
+	void adopt_sorted(std::vector<entry_type>&& entries) {
+		data = std::move(entries);
+		assert(std::ranges::is_sorted(data, std::less<> {}, [](const entry_type& entry) -> const key_type& { return get_key(entry.first); }));
 	}
 	
 	//! erases the <key, value> pair at 'iter',
@@ -218,37 +307,38 @@ public:
 	}
 	
 	//! erases the <key, value> pair for the specified 'key', returns the number of erased <key, value> entries
-	size_t erase(const key_type& key) {
-		const auto iter = find(key);
-		if (iter != end()) {
-			data.erase(iter);
+	template <typename lookup_key_type = key_type>
+	size_t erase(const lookup_key_type& key) {
+		const auto idx = find_index(key);
+		if (idx < data.size()) {
+			data.erase(data.begin() + ptrdiff_t(idx));
 			return 1uz;
 		}
 		return 0uz;
 	}
 	
 	//! returns an iterator to the <key, value> pair corresponding to 'key', returns end() if not found
-	iterator find(const key_type& key) {
-		return find_if(data.begin(), data.end(), [&key](const entry_type& entry) {
-			return (get_key(entry.first) == key);
-		});
+	template <typename lookup_key_type = key_type>
+	iterator find(const lookup_key_type& key) {
+		return data.begin() + ptrdiff_t(find_index(key));
 	}
 	
 	//! returns a const_iterator to the <key, value> pair corresponding to 'key', returns end() if not found
-	const_iterator find(const key_type& key) const {
-		return find_if(data.cbegin(), data.cend(), [&key](const entry_type& entry) {
-			return (get_key(entry.first) == key);
-		});
+	template <typename lookup_key_type = key_type>
+	const_iterator find(const lookup_key_type& key) const {
+		return data.cbegin() + ptrdiff_t(find_index(key));
 	}
 	
 	//! returns 1 if a <key, value> entry for 'key' exists in this map, 0 if not
-	size_t count(const key_type& key) const {
-		return (find(key) != end() ? 1 : 0);
+	template <typename lookup_key_type = key_type>
+	size_t count(const lookup_key_type& key) const {
+		return (find_index(key) != data.size() ? 1 : 0);
 	}
 	
 	//! returns true if a <key, value> entry for 'key' exists in this map, false if not
-	bool contains(const key_type& key) const {
-		return (find(key) != end());
+	template <typename lookup_key_type = key_type>
+	bool contains(const lookup_key_type& key) const {
+		return (find_index(key) != data.size());
 	}
 	
 	// forward auxiliary functions
@@ -22,11 +22,25 @@
 #include <variant>
 #include <iostream>
 #include <fstream>
+#include <string_view>
+#include <span>
+#include <tuple>
+
+//! set this in-class to specify which members should be extracted from a json object via json::extract()/document::extract(),
+//! each member is specified via JSON_FIELD(member) (json key == member name) or JSON_FIELD_PATH(member, "path.to.value")
+#define JSON_SERIALIZATION(class_type, ...) \
+static constexpr auto json_fields() { \
+	using json_class_type = class_type; \
+	return std::make_tuple(__VA_ARGS__); \
+}
+#define JSON_FIELD(member) fl::json::make_json_field(#member, &json_class_type::member)
+#define JSON_FIELD_PATH(member, path) fl::json::make_json_field(path, &json_class_type::member)
 
 namespace fl::json {
 using namespace std::literals;
 
 	struct json_value;
+	//! NOTE: members are iterated in key order, not in document order
 	using json_object = fl::flat_map<std::string, json_value>;
 	using json_array = std::vector<json_value>;
 	
@@ -126,6 +140,13 @@ using namespace std::literals;
 			}
 			return { false, "" };
 		}
+		template <typename T> requires std::is_same_v<T, std::string_view>
+		std::pair<bool, std::string_view> get() const {
+			if (auto val_ptr = std::get_if<std::string>(&value); val_ptr) {
+				return { true, *val_ptr };
+			}
+			return { false, {} };
+		}
 		template <typename T> requires std::is_same_v<T, json_object>
 		std::pair<bool, json_object> get() const {
 			if (auto val_ptr = std::get_if<json_object>(&value); val_ptr) {
@@ -141,6 +162,26 @@ using namespace std::literals;
 			return { false, {} };
 		}
 		
+		//! returns a pointer to the contained string, object or array if its type matches the specified type T,
+		//! returns nullptr if the type doesn't match
+		//! NOTE: unlike get<T>(), this doesn't copy anything
+		template <typename T> requires (std::is_same_v<T, std::string> || std::is_same_v<T, json_object> || std::is_same_v<T, json_array>)
+		const T* get_if() const {
+			return std::get_if<T>(&value);
+		}
+		
+		//! returns all elements of this array, or an empty span if this is not an array
+		std::span<const json_value> get_elements() const;
+		
+		//! returns the member value with the specified key,
+		//! returns nullptr if this is not an object or if no member with this key exists
+		const json_value* find(const std::string_view key) const;
+		
+		//! returns the value at the specified path "node.subnode.key" relative to this value, or this value if path is empty,
+		//! returns nullptr if no value exists at this path
+		//! NOTE: this doesn't allocate any memory
+		const json_value* find_path(const std::string_view path) const;
+		
 		//! gets this value as type "T" or throws if this value is not of the specified type
 		template <typename T>
 		T get_or_throw() const {
@@ -183,6 +224,38 @@ using namespace std::literals;
 		explicit constexpr json_value(const bool& flag_) : value(flag_) {}
 	};
 	
+	inline std::span<const json_value> json_value::get_elements() const {
+		if (auto arr_ptr = std::get_if<json_array>(&value); arr_ptr) {
+			return *arr_ptr;
+		}
+		return {};
+	}
+	
+	//! precompiled "node.subnode.key" path: the path is only split once and can then be resolved many times
+	class json_path {
+	public:
+		json_path() = default;
+		explicit json_path(const std::string_view path_str_);
+		
+		//! resolves this path starting at the specified value (usually the document root),
+		//! returns nullptr if no value exists at this path
+		const json_value* resolve(const json_value& root) const;
+		
+		//! returns the original path string
+		const std::string& get_path_string() const {
+			return path_str;
+		}
+		
+		//! returns true if this is an empty path (resolves to the root value)
+		bool empty() const {
+			return keys.empty();
+		}
+	
+	protected:
+		std::string path_str;
+		std::vector<std::string> keys;
+	};
+	
 	//! json document, root is always a json value
 	struct document {
 	private:
@@ -199,6 +272,36 @@ using namespace std::literals;
 		template <typename T> T get(const std::string& path,
 									const T default_val = default_value<T>::def()) const;
 		
+		//! returns the value of the key specified by the precompiled path,
+		//! or "default_val" if the value doesn't exist or is of a different type
+		template <typename T> T get(const json_path& path,
+									const T default_val = default_value<T>::def()) const {
+			if (const auto val = path.resolve(root); val) {
+				auto ret = val->get<T>();
+				if (ret.first) {
+					return std::move(ret.second);
+				}
+			}
+			return default_val;
+		}
+		
+		//! returns the value at the specified path "node.subnode.key", or the root node if path is an empty string,
+		//! returns nullptr if no value exists at this path
+		//! NOTE: use get_if<T>() or get_elements() on the returned value to access strings, objects and arrays without copying
+		const json_value* find(const std::string_view path) const {
+			return root.find_path(path);
+		}
+		
+		//! returns the value at the specified precompiled path, returns nullptr if no value exists at this path
+		const json_value* find(const json_path& path) const {
+			return path.resolve(root);
+		}
+		
+		//! extracts all members specified via JSON_SERIALIZATION of "dst" from the object at "base_path",
+		//! see json::extract()
+		template <typename T>
+		uint32_t extract(T& dst, const std::string_view base_path = "") const;
+		
 		//! writes this document to disk as "filename",
 		//! returns true on success, false otherwise
 		bool write(const std::string& filename) const {
@@ -225,6 +328,73 @@ using namespace std::literals;
 		}
 	};
 	
+	//! describes a single json-mapped member of a class (see JSON_SERIALIZATION)
+	template <typename class_type, typename member_type>
+	struct json_field {
+		//! path of the value relative to the extracted object
+		const char* path;
+		member_type class_type::* member;
+	};
+	
+	template <typename class_type, typename member_type>
+	constexpr json_field<class_type, member_type> make_json_field(const char* path, member_type class_type::* member) {
+		return { path, member };
+	}
+	
+	//! true if "T" specifies its json-mapped members via JSON_SERIALIZATION
+	template <typename T>
+	concept json_extractable = requires { T::json_fields(); };
+	
+	template <typename T> requires json_extractable<T>
+	uint32_t extract(const json_value& obj, T& dst);
+	
+	//! extracts a single value into "dst", returns true on success
+	template <typename T>
+	bool extract_member(const json_value& val, T& dst) {
+		if constexpr (json_extractable<T>) {
+			if (!val.get_if<json_object>()) {
+				return false;
+			}
+			(void)extract(val, dst);
+			return true;
+		} else if constexpr (std::is_enum_v<T>) {
+			auto ret = val.get<std::underlying_type_t<T>>();
+			if (ret.first) {
+				dst = T(ret.second);
+			}
+			return ret.first;
+		} else {
+			auto ret = val.get<T>();
+			if (ret.first) {
+				dst = std::move(ret.second);
+			}
+			return ret.first;
+		}
+	}
+	
+	//! extracts all members specified via JSON_SERIALIZATION of "dst" from the json object "obj" (all in one go),
+	//! members whose value doesn't exist or has a different type retain their current value,
+	//! returns the amount of extracted members
+	template <typename T> requires json_extractable<T>
+	uint32_t extract(const json_value& obj, T& dst) {
+		uint32_t extracted_count = 0;
+		std::apply([&obj, &dst, &extracted_count](const auto&... fields) {
+			((extracted_count += [&obj, &dst](const auto& field) {
+				const auto val = obj.find_path(field.path);
+				return (val && extract_member(*val, dst.*(field.member)) ? 1u : 0u);
+			}(fields)), ...);
+		}, T::json_fields());
+		return extracted_count;
+	}
+	
+	template <typename T>
+	uint32_t document::extract(T& dst, const std::string_view base_path) const {
+		if (const auto obj = find(base_path); obj) {
+			return json::extract(*obj, dst);
+		}
+		return 0u;
+	}
+	
 	//! reads the json file specified by 'filename' and creates a json document from it
 	document create_document(const std::string& filename);
 	
@@ -0,0 +1,254 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/core/json.hpp>
+#include <string_view>
+#include <span>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <cstdint>
+
+//! streaming (event-based) JSON reading and writing:
+//! documents are never held in memory as a whole, so these can be used with arbitrarily large JSON data
+//! NOTE: supports the same JSON flavor as json::create_document (i.e. also allows "//", "/* */" and "#" comments)
+namespace fl::json {
+	
+	//! receives all parsing events of a stream_reader,
+	//! each function must return true to continue parsing or false to abort parsing
+	//! NOTE: all string_views are only valid for the duration of the call
+	class stream_handler {
+	public:
+		virtual ~stream_handler() = default;
+		
+		virtual bool on_null() { return true; }
+		virtual bool on_bool(const bool /* value */) { return true; }
+		virtual bool on_int(const int64_t /* value */) { return true; }
+		virtual bool on_fp(const double /* value */) { return true; }
+		//! called for string values, "str" is already unescaped
+		virtual bool on_string(const std::string_view /* str */) { return true; }
+		//! called for object member keys (followed by the member value), "key" is already unescaped
+		virtual bool on_key(const std::string_view /* key */) { return true; }
+		virtual bool on_object_begin() { return true; }
+		virtual bool on_object_end() { return true; }
+		virtual bool on_array_begin() { return true; }
+		virtual bool on_array_end() { return true; }
+	};
+	
+	//! stream_reader options
+	struct stream_reader_options {
+		//! size of each chunk that is read from an input stream
+		size_t chunk_size { 1024u * 1024u };
+		//! if true, allows multiple consecutive root values (e.g. JSON lines / concatenated JSON)
+		bool allow_multiple_root_values { false };
+		//! max nesting depth of objects/arrays
+		uint32_t max_depth { 4096u };
+	};
+	
+	//! event-based JSON reader: parses JSON data from an input stream chunk-by-chunk or from memory
+	//! (e.g. a memory-mapped file) and signals all values to the specified handler
+	class stream_reader {
+	public:
+		explicit stream_reader(stream_handler& handler_, const stream_reader_options& options_ = {});
+		
+		//! parses all JSON data from the specified input stream, returns true on success
+		//! NOTE: only "chunk_size" bytes (+ the currently parsed string) are held in memory at once
+		bool parse(std::istream& stream, const std::string& identifier = "");
+		
+		//! parses all JSON data from the specified memory, returns true on success
+		//! NOTE: strings without escape sequences are directly passed on as views into "data"
+		bool parse(const std::span<const char> data, const std::string& identifier = "");
+		
+		//! parses the specified JSON file chunk-by-chunk, returns true on success
+		bool parse_file(const std::string& filename);
+		
+		//! returns the amount of root values that have been parsed by the last parse call
+		uint64_t get_root_value_count() const {
+			return root_value_count;
+		}
+		
+		stream_reader(const stream_reader&) = delete;
+		stream_reader& operator=(const stream_reader&) = delete;
+	
+	protected:
+		stream_handler& handler;
+		const stream_reader_options options;
+		
+		//! current input data
+		const char* cur { nullptr };
+		const char* end { nullptr };
+		const char* chunk_begin { nullptr };
+		//! offset of the current chunk in the input
+		uint64_t chunk_offset { 0u };
+		//! if non-null, further chunks are read from this stream
+		std::istream* input_stream { nullptr };
+		std::unique_ptr<char[]> chunk_buffer;
+		std::string identifier;
+		
+		enum class CONTAINER_TYPE : uint8_t {
+			OBJECT,
+			ARRAY,
+		};
+		//! currently open objects/arrays
+		std::vector<CONTAINER_TYPE> container_stack;
+		//! used for strings and numbers that contain escape sequences or cross chunk boundaries
+		std::string scratch;
+		uint64_t root_value_count { 0u };
+		
+		//! parses everything from the current input
+		bool run();
+		//! reads the next chunk from the input stream, returns false on EOF
+		bool refill();
+		//! returns the next char without consuming it or -1 on EOF
+		int peek() {
+			if (cur == end && !refill()) {
+				return -1;
+			}
+			return (uint8_t)*cur;
+		}
+		//! consumes and returns the next char, returns false on EOF
+		bool next(char& ch) {
+			if (cur == end && !refill()) {
+				return false;
+			}
+			ch = *cur++;
+			return true;
+		}
+		bool error(const std::string_view msg) const;
+		bool skip_whitespace();
+		bool parse_string(std::string_view& str);
+		bool parse_hex4(uint32_t& value);
+		bool parse_number();
+		bool parse_keyword(const std::string_view keyword);
+	};
+	
+	//! stream_handler that builds json_values from the parsed data,
+	//! each complete root value is passed to the specified callback (return false to abort parsing)
+	//! NOTE: strings are re-escaped, so that the values are equivalent to the ones created by json::create_document
+	class json_value_builder : public stream_handler {
+	public:
+		using root_value_callback_t = std::function<bool(json_value&& value)>;
+		explicit json_value_builder(root_value_callback_t root_value_callback_) : root_value_callback(std::move(root_value_callback_)) {}
+		
+		bool on_null() override;
+		bool on_bool(const bool value) override;
+		bool on_int(const int64_t value) override;
+		bool on_fp(const double value) override;
+		bool on_string(const std::string_view str) override;
+		bool on_key(const std::string_view key) override;
+		bool on_object_begin() override;
+		bool on_object_end() override;
+		bool on_array_begin() override;
+		bool on_array_end() override;
+	
+	protected:
+		root_value_callback_t root_value_callback;
+		//! currently open objects/arrays
+		std::vector<json_value> value_stack;
+		//! keys of all currently open object members
+		std::vector<std::string> key_stack;
+		
+		bool add_value(json_value&& value);
+	};
+	
+	//! stream_writer options
+	struct stream_writer_options {
+		//! if true, writes indented, multi-line JSON, otherwise writes everything without whitespace
+		bool pretty { true };
+		//! amount of spaces per indentation level in pretty mode
+		uint32_t indent { 4u };
+		//! size of the internal write buffer (data is only written to the stream once this is full or on flush())
+		size_t buffer_size { 64u * 1024u };
+	};
+	
+	//! buffered JSON writer that writes values one after another to an output stream
+	//! NOTE: each complete root value is followed by a newline (i.e. multiple root values are written as JSON lines)
+	//! NOTE: all functions return false (and log an error) if the call would produce invalid JSON
+	class stream_writer {
+	public:
+		explicit stream_writer(std::ostream& stream_, const stream_writer_options& options_ = {});
+		//! flushes all remaining data
+		~stream_writer();
+		
+		bool begin_object();
+		bool end_object();
+		bool begin_array();
+		bool end_array();
+		//! writes the key of the next object member
+		bool write_key(const std::string_view key);
+		
+		bool write_null();
+		bool write_bool(const bool value);
+		bool write_int(const int64_t value);
+		bool write_uint(const uint64_t value);
+		bool write_fp(const double value);
+		//! writes an (unescaped) string, escaping it as necessary
+		bool write_string(const std::string_view str);
+		
+		//! writes a complete json_value
+		//! NOTE: like json_value::print(), strings and keys are written as-is
+		//!       (json::create_document and json_value_builder store strings in their escaped form)
+		bool write_value(const json_value& value);
+		
+		//! writes all buffered data to the stream and flushes the stream
+		void flush();
+		
+		stream_writer(const stream_writer&) = delete;
+		stream_writer& operator=(const stream_writer&) = delete;
+	
+	protected:
+		std::ostream& stream;
+		const stream_writer_options options;
+		std::unique_ptr<char[]> buffer;
+		size_t buffer_pos { 0u };
+		
+		struct container_t {
+			bool is_object;
+			bool has_key;
+			uint64_t count;
+		};
+		std::vector<container_t> container_stack;
+		
+		//! writes the data to the buffer (or directly to the stream if it is larger than the buffer)
+		void append(const char* data, const size_t size);
+		void append(const std::string_view str) {
+			append(str.data(), str.size());
+		}
+		void append(const char ch) {
+			if (buffer_pos == options.buffer_size) {
+				flush_buffer();
+			}
+			buffer[buffer_pos++] = ch;
+		}
+		void flush_buffer();
+		void append_indent(const size_t depth);
+		void append_escaped(const std::string_view str);
+		//! must be called before writing any value, handles separators and indentation
+		bool begin_value();
+		//! must be called after writing any value
+		void end_value();
+		bool end_container(const bool is_object);
+	};
+	
+	//! escapes the specified string (", \, control characters) and appends it to "dst"
+	void escape_string(const std::string_view str, std::string& dst);
+
+} // namespace fl::json
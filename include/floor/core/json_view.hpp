@@ -0,0 +1,236 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/core/json.hpp>
+#include <string_view>
+#include <span>
+#include <memory>
+#include <vector>
+#include <type_traits>
+#include <cstdint>
+
+//! fast, zero-copy JSON DOM:
+//! the document is parsed in a single pass (no token vector or AST) and all values are allocated in an arena,
+//! strings that don't need unescaping are views into the source data, object members are sorted by key
+//! NOTE: supports the same JSON flavor as json::create_document (i.e. also allows "//", "/* */" and "#" comments)
+namespace fl::json {
+	
+	//! simple arena allocator: memory is allocated in large blocks and only freed once the arena is destroyed
+	//! NOTE: only trivially destructible types may be allocated
+	class arena_allocator {
+	public:
+		explicit arena_allocator(const size_t block_size_ = 64u * 1024u) : block_size(block_size_) {}
+		
+		//! allocates uninitialized memory for "count" objects of type T
+		template <typename T> requires (std::is_trivially_destructible_v<T>)
+		T* allocate(const size_t count) {
+			return (T*)allocate_bytes(sizeof(T) * count, alignof(T));
+		}
+		
+		//! allocates "size" bytes with the specified alignment
+		void* allocate_bytes(const size_t size, const size_t alignment);
+		
+		//! returns the total amount of bytes allocated by this arena (including unused block space)
+		size_t get_allocated_size() const {
+			return allocated_size;
+		}
+		
+		arena_allocator(const arena_allocator&) = delete;
+		arena_allocator& operator=(const arena_allocator&) = delete;
+	
+	protected:
+		const size_t block_size;
+		std::vector<std::unique_ptr<uint8_t[]>> blocks;
+		uint8_t* cur_block_ptr { nullptr };
+		size_t cur_block_size { 0u };
+		size_t cur_offset { 0u };
+		size_t allocated_size { 0u };
+	};
+	
+	struct view_member;
+	
+	//! json value in a view document (keyword, object, array, number or string)
+	//! NOTE: this is a trivially copyable 16 byte handle, all referenced data is owned by the view_document
+	struct view_value {
+		using VALUE_TYPE = json_value::VALUE_TYPE;
+		
+		VALUE_TYPE type { VALUE_TYPE::NULL_VALUE };
+		//! string length, object member count or array element count
+		uint32_t count { 0u };
+		union {
+			bool bool_value;
+			int64_t int_value;
+			double fp_value;
+			const char* str_data;
+			//! sorted by key
+			const view_member* members;
+			const view_value* elements;
+		};
+		
+		constexpr view_value() noexcept : int_value(0) {}
+		
+		//! returns the type of this value
+		constexpr VALUE_TYPE get_type() const {
+			return type;
+		}
+		
+		constexpr bool is_null() const {
+			return (type == VALUE_TYPE::NULL_VALUE);
+		}
+		constexpr bool is_object() const {
+			return (type == VALUE_TYPE::OBJECT);
+		}
+		constexpr bool is_array() const {
+			return (type == VALUE_TYPE::ARRAY);
+		}
+		constexpr bool is_string() const {
+			return (type == VALUE_TYPE::STRING);
+		}
+		
+		//! returns the value of this value if its type matches the specified type T,
+		//! returning it as <true, value>, or returning <false, 0> if the type doesn't match
+		//! NOTE: same conversion rules as json_value::get<T>()
+		template <typename T> requires std::is_same_v<T, bool>
+		std::pair<bool, bool> get() const {
+			if (type == VALUE_TYPE::BOOL_VALUE) {
+				return { true, bool_value };
+			}
+			return { false, false };
+		}
+		template <typename T> requires std::is_same_v<T, int64_t>
+		std::pair<bool, int64_t> get() const {
+			if (type == VALUE_TYPE::INT_NUMBER) {
+				return { true, int_value };
+			}
+			return { false, 0 };
+		}
+		template <typename T> requires std::is_same_v<T, uint64_t>
+		std::pair<bool, uint64_t> get() const {
+			if (type == VALUE_TYPE::INT_NUMBER) {
+				return { true, std::bit_cast<uint64_t>(int_value) };
+			}
+			return { false, 0u };
+		}
+		template <typename T> requires std::is_same_v<T, int32_t>
+		std::pair<bool, int32_t> get() const {
+			if (type == VALUE_TYPE::INT_NUMBER) {
+				return { true, int32_t(int_value < 0 ?
+									   std::max(int_value, int64_t(INT32_MIN)) :
+									   std::min(int_value, int64_t(INT32_MAX))) };
+			}
+			return { false, 0 };
+		}
+		template <typename T> requires std::is_same_v<T, uint32_t>
+		std::pair<bool, uint32_t> get() const {
+			if (type == VALUE_TYPE::INT_NUMBER) {
+				return { true, uint32_t(std::min(std::bit_cast<uint64_t>(int_value), uint64_t(UINT32_MAX))) };
+			}
+			return { false, 0u };
+		}
+		template <typename T> requires std::is_same_v<T, float>
+		std::pair<bool, float> get() const {
+			if (type == VALUE_TYPE::FP_NUMBER) {
+				return { true, float(fp_value) };
+			}
+			return { false, 0.0f };
+		}
+		template <typename T> requires std::is_same_v<T, double>
+		std::pair<bool, double> get() const {
+			if (type == VALUE_TYPE::FP_NUMBER) {
+				return { true, fp_value };
+			}
+			return { false, 0.0 };
+		}
+		template <typename T> requires std::is_same_v<T, std::string_view>
+		std::pair<bool, std::string_view> get() const {
+			if (type == VALUE_TYPE::STRING) {
+				return { true, std::string_view { str_data, count } };
+			}
+			return { false, {} };
+		}
+		
+		//! returns all members of this object (sorted by key), or an empty span if this is not an object
+		std::span<const view_member> get_members() const;
+		
+		//! returns all elements of this array, or an empty span if this is not an array
+		std::span<const view_value> get_elements() const {
+			if (type == VALUE_TYPE::ARRAY) {
+				return { elements, count };
+			}
+			return {};
+		}
+		
+		//! returns the member value with the specified key (O(log n)),
+		//! returns nullptr if this is not an object or if no member with this key exists
+		const view_value* find(const std::string_view key) const;
+		
+		//! converts this value (and all of its children) to a json_value
+		json_value to_json_value() const;
+		
+		void print(std::ostream& stream = std::cout, const uint32_t depth = 0) const;
+	};
+	static_assert(sizeof(view_value) == 16u);
+	static_assert(std::is_trivially_copyable_v<view_value> && std::is_trivially_destructible_v<view_value>);
+	
+	//! single <key, value> member of a view_value object
+	struct view_member {
+		std::string_view key;
+		view_value value;
+	};
+	
+	inline std::span<const view_member> view_value::get_members() const {
+		if (type == VALUE_TYPE::OBJECT) {
+			return { members, count };
+		}
+		return {};
+	}
+	
+	//! json view document, root is always a json value
+	//! NOTE: all values are only valid as long as this document exists (and, if the document doesn't own its source data,
+	//!       as long as the source data exists)
+	struct view_document {
+		view_value root;
+		bool valid { false };
+		
+		//! backing storage of all objects, arrays and unescaped strings
+		std::unique_ptr<arena_allocator> storage;
+		//! if the document was created from a file, this contains the source data that is referenced by all non-escaped strings
+		std::unique_ptr<std::string> owned_source;
+		
+		//! returns the value at the specified path "node.subnode.key", or the root node if path is an empty string,
+		//! returns nullptr if no value exists at this path
+		const view_value* find(const std::string_view path) const;
+		
+		//! converts this view document to a normal json document
+		document to_document() const;
+		
+		//! dumps the document to the specified stream (defaults to "cout")
+		void print(std::ostream& stream = std::cout) const;
+	};
+	
+	//! reads the json file specified by 'filename' and creates a json view document from it
+	view_document create_view_document(const std::string& filename);
+	
+	//! creates a json view document from the in-memory json data,
+	//! 'identifier' is used for error reporting/identification
+	//! NOTE: "json_data" is not copied and must outlive the document
+	view_document create_view_document_from_string(const std::string_view json_data, const std::string identifier = "");
+
+} // namespace fl::json
@@ -24,18 +24,26 @@
 #include <type_traits>
 #include <iostream>
 #include <iomanip>
+#include <string_view>
+#include <optional>
+#include <tuple>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <cstdint>
+#include <floor/constexpr/const_string.hpp>
 
 //! floor logging functions, use appropriately
 //! note that you don't actually have to use a specific character for %_ to print the
 //! correct type (the ostream operator<< is used and the %_ character is ignored - except
 //! for $x (lowercase), $X (uppercase) and $Y (uppercase + fill to width) which will print
 //! out an integer in hex format)
-#define log_error(str, ...) fl::logger::log<fl::logger::compute_arg_count(str)>(fl::logger::LOG_TYPE::ERROR_MSG, __FILE_NAME__, __func__, str, ##__VA_ARGS__)
-#define log_warn(str, ...) fl::logger::log<fl::logger::compute_arg_count(str)>(fl::logger::LOG_TYPE::WARNING_MSG, __FILE_NAME__, __func__, str, ##__VA_ARGS__)
-#define log_debug(str, ...) fl::logger::log<fl::logger::compute_arg_count(str)>(fl::logger::LOG_TYPE::DEBUG_MSG, __FILE_NAME__, __func__, str, ##__VA_ARGS__)
-#define log_msg(str, ...) fl::logger::log<fl::logger::compute_arg_count(str)>(fl::logger::LOG_TYPE::SIMPLE_MSG, "", "", str, ##__VA_ARGS__)
-#define log_undecorated(str, ...) fl::logger::log<fl::logger::compute_arg_count(str)>(fl::logger::LOG_TYPE::UNDECORATED, "", "", str, ##__VA_ARGS__)
+//! NOTE: format strings are parsed at compile time, "$$" can be used to print a single '$'
+#define log_error(str, ...) fl::logger::log<fl::const_string { str }>(fl::logger::LOG_TYPE::ERROR_MSG, __FILE_NAME__, __func__, ##__VA_ARGS__)
+#define log_warn(str, ...) fl::logger::log<fl::const_string { str }>(fl::logger::LOG_TYPE::WARNING_MSG, __FILE_NAME__, __func__, ##__VA_ARGS__)
+#define log_debug(str, ...) fl::logger::log<fl::const_string { str }>(fl::logger::LOG_TYPE::DEBUG_MSG, __FILE_NAME__, __func__, ##__VA_ARGS__)
+#define log_msg(str, ...) fl::logger::log<fl::const_string { str }>(fl::logger::LOG_TYPE::SIMPLE_MSG, "", "", ##__VA_ARGS__)
+#define log_undecorated(str, ...) fl::logger::log<fl::const_string { str }>(fl::logger::LOG_TYPE::UNDECORATED, "", "", ##__VA_ARGS__)
 
 namespace fl {
 
@@ -68,7 +76,93 @@ public:
 		return arg_count;
 	}
 	
+	//! literal text segment of a parsed log format string
+	struct format_segment_t {
+		//! offset of the text in the format string
+		uint32_t offset;
+		//! length of the text
+		uint32_t length;
+		//! true if an argument is written after the text
+		bool has_arg;
+		//! format character of the argument ('\0' if none)
+		char format;
+	};
+	
+	//! type-erased view of a parsed log format string
+	struct format_view_t {
+		const char* str;
+		const format_segment_t* segments;
+		uint32_t segment_count;
+	};
+	
+	//! parses the log format string "str" into literal text segments and arguments, resolving "$$" to '$',
+	//! if "segments" is nullptr, this only returns the amount of segments that are needed
+	static constexpr size_t parse_format(const char* str, format_segment_t* segments) {
+		size_t segment_count = 0;
+		uint32_t segment_start = 0;
+		const auto add_segment = [&segments, &segment_count, &segment_start](const size_t end, const bool has_arg,
+																			 const char format, const size_t next_start) {
+			if (segments) {
+				segments[segment_count] = { segment_start, uint32_t(end) - segment_start, has_arg, format };
+			}
+			++segment_count;
+			segment_start = uint32_t(next_start);
+		};
+		// NOTE: this must match compute_arg_count()
+		const auto len = __builtin_strlen(str);
+		for (size_t i = 0; i < len; ++i) {
+			if (str[i] != '$') {
+				continue;
+			}
+			if (i + 1 == len) {
+				// end of string with no format
+				add_segment(i, true, '\0', i + 1);
+			} else if (str[i + 1] != '$') {
+				const auto format = (is_format_char(str[i + 1]) ? str[i + 1] : '\0');
+				add_segment(i, true, format, format != '\0' ? i + 2 : i + 1);
+				++i;
+			} else {
+				// "$$" -> '$' is part of this segment, continue after the second '$'
+				add_segment(i + 1, false, '\0', i + 2);
+				++i;
+			}
+		}
+		add_segment(len, false, '\0', len);
+		return segment_count;
+	}
+	
+	//! compile-time parsed log format string
+	template <const_string format_str>
+	struct parsed_format {
+		static constexpr const size_t arg_count { compute_arg_count(format_str.data()) };
+		static constexpr const size_t segment_count { parse_format(format_str.data(), nullptr) };
+		static constexpr const std::array<format_segment_t, segment_count> segments = [] {
+			std::array<format_segment_t, segment_count> ret {};
+			parse_format(format_str.data(), ret.data());
+			return ret;
+		}();
+		static constexpr const format_view_t view { format_str.data(), segments.data(), uint32_t(segment_count) };
+	};
+	
+	//! log file sink options
+	//! NOTE: no default member initializers, so that this can be used as a default argument below (-> all zero/false/empty)
+	struct file_sink_options_t {
+		//! max verbosity of messages that are written to the log file(s),
+		//! if empty, this is the same as the console verbosity
+		std::optional<LOG_TYPE> file_verbosity;
+		//! rotate a log file once it would exceed this size (in bytes), 0 = no size-based rotation
+		uint64_t max_file_size;
+		//! rotate a log file once it has been written to for this long (in seconds), 0 = no time-based rotation
+		uint64_t max_file_age;
+		//! max amount of rotated log files that are kept per log file, 0 = keep all
+		//! NOTE: only files that have been rotated by this process are considered
+		uint32_t max_rotated_files;
+		//! if true, rotated log files are BCM-compressed in the background (-> "<rotated file name>.bcm")
+		bool compress_rotated_files;
+	};
+	
 	//! initializes the logger (opens the log files and creates the logger thread)
+	//! NOTE: "verbosity" specifies the console verbosity (and the file verbosity if not set in "file_options")
 	static void init(const size_t verbosity,
 					 const bool separate_msg_file,
 					 const bool append_mode,
@@ -77,7 +171,9 @@ public:
 					 const bool synchronous_logging,
 					 const bool file_logging,
 					 const std::string& log_filename = "",
-					 const std::string& msg_filename = "");
+					 const std::string& msg_filename = "",
+					 const bool deferred_logging = false,
+					 const file_sink_options_t& file_options = {});
 	//! destroys the logger (also makes sure everything has been written to the console and log file)
 	static void destroy();
 	
@@ -86,31 +182,73 @@ public:
 	
 	//! log entry function, this will create a buffer and insert the log msgs start info (type, file name, ...) and
 	//! finally call the internal log function (that does the actual logging)
-	template <size_t computed_arg_count, typename... Args>
-	requires (computed_arg_count == sizeof...(Args) /* log argument count must match */)
-	static void log(const LOG_TYPE type, const char* file, const char* func, const char* str,
-					Args&&... args) {
+	//! NOTE: in deferred logging mode, messages with only arithmetic/enum/pointer/string arguments are not formatted here,
+	//!       but are stored as a binary record (parsed format string + raw arguments) that is formatted by the logger thread,
+	//!       for all other messages, only the message text is formatted here and is then stored the same way
+	template <const_string format_str, typename... Args>
+	requires (parsed_format<format_str>::arg_count == sizeof...(Args) /* log argument count must match */)
+	static void log(const LOG_TYPE type, const char* file, const char* func, Args&&... args) {
+		// check verbosity before doing anything else
+		if (!is_enabled(type)) {
+			return;
+		}
+		const auto& format = parsed_format<format_str>::view;
+		if (deferred.load(std::memory_order_relaxed)) {
+			if constexpr ((is_deferrable_v<std::decay_t<Args>> && ...)) {
+				if (log_deferred(type, file, func, format, args...)) {
+					return;
+				}
+			} else {
+				std::stringstream msg_buffer;
+				format_internal(msg_buffer, format, args...);
+				if (log_deferred(type, file, func, parsed_format<"$">::view, msg_buffer.str())) {
+					return;
+				}
+			}
+			// else: record doesn't fit into the ring -> log immediately
+		}
+		
 		std::stringstream buffer;
 		if (!prepare_log(buffer, type, file, func)) {
 			return;
 		}
-		log_internal(buffer, type, str, std::forward<Args>(args)...);
+		format_internal(buffer, format, args...);
+		log_internal(buffer, type);
 	}
 	
-	//! sets the logger verbosity to the specific LOG_TYPE verbosity level
+	//! sets the logger verbosity to the specific LOG_TYPE verbosity level (for both console and file output)
 	static void set_verbosity(const LOG_TYPE& verbosity);
-	//! returns the current logger verbosity level
+	//! sets the console verbosity to the specific LOG_TYPE verbosity level
+	static void set_console_verbosity(const LOG_TYPE& verbosity);
+	//! sets the log file verbosity to the specific LOG_TYPE verbosity level
+	static void set_file_verbosity(const LOG_TYPE& verbosity);
+	//! returns the current logger verbosity level (max of the console and file verbosity)
 	static LOG_TYPE get_verbosity();
 	
 	//! returns true if the logger was initialized
 	static bool is_initialized();
 	
+	//! returns true if messages of the specified type are logged with the current verbosity level
+	static bool is_enabled(const LOG_TYPE type) {
+		return (type <= verbosity.load(std::memory_order_relaxed));
+	}
+	
+	//! returns true if deferred logging is enabled
+	static bool is_deferred() {
+		return deferred.load(std::memory_order_relaxed);
+	}
+	
 protected:
 	// static class
 	logger(const logger&) = delete;
 	~logger() = delete;
 	logger& operator=(const logger&) = delete;
 	
+	//! current verbosity level (max of the console and file verbosity)
+	static inline std::atomic<LOG_TYPE> verbosity { LOG_TYPE::UNDECORATED };
+	//! true if deferred logging is enabled
+	static inline std::atomic<bool> deferred { false };
+	
 	//! handles the formatting of log messages
 	static bool prepare_log(std::stringstream& buffer, const LOG_TYPE& type, const char* file, const char* func);
 	
@@ -195,33 +333,139 @@ protected:
 		}
 	}
 	
-	//! internal logging function (will be called in the end when there are no more args)
-	static void log_internal(std::stringstream& buffer, const LOG_TYPE& type, const char* str);
-	//! internal logging function (entry point and arg iteration)
-	template <typename T, typename... Args>
-	static void log_internal(std::stringstream& buffer, const LOG_TYPE& type,
-							 const char* str, T&& value, Args&&... args) {
-		for (size_t i = 0, len = __builtin_strlen(str); i < len; ++i) {
-			const auto ch = str[i];
-			if (ch == '$') {
-				if (i + 1 == len) {
-					// end of string with no format
-					handle_format(buffer, '\0', value);
-					log_internal(buffer, type, nullptr);
-					return;
-				} else if (i + 1 < len && str[i + 1] != '$') {
-					handle_format(buffer, str[i + 1], value);
-					const auto next_char_offset = size_t(is_format_char(str[i + 1]) ? 2 : 1);
-					if (i + next_char_offset < len) {
-						log_internal(buffer, type, &str[i + next_char_offset], std::forward<Args>(args)...);
-					} else {
-						log_internal(buffer, type, nullptr);
-					}
+	//! internal formatting function: writes all text segments of the parsed format string and the args in between
+	template <typename... Args>
+	static void format_internal(std::stringstream& buffer, const format_view_t& format, const Args&... args) {
+		uint32_t segment_idx = 0;
+		const auto write_arg = [&buffer, &format, &segment_idx](const auto& value) {
+			for (; segment_idx < format.segment_count; ++segment_idx) {
+				const auto& segment = format.segments[segment_idx];
+				buffer.write(format.str + segment.offset, std::streamsize(segment.length));
+				if (segment.has_arg) {
+					handle_format(buffer, segment.format, value);
+					++segment_idx;
 					return;
 				}
 			}
-			buffer << ch;
+		};
+		(write_arg(args), ...);
+		for (; segment_idx < format.segment_count; ++segment_idx) {
+			const auto& segment = format.segments[segment_idx];
+			buffer.write(format.str + segment.offset, std::streamsize(segment.length));
+		}
+	}
+	
+	//! internal logging function (will be called in the end once everything has been formatted)
+	static void log_internal(std::stringstream& buffer, const LOG_TYPE& type);
+	
+	//////////////////////////////////////////
+	// deferred logging
+	
+	//! formats the binary encoded arguments "arg_data" of a deferred log record according to the parsed format string "format"
+	using deferred_format_func_t = void (*)(std::stringstream& buffer, const format_view_t& format, const uint8_t* arg_data);
+	
+	//! string types that are copied into deferred log records
+	template <typename T>
+	static constexpr bool is_deferred_string_v { (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+												  std::is_same_v<T, const char*> || std::is_same_v<T, char*>) };
+	//! pointers that are printed as a string by std::ostream (and whose contents can thus not be deferred)
+	template <typename T>
+	static constexpr bool is_char_pointer_v { (std::is_pointer_v<T> &&
+											   (std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char> ||
+												std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, signed char> ||
+												std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, unsigned char>)) };
+	//! types that can be stored in a deferred log record (anything else is formatted immediately)
+	template <typename T>
+	static constexpr bool is_deferrable_v { (std::is_arithmetic_v<T> || std::is_enum_v<T> || is_deferred_string_v<T> ||
+											 (std::is_pointer_v<T> && !is_char_pointer_v<T>)) };
+	
+	//! tries to allocate a deferred log record with "arg_size" bytes of argument data in the ring buffer of the current thread,
+	//! returns a pointer to the argument data on success, or nullptr if the message must be logged immediately
+	static uint8_t* acquire_deferred(const LOG_TYPE type, const char* file, const char* func, const format_view_t* format,
+									 deferred_format_func_t format_func, const size_t arg_size);
+	//! makes the record that was previously acquired by acquire_deferred() visible to the logger thread
+	static void commit_deferred(const LOG_TYPE type);
+	
+	//! returns the string view of a deferred string argument
+	template <typename T>
+	static std::string_view deferred_string(const T& value) {
+		using decayed_type = std::decay_t<T>;
+		if constexpr (std::is_same_v<decayed_type, const char*> || std::is_same_v<decayed_type, char*>) {
+			const char* cstr = value;
+			return (cstr != nullptr ? std::string_view(cstr) : std::string_view {});
+		} else {
+			return std::string_view(value);
+		}
+	}
+	
+	//! returns the binary encoded size of the specified argument
+	template <typename T>
+	static size_t deferred_arg_size(const T& value) {
+		using decayed_type = std::decay_t<T>;
+		if constexpr (is_deferred_string_v<decayed_type>) {
+			return sizeof(uint32_t) + deferred_string(value).size();
+		} else {
+			return sizeof(decayed_type);
+		}
+	}
+	
+	//! binary encodes the specified argument at "arg_data" (strings are stored as length + chars)
+	template <typename T>
+	static void encode_deferred_arg(uint8_t*& arg_data, const T& value) {
+		using decayed_type = std::decay_t<T>;
+		if constexpr (is_deferred_string_v<decayed_type>) {
+			const auto str_view = deferred_string(value);
+			const auto len = uint32_t(str_view.size());
+			memcpy(arg_data, &len, sizeof(len));
+			arg_data += sizeof(len);
+			memcpy(arg_data, str_view.data(), len);
+			arg_data += len;
+		} else {
+			const decayed_type decayed_value = value;
+			memcpy(arg_data, &decayed_value, sizeof(decayed_type));
+			arg_data += sizeof(decayed_type);
+		}
+	}
+	
+	//! decodes a binary encoded argument of type T at "arg_data" (strings are returned as string views into the record)
+	template <typename T>
+	static auto decode_deferred_arg(const uint8_t*& arg_data) {
+		if constexpr (is_deferred_string_v<T>) {
+			uint32_t len = 0;
+			memcpy(&len, arg_data, sizeof(len));
+			arg_data += sizeof(len);
+			const std::string_view str_view { (const char*)arg_data, len };
+			arg_data += len;
+			return str_view;
+		} else {
+			T value {};
+			memcpy(&value, arg_data, sizeof(T));
+			arg_data += sizeof(T);
+			return value;
+		}
+	}
+	
+	//! deferred_format_func_t implementation for the specified argument types
+	template <typename... Args>
+	static void format_deferred(std::stringstream& buffer, const format_view_t& format, [[maybe_unused]] const uint8_t* arg_data) {
+		// NOTE: braced initialization guarantees left-to-right evaluation, i.e. arguments are decoded in order
+		std::tuple<decltype(decode_deferred_arg<Args>(arg_data))...> decoded_args { decode_deferred_arg<Args>(arg_data)... };
+		std::apply([&buffer, &format](auto&&... decoded) {
+			format_internal(buffer, format, decoded...);
+		}, decoded_args);
+	}
+	
+	//! stores the log message as a deferred log record, returns false if this isn't possible
+	template <typename... Args>
+	static bool log_deferred(const LOG_TYPE type, const char* file, const char* func, const format_view_t& format, const Args&... args) {
+		const auto arg_size = (size_t(0u) + ... + deferred_arg_size(args));
+		auto arg_data = acquire_deferred(type, file, func, &format, &format_deferred<std::decay_t<Args>...>, arg_size);
+		if (arg_data == nullptr) {
+			return false;
 		}
+		(encode_deferred_arg(arg_data, args), ...);
+		commit_deferred(type);
+		return true;
 	}
 	
 };
@@ -0,0 +1,94 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/core/essentials.hpp>
+#include <span>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+
+namespace fl {
+
+//! read-only memory-mapped file:
+//! the file contents are directly accessible as a span (no read calls, no copies), pages are loaded on demand by the OS
+//! NOTE: the mapping stays valid until this object is destroyed (or moved from), all returned spans are invalidated then
+class mapped_file {
+public:
+	//! access pattern hints for the OS
+	enum class ACCESS_PATTERN : uint32_t {
+		//! no special access pattern
+		NORMAL,
+		//! data will be read sequentially (aggressive read-ahead)
+		SEQUENTIAL,
+		//! data will be read randomly (no read-ahead)
+		RANDOM,
+	};
+	
+	mapped_file() noexcept = default;
+	//! maps the specified file, use is_valid() to check for success
+	explicit mapped_file(const std::string& filename, const ACCESS_PATTERN access_pattern = ACCESS_PATTERN::NORMAL);
+	~mapped_file();
+	
+	mapped_file(mapped_file&& mfile) noexcept;
+	mapped_file& operator=(mapped_file&& mfile) noexcept;
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	
+	//! returns true if the file has been mapped successfully
+	//! NOTE: empty files are valid, but have no data
+	bool is_valid() const {
+		return valid;
+	}
+	
+	//! returns the contents of the whole file
+	std::span<const uint8_t> get_data() const {
+		return { data_ptr, data_size };
+	}
+	
+	//! returns "size" bytes of the file starting at "offset", clamped to the file size
+	std::span<const uint8_t> get_data(const size_t offset, const size_t size) const {
+		if (offset >= data_size) {
+			return {};
+		}
+		return { data_ptr + offset, std::min(size, data_size - offset) };
+	}
+	
+	//! returns the size of the file in bytes
+	size_t size() const {
+		return data_size;
+	}
+	
+	//! hints that the specified range will be needed soon (starts reading it in the background)
+	void prefetch(const size_t offset, const size_t size) const;
+	
+	//! unmaps the file
+	void close();
+	
+protected:
+	const uint8_t* data_ptr { nullptr };
+	size_t data_size { 0u };
+	bool valid { false };
+	//! only used on Windows
+	void* file_handle { nullptr };
+	void* mapping_handle { nullptr };
+	
+};
+
+} // namespace fl
@@ -20,6 +20,11 @@
 
 #include <floor/constexpr/ext_traits.hpp>
 #include <floor/math/vector_lib.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
 
 //! set this in-class with member variables that should be serializable
 //! NOTE: the class must be constructible with the specified member variables, in the specified order
@@ -65,25 +70,88 @@ namespace fl {
 
 //! serialization and deserialization of classes (class members)
 //! "storage_type" must implement byte-wise .data(), .begin(), .end(), .insert(point, first, last), .erase(first, last)
+//! NOTE: deserialized data is not erased from the storage right away, instead a read cursor is advanced,
+//!       consumed data is only erased from the storage once get_storage() is called
 template <typename storage_type = std::vector<uint8_t>>
 class serializer {
 protected:
 	storage_type storage;
+	//! read cursor: amount of bytes at the front of "storage" that have already been deserialized
+	size_t read_offset { 0u };
+	//! nesting depth of serialize() calls (storage is only pre-sized in the outermost call)
+	uint32_t serialize_depth { 0u };
+	
+	//! erases all already deserialized data from the front of the storage
+	void compact() {
+		if constexpr (requires { storage.erase(storage.begin(), storage.end()); }) {
+			if (read_offset > 0) {
+				storage.erase(storage.begin(), storage.begin() + ptrdiff_t(read_offset));
+				read_offset = 0;
+			}
+		}
+	}
 	
 public:
 	explicit serializer(storage_type&& storage_) : storage(std::forward<storage_type&&>(storage_)) {}
 	
 	//! returns the raw data storage of this serializer
-	storage_type& get_storage() { return storage; }
-	const storage_type& get_storage() const { return storage; }
+	//! NOTE: this erases all already deserialized data from the storage
+	storage_type& get_storage() {
+		compact();
+		return storage;
+	}
+	const storage_type& get_storage() const {
+		if (read_offset > 0) {
+			// NOTE: can only be > 0 if this serializer has been used non-const before
+			const_cast<serializer*>(this)->compact();
+		}
+		return storage;
+	}
+	
+	//! returns a pointer to the current read position
+	const uint8_t* read_ptr() const {
+		return (const uint8_t*)storage.data() + read_offset;
+	}
+	
+	//! returns the amount of bytes that have not been deserialized yet
+	size_t get_unread_size() const {
+		return size_t(storage.end() - storage.begin()) - read_offset;
+	}
+	
+	//! reads "size" bytes at the current read position into "dst" and advances the read cursor
+	void read_bytes(void* dst, const size_t size) {
+		memcpy(dst, read_ptr(), size);
+		read_offset += size;
+	}
+	
+	//! writes "size" bytes from "src" to the end of the storage
+	void write_bytes(const void* src, const size_t size) {
+		const auto src_ptr = (const uint8_t*)src;
+		storage.insert(storage.end(), src_ptr, src_ptr + size);
+	}
+	
+	//! reserves space for "size" additional bytes in the storage (if the storage type supports this)
+	void reserve(const size_t size) {
+		if constexpr (requires { storage.reserve(size); storage.capacity(); storage.size(); }) {
+			const auto required_size = storage.size() + size;
+			if (required_size > storage.capacity()) {
+				// NOTE: grow at least geometrically, so that repeated serialize() calls don't degrade into O(n^2)
+				storage.reserve(std::max(required_size, storage.capacity() * 2u));
+			}
+		}
+	}
 	
 	//! serializes the specified parameters into this serializer data container
+	//! NOTE: the storage is pre-sized to fit all parameters
 	template <typename type, typename... types>
 	void serialize(const type& arg, const types&... args) {
-		serialization<type>::serialize(*this, storage, arg);
-		if constexpr(sizeof...(args) > 0) {
-			serialize(args...);
+		if (serialize_depth == 0) {
+			reserve(serialization_size(arg, args...));
 		}
+		++serialize_depth;
+		serialization<type>::serialize(*this, storage, arg);
+		(serialization<types>::serialize(*this, storage, args), ...);
+		--serialize_depth;
 	}
 	
 	//! since "is_constructible" is pretty much useless for this purpose, figure out ourselves if we can directly construct
@@ -171,6 +239,19 @@ public:
 		return std::tuple<std::decay_t<types>...> {};
 	}
 	
+	//! returns true if the serialized representation of "type" is identical to its in-memory representation,
+	//! i.e. contiguous ranges of "type" can be serialized/deserialized with a single memcpy
+	template <typename type>
+	static constexpr bool is_memcpy_serializable() {
+		if constexpr (ext::is_arithmetic_v<type> || std::is_enum_v<type>) {
+			return true;
+		} else if constexpr (is_floor_vector<type>::value) {
+			return (sizeof(type) == sizeof(typename type::this_scalar_type) * type::dim());
+		} else {
+			return false;
+		}
+	}
+	
 protected:
 	//! type-specific serialization implementation
 	template <typename type>
@@ -193,18 +274,6 @@ protected:
 	static void serialization_not_implemented_for_this_type()
 	__attribute__((unavailable("serialization not implemented for this type")));
 	
-	//! helper wrapper to easily convert a uint64_t to 8 uint8_ts
-	union uint64_as_bytes {
-		uint64_t ui64;
-		uint8_t bytes[8];
-	};
-	
-	//! helper wrapper to easily convert a uint32_t to 4 uint8_ts
-	union uint32_as_bytes {
-		uint32_t ui32;
-		uint8_t bytes[4];
-	};
-	
 	// handle erroneous cases
 	template <typename type> requires std::is_pointer_v<type>
 	struct serialization<type> {
@@ -219,20 +288,16 @@ protected:
 	// integral and floating point types (+compiler extension int/fp types)
 	template <typename arith_type> requires ext::is_arithmetic_v<arith_type>
 	struct serialization<arith_type> {
-		static void serialize(serializer&, storage_type& storage, const arith_type& value) {
-			uint8_t bytes[sizeof(arith_type)];
-			memcpy(bytes, &value, sizeof(arith_type));
-			storage.insert(storage.end(), begin(bytes), end(bytes));
+		static void serialize(serializer& ser, storage_type&, const arith_type& value) {
+			ser.write_bytes(&value, sizeof(arith_type));
 		}
-		static arith_type deserialize(serializer&, storage_type& storage) {
+		static arith_type deserialize(serializer& ser, storage_type&) {
 			arith_type ret;
-			memcpy(&ret, storage.data(), sizeof(arith_type));
-			storage.erase(storage.begin(), storage.begin() + sizeof(arith_type));
+			ser.read_bytes(&ret, sizeof(arith_type));
 			return ret;
 		}
-		static void deserialize_inplace(serializer&, storage_type& storage, arith_type& val) {
-			memcpy(&val, storage.data(), sizeof(arith_type));
-			storage.erase(storage.begin(), storage.begin() + sizeof(arith_type));
+		static void deserialize_inplace(serializer& ser, storage_type&, arith_type& val) {
+			ser.read_bytes(&val, sizeof(arith_type));
 		}
 		static constexpr bool is_size_static() { return true; }
 		static constexpr size_t static_size() { return sizeof(arith_type); }
@@ -242,20 +307,16 @@ protected:
 	// enums
 	template <typename enum_type> requires std::is_enum_v<enum_type>
 	struct serialization<enum_type> {
-		static void serialize(serializer&, storage_type& storage, const enum_type& value) {
-			uint8_t bytes[sizeof(enum_type)];
-			memcpy(bytes, &value, sizeof(enum_type));
-			storage.insert(storage.end(), begin(bytes), end(bytes));
+		static void serialize(serializer& ser, storage_type&, const enum_type& value) {
+			ser.write_bytes(&value, sizeof(enum_type));
 		}
-		static enum_type deserialize(serializer&, storage_type& storage) {
+		static enum_type deserialize(serializer& ser, storage_type&) {
 			enum_type ret;
-			memcpy(&ret, storage.data(), sizeof(enum_type));
-			storage.erase(storage.begin(), storage.begin() + sizeof(enum_type));
+			ser.read_bytes(&ret, sizeof(enum_type));
 			return ret;
 		}
-		static void deserialize_inplace(serializer&, storage_type& storage, enum_type& val) {
-			memcpy(&val, storage.data(), sizeof(enum_type));
-			storage.erase(storage.begin(), storage.begin() + sizeof(enum_type));
+		static void deserialize_inplace(serializer& ser, storage_type&, enum_type& val) {
+			ser.read_bytes(&val, sizeof(enum_type));
 		}
 		static constexpr bool is_size_static() { return true; }
 		static constexpr size_t static_size() { return sizeof(enum_type); }
@@ -269,29 +330,32 @@ protected:
 		static_assert(!std::is_reference<scalar_type>::value, "can't serialize references");
 		static_assert(!std::is_pointer<scalar_type>::value, "can't serialize pointers");
 		
-		static void serialize(serializer&, storage_type& storage, const vec_type& vec) {
-			uint8_t bytes[sizeof(scalar_type) * vec_type::dim()];
+		static void serialize(serializer& ser, storage_type&, const vec_type& vec) {
+			if constexpr (is_memcpy_serializable<vec_type>()) {
+				ser.write_bytes(&vec, sizeof(vec_type));
+			} else {
+				uint8_t bytes[sizeof(scalar_type) * vec_type::dim()];
 #pragma unroll
-			for(uint32_t i = 0; i < vec_type::dim(); ++i) {
-				memcpy(bytes + i * sizeof(scalar_type), &vec[i], sizeof(scalar_type));
+				for(uint32_t i = 0; i < vec_type::dim(); ++i) {
+					memcpy(bytes + i * sizeof(scalar_type), &vec[i], sizeof(scalar_type));
+				}
+				ser.write_bytes(bytes, sizeof(bytes));
 			}
-			storage.insert(storage.end(), begin(bytes), end(bytes));
 		}
-		static vec_type deserialize(serializer&, storage_type& storage) {
+		static vec_type deserialize(serializer& ser, storage_type& storage) {
 			vec_type ret;
-#pragma unroll
-			for(uint32_t i = 0; i < vec_type::dim(); ++i) {
-				memcpy(&ret[i], storage.data() + i * sizeof(scalar_type), sizeof(scalar_type));
-			}
-			storage.erase(storage.begin(), storage.begin() + sizeof(scalar_type) * vec_type::dim());
+			deserialize_inplace(ser, storage, ret);
 			return ret;
 		}
-		static void deserialize_inplace(serializer&, storage_type& storage, vec_type& val) {
+		static void deserialize_inplace(serializer& ser, storage_type&, vec_type& val) {
+			if constexpr (is_memcpy_serializable<vec_type>()) {
+				ser.read_bytes(&val, sizeof(vec_type));
+			} else {
 #pragma unroll
-			for(uint32_t i = 0; i < vec_type::dim(); ++i) {
-				memcpy(&val[i], storage.data() + i * sizeof(scalar_type), sizeof(scalar_type));
+				for(uint32_t i = 0; i < vec_type::dim(); ++i) {
+					ser.read_bytes(&val[i], sizeof(scalar_type));
+				}
 			}
-			storage.erase(storage.begin(), storage.begin() + sizeof(scalar_type) * vec_type::dim());
 		}
 		static constexpr bool is_size_static() { return true; }
 		static constexpr size_t static_size() { return sizeof(scalar_type) * vec_type::dim(); }
@@ -302,31 +366,21 @@ protected:
 	template <typename char_type>
 	struct serialization<std::basic_string<char_type>> {
 		using string_type = std::basic_string<char_type>;
-		static void serialize(serializer&, storage_type& storage, const string_type& str) {
-			const uint64_as_bytes size { .ui64 = str.size() * sizeof(char_type) };
-			storage.insert(storage.end(), begin(size.bytes), end(size.bytes));
-			storage.insert(storage.end(), begin(str), end(str));
+		static void serialize(serializer& ser, storage_type&, const string_type& str) {
+			const uint64_t size = str.size() * sizeof(char_type);
+			ser.write_bytes(&size, sizeof(size));
+			ser.write_bytes(str.data(), size);
 		}
-		static string_type deserialize(serializer&, storage_type& storage) {
-			uint64_t size = 0;
-			memcpy(&size, storage.data(), sizeof(size));
-			
+		static string_type deserialize(serializer& ser, storage_type& storage) {
 			string_type ret;
-			ret.resize(size / sizeof(char_type));
-			memcpy(&ret[0], storage.data() + sizeof(size), size);
-			
-			storage.erase(storage.begin(), storage.begin() + sizeof(size) + typename string_type::difference_type(size));
-			
+			deserialize_inplace(ser, storage, ret);
 			return ret;
 		}
-		static void deserialize_inplace(serializer&, storage_type& storage, string_type& val) {
+		static void deserialize_inplace(serializer& ser, storage_type&, string_type& val) {
 			uint64_t size = 0;
-			memcpy(&size, storage.data(), sizeof(size));
-			
+			ser.read_bytes(&size, sizeof(size));
 			val.resize(size / sizeof(char_type));
-			memcpy(&val[0], storage.data() + sizeof(size), size);
-			
-			storage.erase(storage.begin(), storage.begin() + sizeof(size) + typename string_type::difference_type(size));
+			ser.read_bytes(val.data(), size);
 		}
 		static constexpr bool is_size_static() { return false; }
 		static constexpr size_t static_size() { return 0; }
@@ -338,34 +392,38 @@ protected:
 	// vector
 	template <typename data_type>
 	struct serialization<std::vector<data_type>> {
+		//! contiguous POD data can be copied in one go (NOTE: std::vector<bool> is not contiguous)
+		static constexpr bool is_memcpy_range() {
+			return (is_memcpy_serializable<data_type>() && !std::is_same_v<data_type, bool>);
+		}
+		
 		static void serialize(serializer& ser, storage_type& storage, const std::vector<data_type>& vec) {
-			const uint64_as_bytes size { .ui64 = vec.size() };
-			storage.insert(storage.end(), begin(size.bytes), end(size.bytes));
-			for(const auto& elem : vec) {
-				serializer::serialization<data_type>::serialize(ser, storage, elem);
+			const uint64_t size = vec.size();
+			ser.write_bytes(&size, sizeof(size));
+			if constexpr (is_memcpy_range()) {
+				ser.write_bytes(vec.data(), vec.size() * sizeof(data_type));
+			} else {
+				for(const auto& elem : vec) {
+					serializer::serialization<data_type>::serialize(ser, storage, elem);
+				}
 			}
 		}
 		static std::vector<data_type> deserialize(serializer& ser, storage_type& storage) {
-			uint64_t size = 0;
-			memcpy(&size, storage.data(), sizeof(size));
-			storage.erase(storage.begin(), storage.begin() + sizeof(size));
-			
 			std::vector<data_type> ret;
-			ret.resize(size);
-			for(uint64_t i = 0; i < size; ++i) {
-				ret[i] = serializer::serialization<data_type>::deserialize(ser, storage);
-			}
-			
+			deserialize_inplace(ser, storage, ret);
 			return ret;
 		}
 		static void deserialize_inplace(serializer& ser, storage_type& storage, std::vector<data_type>& val) {
 			uint64_t size = 0;
-			memcpy(&size, storage.data(), sizeof(size));
-			storage.erase(storage.begin(), storage.begin() + sizeof(size));
+			ser.read_bytes(&size, sizeof(size));
 			
 			val.resize(size);
-			for(uint64_t i = 0; i < size; ++i) {
-				serializer::serialization<data_type>::deserialize_inplace(ser, storage, val[i]);
+			if constexpr (is_memcpy_range()) {
+				ser.read_bytes(val.data(), size * sizeof(data_type));
+			} else {
+				for(uint64_t i = 0; i < size; ++i) {
+					serializer::serialization<data_type>::deserialize_inplace(ser, storage, val[i]);
+				}
 			}
 		}
 		static constexpr bool is_size_static() { return false; }
@@ -389,20 +447,26 @@ protected:
 	template <typename data_type, size_t count>
 	struct serialization<std::array<data_type, count>> {
 		static void serialize(serializer& ser, storage_type& storage, const std::array<data_type, count>& arr) {
-			for(const auto& elem : arr) {
-				serializer::serialization<data_type>::serialize(ser, storage, elem);
+			if constexpr (is_memcpy_serializable<data_type>()) {
+				ser.write_bytes(arr.data(), count * sizeof(data_type));
+			} else {
+				for(const auto& elem : arr) {
+					serializer::serialization<data_type>::serialize(ser, storage, elem);
+				}
 			}
 		}
 		static std::array<data_type, count> deserialize(serializer& ser, storage_type& storage) {
 			std::array<data_type, count> ret;
-			for(uint32_t i = 0; i < count; ++i) {
-				ret[i] = serializer::serialization<data_type>::deserialize(ser, storage);
-			}
+			deserialize_inplace(ser, storage, ret);
 			return ret;
 		}
 		static void deserialize_inplace(serializer& ser, storage_type& storage, std::array<data_type, count>& val) {
-			for(uint32_t i = 0; i < count; ++i) {
-				serializer::serialization<data_type>::deserialize_inplace(ser, storage, val[i]);
+			if constexpr (is_memcpy_serializable<data_type>()) {
+				ser.read_bytes(val.data(), count * sizeof(data_type));
+			} else {
+				for(uint32_t i = 0; i < count; ++i) {
+					serializer::serialization<data_type>::deserialize_inplace(ser, storage, val[i]);
+				}
 			}
 		}
 		static constexpr bool is_size_static() { return serializer::serialization<data_type>::is_size_static(); }
@@ -17,6 +17,9 @@
  */
 
 #include <floor/core/logger.hpp>
+#include <span>
+#include <cstring>
+#include <algorithm>
 
 namespace fl {
 
@@ -122,4 +125,83 @@ struct serializer_storage_wrapper {
 using read_only_serializer_storage = serializer_storage_wrapper<true, false>;
 using write_only_serializer_storage = serializer_storage_wrapper<false, true>;
 
+//! fixed-capacity serializer storage backed by user-provided memory, i.e. serialization never allocates any memory,
+//! data is inserted at the end of the used range and erased from the front (O(1))
+//! NOTE: if an insert would exceed the capacity, nothing is inserted and the storage is flagged as overflowed
+struct span_serializer_storage {
+	std::span<uint8_t> buffer;
+	//! start of the used range (data before this has been erased)
+	size_t begin_pos { 0u };
+	//! end of the used range
+	size_t end_pos { 0u };
+	bool overflowed { false };
+	
+	//! creates a storage for the specified memory, of which "used_size" bytes already contain (deserializable) data
+	explicit span_serializer_storage(std::span<uint8_t> buffer_, const size_t used_size = 0u) noexcept :
+	buffer(buffer_), end_pos(std::min(used_size, buffer_.size())) {}
+	
+	uint8_t* data() { return buffer.data() + begin_pos; }
+	const uint8_t* data() const { return buffer.data() + begin_pos; }
+	
+	uint8_t* begin() { return buffer.data() + begin_pos; }
+	const uint8_t* begin() const { return buffer.data() + begin_pos; }
+	
+	uint8_t* end() { return buffer.data() + end_pos; }
+	const uint8_t* end() const { return buffer.data() + end_pos; }
+	
+	//! returns the amount of used bytes
+	size_t size() const { return end_pos - begin_pos; }
+	
+	//! returns the amount of bytes that can still be inserted
+	size_t remaining_capacity() const { return buffer.size() - end_pos; }
+	
+	//! returns true if an insert exceeded the capacity
+	bool has_overflowed() const { return overflowed; }
+	
+	//! clears all data and resets the overflow flag
+	void clear() {
+		begin_pos = 0;
+		end_pos = 0;
+		overflowed = false;
+	}
+	
+	const uint8_t* erase(const uint8_t* first, const uint8_t* last) {
+		if (first == last) return end();
+		if (first != begin() || last < first || last > end()) {
+			log_error("can only erase from the start");
+			return nullptr;
+		}
+		begin_pos += size_t(last - first);
+		if (begin_pos == end_pos) {
+			// everything has been erased -> reuse the whole buffer
+			begin_pos = 0;
+			end_pos = 0;
+		}
+		return begin();
+	}
+	
+	const uint8_t* insert(const uint8_t* insert_point, const uint8_t* first, const uint8_t* last) {
+		if (first == last) return end();
+		if (insert_point != end()) {
+			log_error("can only insert at the end");
+			return nullptr;
+		}
+		if (last < first) {
+			log_error("invalid begin/end ptrs");
+			return nullptr;
+		}
+		const auto insert_size = size_t(last - first);
+		if (insert_size > remaining_capacity()) {
+			log_error("insufficient capacity: $ bytes required, but only $ bytes are available", insert_size, remaining_capacity());
+			overflowed = true;
+			return nullptr;
+		}
+		auto insert_ptr = end();
+		memcpy(insert_ptr, first, insert_size);
+		end_pos += insert_size;
+		return insert_ptr;
+	}
+	
+};
+
 } // namespace fl
@@ -21,6 +21,7 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <span>
 #include <utility>
 #include <cstdint>
 
@@ -29,6 +30,22 @@ namespace fl::unicode {
 	std::vector<uint32_t> utf8_to_unicode(const std::string_view& str);
 	std::string unicode_to_utf8(const std::vector<uint32_t>& codes);
 	
+	//! decodes the utf-8 string to utf-32 code points and writes these to "dst", returns the amount of written code points
+	//! NOTE: like the std::vector variant, decoding stops at the first invalid code sequence
+	//! NOTE: "dst" must be able to hold at least str.size() code points
+	size_t utf8_to_unicode(const std::string_view& str, std::span<uint32_t> dst);
+	//! encodes the utf-32 code points to utf-8 and writes these to "dst", returns the amount of written bytes
+	//! NOTE: like the std::vector variant, ASCII control characters (other than tab) are dropped and encoding stops at the first invalid code point
+	//! NOTE: "dst" must be able to hold at least 4 * codes.size() bytes
+	size_t unicode_to_utf8(const std::span<const uint32_t> codes, std::span<char> dst);
+	
+	//! strictly decodes the utf-8 string to utf-16 and writes it to "dst",
+	//! returns <true, amount of written utf-16 code units> on success
+	//! and <false, amount of code units written up to the first invalid code sequence> on failure
+	//! NOTE: see validate_utf8() for what is considered invalid
+	//! NOTE: "dst" must be able to hold at least str.size() code units
+	std::pair<bool, size_t> utf8_to_utf16(const std::string_view& str, std::span<char16_t> dst);
+	
 	//! decodes a single multi-byte utf-8 character to a utf-32/32-bit uint,
 	//! returns <false, 0> if the utf-8 code point is invalid and <true, utf-32 code> if valid
 	//! NOTE: the specified 'iter' is advanced while doing this (will point to the last code point byte)
@@ -42,6 +59,15 @@ namespace fl::unicode {
 	//! and <false, iterator to invalid code sequence> if invalid
 	std::pair<bool, std::string::const_iterator> validate_utf8_string(const std::string& str);
 	
+	//! strictly checks if a string is a valid utf-8 string (RFC 3629), returns <true, str.size()> if valid
+	//! and <false, offset of the first invalid code sequence> if invalid
+	//! NOTE: in addition to validate_utf8_string, this also rejects overlong encodings and surrogate code points (U+D800 - U+DFFF)
+	//! NOTE: this processes 16 bytes at once using SSSE3/NEON if available
+	std::pair<bool, size_t> validate_utf8(const std::string_view& str);
+	
+	//! returns true if the string only consists of ASCII characters
+	bool is_ascii(const std::string_view& str);
+	
 #if defined(__APPLE__)
 	std::string utf8_decomp_to_precomp(const std::string& str);
 #endif
@@ -720,6 +720,87 @@ FLOOR_POP_WARNINGS()
 				__builtin_memcpy(&img->data[offset], &converted_color, sizeof(decltype(converted_color)));
 			}
 		}
+		
+#if !defined(FLOOR_DEVICE_HOST_COMPUTE_IS_DEVICE)
+		// row read/write functions for 16-bit half float formats: all texels of a row are converted at once
+		// NOTE: "coord" is clamped to the image, the amount of texels is limited so that the row end is never crossed
+		template <typename coord_type>
+		requires(data_type == IMAGE_TYPE::FLOAT && image_format == IMAGE_TYPE::FORMAT_16 &&
+				 !has_flag<IMAGE_TYPE::FLAG_DEPTH>(fixed_image_type) && !sample_repeat && !sample_repeat_mirrored)
+		static size_t read_row(const host_device_image<fixed_image_type, is_lod, is_lod_float, is_bias, sample_repeat, sample_repeat_mirrored>* img,
+							   const coord_type& coord,
+							   const uint32_t layer,
+							   const uint32_t lod_input,
+							   std::span<float4> texels) {
+			constexpr const bool is_array = has_flag<IMAGE_TYPE::FLAG_ARRAY>(fixed_image_type);
+			const auto lod = select_lod(lod_input);
+			const auto clamped_coord = process_coord(img->level_info[lod], coord);
+			size_t offset;
+			if constexpr(!is_array) offset = coord_to_offset(img->level_info[lod], clamped_coord);
+			else offset = coord_to_offset(img->level_info[lod], clamped_coord, layer);
+			
+			const auto count = std::min(texels.size(), size_t(img->level_info[lod].dim_x - clamped_coord.x));
+			const auto half_data = (const soft_f16*)&img->data[offset];
+			if constexpr(channel_count == 4) {
+				// float4 texels are tightly packed -> can directly convert into them
+				convert_f16_to_f32({ half_data, count * 4u }, { (float*)texels.data(), count * 4u });
+			} else {
+				// convert in chunks to a tightly packed buffer first, then expand to float4
+				static constexpr const size_t chunk_size { 256u };
+				float chunk[chunk_size * channel_count];
+				for(size_t i = 0; i < count; i += chunk_size) {
+					const auto chunk_count = std::min(chunk_size, count - i);
+					convert_f16_to_f32({ half_data + i * channel_count, chunk_count * channel_count }, chunk);
+					for(size_t j = 0; j < chunk_count; ++j) {
+						float4 texel;
+#pragma clang loop unroll(full)
+						for(uint32_t c = 0; c < channel_count; ++c) {
+							texel[c] = chunk[j * channel_count + c];
+						}
+						texels[i + j] = texel;
+					}
+				}
+			}
+			return count;
+		}
+		
+		template <typename coord_type>
+		requires(data_type == IMAGE_TYPE::FLOAT && image_format == IMAGE_TYPE::FORMAT_16 &&
+				 !has_flag<IMAGE_TYPE::FLAG_DEPTH>(fixed_image_type) && !sample_repeat && !sample_repeat_mirrored)
+		static size_t write_row(const host_device_image<fixed_image_type, is_lod, is_lod_float, is_bias, sample_repeat, sample_repeat_mirrored>* img,
+								const coord_type& coord,
+								const uint32_t layer,
+								const uint32_t lod_input,
+								std::span<const float4> texels) {
+			constexpr const bool is_array = has_flag<IMAGE_TYPE::FLAG_ARRAY>(fixed_image_type);
+			const auto lod = select_lod(lod_input);
+			const auto clamped_coord = process_coord(img->level_info[lod], coord);
+			size_t offset;
+			if constexpr(!is_array) offset = coord_to_offset(img->level_info[lod], clamped_coord);
+			else offset = coord_to_offset(img->level_info[lod], clamped_coord, layer);
+			
+			const auto count = std::min(texels.size(), size_t(img->level_info[lod].dim_x - clamped_coord.x));
+			const auto half_data = (soft_f16*)&img->data[offset];
+			if constexpr(channel_count == 4) {
+				convert_f32_to_f16({ (const float*)texels.data(), count * 4u }, { half_data, count * 4u });
+			} else {
+				// gather all used channels into a tightly packed buffer first, then convert
+				static constexpr const size_t chunk_size { 256u };
+				float chunk[chunk_size * channel_count];
+				for(size_t i = 0; i < count; i += chunk_size) {
+					const auto chunk_count = std::min(chunk_size, count - i);
+					for(size_t j = 0; j < chunk_count; ++j) {
+#pragma clang loop unroll(full)
+						for(uint32_t c = 0; c < channel_count; ++c) {
+							chunk[j * channel_count + c] = texels[i + j][c];
+						}
+					}
+					convert_f32_to_f16({ chunk, chunk_count * channel_count }, { half_data + i * channel_count, chunk_count * channel_count });
+				}
+			}
+			return count;
+		}
+#endif
 
 
 		template <typename coord_type>
@@ -1478,6 +1559,80 @@ FLOOR_IGNORE_WARNING(switch) // ignore "case value not in enumerated type 'IMAGE
 		}
 	}
 
+#if !defined(FLOOR_DEVICE_HOST_COMPUTE_IS_DEVICE)
+#define FLOOR_RT_ROW_IMAGE_CASE(rt_base_type, func) case (rt_base_type): \
+return host_image_impl::fixed_image<(rt_base_type | fixed_base_type), is_lod, is_lod_float, is_bias, sample_repeat, sample_repeat_mirrored>::func( \
+(const host_device_image<(rt_base_type | fixed_base_type), is_lod, is_lod_float, is_bias, sample_repeat, sample_repeat_mirrored>*)img, coord, layer, lod, texels);
+	
+	//! reads up to "texels.size()" consecutive texels in x direction, starting at the integer coordinate "coord",
+	//! returns the amount of read texels (the row end is never crossed)
+	//! NOTE: 16-bit half float images are converted in bulk, all other formats are read texel by texel
+	template <typename coord_type>
+	requires((has_flag<IMAGE_TYPE::FLAG_NORMALIZED>(sample_image_type) || fixed_data_type == IMAGE_TYPE::FLOAT) &&
+			 !has_flag<IMAGE_TYPE::FLAG_DEPTH>(sample_image_type) &&
+			 !ext::is_floating_point_v<typename coord_type::decayed_scalar_type> &&
+			 !sample_repeat && !sample_repeat_mirrored)
+	static size_t read_row(const host_device_image_type* img, const coord_type& coord, const uint32_t layer, const uint32_t lod,
+						   std::span<float4> texels) {
+		const auto runtime_base_type = img->runtime_image_type & (IMAGE_TYPE::__FORMAT_MASK |
+																  IMAGE_TYPE::__CHANNELS_MASK |
+																  IMAGE_TYPE::__DATA_TYPE_MASK |
+																  IMAGE_TYPE::FLAG_NORMALIZED);
+		switch(runtime_base_type) {
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_1 | IMAGE_TYPE::FLOAT, read_row)
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_2 | IMAGE_TYPE::FLOAT, read_row)
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_3 | IMAGE_TYPE::FLOAT, read_row)
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_4 | IMAGE_TYPE::FLOAT, read_row)
+			default: break;
+		}
+		
+		const auto& level_info = img->level_info[std::min(host_limits::max_mip_levels - 1u, lod)];
+		const auto start_x = uint32_t(std::clamp(int32_t(coord.x), 0, level_info.clamp_dim_int.x));
+		const auto count = std::min(texels.size(), size_t(level_info.dim_x - start_x));
+		auto texel_coord = coord;
+		for(size_t i = 0; i < count; ++i) {
+			texel_coord.x = decltype(texel_coord.x)(start_x + i);
+			texels[i] = read(img, texel_coord, vector_n<int32_t, coord_type::dim()> {}, layer, int32_t(lod), float(lod));
+		}
+		return count;
+	}
+	
+	//! writes up to "texels.size()" consecutive texels in x direction, starting at the integer coordinate "coord",
+	//! returns the amount of written texels (the row end is never crossed)
+	//! NOTE: 16-bit half float images are converted in bulk, all other formats are written texel by texel
+	template <typename coord_type>
+	requires((has_flag<IMAGE_TYPE::FLAG_NORMALIZED>(sample_image_type) || fixed_data_type == IMAGE_TYPE::FLOAT) &&
+			 !has_flag<IMAGE_TYPE::FLAG_DEPTH>(sample_image_type) &&
+			 !ext::is_floating_point_v<typename coord_type::decayed_scalar_type> &&
+			 !sample_repeat && !sample_repeat_mirrored)
+	static size_t write_row(const host_device_image_type* img, const coord_type& coord, const uint32_t layer, const uint32_t lod,
+							std::span<const float4> texels) {
+		const auto runtime_base_type = img->runtime_image_type & (IMAGE_TYPE::__FORMAT_MASK |
+																  IMAGE_TYPE::__CHANNELS_MASK |
+																  IMAGE_TYPE::__DATA_TYPE_MASK |
+																  IMAGE_TYPE::FLAG_NORMALIZED);
+		switch(runtime_base_type) {
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_1 | IMAGE_TYPE::FLOAT, write_row)
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_2 | IMAGE_TYPE::FLOAT, write_row)
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_3 | IMAGE_TYPE::FLOAT, write_row)
+			FLOOR_RT_ROW_IMAGE_CASE(IMAGE_TYPE::FORMAT_16 | IMAGE_TYPE::CHANNELS_4 | IMAGE_TYPE::FLOAT, write_row)
+			default: break;
+		}
+		
+		const auto& level_info = img->level_info[std::min(host_limits::max_mip_levels - 1u, lod)];
+		const auto start_x = uint32_t(std::clamp(int32_t(coord.x), 0, level_info.clamp_dim_int.x));
+		const auto count = std::min(texels.size(), size_t(level_info.dim_x - start_x));
+		auto texel_coord = coord;
+		for(size_t i = 0; i < count; ++i) {
+			texel_coord.x = decltype(texel_coord.x)(start_x + i);
+			write(img, texel_coord, layer, lod, texels[i]);
+		}
+		return count;
+	}
+	
+#undef FLOOR_RT_ROW_IMAGE_CASE
+#endif
+
 FLOOR_POP_WARNINGS()
 #undef FLOOR_RT_READ_IMAGE_CASE
 #undef FLOOR_RT_WRITE_IMAGE_CASE
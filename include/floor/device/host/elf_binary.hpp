@@ -60,6 +60,7 @@ namespace fl {
 struct section_t;
 struct relocation_t;
 struct symbol_t;
+struct prelinked_symbol_t;
 
 class elf_binary {
 public:
@@ -180,13 +181,14 @@ protected:
 							 const std::vector<relocation_t>& relocations,
 							 aligned_ptr<uint8_t>& memory);
 	
-	//! tries to resolve the symbol specified by "sym", in the specified "instance" + "ext_instance"
-	const void* resolve_symbol(internal_instance_t& instance, instance_t& ext_instance, const symbol_t& sym);
+	//! resolves all symbols that are used by relocations and determines all other instance-independent info once,
+	//! so that instantiation only has to copy memory and patch in per-instance addresses
+	bool prelink();
 	
-	//! tries to resolve the section specified by "sym", in the specified "instance"
-	const void* resolve_section(internal_instance_t& instance, const symbol_t& sym);
+	//! resolves the specified symbol independently of any instance, returns true on success
+	bool prelink_symbol(const symbol_t& sym, prelinked_symbol_t& prelinked_sym) const;
 	
-	//! tries to resolve the symbol in the specified "relocation", in the specified "instance" + "ext_instance"
+	//! resolves the pre-linked symbol in the specified "relocation", in the specified "instance" + "ext_instance"
 	const void* resolve(internal_instance_t& instance, instance_t& ext_instance, const relocation_t& relocation);
 	
 };
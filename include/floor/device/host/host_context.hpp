@@ -29,6 +29,7 @@
 #include <floor/device/host/host_program.hpp>
 #include <floor/device/host/host_queue.hpp>
 #include <floor/threading/atomic_spin_lock.hpp>
+#include <functional>
 
 namespace fl {
 
@@ -179,6 +180,15 @@ protected:
 	
 	std::shared_ptr<device_program> create_program_from_archive_binaries(universal_binary::archive_binaries& bins) REQUIRES(!programs_lock);
 	
+	//! creates the host programs for all devices in parallel (on a bounded amount of threads):
+	//! "create_entry" is only called once for each unique key in "dev_keys" (one key per device, in device order),
+	//! all devices with the same key will share the resulting program entry
+	host_program::program_map_type create_host_programs(const std::vector<uint64_t>& dev_keys,
+														const std::function<host_program::host_program_entry(const host_device&, const size_t dev_idx)>& create_entry) const;
+	
+	//! returns the per-device program keys used for deduplicating program creation across devices with the same CPU tier
+	std::vector<uint64_t> get_cpu_tier_program_keys() const;
+	
 };
 
 } // namespace fl
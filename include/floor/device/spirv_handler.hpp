@@ -20,6 +20,7 @@
 
 #include <floor/core/essentials.hpp>
 #include <floor/device/toolchain.hpp>
+#include <span>
 
 namespace fl::spirv_handler {
 	//! loads a spir-v binary from the file specified by file_name,
@@ -48,19 +49,41 @@ namespace fl::spirv_handler {
 		struct entry {
 			std::vector<toolchain::FUNCTION_TYPE> function_types;
 			std::vector<std::string> function_names;
+			//! word offset of the SPIR-V module relative to the start of all module data
 			uint32_t data_offset;
 			uint32_t data_word_count;
+			//! view of the SPIR-V module data of this entry
+			//! NOTE: this either points into "spirv_data" or into the memory the container was loaded from (zero-copy)
+			std::span<const uint32_t> code;
 		};
 		std::vector<entry> entries;
+		//! owned SPIR-V data, this is empty if the container references external memory (zero-copy)
 		std::unique_ptr<uint32_t[]> spirv_data;
 		bool valid { false };
 	};
 	static constexpr const uint32_t container_version { 2u };
 	
+	//! options for loading a SPIR-V container
+	struct container_load_options {
+		//! if true and the container memory is 4-byte aligned, SPIR-V module data is not copied,
+		//! i.e. entry code spans directly reference the specified memory, which must outlive the container
+		bool zero_copy { false };
+		//! if true, processes the per-entry metadata of all entries in parallel on the global task scheduler
+		//! NOTE: this is only done when validating or for very large containers, otherwise processing is too cheap
+		bool parallel { true };
+		//! if true, performs a sanity check of all SPIR-V modules (header and instruction word counts)
+		bool validate { false };
+	};
+	
 	//! loads a SPIR-V container file and processes it into a usable 'container' object
-	container load_container(const std::string& file_name);
+	container load_container(const std::string& file_name, const container_load_options options = {});
 	container load_container_from_memory(const uint8_t* data_ptr,
 										 const size_t& data_size,
-										 const std::string identifier = "");
+										 const std::string identifier = "",
+										 const container_load_options options = {});
+	
+	//! performs a sanity check of the specified SPIR-V module:
+	//! checks the header (magic, version, id bound, schema) and that all instruction word counts are valid
+	bool validate_module(const std::span<const uint32_t> code, const std::string& identifier = "");
 
 } // fl::spirv_handler
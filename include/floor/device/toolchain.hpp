@@ -279,6 +279,11 @@ namespace fl::toolchain {
 		//! when building a FUBAR archive: compress all binary data in the archive?
 		bool compress_binaries { false };
 		
+		//! if true, SPIR-V/AIR/Host-Compute binaries are returned as in-memory data in program_data::data_or_filename
+		//! instead of being written to a temporary file whose file name is returned
+		//! NOTE: compiler outputs are written into memory (memfd) where possible, falling back to temporary files otherwise
+		bool in_memory_binary { false };
+		
 		//! if true, enables C assert() functionality,
 		//! i.e. if an assertion doesn't hold true, the function is exited and an error is printed
 		//! NOTE: printing requires soft-printf to be enabled on Metal/Vulkan/Host-Compute
@@ -370,8 +375,8 @@ namespace fl::toolchain {
 		//! true if compilation was successful and this contains valid program data, false otherwise
 		bool valid { false };
 		
-		//! this either contains the compiled binary data (for PTX, SPIR),
-		//! or the filename to the compiled binary (SPIR-V, AIR)
+		//! this either contains the compiled binary data (for PTX, SPIR, or if compile_options::in_memory_binary is set),
+		//! or the filename to the compiled binary (SPIR-V, AIR, Host-Compute)
 		std::string data_or_filename;
 		
 		//! contains the function-specific information for all functions in the program
@@ -401,5 +406,10 @@ namespace fl::toolchain {
 	bool create_floor_function_info(const std::string& ffi_file_name,
 									std::vector<function_info>& functions,
 									const uint32_t toolchain_version);
+	//! creates the internal floor function info representation from the specified in-memory floor function info,
+	//! returns true on success
+	bool create_floor_function_info_from_memory(const std::string_view ffi,
+												std::vector<function_info>& functions,
+												const uint32_t toolchain_version);
 
 } // fl::toolchain
@@ -449,18 +449,21 @@ using namespace std::literals;
 	
 	//! builds an archive from the given source file/code, with the specified options, for the specified targets,
 	//! writing the binary output to the specified destination if successful (returns false if not),
-	//! if "use_precompiled_header" is set, a pre-compiled header will be generated and used for each target
+	//! if "use_precompiled_header" is set, a pre-compiled header will be generated and used for each target,
+	//! at most "max_build_jobs" targets are built concurrently (0 = #logical CPUs)
 	//! NOTE: compile_options::target is ignored for this
 	bool build_archive_from_file(const std::string& src_file_name,
 								 const std::string& dst_archive_file_name,
 								 const toolchain::compile_options& options,
 								 const std::vector<target>& targets,
-								 const bool use_precompiled_header = false);
+								 const bool use_precompiled_header = false,
+								 const uint32_t max_build_jobs = 0u);
 	bool build_archive_from_memory(const std::string& src_code,
 								   const std::string& dst_archive_file_name,
 								   const toolchain::compile_options& options,
 								   const std::vector<target>& targets,
-								   const bool use_precompiled_header = false);
+								   const bool use_precompiled_header = false,
+								   const uint32_t max_build_jobs = 0u);
 	
 	//! finds the best matching binary for the specified device inside the specified archive,
 	//! returns nullptr if no compatible binary has been found at all
@@ -19,56 +19,34 @@
 #pragma once
 
 #include <floor/threading/thread_base.hpp>
-#include <floor/threading/thread_safety.hpp>
+#include <floor/threading/task_scheduler.hpp>
+#include <floor/threading/mpsc_queue.hpp>
+#include <floor/threading/atomic_spin_lock.hpp>
+#include <floor/core/logger.hpp>
 #include <string>
-#include <mutex>
-#include <queue>
+#include <vector>
+#include <span>
 #include <chrono>
-#include <condition_variable>
+#include <thread>
 
 namespace fl {
 using namespace std::literals;
 
-//! single command completion thread (run/owned by the specified completion handler)
-template <typename completion_handler_type, class command_buffer_completion_class>
-class generic_cmd_completion_thread final : public thread_base, public command_buffer_completion_class {
+//! single command completion waiter thread (run/owned by the specified completion handler)
+template <typename completion_handler_type>
+class generic_cmd_completion_waiter final : public thread_base {
 public:
-	generic_cmd_completion_thread(completion_handler_type& handler_, const std::string name) : thread_base(name), handler(handler_) {
-		// never sleep or yield, will wait on "work_cv" in run()
+	generic_cmd_completion_waiter(completion_handler_type& handler_, const std::string name) : thread_base(name), handler(handler_) {
+		// only run once there is new work (-> wakeup() in add_cmd_completion)
 		set_thread_delay(0u);
 		set_yield_after_run(false);
+		set_wakeup_driven(true);
 	}
-	~generic_cmd_completion_thread() override = default;
+	~generic_cmd_completion_waiter() override = default;
 	
 	void run() override {
 		try {
-			typename completion_handler_type::cmd_t cmd {};
-			for (uint32_t run = 0; ; ++run) {
-				{
-					// wait until we have new work,
-					// time out after 200ms in case everything is being shut down or halted
-					std::unique_lock<std::mutex> work_lock_guard(handler.work_cv_lock);
-					if (run == 0) {
-						// if this is the first run/iteration, we haven't completed any work/cmd yet
-						handler.work_cv.wait_for(work_lock_guard, 200ms);
-						if (!handler.has_work()) {
-							return; // -> return to thread_base and (potentially) run again
-						}
-					}
-					// else: run 1+: just completed work, immediately retry to get new work w/o waiting on the CV
-					else {
-						// get work/cmd if there is any, otherwise return and retry
-						if (!handler.has_work()) {
-							return;
-						}
-					}
-					cmd = handler.get_work();
-				}
-				
-				// wait on cmd
-				// TODO: do we rather want to have a back-off mechanism and handle multiple completions per thread?
-				command_buffer_completion_class::complete(cmd);
-			}
+			handler.wait_for_pending();
 		} catch (std::exception& exc) {
 			log_error("exception during $ work execution: $", thread_name, exc.what());
 		}
@@ -82,7 +60,20 @@ protected:
 	completion_handler_type& handler;
 };
 
-//! asynchronous command completion handler (runs command completion in separate threads)
+//! asynchronous command completion handler:
+//! a single waiter thread multiplexes all pending commands (in submission order) and dispatches the completion of
+//! each completed command to a small pool of callback threads
+//! "command_buffer_completion_class" must provide:
+//!  * static bool is_complete(cmd_type&): non-blocking check if the command has completed (successfully or not)
+//!  * static void complete(cmd_type&): performs the completion handling of a completed command (called on a callback thread)
+//! and should provide at least one of:
+//!  * static bool wait_any(std::span<cmd_type* const>, bool cmds_changed, std::chrono::microseconds max_wait): blocks until
+//!    any of the specified commands may have completed or "max_wait" has elapsed, returns false if it can't wait on these
+//!    commands, "cmds_changed" is false if the commands are the same as in the previous call (-> wait data can be reused)
+//!  * static bool wait(cmd_type&, std::chrono::microseconds max_wait): blocks until the specified command may have
+//!    completed or "max_wait" has elapsed, returns false if it can't wait on this command
+//! if wait_any() is unavailable or fails, the waiter blocks on the oldest pending command via wait() instead,
+//! only if neither is available or both fail will the waiter poll with a back-off
 template <typename cmd_type, class command_buffer_completion_class>
 class generic_cmd_completion_handler {
 public:
@@ -90,68 +81,157 @@ public:
 	using cmd_completion_handler_class = generic_cmd_completion_handler<cmd_type, command_buffer_completion_class>;
 	//! externally specified command type that needs completion
 	using cmd_t = cmd_type;
-	//! worker/handler thread class
-	using cmd_completion_thread_class = generic_cmd_completion_thread<cmd_completion_handler_class, command_buffer_completion_class>;
+	//! waiter thread class
+	using cmd_completion_waiter_class = generic_cmd_completion_waiter<cmd_completion_handler_class>;
 	
-	generic_cmd_completion_handler() {
-		cmd_completion_threads.resize(completion_thread_count);
-		for (uint32_t i = 0; i < completion_thread_count; ++i) {
-			cmd_completion_threads[i] = std::make_unique<cmd_completion_thread_class>(*this, "cmpl_hndlr_" + std::to_string(i));
-			cmd_completion_threads[i]->start();
-		}
+	generic_cmd_completion_handler() : callback_scheduler("cmpl_cb", callback_thread_count) {
+		waiter_thread = std::make_unique<cmd_completion_waiter_class>(*this, "cmpl_waiter");
+		waiter_thread->start();
 	}
 	
 	~generic_cmd_completion_handler() {
-		GUARD(cmd_completion_threads_lock);
-		for (auto& th : cmd_completion_threads) {
-			th->set_thread_should_finish();
+		// NOTE: the waiter thread only finishes after its current run, which completes all pending commands
+		waiter_thread->finish();
+		waiter_thread = nullptr;
+		
+		// complete anything that has been added after the last run of the waiter thread
+		try {
+			wait_for_pending();
+		} catch (std::exception& exc) {
+			log_error("exception during command completion: $", exc.what());
 		}
-		work_cv.notify_all();
-		for (auto& th : cmd_completion_threads) {
-			th->finish();
+		
+		// wait until all completion callbacks have been executed (help executing these while waiting)
+		while (callbacks_in_flight.load() > 0u) {
+			if (!callback_scheduler.try_run_one()) {
+				std::this_thread::yield();
+			}
 		}
-		cmd_completion_threads.clear();
 	}
 	
 	void add_cmd_completion(cmd_type&& cmd) {
-		{
-			std::unique_lock<std::mutex> work_lock_guard(work_cv_lock);
-			work_queue.emplace(std::move(cmd));
-		}
-		work_cv.notify_one();
+		work_queue.push(std::move(cmd));
+		waiter_thread->wakeup();
 	}
 	
 protected:
-	friend cmd_completion_thread_class;
+	friend cmd_completion_waiter_class;
+	
+	//! amount of threads that execute completion callbacks
+	static constexpr const uint32_t callback_thread_count { 2 };
+	//! max time the waiter will block in wait_any()/wait() before checking for newly added commands
+	static constexpr const auto max_wait_time { 1000us };
 	
-	//! max amount of completion threads that are created / will be running at most
-	static constexpr const uint32_t completion_thread_count { 8 };
+	//! newly added commands, picked up by the waiter thread
+	mpsc_queue<cmd_type, 256u> work_queue;
+	//! all commands that haven't completed yet, in submission order (only accessed by the waiter)
+	std::vector<cmd_type> pending;
+	//! pointers to all "pending" commands, used for wait_any() (only accessed by the waiter)
+	std::vector<cmd_type*> pending_ptrs;
 	
-	//! access to "cmd_completion_threads" must be thread-safe
-	safe_mutex cmd_completion_threads_lock;
-	//! command completion threads
-	std::vector<std::unique_ptr<cmd_completion_thread_class>> cmd_completion_threads GUARDED_BY(cmd_completion_threads_lock);
+	//! amount of completion callbacks that have been dispatched, but haven't finished yet
+	std::atomic<uint32_t> callbacks_in_flight { 0u };
+	//! executes the completion callbacks
+	task_scheduler callback_scheduler;
 	
-	//! required lock for "work_cv"
-	std::mutex work_cv_lock;
-	//! will be signaled once there is new work
-	std::condition_variable work_cv;
-	//! currently queued command completion work
-	std::queue<cmd_type> work_queue;
+	//! the waiter thread
+	std::unique_ptr<cmd_completion_waiter_class> waiter_thread;
 	
-	//! returns true if there is any work that needs to be handled
-	//! NOTE: requires holding "work_cv_lock"
-	bool has_work() {
-		return !work_queue.empty();
+	//! waits on all pending commands, including ones that are added in the meantime, and dispatches their completion,
+	//! returns once there are no more pending commands
+	//! NOTE: must only be called by a single thread at a time (the waiter thread)
+	void wait_for_pending() {
+		// NOTE: "pending_ptrs" (and any wait data of the completion class) only need to be rebuilt when "pending" has changed
+		bool pending_changed = true;
+		for (uint32_t idle_iteration = 0u; ; ) {
+			work_queue.consume([this, &pending_changed](cmd_type&& cmd) {
+				pending.emplace_back(std::move(cmd));
+				pending_changed = true;
+			});
+			if (pending.empty()) {
+				return;
+			}
+			
+			// dispatch all completed commands in submission order, keep the order of the remaining ones
+			size_t keep_count = 0;
+			for (size_t i = 0, count = pending.size(); i < count; ++i) {
+				bool is_done = true;
+				try {
+					is_done = command_buffer_completion_class::is_complete(pending[i]);
+				} catch (std::exception& exc) {
+					// -> still dispatch, complete() will handle the failure
+					log_error("exception during command completion check: $", exc.what());
+				}
+				if (is_done) {
+					dispatch(std::move(pending[i]));
+				} else {
+					if (keep_count != i) {
+						pending[keep_count] = std::move(pending[i]);
+					}
+					++keep_count;
+				}
+			}
+			const auto any_completed = (keep_count < pending.size());
+			pending.erase(pending.begin() + ptrdiff_t(keep_count), pending.end());
+			if (any_completed) {
+				idle_iteration = 0u;
+				pending_changed = true;
+				continue;
+			}
+			
+			// nothing has completed yet -> block on all pending commands if supported,
+			// otherwise block on the oldest pending command
+			if constexpr (requires(std::span<cmd_type* const> cmds) {
+				{ command_buffer_completion_class::wait_any(cmds, true, max_wait_time) } -> std::same_as<bool>;
+			}) {
+				if (pending_changed) {
+					pending_ptrs.clear();
+					for (auto& cmd : pending) {
+						pending_ptrs.emplace_back(&cmd);
+					}
+				}
+				const auto cmds_changed = pending_changed;
+				pending_changed = false;
+				if (command_buffer_completion_class::wait_any(pending_ptrs, cmds_changed, max_wait_time)) {
+					continue;
+				}
+			}
+			if constexpr (requires(cmd_type& cmd) {
+				{ command_buffer_completion_class::wait(cmd, max_wait_time) } -> std::same_as<bool>;
+			}) {
+				if (command_buffer_completion_class::wait(pending.front(), max_wait_time)) {
+					continue;
+				}
+			}
+			
+			// last resort: can't block on any of the pending commands -> back off
+			if (idle_iteration < 64u) {
+				FLOOR_SPIN_WAIT();
+			} else if (idle_iteration < 128u) {
+				std::this_thread::yield();
+			} else {
+				std::this_thread::sleep_for(50us);
+			}
+			++idle_iteration;
+		}
 	}
 	
-	//! returns and removes the cmd from the front of the work queue
-	//! NOTE: requires holding "work_cv_lock"
-	cmd_type get_work() {
-		cmd_type cmd = std::move(work_queue.front());
-		work_queue.pop();
-		return cmd;
+	//! executes the completion handling of "cmd" on a callback thread
+	void dispatch(cmd_type&& cmd) {
+		callbacks_in_flight.fetch_add(1u);
+		callback_scheduler.spawn([this, compl_cmd = std::move(cmd)]() mutable {
+			try {
+				command_buffer_completion_class::complete(compl_cmd);
+			} catch (std::exception& exc) {
+				log_error("exception during command completion: $", exc.what());
+			}
+			// release all command resources before signaling that we're done
+			compl_cmd = {};
+			// NOTE: must be the last access of this
+			callbacks_in_flight.fetch_sub(1u);
+		});
 	}
+	
 };
 
 } // namespace fl
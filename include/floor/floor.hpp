@@ -390,6 +390,12 @@ protected:
 		bool log_use_time = true;
 		bool log_use_color = true;
 		bool log_synchronous = false;
+		bool log_deferred = false;
+		uint32_t file_verbosity = (uint32_t)logger::LOG_TYPE::UNDECORATED;
+		uint64_t log_max_file_size = 0;
+		uint64_t log_max_file_age = 0;
+		uint32_t log_max_rotated_files = 0;
+		bool log_compress_rotated_files = false;
 		bool file_logging = true;
 		std::string log_filename;
 		std::string msg_filename;
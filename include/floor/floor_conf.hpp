@@ -58,6 +58,11 @@
 // if defined, this disables OpenXR support
 //#define FLOOR_NO_OPENXR 1
 
+// if defined, this disables computing component-wise float vector math (rsqrt, sin, cos, atan2, exp, log) with the SIMD math
+// functions (-> simd_math.hpp) on the host and with Host-Compute, and uses the scalar std functions instead
+// NOTE: results may differ from the scalar std functions by up to 2 ULP (-> tests/simd_math_test.cpp)
+//#define FLOOR_NO_VEC_SIMD_MATH 1
+
 // if defined, this will use extern templates for specific template classes (vector*, matrix, etc.)
 // and instantiate them for various basic types (float, int, ...)
 // NOTE: don't enable this for compute (these won't compile the necessary .cpp files)
@@ -0,0 +1,265 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/math/ray_packet.hpp>
+#include <vector>
+#include <span>
+#include <array>
+#include <bit>
+
+namespace fl {
+
+//! 4-wide bounding volume hierarchy over arbitrary primitives (only their bounding boxes are needed to build it):
+//! the hierarchy is built with binned SAH and then collapsed into nodes with 4 children each, whose bounding boxes are
+//! stored in structure-of-arrays layout, so that a single ray is tested against all children of a node at once
+class bvh {
+public:
+	//! amount of children per node
+	static constexpr const uint32_t node_width { 4u };
+	//! indicates an invalid primitive / no hit
+	static constexpr const uint32_t invalid_index { ~0u };
+	
+	//! BVH node
+	struct node_t {
+		//! bounding boxes of all children
+		bbox_batch<node_width> child_bounds;
+		//! per child: inner node -> index of the child node, leaf -> offset into "prim_indices"
+		std::array<uint32_t, node_width> child_index { invalid_index, invalid_index, invalid_index, invalid_index };
+		//! per child: 0 for inner nodes, otherwise the amount of primitives in the leaf
+		std::array<uint32_t, node_width> child_prim_count {};
+		//! bitmask of all children that are actually used
+		uint32_t child_mask { 0u };
+	};
+	
+	//! ray hit result
+	struct hit_t {
+		//! index of the hit primitive (invalid_index if there was no hit)
+		uint32_t primitive { invalid_index };
+		//! distance along the ray to the hit
+		float distance { ext::limits<float>::max };
+		
+		explicit operator bool() const {
+			return (primitive != invalid_index);
+		}
+	};
+	
+	bvh() = default;
+	//! builds the BVH for the specified primitive bounding boxes (-> build())
+	explicit bvh(std::span<const bboxf> prim_bounds, const uint32_t max_leaf_size = 4u) {
+		build(prim_bounds, max_leaf_size);
+	}
+	
+	//! (re)builds the BVH for the specified primitive bounding boxes,
+	//! the index of each box in "prim_bounds" is the primitive index that is used in all queries
+	//! NOTE: leaves contain at most "max_leaf_size" primitives, unless the max tree depth has been reached
+	void build(std::span<const bboxf> prim_bounds, const uint32_t max_leaf_size = 4u);
+	
+	//! returns true if this BVH contains no primitives
+	bool empty() const {
+		return nodes.empty();
+	}
+	
+	//! returns the bounding box of all primitives
+	const bboxf& get_bounds() const {
+		return bounds;
+	}
+	
+	//! returns all nodes (the root node is at index 0)
+	const std::vector<node_t>& get_nodes() const {
+		return nodes;
+	}
+	
+	//! finds the closest primitive that is hit by "r" within [0, t_max]:
+	//! "prim_intersect(uint32_t primitive, const ray&, float t_max) -> float" must return the hit distance if the
+	//! primitive is hit within [0, t_max] and a value > t_max otherwise
+	template <typename F>
+	hit_t intersect(const ray& r, F&& prim_intersect, const float t_max = ext::limits<float>::max) const {
+		hit_t hit { .distance = t_max };
+		if (nodes.empty()) {
+			return hit;
+		}
+		
+		const prepared_ray pray(r);
+		std::array<uint32_t, max_stack_size> stack;
+		uint32_t stack_size = 0u;
+		stack[stack_size++] = 0u;
+		while (stack_size > 0u) {
+			const auto& node = nodes[stack[--stack_size]];
+			typename bbox_batch<node_width>::simd_type t_near;
+			auto hit_mask = pray.intersect(node.child_bounds, hit.distance, t_near) & node.child_mask;
+			if (hit_mask == 0u) {
+				continue;
+			}
+			
+			// visit children from near to far: leaves are handled immediately, inner nodes are pushed in reverse order
+			std::array<uint32_t, node_width> order;
+			uint32_t order_count = 0u;
+			for (; hit_mask != 0u; hit_mask &= hit_mask - 1u) {
+				const auto child = uint32_t(std::countr_zero(hit_mask));
+				uint32_t pos = order_count++;
+				for (; pos > 0u && t_near[order[pos - 1u]] > t_near[child]; --pos) {
+					order[pos] = order[pos - 1u];
+				}
+				order[pos] = child;
+			}
+			for (uint32_t i = 0; i < order_count; ++i) {
+				const auto child = order[i];
+				if (node.child_prim_count[child] == 0u) {
+					continue;
+				}
+				if (t_near[child] > hit.distance) {
+					continue;
+				}
+				for (uint32_t prim = 0; prim < node.child_prim_count[child]; ++prim) {
+					const auto prim_idx = prim_indices[node.child_index[child] + prim];
+					if (const auto dist = prim_intersect(prim_idx, r, hit.distance); dist <= hit.distance) {
+						hit = { prim_idx, dist };
+					}
+				}
+			}
+			for (uint32_t i = order_count; i > 0u; --i) {
+				const auto child = order[i - 1u];
+				if (node.child_prim_count[child] == 0u) {
+					stack[stack_size++] = node.child_index[child];
+				}
+			}
+		}
+		return hit;
+	}
+	
+	//! finds the closest primitive for each ray in "rays" (see single ray intersect()), hits are written to "hits"
+	//! NOTE: a node is only visited if any ray of the packet hits it, so this is best used with coherent rays
+	template <uint32_t packet_width, typename F>
+	void intersect(const ray_packet<packet_width>& rays, F&& prim_intersect, std::span<hit_t, size_t(packet_width)> hits,
+				   const float t_max = ext::limits<float>::max) const {
+		using simd_type = typename ray_packet<packet_width>::simd_type;
+		for (auto& hit : hits) {
+			hit = { .distance = t_max };
+		}
+		if (nodes.empty()) {
+			return;
+		}
+		
+		simd_type t_far = simd::splat<simd_type>(t_max);
+		std::array<uint32_t, max_stack_size> stack;
+		uint32_t stack_size = 0u;
+		stack[stack_size++] = 0u;
+		while (stack_size > 0u) {
+			const auto& node = nodes[stack[--stack_size]];
+			for (uint32_t child = 0; child < node_width; ++child) {
+				if ((node.child_mask & (1u << child)) == 0u) {
+					continue;
+				}
+				simd_type t_near;
+				auto ray_mask = rays.intersect(node.child_bounds.get(child), t_far, t_near);
+				if (ray_mask == 0u) {
+					continue;
+				}
+				if (node.child_prim_count[child] == 0u) {
+					stack[stack_size++] = node.child_index[child];
+					continue;
+				}
+				for (; ray_mask != 0u; ray_mask &= ray_mask - 1u) {
+					const auto ray_idx = uint32_t(std::countr_zero(ray_mask));
+					const auto r = rays.get(ray_idx);
+					auto& hit = hits[ray_idx];
+					for (uint32_t prim = 0; prim < node.child_prim_count[child]; ++prim) {
+						const auto prim_idx = prim_indices[node.child_index[child] + prim];
+						if (const auto dist = prim_intersect(prim_idx, r, hit.distance); dist <= hit.distance) {
+							hit = { prim_idx, dist };
+						}
+					}
+					t_far[ray_idx] = hit.distance;
+				}
+			}
+		}
+	}
+	
+	//! calls "func(uint32_t primitive)" for all primitives whose bounding box is hit by "r" within [0, t_max]
+	//! (e.g. for picking, when all candidates are needed)
+	template <typename F>
+	void for_each_intersected(const ray& r, F&& func, const float t_max = ext::limits<float>::max) const {
+		const prepared_ray pray(r);
+		for_each_leaf([&pray, &t_max](const bbox_batch<node_width>& boxes) {
+			typename bbox_batch<node_width>::simd_type t_near;
+			return pray.intersect(boxes, t_max, t_near);
+		}, [&pray, &t_max](const bboxf& box) {
+			float t_near = 0.0f;
+			return pray.intersect(box, t_max, t_near);
+		}, std::forward<F>(func));
+	}
+	
+	//! calls "func(uint32_t primitive)" for all primitives whose bounding box overlaps with "box" (e.g. for culling)
+	template <typename F>
+	void for_each_overlapping(const bboxf& box, F&& func) const {
+		for_each_leaf([&box](const bbox_batch<node_width>& boxes) {
+			return boxes.overlaps(box);
+		}, [&box](const bboxf& prim_box) {
+			return (prim_box.min.x <= box.max.x && prim_box.max.x >= box.min.x &&
+					prim_box.min.y <= box.max.y && prim_box.max.y >= box.min.y &&
+					prim_box.min.z <= box.max.z && prim_box.max.z >= box.min.z);
+		}, std::forward<F>(func));
+	}
+	
+protected:
+	//! max binary tree depth during the build (-> bounds the traversal stack size)
+	static constexpr const uint32_t max_build_depth { 64u };
+	//! max traversal stack size: each visited node pushes at most node_width - 1 more nodes than it pops
+	static constexpr const uint32_t max_stack_size { max_build_depth * (node_width - 1u) + 1u };
+	
+	std::vector<node_t> nodes;
+	//! primitive indices referenced by the leaves
+	std::vector<uint32_t> prim_indices;
+	//! per primitive bounding boxes (used for exact per-primitive tests in for_each_*)
+	std::vector<bboxf> prim_bounds;
+	//! bounding box of all primitives
+	bboxf bounds;
+	
+	//! visits all nodes for which "node_test(const bbox_batch&) -> child bitmask" returns a hit, and calls "func(primitive)"
+	//! for all primitives in hit leaves for which "prim_test(const bboxf&) -> bool" returns true
+	template <typename node_test_func, typename prim_test_func, typename F>
+	void for_each_leaf(node_test_func&& node_test, prim_test_func&& prim_test, F&& func) const {
+		if (nodes.empty()) {
+			return;
+		}
+		std::array<uint32_t, max_stack_size> stack;
+		uint32_t stack_size = 0u;
+		stack[stack_size++] = 0u;
+		while (stack_size > 0u) {
+			const auto& node = nodes[stack[--stack_size]];
+			for (auto hit_mask = node_test(node.child_bounds) & node.child_mask; hit_mask != 0u; hit_mask &= hit_mask - 1u) {
+				const auto child = uint32_t(std::countr_zero(hit_mask));
+				if (node.child_prim_count[child] == 0u) {
+					stack[stack_size++] = node.child_index[child];
+					continue;
+				}
+				for (uint32_t prim = 0; prim < node.child_prim_count[child]; ++prim) {
+					const auto prim_idx = prim_indices[node.child_index[child] + prim];
+					if (prim_test(prim_bounds[prim_idx])) {
+						func(prim_idx);
+					}
+				}
+			}
+		}
+	}
+	
+};
+
+} // namespace fl
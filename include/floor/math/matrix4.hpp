@@ -21,6 +21,7 @@
 #include <utility>
 #include <tuple>
 #include <functional>
+#include <span>
 #if !defined(FLOOR_NO_MATH_STR)
 #include <ostream>
 #include <sstream>
@@ -182,6 +183,12 @@ public:
 	
 	//! multiplies this matrix with 'mat' and returns the result
 	constexpr matrix4 operator*(const matrix4& mat) const {
+		if constexpr (use_simd) {
+			if !consteval {
+				return simd_mul(mat);
+			}
+		}
+		
 		matrix4 mul_mat { (scalar_type)0 };
 #pragma unroll
 		for(size_t mi = 0; mi < 4; ++mi) { // column
@@ -309,6 +316,12 @@ public:
 	
 	//! returns the inverted form of this matrix
 	constexpr matrix4 inverted() const {
+		if constexpr (use_simd) {
+			if !consteval {
+				return simd_inverted();
+			}
+		}
+		
 		matrix4 mat {};
 		
 		const scalar_type p00(data[10] * data[15]);
@@ -367,6 +380,51 @@ public:
 		return mat;
 	}
 	
+	//! inverts this matrix, assuming it is an affine transformation (-> inverted_affine())
+	constexpr matrix4& invert_affine() {
+		*this = inverted_affine();
+		return *this;
+	}
+	
+	//! returns the inverted form of this matrix, assuming it is an affine transformation,
+	//! i.e. the bottom row is (0, 0, 0, 1) and only the top left 3x3 part and the translation must be inverted
+	//! NOTE: this is considerably cheaper than inverted(), but returns wrong results for projection matrices
+	constexpr matrix4 inverted_affine() const {
+		if constexpr (use_simd) {
+			if !consteval {
+				return simd_inverted_affine();
+			}
+		}
+		
+		// rows of the inverted 3x3 part (scaled by the determinant) are the cross products of the columns
+		const scalar_type cols[3][3] {
+			{ data[0], data[1], data[2] },
+			{ data[4], data[5], data[6] },
+			{ data[8], data[9], data[10] },
+		};
+		scalar_type rows[3][3] {};
+#pragma unroll
+		for(size_t i = 0; i < 3; ++i) {
+			const auto& p = cols[(i + 1) % 3];
+			const auto& q = cols[(i + 2) % 3];
+			rows[i][0] = p[1] * q[2] - p[2] * q[1];
+			rows[i][1] = p[2] * q[0] - p[0] * q[2];
+			rows[i][2] = p[0] * q[1] - p[1] * q[0];
+		}
+		const scalar_type inv_det(((scalar_type)1) / (cols[0][0] * rows[0][0] + cols[0][1] * rows[0][1] + cols[0][2] * rows[0][2]));
+		
+		matrix4 mat {};
+#pragma unroll
+		for(size_t row = 0; row < 3; ++row) {
+#pragma unroll
+			for(size_t col = 0; col < 3; ++col) {
+				mat.data[(col * 4) + row] = rows[row][col] * inv_det;
+			}
+			mat.data[12 + row] = -(rows[row][0] * data[12] + rows[row][1] * data[13] + rows[row][2] * data[14]) * inv_det;
+		}
+		return mat;
+	}
+	
 	//! transposes this matrix
 	constexpr matrix4& transpose() {
 		std::swap(data[1], data[4]);
@@ -433,6 +491,59 @@ public:
 		return *this;
 	}
 	
+	//! transforms the points in "src" by this matrix and writes them to "dst" (same as vector3 * matrix4, i.e. implicit .w = 1),
+	//! only the first min(#src, #dst) points are transformed, "src" and "dst" may be the same
+	constexpr void transform_points(std::span<const vector3<scalar_type>> src, std::span<vector3<scalar_type>> dst) const {
+		const auto count = std::min(src.size(), dst.size());
+		if constexpr (use_simd) {
+			if !consteval {
+				const simd4_type c0 = load_column(0), c1 = load_column(1), c2 = load_column(2), c3 = load_column(3);
+				for(size_t i = 0; i < count; ++i) {
+					const auto point = c0 * src[i].x + c1 * src[i].y + c2 * src[i].z + c3;
+					dst[i] = { point.x, point.y, point.z };
+				}
+				return;
+			}
+		}
+		for(size_t i = 0; i < count; ++i) {
+			dst[i] = src[i] * *this;
+		}
+	}
+	
+	//! transforms all points in "points" by this matrix (-> transform_points(src, dst))
+	constexpr void transform_points(std::span<vector3<scalar_type>> points) const {
+		transform_points(points, points);
+	}
+	
+	//! transforms the direction vectors in "src" by this matrix and writes them to "dst" (implicit .w = 0, i.e. the
+	//! translation is ignored), only the first min(#src, #dst) vectors are transformed, "src" and "dst" may be the same
+	constexpr void transform_vectors(std::span<const vector3<scalar_type>> src, std::span<vector3<scalar_type>> dst) const {
+		const auto count = std::min(src.size(), dst.size());
+		if constexpr (use_simd) {
+			if !consteval {
+				const simd4_type c0 = load_column(0), c1 = load_column(1), c2 = load_column(2);
+				for(size_t i = 0; i < count; ++i) {
+					const auto vec = c0 * src[i].x + c1 * src[i].y + c2 * src[i].z;
+					dst[i] = { vec.x, vec.y, vec.z };
+				}
+				return;
+			}
+		}
+		for(size_t i = 0; i < count; ++i) {
+			const auto& vec = src[i];
+			dst[i] = {
+				data[0] * vec.x + data[4] * vec.y + data[8] * vec.z,
+				data[1] * vec.x + data[5] * vec.y + data[9] * vec.z,
+				data[2] * vec.x + data[6] * vec.y + data[10] * vec.z,
+			};
+		}
+	}
+	
+	//! transforms all direction vectors in "vecs" by this matrix (-> transform_vectors(src, dst))
+	constexpr void transform_vectors(std::span<vector3<scalar_type>> vecs) const {
+		transform_vectors(vecs, vecs);
+	}
+	
 	//! returns this matrix as a tuple
 	constexpr auto as_tuple() const {
 		return std::make_tuple(data[0], data[1], data[2], data[3],
@@ -719,6 +830,118 @@ public:
 		};
 	}
 	
+protected:
+	//////////////////////////////////////////
+	// SIMD implementations
+#pragma mark SIMD implementations
+	
+	//! true if the SIMD implementations are used at run-time (only on the host and only for float and double)
+	static constexpr const bool use_simd {
+#if !defined(FLOOR_DEVICE) || (defined(FLOOR_DEVICE_HOST_COMPUTE) && !defined(FLOOR_DEVICE_HOST_COMPUTE_IS_DEVICE))
+		std::is_same_v<decayed_scalar_type, float> || std::is_same_v<decayed_scalar_type, double>
+#else
+		false
+#endif
+	};
+	
+	//! SIMD vector holding one matrix column
+	using simd4_type = __attribute__((ext_vector_type(4))) std::conditional_t<use_simd, decayed_scalar_type, float>;
+	
+	floor_inline_always simd4_type load_column(const size_t col) const {
+		simd4_type ret;
+		__builtin_memcpy(&ret, &data[col * 4], sizeof(simd4_type));
+		return ret;
+	}
+	
+	floor_inline_always void store_column(const size_t col, const simd4_type& vec) {
+		__builtin_memcpy(&data[col * 4], &vec, sizeof(simd4_type));
+	}
+	
+	//! cross product of the xyz components of "a" and "b", .w of the result is always 0
+	static floor_inline_always simd4_type simd_cross(const simd4_type& a, const simd4_type& b) {
+		return (__builtin_shufflevector(a, a, 1, 2, 0, 3) * __builtin_shufflevector(b, b, 2, 0, 1, 3) -
+				__builtin_shufflevector(a, a, 2, 0, 1, 3) * __builtin_shufflevector(b, b, 1, 2, 0, 3));
+	}
+	
+	//! dot product of the xyz components of "a" and "b"
+	static floor_inline_always decayed_scalar_type simd_dot(const simd4_type& a, const simd4_type& b) {
+		const auto prod = a * b;
+		return prod.x + prod.y + prod.z;
+	}
+	
+	//! creates a matrix from the specified rows (-> transposes them into columns)
+	static floor_inline_always matrix4 simd_from_rows(const simd4_type& r0, const simd4_type& r1,
+													  const simd4_type& r2, const simd4_type& r3) {
+		const auto t0 = __builtin_shufflevector(r0, r1, 0, 4, 1, 5);
+		const auto t1 = __builtin_shufflevector(r2, r3, 0, 4, 1, 5);
+		const auto t2 = __builtin_shufflevector(r0, r1, 2, 6, 3, 7);
+		const auto t3 = __builtin_shufflevector(r2, r3, 2, 6, 3, 7);
+		matrix4 mat;
+		mat.store_column(0, __builtin_shufflevector(t0, t1, 0, 1, 4, 5));
+		mat.store_column(1, __builtin_shufflevector(t0, t1, 2, 3, 6, 7));
+		mat.store_column(2, __builtin_shufflevector(t2, t3, 0, 1, 4, 5));
+		mat.store_column(3, __builtin_shufflevector(t2, t3, 2, 3, 6, 7));
+		return mat;
+	}
+	
+	//! SIMD matrix multiplication: each result column is the sum of all columns of "mat" scaled by a broadcast element of
+	//! this matrix (-> contracted to FMAs if the target supports them)
+	matrix4 simd_mul(const matrix4& mat) const {
+		const simd4_type m0 = mat.load_column(0), m1 = mat.load_column(1), m2 = mat.load_column(2), m3 = mat.load_column(3);
+		matrix4 mul_mat;
+#pragma unroll
+		for(size_t col = 0; col < 4; ++col) {
+			mul_mat.store_column(col, (m0 * data[col * 4] + m1 * data[(col * 4) + 1] +
+									   m2 * data[(col * 4) + 2] + m3 * data[(col * 4) + 3]));
+		}
+		return mul_mat;
+	}
+	
+	//! SIMD cofactor inverse: with the 3D column vectors a, b, c, d and the bottom row (x, y, z, w), all 2x2 cofactors
+	//! can be expressed as s = a x b, t = c x d, u = a * y - b * x and v = c * w - d * z
+	//! (this is the same computation as the scalar inverted(), just reordered so that it maps to 4-wide SIMD ops)
+	matrix4 simd_inverted() const {
+		const simd4_type a = load_column(0), b = load_column(1), c = load_column(2), d = load_column(3);
+		auto s = simd_cross(a, b);
+		auto t = simd_cross(c, d);
+		// NOTE: .w of s, t, u and v is ignored/unused, .w of all rows is set explicitly below
+		auto u = a * b.w - b * a.w;
+		auto v = c * d.w - d * c.w;
+		
+		const auto inv_det = ((decayed_scalar_type)1) / (simd_dot(s, v) + simd_dot(t, u));
+		s *= inv_det;
+		t *= inv_det;
+		u *= inv_det;
+		v *= inv_det;
+		
+		auto r0 = simd_cross(b, v) + t * b.w;
+		auto r1 = simd_cross(v, a) - t * a.w;
+		auto r2 = simd_cross(d, u) + s * d.w;
+		auto r3 = simd_cross(u, c) - s * c.w;
+		r0.w = -simd_dot(b, t);
+		r1.w = simd_dot(a, t);
+		r2.w = -simd_dot(d, s);
+		r3.w = simd_dot(c, s);
+		return simd_from_rows(r0, r1, r2, r3);
+	}
+	
+	//! SIMD affine inverse: the rows of the inverted 3x3 part are the cross products of its columns (scaled by 1 / det),
+	//! the inverted translation is then the negated inverted 3x3 part times the translation
+	matrix4 simd_inverted_affine() const {
+		const simd4_type a = load_column(0), b = load_column(1), c = load_column(2), translation = load_column(3);
+		auto r0 = simd_cross(b, c);
+		auto r1 = simd_cross(c, a);
+		auto r2 = simd_cross(a, b);
+		const auto inv_det = ((decayed_scalar_type)1) / simd_dot(a, r0);
+		r0 *= inv_det;
+		r1 *= inv_det;
+		r2 *= inv_det;
+		r0.w = -simd_dot(r0, translation);
+		r1.w = -simd_dot(r1, translation);
+		r2.w = -simd_dot(r2, translation);
+		return simd_from_rows(r0, r1, r2, simd4_type { 0, 0, 0, 1 });
+	}
+	
 };
 
 using matrix4f = matrix4<float>;
@@ -0,0 +1,176 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/math/vector_batch.hpp>
+#include <floor/math/ray.hpp>
+#include <floor/math/bbox.hpp>
+#include <span>
+#include <cmath>
+
+namespace fl {
+
+//! structure-of-arrays batch of "lane_count" axis-aligned bounding boxes
+template <uint32_t lane_count_ = native_simd_width<float>()>
+struct bbox_batch {
+	using batch_type = vector_batch<float3, lane_count_>;
+	using simd_type = typename batch_type::simd_type;
+	static constexpr const uint32_t lane_count { lane_count_ };
+	
+	//! [0] = all min corners, [1] = all max corners (-> can be directly indexed by a ray direction sign)
+	std::array<batch_type, 2> bounds {};
+	
+	//! gathers the "count" (<= lane_count) boxes at "boxes" into a batch (remaining lanes are set to the last box)
+	static constexpr bbox_batch load(const bboxf* boxes, const uint32_t count = lane_count) {
+		assert(count > 0u && count <= lane_count);
+		bbox_batch ret;
+		for (uint32_t i = 0; i < lane_count; ++i) {
+			ret.set(i, boxes[i < count ? i : count - 1u]);
+		}
+		return ret;
+	}
+	
+	//! returns the box in lane "idx"
+	constexpr bboxf get(const uint32_t idx) const {
+		return { bounds[0].get(idx), bounds[1].get(idx) };
+	}
+	
+	//! sets the box in lane "idx"
+	constexpr void set(const uint32_t idx, const bboxf& box) {
+		bounds[0].set(idx, box.min);
+		bounds[1].set(idx, box.max);
+	}
+	
+	//! returns the bitmask of all boxes that overlap with "box" (touching counts as overlapping)
+	constexpr uint32_t overlaps(const bboxf& box) const {
+		uint32_t mask = ~0u;
+		for (uint32_t c = 0; c < 3; ++c) {
+			mask &= simd::bitmask(bounds[0].comps[c] <= box.max[c]);
+			mask &= simd::bitmask(bounds[1].comps[c] >= box.min[c]);
+		}
+		return mask;
+	}
+	
+};
+
+//! single ray with a precomputed inverse direction and direction signs, used to intersect one ray with many boxes
+class prepared_ray {
+public:
+	float3 origin;
+	float3 inv_direction;
+	//! per component: 1 if the direction sign bit is set, 0 otherwise
+	//! NOTE: this must also be 1 for -0.0, since the inverse direction is -inf then
+	uint3 sign;
+	
+	constexpr prepared_ray() noexcept = default;
+	constexpr explicit prepared_ray(const ray& r) noexcept :
+	origin(r.origin), inv_direction(1.0f / r.direction),
+	sign(std::signbit(r.direction.x) ? 1u : 0u, std::signbit(r.direction.y) ? 1u : 0u, std::signbit(r.direction.z) ? 1u : 0u) {}
+	
+	//! intersects this ray with all boxes in "boxes" and returns the bitmask of all boxes that are hit within [0, t_max],
+	//! "t_near" is set to the entry distance of each box (0 if the ray origin is inside the box)
+	//! NOTE: since the near/far planes only depend on the ray direction sign, these are directly selected per axis,
+	//!       i.e. no per-lane min/max is necessary
+	template <uint32_t lane_count>
+	constexpr uint32_t intersect(const bbox_batch<lane_count>& boxes, const float t_max,
+								 typename bbox_batch<lane_count>::simd_type& t_near) const {
+		using simd_type = typename bbox_batch<lane_count>::simd_type;
+		simd_type t_far = simd::splat<simd_type>(t_max);
+		t_near = simd::splat<simd_type>(0.0f);
+		for (uint32_t c = 0; c < 3; ++c) {
+			const auto t_near_c = (boxes.bounds[sign[c]].comps[c] - origin[c]) * inv_direction[c];
+			const auto t_far_c = (boxes.bounds[1u - sign[c]].comps[c] - origin[c]) * inv_direction[c];
+			t_near = simd::max(t_near, t_near_c);
+			t_far = simd::min(t_far, t_far_c);
+		}
+		return simd::bitmask(t_near <= t_far);
+	}
+	
+	//! intersects this ray with "box", returns true if it is hit within [0, t_max], "t_near" is set to the entry distance
+	constexpr bool intersect(const bboxf& box, const float t_max, float& t_near) const {
+		const bboxf::vector_type bounds[2] { box.min, box.max };
+		float t_far = t_max;
+		t_near = 0.0f;
+		for (uint32_t c = 0; c < 3; ++c) {
+			t_near = std::max(t_near, (bounds[sign[c]][c] - origin[c]) * inv_direction[c]);
+			t_far = std::min(t_far, (bounds[1u - sign[c]][c] - origin[c]) * inv_direction[c]);
+		}
+		return (t_near <= t_far);
+	}
+	
+};
+
+//! packet of "lane_count" rays in structure-of-arrays layout, used to intersect many rays with one box
+template <uint32_t lane_count_ = native_simd_width<float>()>
+class ray_packet {
+public:
+	using batch_type = vector_batch<float3, lane_count_>;
+	using simd_type = typename batch_type::simd_type;
+	static constexpr const uint32_t lane_count { lane_count_ };
+	
+	batch_type origin;
+	batch_type direction;
+	//! 1 / direction
+	batch_type inv_direction;
+	//! bitmask of all lanes that contain an actual ray
+	uint32_t valid_mask { 0u };
+	
+	constexpr ray_packet() noexcept = default;
+	
+	//! creates a packet from the "count" (<= lane_count) rays at "rays" (remaining lanes are set to the last ray)
+	constexpr ray_packet(const ray* rays, const uint32_t count = lane_count) noexcept {
+		assert(count > 0u && count <= lane_count);
+		for (uint32_t i = 0; i < lane_count; ++i) {
+			const auto& r = rays[i < count ? i : count - 1u];
+			origin.set(i, r.origin);
+			direction.set(i, r.direction);
+		}
+		inv_direction = batch_type::broadcast(float3 { 1.0f }) / direction;
+		valid_mask = (count < 32u ? (1u << count) - 1u : ~0u);
+	}
+	
+	//! returns the ray in lane "idx"
+	constexpr ray get(const uint32_t idx) const {
+		return { origin.get(idx), direction.get(idx) };
+	}
+	
+	//! intersects all rays with "box" and returns the bitmask of all valid rays that hit the box within [0, t_max],
+	//! "t_near" is set to the entry distance of each ray (0 if the ray origin is inside the box)
+	//! NOTE: since the direction sign differs per lane, near/far planes are determined with per-lane min/max
+	constexpr uint32_t intersect(const bboxf& box, const simd_type& t_max, simd_type& t_near) const {
+		simd_type t_far = t_max;
+		t_near = simd::splat<simd_type>(0.0f);
+		for (uint32_t c = 0; c < 3; ++c) {
+			const auto t1 = (box.min[c] - origin.comps[c]) * inv_direction.comps[c];
+			const auto t2 = (box.max[c] - origin.comps[c]) * inv_direction.comps[c];
+			t_near = simd::max(t_near, simd::min(t1, t2));
+			t_far = simd::min(t_far, simd::max(t1, t2));
+		}
+		return (simd::bitmask(t_near <= t_far) & valid_mask);
+	}
+	
+	//! intersects all rays with "box" and returns the bitmask of all valid rays that hit the box (at distance >= 0)
+	constexpr uint32_t intersect(const bboxf& box) const {
+		simd_type t_near;
+		return intersect(box, simd::splat<simd_type>(ext::limits<float>::max), t_near);
+	}
+	
+};
+
+} // namespace fl
@@ -0,0 +1,548 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+// NOTE: this is the run-time SIMD counterpart to const_math/rt_math: all functions in here operate on clang vector types
+//       (e.g. "float __attribute__((ext_vector_type(8)))") and only use compiler builtins, i.e. this is usable in
+//       host code as well as in Host-Compute device code
+
+#include <type_traits>
+#include <utility>
+#include <array>
+#include <floor/core/essentials.hpp>
+#include <floor/constexpr/const_math.hpp>
+
+namespace fl {
+
+//! returns the native SIMD width (in elements of "scalar_type") of the host CPU that we're compiling for
+template <typename scalar_type>
+consteval uint32_t native_simd_width() {
+#if defined(__AVX512F__)
+	constexpr const uint32_t simd_bytes { 64u };
+#elif defined(__AVX__)
+	constexpr const uint32_t simd_bytes { 32u };
+#else // SSE, NEON
+	constexpr const uint32_t simd_bytes { 16u };
+#endif
+	return (simd_bytes > uint32_t(sizeof(scalar_type)) ? simd_bytes / uint32_t(sizeof(scalar_type)) : 1u);
+}
+
+//! SIMD vector of "lane_count" scalars (clang vector type)
+template <typename scalar_type, uint32_t lane_count>
+using simd_vector_t = __attribute__((ext_vector_type(lane_count))) scalar_type;
+
+//! accuracy of the SIMD math functions
+enum class simd_math_accuracy : uint32_t {
+	//! targets a max error of 2 ULP, handles the full input range incl. special values
+	precise,
+	//! targets a max error of 3 ULP, but with restrictions on the input range (see the resp. function)
+	fast,
+};
+
+//! SIMD type traits (for internal use only)
+namespace simd_impl {
+	//! scalar type of the SIMD vector type "simd_type"
+	template <typename simd_type>
+	using scalar_t = std::remove_cvref_t<decltype(std::declval<simd_type>()[0])>;
+	
+	//! amount of lanes of the SIMD vector type "simd_type"
+	template <typename simd_type>
+	static constexpr const uint32_t lane_count_v { uint32_t(sizeof(simd_type) / sizeof(scalar_t<simd_type>)) };
+	
+	//! signed integer SIMD vector type with the same lane count and lane size as "simd_type" (-> comparison result type)
+	template <typename simd_type>
+	using int_t = decltype(std::declval<simd_type>() == std::declval<simd_type>());
+	
+	//! true if "simd_type" is a float SIMD vector type that can be used with the SIMD math functions
+	template <typename simd_type>
+	static constexpr const bool is_float_simd_v { std::is_same_v<scalar_t<simd_type>, float> };
+} // namespace simd_impl
+
+//! element-wise SIMD helper functions (falling back to per-lane ops if the compiler doesn't provide an element-wise builtin)
+namespace simd {
+	//! returns a SIMD vector with all lanes set to "val"
+	template <typename simd_type, typename scalar_type>
+	floor_inline_always constexpr simd_type splat(const scalar_type& val) {
+		// NOTE: vector + scalar implicitly splats the scalar
+		return simd_type {} + val;
+	}
+	
+	template <typename simd_type>
+	floor_inline_always constexpr simd_type min(const simd_type& a, const simd_type& b) {
+#if __has_builtin(__builtin_elementwise_min)
+		return __builtin_elementwise_min(a, b);
+#else
+		simd_type ret;
+		for (uint32_t i = 0; i < sizeof(simd_type) / sizeof(a[0]); ++i) {
+			ret[i] = (a[i] < b[i] ? a[i] : b[i]);
+		}
+		return ret;
+#endif
+	}
+	
+	template <typename simd_type>
+	floor_inline_always constexpr simd_type max(const simd_type& a, const simd_type& b) {
+#if __has_builtin(__builtin_elementwise_max)
+		return __builtin_elementwise_max(a, b);
+#else
+		simd_type ret;
+		for (uint32_t i = 0; i < sizeof(simd_type) / sizeof(a[0]); ++i) {
+			ret[i] = (a[i] > b[i] ? a[i] : b[i]);
+		}
+		return ret;
+#endif
+	}
+	
+	template <typename simd_type>
+	floor_inline_always simd_type sqrt(const simd_type& a) {
+#if __has_builtin(__builtin_elementwise_sqrt)
+		return __builtin_elementwise_sqrt(a);
+#else
+		simd_type ret;
+		for (uint32_t i = 0; i < sizeof(simd_type) / sizeof(a[0]); ++i) {
+			ret[i] = math::sqrt(a[i]);
+		}
+		return ret;
+#endif
+	}
+	
+	template <typename simd_type>
+	floor_inline_always simd_type floor(const simd_type& a) {
+#if __has_builtin(__builtin_elementwise_floor)
+		return __builtin_elementwise_floor(a);
+#else
+		simd_type ret;
+		for (uint32_t i = 0; i < sizeof(simd_type) / sizeof(a[0]); ++i) {
+			ret[i] = math::floor(a[i]);
+		}
+		return ret;
+#endif
+	}
+	
+	//! horizontal min of all lanes
+	template <typename simd_type>
+	floor_inline_always constexpr auto reduce_min(const simd_type& a) {
+#if __has_builtin(__builtin_reduce_min)
+		return __builtin_reduce_min(a);
+#else
+		auto ret = a[0];
+		for (uint32_t i = 1; i < sizeof(simd_type) / sizeof(a[0]); ++i) {
+			ret = (a[i] < ret ? a[i] : ret);
+		}
+		return ret;
+#endif
+	}
+	
+	//! horizontal max of all lanes
+	template <typename simd_type>
+	floor_inline_always constexpr auto reduce_max(const simd_type& a) {
+#if __has_builtin(__builtin_reduce_max)
+		return __builtin_reduce_max(a);
+#else
+		auto ret = a[0];
+		for (uint32_t i = 1; i < sizeof(simd_type) / sizeof(a[0]); ++i) {
+			ret = (a[i] > ret ? a[i] : ret);
+		}
+		return ret;
+#endif
+	}
+	
+	//! returns a bitmask of all lanes of the comparison result "mask" that are true (lane #i -> bit #i)
+	template <typename simd_mask_type>
+	floor_inline_always constexpr uint32_t bitmask(const simd_mask_type& mask) {
+		uint32_t bits = 0u;
+		for (uint32_t i = 0; i < sizeof(simd_mask_type) / sizeof(mask[0]); ++i) {
+			bits |= (mask[i] != 0 ? 1u << i : 0u);
+		}
+		return bits;
+	}
+	
+	//! returns "a" for all lanes in which the comparison result "mask" is true, "b" otherwise
+	template <typename simd_type>
+	floor_inline_always constexpr simd_type select(const simd_impl::int_t<simd_type>& mask, const simd_type& a, const simd_type& b) {
+		using int_type = simd_impl::int_t<simd_type>;
+		return __builtin_bit_cast(simd_type, (mask & __builtin_bit_cast(int_type, a)) | (~mask & __builtin_bit_cast(int_type, b)));
+	}
+	
+	//! returns the absolute value of all lanes (by clearing the sign bit)
+	template <typename simd_type> requires (simd_impl::is_float_simd_v<simd_type>)
+	floor_inline_always constexpr simd_type abs(const simd_type& a) {
+		using int_type = simd_impl::int_t<simd_type>;
+		return __builtin_bit_cast(simd_type, __builtin_bit_cast(int_type, a) & 0x7FFF'FFFF);
+	}
+	
+	//! returns the sign bit of all lanes as a comparison result (i.e. also true for -0 and NaNs with a set sign bit)
+	template <typename simd_type> requires (simd_impl::is_float_simd_v<simd_type>)
+	floor_inline_always constexpr simd_impl::int_t<simd_type> signbit(const simd_type& a) {
+		return (__builtin_bit_cast(simd_impl::int_t<simd_type>, a) >> 31);
+	}
+	
+	//! returns 2^n for all lanes, with n in [-126, 127]
+	template <typename simd_type> requires (simd_impl::is_float_simd_v<simd_type>)
+	floor_inline_always constexpr simd_type exp2i(const simd_impl::int_t<simd_type>& n) {
+		return __builtin_bit_cast(simd_type, (n + 127) << 23);
+	}
+	
+	//////////////////////////////////////////
+	// transcendental functions
+	// NOTE: all of these operate on float lanes (e.g. simd_vector_t<float, 4/8/16>), ULP errors are the targeted error bounds
+	//       relative to the correctly rounded result over the full float range (unless specified otherwise),
+	//       the bounds are verified against libm by tests/simd_math_test.cpp
+	
+	//! computes 1 / sqrt(x)
+	//! precise: 2 ULP, computed via sqrt and division
+	//! fast: 3 ULP, initial estimate via integer arithmetic and three Newton-Raphson iterations, x must be positive, normal and finite
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type rsqrt(const simd_type& x) {
+		if constexpr (accuracy == simd_math_accuracy::precise) {
+			return 1.0f / simd::sqrt(x);
+		} else {
+			using int_type = simd_impl::int_t<simd_type>;
+			const auto half_x = x * 0.5f;
+			auto y = __builtin_bit_cast(simd_type, 0x5F37'5A86 - (__builtin_bit_cast(int_type, x) >> 1));
+#pragma unroll
+			for (uint32_t i = 0; i < 3u; ++i) {
+				y = y * (1.5f - half_x * y * y);
+			}
+			return y;
+		}
+	}
+	
+	//! computes e^x
+	//! precise: 1 ULP, correctly handles overflow (-> inf), denormal results and underflow (-> 0)
+	//! fast: 3 ULP, one less polynomial term, otherwise identical
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type exp(const simd_type& x) {
+		using int_type = simd_impl::int_t<simd_type>;
+		// e^x = 2^n * e^r, with n = round(x / ln(2)) and r in [-ln(2) / 2, ln(2) / 2]
+		// NOTE: clamped so that the result is inf or 0 outside of this range (NaN is restored at the end)
+		const auto clamped_x = simd::min(simd::max(x, simd::splat<simd_type>(-104.0f)), simd::splat<simd_type>(89.0f));
+		const auto n = simd::floor(clamped_x * 1.44269504088896341f + 0.5f);
+		// NOTE: ln(2) is split into a high part that can be multiplied exactly with n and a low part
+		auto r = clamped_x - n * 0.693359375f;
+		r = r - n * -2.12194440e-4f;
+		
+		const auto r2 = r * r;
+		simd_type poly;
+		if constexpr (accuracy == simd_math_accuracy::precise) {
+			poly = (((((1.9875691500e-4f * r + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r + 4.1665795894e-2f) * r +
+					 1.6666665459e-1f) * r + 5.0000001201e-1f);
+		} else {
+			poly = ((((1.3888889e-3f * r + 8.3333333e-3f) * r + 4.1666667e-2f) * r + 1.6666667e-1f) * r + 0.5f);
+		}
+		const auto exp_r = poly * r2 + r + 1.0f;
+		
+		// scale by 2^n in two steps, so that n in [-150, 128] can be handled (-> denormals and the largest finite values)
+		const auto ni = __builtin_convertvector(n, int_type);
+		const auto n_lo = (ni >> 1);
+		const auto ret = exp_r * simd::exp2i<simd_type>(n_lo) * simd::exp2i<simd_type>(ni - n_lo);
+		return simd::select(x != x, x, ret);
+	}
+	
+	//! computes the natural logarithm of x
+	//! precise: 1 ULP, correctly handles denormal inputs, returns -inf for 0, inf for inf and NaN for negative inputs
+	//! fast: 1 ULP, but denormal inputs are not supported (-> wrong results)
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type log(const simd_type& x) {
+		using int_type = simd_impl::int_t<simd_type>;
+		// x = m * 2^e, with m in [sqrt(2) / 2, sqrt(2)) -> log(x) = log(m) + e * ln(2)
+		auto scaled_x = x;
+		auto exp_bias = simd::splat<int_type>(126);
+		if constexpr (accuracy == simd_math_accuracy::precise) {
+			// scale denormals into the normal range
+			const auto is_denormal = (x < 1.17549435e-38f);
+			scaled_x = simd::select(is_denormal, x * 8388608.0f, x);
+			exp_bias += (is_denormal & 23);
+		}
+		const auto bits = __builtin_bit_cast(int_type, scaled_x);
+		auto e = ((bits >> 23) & 0xFF) - exp_bias;
+		auto m = __builtin_bit_cast(simd_type, (bits & 0x007F'FFFF) | 0x3F00'0000);
+		const auto is_small_m = (m < 0.707106781186547524f);
+		e += is_small_m; // -1 if true
+		m = simd::select(is_small_m, m + m, m) - 1.0f;
+		const auto fe = __builtin_convertvector(e, simd_type);
+		
+		const auto m2 = m * m;
+		auto y = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m + 1.1676998740e-1f) * m - 1.2420140846e-1f) * m +
+					   1.4249322787e-1f) * m - 1.6668057665e-1f) * m + 2.0000714765e-1f) * m - 2.4999993993e-1f) * m +
+				 3.3333331174e-1f) * m * m2;
+		// NOTE: ln(2) split into a high and low part (same as in exp)
+		y += fe * -2.12194440e-4f;
+		y += -0.5f * m2;
+		auto ret = m + y;
+		ret += fe * 0.693359375f;
+		
+		// special values
+		constexpr const auto inf = __builtin_huge_valf();
+		ret = simd::select(x == inf, x, ret);
+		ret = simd::select((x < 0.0f) | (x != x), simd::splat<simd_type>(__builtin_nanf("")), ret);
+		return simd::select(x == 0.0f, simd::splat<simd_type>(-inf), ret);
+	}
+
+} // namespace simd
+
+namespace simd_impl {
+	//! computes sin(x) (if !is_cos) or cos(x) (if is_cos)
+	template <bool is_cos, simd_math_accuracy accuracy, typename simd_type>
+	floor_inline_always simd_type sin_cos(const simd_type& x) {
+		using int_type = int_t<simd_type>;
+		constexpr const auto lane_count = lane_count_v<simd_type>;
+		
+		// reduce |x| to r in [-pi/4, pi/4] and the quadrant q, with |x| = q * pi/2 + r
+		const auto abs_x = simd::abs(x);
+		simd_type r;
+		int_type quadrant;
+		if constexpr (accuracy == simd_math_accuracy::precise) {
+			// reduction in double precision, with pi/4 split into three parts (the first two can be exactly multiplied
+			// with the octant j < 2^26) -> accurate for |x| <= 2^25
+			using double_type = simd_vector_t<double, lane_count>;
+			const auto abs_x_dbl = __builtin_convertvector(abs_x, double_type);
+			const auto octant = simd::floor(abs_x_dbl * 1.27323954473516268615);
+			// -> round up to an even octant
+			const auto j = simd::floor((octant + 1.0) * 0.5) * 2.0;
+			const auto r_dbl = (((abs_x_dbl - j * 7.85398155450820922852e-01) - j * 7.94662735614792836714e-09) -
+								j * 3.06161699786838294307e-17);
+			r = __builtin_convertvector(r_dbl, simd_type);
+			quadrant = __builtin_convertvector(simd::min(j, simd::splat<double_type>(67108864.0)) * 0.5, int_type);
+		} else {
+			// reduction in single precision with pi/4 split into three parts -> absolute error < 1e-7 for |x| <= 8192,
+			// but close to the roots of sin/cos the relative error grows with |x|
+			auto j = __builtin_convertvector(abs_x * 1.27323954473516f, int_type);
+			j = (j + 1) & ~1;
+			const auto fj = __builtin_convertvector(j, simd_type);
+			r = ((abs_x - fj * 0.78515625f) - fj * 2.4187564849853515625e-4f) - fj * 3.77489497744594108e-8f;
+			quadrant = (j >> 1);
+		}
+		
+		// sin(x) = (sin(r), cos(r), -sin(r), -cos(r))[q]
+		// cos(x) = (cos(r), -sin(r), -cos(r), sin(r))[q]
+		const auto r2 = r * r;
+		const auto sin_r = ((-1.9515295891e-4f * r2 + 8.3321608736e-3f) * r2 - 1.6666654611e-1f) * r2 * r + r;
+		const auto cos_r = ((2.443315711809948e-5f * r2 - 1.388731625493765e-3f) * r2 + 4.166664568298827e-2f) * r2 * r2 -
+							0.5f * r2 + 1.0f;
+		const auto use_cos_poly = ((quadrant & 1) != 0);
+		int_type sign_mask;
+		simd_type ret;
+		if constexpr (!is_cos) {
+			ret = simd::select(use_cos_poly, cos_r, sin_r);
+			sign_mask = ((quadrant << 30) ^ __builtin_bit_cast(int_type, x)) & int(0x8000'0000u);
+		} else {
+			ret = simd::select(use_cos_poly, sin_r, cos_r);
+			sign_mask = ((quadrant + 1) << 30) & int(0x8000'0000u);
+		}
+		ret = __builtin_bit_cast(simd_type, __builtin_bit_cast(int_type, ret) ^ sign_mask);
+		
+		if constexpr (accuracy == simd_math_accuracy::precise) {
+			// rare: compute huge inputs (incl. inf and NaN) with the scalar double precision function
+			if (const auto huge_mask = simd::bitmask(~(abs_x <= 33554432.0f)); huge_mask != 0u) [[unlikely]] {
+				for (uint32_t i = 0; i < lane_count; ++i) {
+					if ((huge_mask & (1u << i)) != 0u) {
+						ret[i] = float(is_cos ? math::cos(double(x[i])) : math::sin(double(x[i])));
+					}
+				}
+			}
+		}
+		return ret;
+	}
+	
+	//! computes log(x) for float x in (0, inf) in double precision:
+	//! x = m * 2^e, with m in [sqrt(2) / 2, sqrt(2)) -> log(x) = log(m) + e * ln(2), with log(m) = 2 * atanh((m - 1) / (m + 1))
+	//! NOTE: the decomposition is done on the float input, so that only 32-bit integer ops are necessary
+	//!       (64-bit integer <-> double conversions are not natively supported pre-AVX-512)
+	template <uint32_t term_count, typename simd_type>
+	floor_inline_always auto log_dbl(const simd_type& x) {
+		using int_type = int_t<simd_type>;
+		using double_type = simd_vector_t<double, lane_count_v<simd_type>>;
+		// scale denormals into the normal range
+		const auto is_denormal = (x < 1.17549435e-38f);
+		const auto bits = __builtin_bit_cast(int_type, simd::select(is_denormal, x * 8388608.0f, x));
+		auto e = ((bits >> 23) & 0xFF) - 127 - (is_denormal & 23);
+		auto m = __builtin_bit_cast(simd_type, (bits & 0x007F'FFFF) | 0x3F80'0000);
+		const auto is_large_m = (m > 1.41421356237309504880f);
+		e -= is_large_m; // +1 if true
+		m = simd::select(is_large_m, m * 0.5f, m);
+		const auto m_dbl = __builtin_convertvector(m, double_type);
+		
+		const auto s = (m_dbl - 1.0) / (m_dbl + 1.0);
+		const auto s2 = s * s;
+		// atanh(s) = s + s^3 / 3 + s^5 / 5 + ...
+		constexpr const auto coeffs = []() consteval {
+			std::array<double, term_count> ret {};
+			for (uint32_t i = 0; i < term_count; ++i) {
+				ret[i] = 1.0 / double(i * 2u + 1u);
+			}
+			return ret;
+		}();
+		auto series = simd::splat<double_type>(coeffs[term_count - 1u]);
+#pragma unroll
+		for (uint32_t i = term_count - 1u; i > 0u; --i) {
+			series = series * s2 + coeffs[i - 1u];
+		}
+		return __builtin_convertvector(e, double_type) * 0.693147180559945309417 + 2.0 * s * series;
+	}
+	
+	//! computes e^x for x in [-110, 90] in double precision
+	template <uint32_t term_count, typename double_type>
+	floor_inline_always double_type exp_dbl(const double_type& x) {
+		using int_type = int_t<double_type>;
+		// e^x = 2^n * e^r, with n = round(x / ln(2)) and r in [-ln(2) / 2, ln(2) / 2]
+		const auto n = simd::floor(x * 1.44269504088896340736 + 0.5);
+		const auto r = (x - n * 6.93147180369123816490e-01) - n * 1.90821492927058770002e-10;
+		// Taylor series: 1 + r + r^2 / 2! + r^3 / 3! + ...
+		constexpr const auto coeffs = []() consteval {
+			std::array<double, term_count + 1u> ret {};
+			double fac = 1.0;
+			for (uint32_t i = 0; i <= term_count; ++i) {
+				fac *= (i > 0u ? double(i) : 1.0);
+				ret[i] = 1.0 / fac;
+			}
+			return ret;
+		}();
+		auto series = simd::splat<double_type>(coeffs[term_count]);
+#pragma unroll
+		for (uint32_t i = term_count; i > 0u; --i) {
+			series = series * r + coeffs[i - 1u];
+		}
+		// NOTE: adding 1.5 * 2^52 puts the integer n into the low mantissa bits, which avoids a double -> int64 conversion
+		return series * __builtin_bit_cast(double_type, (__builtin_bit_cast(int_type, n + 6755399441055744.0) + 1023) << 52);
+	}
+	
+	//! computes atan2(|y|, x) in [0, pi] from |y|, |x| and the sign of x, with the lanes being either float or double
+	//! NOTE: NaN inputs are not handled here
+	template <typename fp_simd_type>
+	floor_inline_always fp_simd_type atan2_abs(const fp_simd_type& abs_y, const fp_simd_type& abs_x, const int_t<fp_simd_type>& neg_x) {
+		using fp_type = scalar_t<fp_simd_type>;
+		constexpr const bool is_double { std::is_same_v<fp_type, double> };
+		constexpr const auto inf = fp_type(__builtin_huge_valf());
+		// pi/4, pi/2 and pi are split into a high and low part for float, so that additions/subtractions don't lose accuracy
+		constexpr const auto pi_4_hi = (is_double ? fp_type(0.785398163397448309616) : fp_type(0.785398185253143310546875));
+		constexpr const auto pi_4_lo = (is_double ? fp_type(0.0) : fp_type(-2.185569414336861e-8));
+		constexpr const auto pi_2_hi = (is_double ? fp_type(1.57079632679489661923) : fp_type(1.57079637050628662109375));
+		constexpr const auto pi_2_lo = (is_double ? fp_type(0.0) : fp_type(-4.371138828673793e-8));
+		constexpr const auto pi_hi = (is_double ? fp_type(3.14159265358979323846) : fp_type(3.1415927410125732421875));
+		constexpr const auto pi_lo = (is_double ? fp_type(0.0) : fp_type(-8.742277657347586e-8));
+		
+		// reduce to atan(a) with a = min(|x|, |y|) / max(|x|, |y|) in [0, 1]
+		const auto max_xy = simd::max(abs_x, abs_y);
+		auto a = simd::min(abs_x, abs_y) / max_xy;
+		a = simd::select(max_xy == fp_type(0.0), simd::splat<fp_simd_type>(fp_type(0.0)), a);
+		a = simd::select((abs_x == inf) & (abs_y == inf), simd::splat<fp_simd_type>(fp_type(1.0)), a);
+		
+		// further reduce to [0, tan(pi/8)] via atan(a) = pi/4 + atan((a - 1) / (a + 1))
+		const auto is_large_a = (a > fp_type(0.414213562373095));
+		a = simd::select(is_large_a, (a - fp_type(1.0)) / (a + fp_type(1.0)), a);
+		const auto a2 = a * a;
+		auto ret = ((((fp_type(8.05374449538e-2) * a2 - fp_type(1.38776856032e-1)) * a2 + fp_type(1.99777106478e-1)) * a2 -
+					 fp_type(3.33329491539e-1)) * a2 * a + a);
+		ret += simd::select(is_large_a, simd::splat<fp_simd_type>(pi_4_hi), simd::splat<fp_simd_type>(fp_type(0.0)));
+		ret += simd::select(is_large_a, simd::splat<fp_simd_type>(pi_4_lo), simd::splat<fp_simd_type>(fp_type(0.0)));
+		
+		// undo the reduction: octant (|y| > |x|) and quadrant (x < 0)
+		ret = simd::select(abs_y > abs_x, (pi_2_hi - ret) + pi_2_lo, ret);
+		return simd::select(neg_x, (pi_hi - ret) + pi_lo, ret);
+	}
+
+} // namespace simd_impl
+
+namespace simd {
+	//! computes sin(x)
+	//! precise: 2 ULP, lanes with |x| > 2^25 (rare) are computed with the scalar math::sin
+	//! fast: 2 ULP for |x| <= 32, absolute error < 1e-7 for |x| <= 8192, inf/NaN inputs return undefined values
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type sin(const simd_type& x) {
+		return simd_impl::sin_cos<false, accuracy>(x);
+	}
+	
+	//! computes cos(x)
+	//! precise: 2 ULP, lanes with |x| > 2^25 (rare) are computed with the scalar math::cos
+	//! fast: 2 ULP for |x| <= 32, absolute error < 1e-7 for |x| <= 8192, inf/NaN inputs return undefined values
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type cos(const simd_type& x) {
+		return simd_impl::sin_cos<true, accuracy>(x);
+	}
+	
+	//! computes atan2(y, x), i.e. the angle of the point (x, y) in [-pi, pi], incl. correct handling of zeros, inf and NaN
+	//! precise: 1 ULP, computed in double precision
+	//! fast: 3 ULP
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type atan2(const simd_type& y, const simd_type& x) {
+		using int_type = simd_impl::int_t<simd_type>;
+		const auto abs_x = simd::abs(x);
+		const auto abs_y = simd::abs(y);
+		simd_type ret;
+		if constexpr (accuracy == simd_math_accuracy::precise) {
+			using double_type = simd_vector_t<double, simd_impl::lane_count_v<simd_type>>;
+			using double_int_type = simd_impl::int_t<double_type>;
+			ret = __builtin_convertvector(simd_impl::atan2_abs<double_type>(__builtin_convertvector(abs_y, double_type),
+																			__builtin_convertvector(abs_x, double_type),
+																			__builtin_convertvector(simd::signbit(x), double_int_type)),
+										  simd_type);
+		} else {
+			ret = simd_impl::atan2_abs<simd_type>(abs_y, abs_x, simd::signbit(x));
+		}
+		// sign of y
+		ret = __builtin_bit_cast(simd_type, __builtin_bit_cast(int_type, ret) | (__builtin_bit_cast(int_type, y) & int(0x8000'0000u)));
+		return simd::select((x != x) | (y != y), x + y, ret);
+	}
+	
+	//! computes x^y
+	//! precise: 1 ULP, computed as e^(y * log(x)) in double precision, handles all special values like std::pow
+	//! fast: 3 ULP, same as precise, but with fewer series terms
+	template <simd_math_accuracy accuracy = simd_math_accuracy::precise, typename simd_type>
+	requires (simd_impl::is_float_simd_v<simd_type>)
+	simd_type pow(const simd_type& x, const simd_type& y) {
+		using int_type = simd_impl::int_t<simd_type>;
+		using double_type = simd_vector_t<double, simd_impl::lane_count_v<simd_type>>;
+		constexpr const auto inf = __builtin_huge_valf();
+		constexpr const uint32_t log_terms = (accuracy == simd_math_accuracy::precise ? 7u : 5u);
+		constexpr const uint32_t exp_terms = (accuracy == simd_math_accuracy::precise ? 9u : 7u);
+		
+		// |x|^y = e^(y * log(|x|))
+		const auto abs_x = simd::abs(x);
+		auto log_x = simd_impl::log_dbl<log_terms>(abs_x);
+		using double_int_type = simd_impl::int_t<double_type>;
+		log_x = simd::select(__builtin_convertvector(abs_x == 0.0f, double_int_type), simd::splat<double_type>(-double(inf)), log_x);
+		log_x = simd::select(__builtin_convertvector(abs_x == inf, double_int_type), simd::splat<double_type>(double(inf)), log_x);
+		// NOTE: clamped so that the result is inf or 0 outside of this range (NaN is handled below)
+		const auto exponent = simd::min(simd::max(__builtin_convertvector(y, double_type) * log_x, simd::splat<double_type>(-110.0)),
+										simd::splat<double_type>(90.0));
+		auto ret = __builtin_convertvector(simd_impl::exp_dbl<exp_terms>(exponent), simd_type);
+		
+		// negative x: odd integer y -> negate, non-integer y -> NaN (except for -inf)
+		const auto abs_y = simd::abs(y);
+		const auto is_int_y = (simd::floor(y) == y);
+		// NOTE: all floats >= 2^24 are even integers
+		const auto int_y = __builtin_convertvector(simd::select(abs_y < 16777216.0f, y, simd::splat<simd_type>(0.0f)), int_type);
+		const auto is_odd_y = ((int_y & 1) != 0);
+		ret = simd::select(simd::signbit(x) & is_odd_y, -ret, ret);
+		ret = simd::select((x < 0.0f) & ~is_int_y & (x != -inf), simd::splat<simd_type>(__builtin_nanf("")), ret);
+		// NaN propagation, except for pow(1, y) = 1, pow(x, 0) = 1 and pow(-1, +/-inf) = 1
+		ret = simd::select((x != x) | (y != y), x + y, ret);
+		return simd::select((x == 1.0f) | (y == 0.0f) | ((x == -1.0f) & (abs_y == inf)), simd::splat<simd_type>(1.0f), ret);
+	}
+
+} // namespace simd
+
+} // namespace fl
@@ -2269,14 +2269,59 @@ public:
 	// misc math
 #pragma mark misc math
 	
+#if !defined(FLOOR_DEVICE) || defined(FLOOR_DEVICE_HOST_COMPUTE)
+	//! returns true if component-wise math functions are computed with the SIMD math functions (-> simd_math.hpp) at run-time,
+	//! which is the case for float vectors with at least "min_width" components unless FLOOR_NO_VEC_SIMD_MATH is defined
+	//! NOTE: all vector widths are computed as a float4 SIMD vector, so for functions where the scalar version is relatively
+	//!       cheap, the SIMD version is only faster if all lanes are actually used
+	template <uint32_t min_width>
+	static constexpr bool use_simd_math() {
+#if !defined(FLOOR_NO_VEC_SIMD_MATH)
+		return (std::is_same_v<decayed_scalar_type, float> && FLOOR_VECTOR_WIDTH >= min_width);
+#else
+		return false;
+#endif
+	}
+	
+	//! returns this vector as a float4 SIMD vector for use with the SIMD math functions,
+	//! unused lanes are set to 1 (-> valid input for all SIMD math functions)
+	simd_vector_t<float, 4> to_simd_math() const {
+#if FLOOR_VECTOR_WIDTH == 1
+		return { float(x), 1.0f, 1.0f, 1.0f };
+#elif FLOOR_VECTOR_WIDTH == 2
+		return { float(x), float(y), 1.0f, 1.0f };
+#elif FLOOR_VECTOR_WIDTH == 3
+		return { float(x), float(y), float(z), 1.0f };
+#else
+		return { float(x), float(y), float(z), float(w) };
+#endif
+	}
+	
+	//! creates a vector from the first FLOOR_VECTOR_WIDTH lanes of the float4 SIMD vector "vec"
+	static vector_type from_simd_math(const simd_vector_t<float, 4>& vec) {
+		return {
+			scalar_type(vec[0])
+#if FLOOR_VECTOR_WIDTH >= 2
+			, scalar_type(vec[1])
+#endif
+#if FLOOR_VECTOR_WIDTH >= 3
+			, scalar_type(vec[2])
+#endif
+#if FLOOR_VECTOR_WIDTH >= 4
+			, scalar_type(vec[3])
+#endif
+		};
+	}
+#endif
+	
 	//! applies the sqrt function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::sqrt, sqrt, sqrted)
 	//! applies the rsqrt function on all components
-	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::rsqrt, rsqrt, rsqrted)
+	FLOOR_VEC_SIMD_MATH_FUNC(2, (simd::rsqrt(to_simd_math())), vector_helper<decayed_scalar_type>::rsqrt, rsqrt, rsqrted)
 	//! applies the sin function on all components
-	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::sin, sin, sined)
+	FLOOR_VEC_SIMD_MATH_FUNC(2, (simd::sin(to_simd_math())), vector_helper<decayed_scalar_type>::sin, sin, sined)
 	//! applies the cos function on all components
-	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::cos, cos, cosed)
+	FLOOR_VEC_SIMD_MATH_FUNC(2, (simd::cos(to_simd_math())), vector_helper<decayed_scalar_type>::cos, cos, cosed)
 	//! applies the tan function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::tan, tan, taned)
 	//! applies the asin function on all components
@@ -2286,13 +2331,15 @@ public:
 	//! applies the atan function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::atan, atan, ataned)
 	//! applies the atan2 function on all components (scalar x)
-	FLOOR_VEC_FUNC_ARGS(vector_helper<decayed_scalar_type>::atan2, atan2, atan2ed,
-						(const scalar_type& rhs),
-						rhs)
+	FLOOR_VEC_SIMD_MATH_FUNC_ARGS(2, (simd::atan2(to_simd_math(), simd::splat<simd_vector_t<float, 4>>(float(rhs)))),
+								  vector_helper<decayed_scalar_type>::atan2, atan2, atan2ed,
+								  (const scalar_type& rhs),
+								  rhs)
 	//! applies the atan2 function on all components (vector x)
-	FLOOR_VEC_FUNC_ARGS_VEC(vector_helper<decayed_scalar_type>::atan2, atan2, atan2ed,
-							(const vector_type& rhs),
-							rhs.)
+	FLOOR_VEC_SIMD_MATH_FUNC_ARGS_VEC(2, (simd::atan2(to_simd_math(), rhs.to_simd_math())),
+									  vector_helper<decayed_scalar_type>::atan2, atan2, atan2ed,
+									  (const vector_type& rhs),
+									  rhs.)
 	//! applies the sinh function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::sinh, sinh, sinhed)
 	//! applies the cosh function on all components
@@ -2306,11 +2353,11 @@ public:
 	//! applies the atanh function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::atanh, atanh, atanhed)
 	//! applies the exp function on all components
-	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::exp, exp, exped)
+	FLOOR_VEC_SIMD_MATH_FUNC(4, (simd::exp(to_simd_math())), vector_helper<decayed_scalar_type>::exp, exp, exped)
 	//! applies the exp2 function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::exp2, exp2, exp2ed)
 	//! applies the log function on all components
-	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::log, log, loged)
+	FLOOR_VEC_SIMD_MATH_FUNC(4, (simd::log(to_simd_math())), vector_helper<decayed_scalar_type>::log, log, loged)
 	//! applies the log2 function on all components
 	FLOOR_VEC_FUNC(vector_helper<decayed_scalar_type>::log2, log2, log2ed)
 	//! applies the pow function on all components (scalar exponent)
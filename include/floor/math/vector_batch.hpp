@@ -0,0 +1,473 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/math/vector_lib.hpp>
+#include <floor/math/simd_math.hpp>
+#include <floor/math/matrix4.hpp>
+#include <floor/math/quaternion.hpp>
+#include <floor/math/bbox.hpp>
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <span>
+#include <bit>
+#include <cmath>
+#include <cassert>
+
+namespace fl {
+
+//! structure-of-arrays batch of "lane_count" vectors:
+//! each vector component is stored in its own SIMD vector, i.e. all ops process "lane_count" vectors at once
+template <typename vec_type, uint32_t lane_count_ = native_simd_width<typename vec_type::decayed_scalar_type>()>
+requires (is_floor_vector_v<vec_type> && std::is_floating_point_v<typename vec_type::decayed_scalar_type> &&
+		  std::has_single_bit(lane_count_))
+class vector_batch {
+public:
+	using vector_type = vec_type;
+	using scalar_type = typename vector_type::decayed_scalar_type;
+	//! SIMD type of a single component
+	using simd_type = simd_vector_t<scalar_type, lane_count_>;
+	
+	//! vector dimensionality
+	static constexpr const uint32_t dim { vector_type::dim() };
+	//! amount of vectors in this batch
+	static constexpr const uint32_t lane_count { lane_count_ };
+	
+	//! all components: [0] = all x, [1] = all y, ...
+	std::array<simd_type, dim> comps {};
+	
+	constexpr vector_batch() noexcept = default;
+	constexpr vector_batch(const std::array<simd_type, dim>& comps_) noexcept : comps(comps_) {}
+	
+	//! returns a batch with all lanes set to "vec"
+	static constexpr vector_batch broadcast(const vector_type& vec) {
+		vector_batch ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret.comps[c] = simd::splat<simd_type>(vec[c]);
+		}
+		return ret;
+	}
+	
+	//! gathers the "count" (<= lane_count) AoS vectors at "vecs" into a batch
+	//! NOTE: if count < lane_count, the remaining lanes are set to the last vector,
+	//!       so that horizontal min/max ops (-> bounds) are not affected by these
+	static constexpr vector_batch load(const vector_type* vecs, const uint32_t count = lane_count) {
+		assert(count > 0u && count <= lane_count);
+		vector_batch ret;
+		for (uint32_t i = 0; i < lane_count; ++i) {
+			const auto& vec = vecs[i < count ? i : count - 1u];
+			for (uint32_t c = 0; c < dim; ++c) {
+				ret.comps[c][i] = vec[c];
+			}
+		}
+		return ret;
+	}
+	
+	//! scatters the first "count" (<= lane_count) vectors of this batch to the AoS vectors at "vecs"
+	constexpr void store(vector_type* vecs, const uint32_t count = lane_count) const {
+		assert(count <= lane_count);
+		for (uint32_t i = 0; i < count; ++i) {
+			for (uint32_t c = 0; c < dim; ++c) {
+				vecs[i][c] = comps[c][i];
+			}
+		}
+	}
+	
+	//! returns the vector in lane "idx"
+	constexpr vector_type get(const uint32_t idx) const {
+		vector_type ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret[c] = comps[c][idx];
+		}
+		return ret;
+	}
+	
+	//! sets the vector in lane "idx"
+	constexpr void set(const uint32_t idx, const vector_type& vec) {
+		for (uint32_t c = 0; c < dim; ++c) {
+			comps[c][idx] = vec[c];
+		}
+	}
+	
+	constexpr const simd_type& x() const {
+		return comps[0];
+	}
+	constexpr const simd_type& y() const requires (dim >= 2) {
+		return comps[1];
+	}
+	constexpr const simd_type& z() const requires (dim >= 3) {
+		return comps[2];
+	}
+	constexpr const simd_type& w() const requires (dim >= 4) {
+		return comps[3];
+	}
+	
+	//////////////////////////////////////////
+	// basic ops
+#pragma mark basic ops
+
+#define FLOOR_VECTOR_BATCH_OP(op) \
+	constexpr vector_batch operator op(const vector_batch& batch) const { \
+		vector_batch ret; \
+		for (uint32_t c = 0; c < dim; ++c) { \
+			ret.comps[c] = comps[c] op batch.comps[c]; \
+		} \
+		return ret; \
+	} \
+	constexpr vector_batch operator op(const simd_type& val) const { \
+		vector_batch ret; \
+		for (uint32_t c = 0; c < dim; ++c) { \
+			ret.comps[c] = comps[c] op val; \
+		} \
+		return ret; \
+	} \
+	constexpr vector_batch operator op(const scalar_type& val) const { \
+		vector_batch ret; \
+		for (uint32_t c = 0; c < dim; ++c) { \
+			ret.comps[c] = comps[c] op val; \
+		} \
+		return ret; \
+	} \
+	constexpr vector_batch& operator op##=(const vector_batch& batch) { \
+		*this = *this op batch; \
+		return *this; \
+	}
+	
+	FLOOR_VECTOR_BATCH_OP(+)
+	FLOOR_VECTOR_BATCH_OP(-)
+	FLOOR_VECTOR_BATCH_OP(*)
+	FLOOR_VECTOR_BATCH_OP(/)
+#undef FLOOR_VECTOR_BATCH_OP
+	
+	constexpr vector_batch operator-() const {
+		vector_batch ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret.comps[c] = -comps[c];
+		}
+		return ret;
+	}
+	
+	//! component-wise min of this batch and "batch"
+	constexpr vector_batch minned(const vector_batch& batch) const {
+		vector_batch ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret.comps[c] = simd::min(comps[c], batch.comps[c]);
+		}
+		return ret;
+	}
+	
+	//! component-wise max of this batch and "batch"
+	constexpr vector_batch maxed(const vector_batch& batch) const {
+		vector_batch ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret.comps[c] = simd::max(comps[c], batch.comps[c]);
+		}
+		return ret;
+	}
+	
+	//! returns the component-wise min of all vectors in this batch
+	constexpr vector_type reduce_min() const {
+		vector_type ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret[c] = simd::reduce_min(comps[c]);
+		}
+		return ret;
+	}
+	
+	//! returns the component-wise max of all vectors in this batch
+	constexpr vector_type reduce_max() const {
+		vector_type ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret[c] = simd::reduce_max(comps[c]);
+		}
+		return ret;
+	}
+	
+	//////////////////////////////////////////
+	// geometric ops
+#pragma mark geometric ops
+	
+	//! per-lane dot product of this batch and "batch"
+	constexpr simd_type dot(const vector_batch& batch) const {
+		simd_type ret = comps[0] * batch.comps[0];
+		for (uint32_t c = 1; c < dim; ++c) {
+			ret += comps[c] * batch.comps[c];
+		}
+		return ret;
+	}
+	
+	//! per-lane dot product of this batch with itself
+	constexpr simd_type dot() const {
+		return dot(*this);
+	}
+	
+	//! per-lane length
+	simd_type length() const {
+		return simd::sqrt(dot());
+	}
+	
+	//! per-lane cross product of this batch and "batch"
+	constexpr vector_batch crossed(const vector_batch& batch) const requires (dim == 3) {
+		return std::array<simd_type, 3> {
+			comps[1] * batch.comps[2] - comps[2] * batch.comps[1],
+			comps[2] * batch.comps[0] - comps[0] * batch.comps[2],
+			comps[0] * batch.comps[1] - comps[1] * batch.comps[0],
+		};
+	}
+	
+	//! returns all vectors of this batch normalized
+	vector_batch normalized() const {
+		return *this * (scalar_type(1) / length());
+	}
+	
+	//! normalizes all vectors of this batch
+	vector_batch& normalize() {
+		*this = normalized();
+		return *this;
+	}
+	
+	//! M * v for all vectors of this batch, with the same semantics as vector * matrix4:
+	//! vector3 is treated as a point (implicit .w = 1), vector4 performs a full 4x4 multiplication
+	constexpr vector_batch transformed(const matrix4<scalar_type>& mat) const requires (dim == 3 || dim == 4) {
+		const auto& m = mat.data;
+		vector_batch ret;
+		for (uint32_t r = 0; r < dim; ++r) {
+			if constexpr (dim == 3) {
+				ret.comps[r] = comps[0] * m[r] + comps[1] * m[4 + r] + comps[2] * m[8 + r] + m[12 + r];
+			} else {
+				ret.comps[r] = comps[0] * m[r] + comps[1] * m[4 + r] + comps[2] * m[8 + r] + comps[3] * m[12 + r];
+			}
+		}
+		return ret;
+	}
+	
+	//! transforms all vectors of this batch by "mat" (-> transformed())
+	constexpr vector_batch& transform(const matrix4<scalar_type>& mat) requires (dim == 3 || dim == 4) {
+		*this = transformed(mat);
+		return *this;
+	}
+	
+	//! rotates all vectors of this batch according to the unit quaternion "q" (same as quaternion::rotate_vector)
+	constexpr vector_batch rotated(const quaternion<scalar_type>& q) const requires (dim == 3) {
+		const auto qv = broadcast(q.to_vector3());
+		const auto qv_dot = qv.dot(*this);
+		const auto vec_scale = scalar_type(2) * q.r * q.r - scalar_type(1);
+		return (qv * qv_dot + qv.crossed(*this) * q.r) * scalar_type(2) + *this * vec_scale;
+	}
+	
+	//! rotates all vectors of this batch according to the unit quaternion "q"
+	constexpr vector_batch& rotate(const quaternion<scalar_type>& q) requires (dim == 3) {
+		*this = rotated(q);
+		return *this;
+	}
+	
+	//! returns the bounding box of all vectors in this batch
+	constexpr bbox<vector_type> bounds() const requires (dim == 3) {
+		return { reduce_min(), reduce_max() };
+	}
+	
+};
+
+//! extends "box" by all vectors in "batch"
+template <typename vec_type, uint32_t lane_count>
+constexpr bbox<vec_type>& extend(bbox<vec_type>& box, const vector_batch<vec_type, lane_count>& batch) {
+	return box.extend(batch.bounds());
+}
+
+//! extends "box" by all bounding boxes in the batches "mins" and "maxs" (bbox merge)
+template <typename vec_type, uint32_t lane_count>
+constexpr bbox<vec_type>& extend(bbox<vec_type>& box, const vector_batch<vec_type, lane_count>& mins,
+								 const vector_batch<vec_type, lane_count>& maxs) {
+	return box.extend(bbox<vec_type> { mins.reduce_min(), maxs.reduce_max() });
+}
+
+//! dynamically sized structure-of-arrays storage of vectors:
+//! each vector component is stored in its own contiguous array, which is padded to a multiple of the batch lane count,
+//! bulk ops are performed batch-wise (-> vector_batch)
+template <typename vec_type, uint32_t lane_count_ = native_simd_width<typename vec_type::decayed_scalar_type>()>
+class soa_array {
+public:
+	using batch_type = vector_batch<vec_type, lane_count_>;
+	using vector_type = vec_type;
+	using scalar_type = typename batch_type::scalar_type;
+	using simd_type = typename batch_type::simd_type;
+	static constexpr const uint32_t dim { batch_type::dim };
+	static constexpr const uint32_t lane_count { lane_count_ };
+	
+	soa_array() = default;
+	explicit soa_array(const size_t size_) {
+		resize(size_);
+	}
+	//! creates the SoA representation of the specified AoS vectors
+	explicit soa_array(std::span<const vector_type> vecs) {
+		from_aos(vecs);
+	}
+	
+	//! returns the amount of vectors in this array
+	size_t size() const {
+		return count;
+	}
+	
+	//! returns true if this array is empty
+	bool empty() const {
+		return (count == 0u);
+	}
+	
+	//! returns the amount of batches that are needed to process all vectors
+	size_t batch_count() const {
+		return (count + lane_count - 1u) / lane_count;
+	}
+	
+	//! resizes this array to "size_" vectors (new vectors are zero-initialized)
+	void resize(const size_t size_) {
+		const auto prev_count = count;
+		count = size_;
+		for (auto& comp : comps) {
+			// padding lanes that become part of the array may contain anything (bulk ops also process these) -> zero them
+			const auto prev_padded_size = comp.size();
+			if (count > prev_count) {
+				std::fill(comp.begin() + ptrdiff_t(prev_count), comp.begin() + ptrdiff_t(std::min(count, prev_padded_size)), scalar_type(0));
+			}
+			comp.resize(batch_count() * lane_count, scalar_type(0));
+		}
+	}
+	
+	//! returns the contiguous array of component "c"
+	std::span<scalar_type> component(const uint32_t c) {
+		return { comps[c].data(), count };
+	}
+	std::span<const scalar_type> component(const uint32_t c) const {
+		return { comps[c].data(), count };
+	}
+	
+	//! AoS -> SoA: sets this array to the specified vectors
+	void from_aos(std::span<const vector_type> vecs) {
+		resize(vecs.size());
+		for (size_t i = 0; i < count; ++i) {
+			for (uint32_t c = 0; c < dim; ++c) {
+				comps[c][i] = vecs[i][c];
+			}
+		}
+	}
+	
+	//! SoA -> AoS: writes all vectors of this array to "vecs" (must have the same size as this array)
+	void to_aos(std::span<vector_type> vecs) const {
+		assert(vecs.size() == count);
+		for (size_t i = 0; i < count; ++i) {
+			for (uint32_t c = 0; c < dim; ++c) {
+				vecs[i][c] = comps[c][i];
+			}
+		}
+	}
+	
+	//! SoA -> AoS: returns all vectors of this array
+	std::vector<vector_type> to_aos() const {
+		std::vector<vector_type> vecs(count);
+		to_aos(vecs);
+		return vecs;
+	}
+	
+	//! returns the vector at "idx"
+	vector_type get(const size_t idx) const {
+		vector_type ret;
+		for (uint32_t c = 0; c < dim; ++c) {
+			ret[c] = comps[c][idx];
+		}
+		return ret;
+	}
+	
+	//! sets the vector at "idx"
+	void set(const size_t idx, const vector_type& vec) {
+		for (uint32_t c = 0; c < dim; ++c) {
+			comps[c][idx] = vec[c];
+		}
+	}
+	
+	//! loads the batch at "batch_idx" (vectors [batch_idx * lane_count, (batch_idx + 1) * lane_count))
+	//! NOTE: lanes beyond size() contain padding
+	batch_type load_batch(const size_t batch_idx) const {
+		batch_type batch;
+		for (uint32_t c = 0; c < dim; ++c) {
+			__builtin_memcpy(&batch.comps[c], comps[c].data() + batch_idx * lane_count, sizeof(simd_type));
+		}
+		return batch;
+	}
+	
+	//! stores "batch" to the batch at "batch_idx"
+	void store_batch(const size_t batch_idx, const batch_type& batch) {
+		for (uint32_t c = 0; c < dim; ++c) {
+			__builtin_memcpy(comps[c].data() + batch_idx * lane_count, &batch.comps[c], sizeof(simd_type));
+		}
+	}
+	
+	//! calls "func(batch_type&)" for all batches and stores the modified batches again
+	template <typename F>
+	void for_each_batch(F&& func) {
+		for (size_t batch_idx = 0, batches = batch_count(); batch_idx < batches; ++batch_idx) {
+			auto batch = load_batch(batch_idx);
+			func(batch);
+			store_batch(batch_idx, batch);
+		}
+	}
+	
+	//! transforms all vectors by "mat" (-> vector_batch::transformed())
+	void transform(const matrix4<scalar_type>& mat) requires (dim == 3 || dim == 4) {
+		for_each_batch([&mat](batch_type& batch) {
+			batch.transform(mat);
+		});
+	}
+	
+	//! rotates all vectors according to the unit quaternion "q"
+	void rotate(const quaternion<scalar_type>& q) requires (dim == 3) {
+		for_each_batch([&q](batch_type& batch) {
+			batch.rotate(q);
+		});
+	}
+	
+	//! normalizes all vectors
+	//! NOTE: padding lanes may contain inf/nan afterwards, which is fine since these are never read as vectors
+	//!       (and are zeroed by resize() if they become part of the array)
+	void normalize() {
+		for_each_batch([](batch_type& batch) {
+			batch.normalize();
+		});
+	}
+	
+	//! returns the bounding box of all vectors
+	bbox<vector_type> bounds() const requires (dim == 3) {
+		bbox<vector_type> box;
+		const auto full_batches = count / lane_count;
+		for (size_t batch_idx = 0; batch_idx < full_batches; ++batch_idx) {
+			extend(box, load_batch(batch_idx));
+		}
+		// remaining vectors (don't include padding)
+		for (size_t i = full_batches * lane_count; i < count; ++i) {
+			box.extend(get(i));
+		}
+		return box;
+	}
+	
+protected:
+	size_t count { 0u };
+	std::array<std::vector<scalar_type>, dim> comps;
+	
+};
+
+} // namespace fl
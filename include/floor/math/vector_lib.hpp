@@ -28,6 +28,11 @@ FLOOR_IGNORE_WARNING(float-equal)
 // forwarder for many math functions for all necessary base types
 #include <floor/math/vector_helper.hpp>
 
+// run-time SIMD math functions (used by float vectors on the host and with Host-Compute)
+#if !defined(FLOOR_DEVICE) || defined(FLOOR_DEVICE_HOST_COMPUTE)
+#include <floor/math/simd_math.hpp>
+#endif
+
 namespace fl {
 
 // forward declare all vector types because of inter-dependencies
@@ -233,3 +233,47 @@ FLOOR_VEC_FUNC_EXT_ARGS(func_name, func_name_this, func_name_copy, FLOOR_NOP, fu
 		return { FLOOR_VEC_FUNC_OP_EXPAND(this->, func_name, rhs, FLOOR_COMMA, rhs_sel, \
 										  rhs_sep(), FLOOR_VEC_ASSIGN_NOP, ##__VA_ARGS__) }; \
 	}
+
+// same as FLOOR_VEC_FUNC*, but computed with the SIMD math functions at run-time if "use_simd_math<min_width>()" is true
+// (-> simd_math.hpp), "simd_call" is the parenthesized SIMD math function call on "to_simd_math()"
+// NOTE: this can be disabled via FLOOR_NO_VEC_SIMD_MATH (-> floor_conf.hpp), since results may differ from the scalar std functions
+#if !defined(FLOOR_NO_VEC_SIMD_MATH) && (!defined(FLOOR_DEVICE) || defined(FLOOR_DEVICE_HOST_COMPUTE))
+#define FLOOR_VEC_SIMD_MATH_FUNC(min_width, simd_call, func_name, func_name_this, func_name_copy) \
+FLOOR_VEC_SIMD_MATH_FUNC_EXT_ARGS(min_width, simd_call, func_name, func_name_this, func_name_copy, (), FLOOR_NOP, FLOOR_NOP_FUNC, FLOOR_VEC_RHS_NOP)
+
+#define FLOOR_VEC_SIMD_MATH_FUNC_ARGS(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, ...) \
+FLOOR_VEC_SIMD_MATH_FUNC_EXT_ARGS(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, FLOOR_NOP, FLOOR_NOP_FUNC, FLOOR_VEC_RHS_NOP, __VA_ARGS__)
+
+#define FLOOR_VEC_SIMD_MATH_FUNC_ARGS_VEC(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, rhs) \
+FLOOR_VEC_SIMD_MATH_FUNC_EXT_ARGS(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, rhs, FLOOR_COMMA_FUNC, FLOOR_VEC_RHS_VEC)
+
+#define FLOOR_VEC_SIMD_MATH_FUNC_EXT_ARGS(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, rhs, rhs_sep, rhs_sel, ...) \
+	constexpr vector_type& func_name_this func_args { \
+		if constexpr (use_simd_math<min_width>()) { \
+			if !consteval { \
+				return set(from_simd_math simd_call); \
+			} \
+		} \
+		FLOOR_VEC_FUNC_OP_EXPAND(this->, func_name, rhs, FLOOR_SEMICOLON, rhs_sel, rhs_sep(), \
+								 FLOOR_VEC_ASSIGN_SET, ##__VA_ARGS__); \
+		return *this; \
+	} \
+	constexpr vector_type func_name_copy func_args const { \
+		if constexpr (use_simd_math<min_width>()) { \
+			if !consteval { \
+				return from_simd_math simd_call; \
+			} \
+		} \
+		return { FLOOR_VEC_FUNC_OP_EXPAND(this->, func_name, rhs, FLOOR_COMMA, rhs_sel, \
+										  rhs_sep(), FLOOR_VEC_ASSIGN_NOP, ##__VA_ARGS__) }; \
+	}
+#else // no SIMD math on devices or if not enabled
+#define FLOOR_VEC_SIMD_MATH_FUNC(min_width, simd_call, func_name, func_name_this, func_name_copy) \
+FLOOR_VEC_FUNC(func_name, func_name_this, func_name_copy)
+
+#define FLOOR_VEC_SIMD_MATH_FUNC_ARGS(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, ...) \
+FLOOR_VEC_FUNC_ARGS(func_name, func_name_this, func_name_copy, func_args, __VA_ARGS__)
+
+#define FLOOR_VEC_SIMD_MATH_FUNC_ARGS_VEC(min_width, simd_call, func_name, func_name_this, func_name_copy, func_args, rhs) \
+FLOOR_VEC_FUNC_ARGS_VEC(func_name, func_name_this, func_name_copy, func_args, rhs)
+#endif
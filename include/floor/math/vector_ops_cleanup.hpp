@@ -57,3 +57,7 @@
 #undef FLOOR_VEC_FUNC_ARGS
 #undef FLOOR_VEC_FUNC_ARGS_VEC
 #undef FLOOR_VEC_FUNC_EXT_ARGS
+#undef FLOOR_VEC_SIMD_MATH_FUNC
+#undef FLOOR_VEC_SIMD_MATH_FUNC_ARGS
+#undef FLOOR_VEC_SIMD_MATH_FUNC_ARGS_VEC
+#undef FLOOR_VEC_SIMD_MATH_FUNC_EXT_ARGS
@@ -18,39 +18,142 @@
 
 #pragma once
 
-#include <floor/threading/atomic_spin_lock.hpp>
-#include <floor/threading/thread_safety.hpp>
 #include <floor/core/essentials.hpp>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <new>
+#include <thread>
 
 namespace fl {
 
 // interface partially based on std shared_ptr and N4162/N4260 proposals, with additional functionality:
 //  * this is a completely thread-safe shared_ptr, not just a wrapper around atomic_* functions like N4162/N4260
-//  * locked/thread-safe function calls / access via get/*/->
+//  * thread-safe access via get/*/-> (the accessed object is kept alive for the duration of the access)
 // ref shared_ptr: https://github.com/cplusplus/draft/blob/master/source/utilities.tex#L5568
 // ref thread-safety of shared_ptr: http://www.boost.org/doc/libs/1_53_0/libs/smart_ptr/shared_ptr.htm#ThreadSafety
 // ref atomic_shared_ptr: http://isocpp.org/files/papers/N4162.pdf
 //                        http://isocpp.org/files/papers/N4260.pdf
+//
+// implementation: lock-free, using split (differential) reference counting:
+// the stored shared_ptr is held by a heap-allocated node, the node pointer and an "external" reference count are packed
+// into a single 64-bit atomic word. readers increment the external count to acquire the node, copy the shared_ptr
+// and then decrement the external count again, i.e. readers never block each other or writers.
+// once a node has been replaced by a writer, the writer transfers the outstanding external count to the nodes
+// "internal" count, then remaining readers release their references on the internal count instead,
+// whoever releases the last reference deletes the node.
+// NOTE: access via get/*/-> is not serialized (it only keeps the object alive), T itself must support concurrent access
+// NOTE: node pointers must fit into 48 bits (checked on allocation, std::bad_alloc is thrown otherwise), this is the case for
+//       user-space heap memory on x86-64 (unless mmap is explicitly hinted above 47 bits with 5-level paging) and on
+//       aarch64 (unless top-byte pointer tagging is used, e.g. Android tagged pointers or MTE)
+// NOTE: up to 2^15 concurrent accesses are handled without blocking, any further accesses wait until the count has dropped
 template <class T> class alignas(64u) atomic_shared_ptr {
 protected:
-	mutable atomic_spin_lock_unaligned mtx;
-	mutable std::shared_ptr<T> ptr GUARDED_BY(mtx);
+	//! holds the actually stored shared_ptr
+	struct node_t {
+		//! NOTE: this is never modified while the node is reachable
+		const std::shared_ptr<T> sptr;
+		//! internal reference count (negative while the node is still stored or outstanding references haven't been transferred)
+		std::atomic<int64_t> internal_count { 0 };
+	};
+	
+	//! node pointers are stored in the lower 48 bits, the external reference count in the upper 16 bits
+	static constexpr uint64_t ptr_mask { (1ull << 48ull) - 1ull };
+	static constexpr uint64_t count_shift { 48ull };
+	static constexpr uint64_t count_one { 1ull << count_shift };
+	//! once the external count reaches this, further readers back off until it drops again,
+	//! this leaves room for 2^15 readers that have incremented the count, but haven't backed off yet (-> no overflow)
+	static constexpr int64_t max_external_count { 1ll << 15ll };
+#if !defined(__x86_64__) && !defined(__aarch64__) && !defined(_M_X64) && !defined(_M_ARM64)
+	static_assert(sizeof(void*) <= 4u, "48-bit node pointers are only supported on x86-64 and aarch64 (or 32-bit platforms)");
+#endif
+	
+	//! packed node pointer + external reference count
+	mutable std::atomic<uint64_t> word { 0u };
+	static_assert(std::atomic<uint64_t>::is_always_lock_free);
+	
+	static floor_inline_always node_t* get_node(const uint64_t packed_word) {
+		return (node_t*)(uintptr_t)(packed_word & ptr_mask);
+	}
+	static floor_inline_always int64_t get_external_count(const uint64_t packed_word) {
+		return int64_t(packed_word >> count_shift);
+	}
+	static floor_inline_always uint64_t make_word(std::shared_ptr<T>&& sptr) {
+		if (!sptr) {
+			return 0u;
+		}
+		auto node = new node_t { .sptr = std::move(sptr) };
+		if (((uint64_t)(uintptr_t)node & ~ptr_mask) != 0u) [[unlikely]] {
+			// node can't be packed (tagged pointer or > 48-bit address)
+			delete node;
+			throw std::bad_alloc();
+		}
+		return (uint64_t)(uintptr_t)node;
+	}
+	
+	//! acquires a reference to the currently stored node, returns the word at the time of acquisition (node is nullptr if empty)
+	floor_inline_always uint64_t acquire_node() const noexcept {
+		auto prev_word = word.fetch_add(count_one, std::memory_order_acquire);
+		while (get_external_count(prev_word) >= max_external_count && get_node(prev_word) != nullptr) [[unlikely]] {
+			// too many concurrent references -> release ours again and wait until the count has dropped
+			release_node(get_node(prev_word));
+			do {
+				std::this_thread::yield();
+			} while (get_external_count(word.load(std::memory_order_relaxed)) >= max_external_count);
+			prev_word = word.fetch_add(count_one, std::memory_order_acquire);
+		}
+		if (get_node(prev_word) == nullptr) {
+			// nothing stored -> undo if the word hasn't been changed in the meantime
+			// (if it has been changed, our increment has been discarded by the writer)
+			auto cur_word = prev_word + count_one;
+			while (get_node(cur_word) == nullptr && get_external_count(cur_word) > 0) {
+				if (word.compare_exchange_weak(cur_word, cur_word - count_one, std::memory_order_relaxed)) {
+					break;
+				}
+			}
+		}
+		return prev_word;
+	}
+	
+	//! releases a reference that has been acquired via acquire_node()
+	floor_inline_always void release_node(node_t* node) const noexcept {
+		auto cur_word = word.load(std::memory_order_relaxed);
+		while (get_node(cur_word) == node) {
+			// still stored -> our reference is part of the external count
+			if (word.compare_exchange_weak(cur_word, cur_word - count_one, std::memory_order_release, std::memory_order_relaxed)) {
+				return;
+			}
+		}
+		// node has been replaced -> our reference has been transferred to the internal count
+		if (node->internal_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			delete node;
+		}
+	}
+	
+	//! retires a node that has been removed from "word" (with its external count at the time of removal),
+	//! "extra_refs" are additional references that are held by the caller and are released as well
+	static floor_inline_always void retire_node(const uint64_t removed_word, const int64_t extra_refs = 0) noexcept {
+		auto node = get_node(removed_word);
+		if (node == nullptr) {
+			return;
+		}
+		const auto transfer_count = get_external_count(removed_word) - extra_refs;
+		if (node->internal_count.fetch_add(transfer_count, std::memory_order_acq_rel) == -transfer_count) {
+			delete node;
+		}
+	}
 	
 public:
-	// aka locking proxy
+	//! access proxy: holds a reference to the stored object for the duration of the access
+	//! NOTE: for compatibility with the previous lock-based implementation, this is still called "locked_ptr",
+	//!       but doesn't actually lock anything
 	template <typename U>
 	class locked_ptr {
 	protected:
-		atomic_spin_lock_unaligned& mtx_ref;
-		std::shared_ptr<U>& ptr;
-		
+		const std::shared_ptr<U> ptr;
+	
 	public:
-		explicit locked_ptr(atomic_spin_lock_unaligned& mtx_, std::shared_ptr<U>& ptr_) noexcept : mtx_ref(mtx_), ptr(ptr_) {
-			mtx_ref.lock();
-		}
-		~locked_ptr() {
-			mtx_ref.unlock();
-		}
+		explicit locked_ptr(std::shared_ptr<U>&& ptr_) noexcept : ptr(std::move(ptr_)) {}
 		locked_ptr& operator=(const locked_ptr&) = delete;
 		floor_inline_always U* get() const noexcept {
 			return ptr.get();
@@ -69,120 +172,144 @@ public:
 	// constructors:
 	constexpr atomic_shared_ptr() noexcept = default;
 	constexpr atomic_shared_ptr(nullptr_t) noexcept {}
-	constexpr atomic_shared_ptr(std::shared_ptr<T> sptr) noexcept : ptr(sptr) {}
+	atomic_shared_ptr(std::shared_ptr<T> sptr) : word(make_word(std::move(sptr))) {}
 	atomic_shared_ptr(const atomic_shared_ptr&) = delete;
 	
 	// destructor:
 	~atomic_shared_ptr() {
-		mtx.lock();
-		// note: shared_ptr is cleaned up / destructed automatically
-		ptr.reset();
-		mtx.unlock();
+		// note: shared_ptr is cleaned up / destructed automatically once all references are gone
+		retire_node(word.exchange(0u, std::memory_order_acq_rel));
 	}
 	
 	// assignment:
-	floor_inline_always atomic_shared_ptr& operator=(std::shared_ptr<T> sptr) REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.swap(sptr);
+	floor_inline_always atomic_shared_ptr& operator=(std::shared_ptr<T> sptr) {
+		store(std::move(sptr));
 		return *this;
 	}
-	floor_inline_always atomic_shared_ptr& operator=(nullptr_t) REQUIRES(!mtx) {
+	floor_inline_always atomic_shared_ptr& operator=(nullptr_t) {
 		reset();
 		return *this;
 	}
 	atomic_shared_ptr& operator=(const atomic_shared_ptr&) = delete;
 	
-	floor_inline_always void store(std::shared_ptr<T> sptr) noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.swap(sptr);
+	//! NOTE: may throw std::bad_alloc (allocates a new node if "sptr" is non-empty)
+	floor_inline_always void store(std::shared_ptr<T> sptr) {
+		retire_node(word.exchange(make_word(std::move(sptr)), std::memory_order_acq_rel));
 	}
 	
-	floor_inline_always std::shared_ptr<T> exchange(std::shared_ptr<T> sptr) noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.swap(sptr);
-		return sptr;
+	//! NOTE: may throw std::bad_alloc (allocates a new node if "sptr" is non-empty)
+	floor_inline_always std::shared_ptr<T> exchange(std::shared_ptr<T> sptr) {
+		const auto prev_word = word.exchange(make_word(std::move(sptr)), std::memory_order_acq_rel);
+		auto prev_node = get_node(prev_word);
+		if (prev_node == nullptr) {
+			return {};
+		}
+		// NOTE: can't move from the node, since readers may still be copying it
+		std::shared_ptr<T> ret = prev_node->sptr;
+		retire_node(prev_word);
+		return ret;
 	}
 	
-	floor_inline_always bool compare_exchange_strong(std::shared_ptr<T>& expected, const std::shared_ptr<T>& desired) noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		// check if ptr and expected share the same control block (are the same)
-		if(!ptr.owner_before(expected) && !expected.owner_before(ptr)) {
-			ptr = desired;
-			return true;
+	//! NOTE: may throw std::bad_alloc (allocates a new node if "desired" is non-empty)
+	floor_inline_always bool compare_exchange_strong(std::shared_ptr<T>& expected, std::shared_ptr<T> desired) {
+		const auto desired_word = make_word(std::move(desired));
+		for (;;) {
+			const auto acquired_word = acquire_node();
+			const auto node = get_node(acquired_word);
+			if (node == nullptr) {
+				if (expected) {
+					expected = nullptr;
+					retire_node(desired_word);
+					return false;
+				}
+				// try to replace the empty word (external count may be non-zero due to concurrent readers)
+				auto cur_word = word.load(std::memory_order_relaxed);
+				while (get_node(cur_word) == nullptr) {
+					if (word.compare_exchange_weak(cur_word, desired_word, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+						return true;
+					}
+				}
+				// changed in the meantime -> retry
+				continue;
+			}
+			
+			// check if the stored ptr and expected share the same control block (are the same)
+			if (node->sptr.owner_before(expected) || expected.owner_before(node->sptr)) {
+				expected = node->sptr;
+				release_node(node);
+				retire_node(desired_word);
+				return false;
+			}
+			
+			// try to replace the node, while it is still stored (our reference is part of its external count)
+			auto cur_word = word.load(std::memory_order_relaxed);
+			while (get_node(cur_word) == node) {
+				if (word.compare_exchange_weak(cur_word, desired_word, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					// transfer all other references and release ours
+					retire_node(cur_word, 1);
+					return true;
+				}
+			}
+			// replaced in the meantime -> retry
+			release_node(node);
 		}
-		expected = ptr;
-		return false;
-	}
-	floor_inline_always bool compare_exchange_strong(std::shared_ptr<T>& expected, std::shared_ptr<T>&& desired) noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		// check if ptr and expected share the same control block (are the same)
-		if(!ptr.owner_before(expected) && !expected.owner_before(ptr)) {
-			ptr = desired;
-			return true;
-		}
-		expected = ptr;
-		return false;
-	}
-	floor_inline_always bool compare_exchange_weak(std::shared_ptr<T>& expected, const std::shared_ptr<T>& desired) noexcept REQUIRES(!mtx) {
-		return compare_exchange_strong(expected, desired);
 	}
-	floor_inline_always bool compare_exchange_weak(std::shared_ptr<T>& expected, std::shared_ptr<T>&& desired) noexcept REQUIRES(!mtx) {
-		return compare_exchange_strong(expected, std::forward(desired));
+	floor_inline_always bool compare_exchange_weak(std::shared_ptr<T>& expected, std::shared_ptr<T> desired) {
+		return compare_exchange_strong(expected, std::move(desired));
 	}
 	
 	// modifiers:
-	floor_inline_always void reset() noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.reset();
+	floor_inline_always void reset() noexcept {
+		retire_node(word.exchange(0u, std::memory_order_acq_rel));
 	}
-	template<class Y> floor_inline_always void reset(Y* p) REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.reset(p);
+	template<class Y> floor_inline_always void reset(Y* p) {
+		store(std::shared_ptr<T>(p));
 	}
-	template<class Y, class D> floor_inline_always void reset(Y* p, D d) REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.reset(p, d);
+	template<class Y, class D> floor_inline_always void reset(Y* p, D d) {
+		store(std::shared_ptr<T>(p, d));
 	}
-	template<class Y, class D, class A> floor_inline_always void reset(Y* p, D d, A a) REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		ptr.reset(p, d, a);
+	template<class Y, class D, class A> floor_inline_always void reset(Y* p, D d, A a) {
+		store(std::shared_ptr<T>(p, d, a));
 	}
 	
 	// observers:
-	floor_inline_always locked_ptr<T> get() const noexcept NO_THREAD_SAFETY_ANALYSIS {
-		return locked_ptr<T> { mtx, ptr };
+	floor_inline_always locked_ptr<T> get() const noexcept {
+		return locked_ptr<T> { load() };
 	}
 	floor_inline_always T* unsafe_get() const noexcept {
-		return ptr.get();
+		auto node = get_node(word.load(std::memory_order_acquire));
+		return (node != nullptr ? node->sptr.get() : nullptr);
 	}
-	floor_inline_always locked_ptr<T> operator*() const noexcept NO_THREAD_SAFETY_ANALYSIS {
-		return locked_ptr<T> { mtx, ptr };
+	floor_inline_always locked_ptr<T> operator*() const noexcept {
+		return locked_ptr<T> { load() };
 	}
-	floor_inline_always locked_ptr<T> operator->() const noexcept NO_THREAD_SAFETY_ANALYSIS {
-		return locked_ptr<T> { mtx, ptr };
+	floor_inline_always locked_ptr<T> operator->() const noexcept {
+		return locked_ptr<T> { load() };
 	}
-	floor_inline_always long use_count() const noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		return ptr.use_count();
+	floor_inline_always long use_count() const noexcept {
+		const auto sptr = load();
+		// don't count the temporary copy
+		return (sptr ? sptr.use_count() - 1 : 0);
 	}
-	floor_inline_always bool unique() const noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		return ptr.unique();
+	floor_inline_always bool unique() const noexcept {
+		return (use_count() == 1);
 	}
-	floor_inline_always explicit operator bool() const noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		return ptr();
+	floor_inline_always explicit operator bool() const noexcept {
+		return (get_node(word.load(std::memory_order_acquire)) != nullptr);
 	}
-	template<class U> floor_inline_always bool owner_before(std::shared_ptr<U> const& b) const REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		return ptr.owner_before(b);
+	template<class U> floor_inline_always bool owner_before(std::shared_ptr<U> const& b) const {
+		return load().owner_before(b);
 	}
 	
-	constexpr bool is_lock_free() const noexcept { return false; }
+	constexpr bool is_lock_free() const noexcept { return true; }
 	
-	floor_inline_always std::shared_ptr<T> load() const noexcept REQUIRES(!mtx) {
-		safe_guard<atomic_spin_lock_unaligned> guard(mtx);
-		std::shared_ptr<T> ret = ptr;
+	floor_inline_always std::shared_ptr<T> load() const noexcept {
+		const auto node = get_node(acquire_node());
+		if (node == nullptr) {
+			return {};
+		}
+		std::shared_ptr<T> ret = node->sptr;
+		release_node(node);
 		return ret;
 	}
 	
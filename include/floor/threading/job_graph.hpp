@@ -0,0 +1,163 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/core/essentials.hpp>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <latch>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace fl {
+
+//! executes a graph of jobs with dependencies on a bounded set of worker threads
+//! usage:
+//!  * add all jobs via add_job(), specifying the jobs each job depends on (these must have been added before)
+//!  * call execute() to start execution, then wait() to block until all jobs have finished (or have been cancelled)
+//! NOTE: a job signals failure by returning false (or throwing), at which point all jobs that haven't started yet
+//!       are cancelled ("cancellation on first failure"), jobs that are already running will finish normally
+//! NOTE: jobs whose dependencies have been resolved are scheduled before any other not-yet-started job,
+//!       i.e. a chain of dependent jobs (a pipeline) is finished as soon as possible
+class job_graph {
+public:
+	//! identifies a job inside the graph
+	using job_id = uint32_t;
+	//! job function: must return true on success, false on failure
+	using job_func_t = std::function<bool()>;
+
+	//! status of a single job
+	enum class JOB_STATUS : uint32_t {
+		//! job is waiting for its dependencies or a free worker thread
+		PENDING,
+		//! job is currently being executed
+		RUNNING,
+		//! job has been executed successfully
+		SUCCEEDED,
+		//! job has been executed, but failed
+		FAILED,
+		//! job has been cancelled before it was executed
+		CANCELLED,
+	};
+
+	//! creates a new job graph that will execute at most "max_concurrency" jobs at once,
+	//! if "max_concurrency" is 0, this will use the amount of logical CPU cores
+	//! NOTE: worker threads are named "<name>_<index>"
+	explicit job_graph(const std::string name = "job", const uint32_t max_concurrency = 0u);
+	//! waits until all jobs have finished (if execute() has been called)
+	~job_graph();
+
+	//! adds a new job that will be executed once all specified "dependencies" have been executed successfully,
+	//! returns the id of the job
+	//! NOTE: jobs can only be added before execute() has been called
+	job_id add_job(job_func_t op, const std::vector<job_id>& dependencies = {});
+
+	//! starts the execution of all jobs (non-blocking), returns false if the graph was already started
+	bool execute();
+
+	//! blocks until all jobs have finished or have been cancelled,
+	//! returns true if all jobs have been executed successfully
+	bool wait();
+
+	//! shortcut for execute() + wait()
+	bool execute_and_wait() {
+		return (execute() && wait());
+	}
+
+	//! cancels all jobs that haven't started yet
+	//! NOTE: this is a no-op once all jobs have completed
+	void cancel();
+
+	//! returns true if the graph has been cancelled (either by a failed job or by calling cancel())
+	//! NOTE: long running jobs may use this to abort early
+	bool is_cancelled() const {
+		return cancelled;
+	}
+
+	//! returns a future that holds the result of the specified job once it has finished (false if cancelled)
+	std::shared_future<bool> get_future(const job_id id) const;
+
+	//! returns the current status of the specified job
+	JOB_STATUS get_job_status(const job_id id) const;
+
+	//! returns the amount of jobs in this graph
+	uint32_t get_job_count() const;
+
+	//! returns the max amount of jobs that are executed concurrently
+	uint32_t get_max_concurrency() const {
+		return max_concurrency;
+	}
+
+	// prohibit copying and moving
+	job_graph(const job_graph&) = delete;
+	job_graph& operator=(const job_graph&) = delete;
+	job_graph(job_graph&&) = delete;
+	job_graph& operator=(job_graph&&) = delete;
+
+protected:
+	const std::string name;
+	const uint32_t max_concurrency;
+
+	struct job_t {
+		job_func_t op;
+		//! jobs that depend on this job
+		std::vector<job_id> dependents;
+		//! amount of dependencies that haven't been executed yet
+		uint32_t unresolved_dependency_count { 0u };
+		JOB_STATUS status { JOB_STATUS::PENDING };
+		std::promise<bool> result;
+		std::shared_future<bool> result_future;
+	};
+
+	//! protects all job state, the ready queue and the worker threads
+	mutable std::mutex jobs_lock;
+	//! will be signaled once a job becomes ready or all jobs have finished
+	std::condition_variable jobs_cv;
+	std::vector<std::unique_ptr<job_t>> jobs;
+	//! jobs that can be executed right now
+	std::deque<job_id> ready_queue;
+	//! amount of jobs that have finished, failed or have been cancelled
+	uint32_t finished_job_count { 0u };
+	bool started { false };
+	std::atomic<bool> cancelled { false };
+	std::atomic<bool> failed { false };
+
+	//! counts down once for each finished, failed or cancelled job
+	std::unique_ptr<std::latch> completion_latch;
+	std::vector<std::thread> workers;
+
+	//! worker thread function
+	void worker_run(const uint32_t worker_idx);
+	//! marks the specified job as finished and schedules its dependents
+	//! NOTE: requires holding "jobs_lock"
+	void finish_job(job_t& job, const bool success);
+	//! cancels all pending jobs
+	//! NOTE: requires holding "jobs_lock"
+	void cancel_pending_jobs();
+
+};
+
+} // namespace fl
@@ -0,0 +1,189 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/threading/atomic_spin_lock.hpp>
+#include <floor/threading/thread_safety.hpp>
+#include <floor/core/essentials.hpp>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <bit>
+#include <cstdint>
+
+namespace fl {
+
+//! multi-producer/single-consumer queue:
+//! values are pushed into a bounded lock-free ring (based on Dmitry Vyukov's bounded MPMC queue),
+//! only if the ring is full, values are pushed into an unbounded locked overflow queue instead (i.e. push never fails)
+//! NOTE: values pushed by the same thread are always popped in the same order (also when overflowing)
+//! NOTE: try_pop/consume must only be called by a single consumer thread at a time
+//! NOTE: popped ring slots are reset to T {}, so that no resources are kept alive by the queue
+template <typename T, size_t capacity = 4096u>
+requires (std::has_single_bit(capacity) && std::is_default_constructible_v<T> && std::is_move_assignable_v<T>)
+class mpsc_queue {
+public:
+	mpsc_queue() : cells(std::make_unique<cell_t[]>(capacity)) {
+		for (size_t i = 0; i < capacity; ++i) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+	
+	mpsc_queue(const mpsc_queue&) = delete;
+	mpsc_queue& operator=(const mpsc_queue&) = delete;
+	
+	//! pushes "value" into the queue, can be called from any thread
+	void push(T&& value) REQUIRES(!overflow_lock) {
+		// once anything has overflowed, all further values must also go into the overflow queue
+		// until the consumer has picked these up (otherwise values of the same producer could be reordered)
+		if (overflow_count.load(std::memory_order_acquire) == 0u && try_push_ring(value)) [[likely]] {
+			return;
+		}
+		GUARD(overflow_lock);
+		overflow.emplace_back(std::move(value));
+		overflow_count.store(overflow.size(), std::memory_order_release);
+	}
+	void push(const T& value) REQUIRES(!overflow_lock) {
+		T value_copy { value };
+		push(std::move(value_copy));
+	}
+	
+	//! pops the next value from the queue into "value", returns false if the queue is empty
+	bool try_pop(T& value) REQUIRES(!overflow_lock) {
+		// overflowed values that have already been picked up must be handled before anything in the ring
+		if (!overflow_processing.empty()) {
+			value = std::move(overflow_processing.front());
+			overflow_processing.pop_front();
+			return true;
+		}
+		if (try_pop_ring(value)) [[likely]] {
+			return true;
+		}
+		// ring is empty -> pick up all overflowed values (these were all pushed after the values in the ring)
+		if (overflow_count.load(std::memory_order_acquire) == 0u) {
+			return false;
+		}
+		if (enqueue_pos.load(std::memory_order_acquire) != dequeue_pos) {
+			// a producer hasn't finished writing to the ring yet -> can't pick up overflowed values before that
+			return false;
+		}
+		{
+			GUARD(overflow_lock);
+			overflow_processing.swap(overflow);
+			overflow_count.store(0u, std::memory_order_release);
+		}
+		if (overflow_processing.empty()) {
+			return false;
+		}
+		value = std::move(overflow_processing.front());
+		overflow_processing.pop_front();
+		return true;
+	}
+	
+	//! pops all values that are currently in the queue and calls "consumer(T&&)" for each of them,
+	//! returns the amount of consumed values
+	template <typename F>
+	size_t consume(F&& consumer) REQUIRES(!overflow_lock) {
+		size_t count = 0;
+		T value {};
+		while (try_pop(value)) {
+			consumer(std::move(value));
+			value = T {};
+			++count;
+		}
+		return count;
+	}
+	
+	//! returns true if the queue is currently empty
+	//! NOTE: this is only an approximation if other threads are pushing at the same time
+	bool empty() const {
+		if (!overflow_processing.empty() || overflow_count.load(std::memory_order_acquire) > 0u) {
+			return false;
+		}
+		const auto& cell = cells[dequeue_pos & (capacity - 1u)];
+		return (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1u);
+	}
+	
+	//! returns the max amount of values the lock-free ring can hold
+	static constexpr size_t get_capacity() {
+		return capacity;
+	}
+	
+protected:
+	struct cell_t {
+		std::atomic<size_t> sequence;
+		T value {};
+	};
+	std::unique_ptr<cell_t[]> cells;
+	
+	//! producer position (shared by all producers)
+	alignas(64u) std::atomic<size_t> enqueue_pos { 0u };
+	//! consumer position (only accessed by the consumer)
+	alignas(64u) size_t dequeue_pos { 0u };
+	//! overflowed values that have been picked up by the consumer (only accessed by the consumer)
+	std::deque<T> overflow_processing;
+	
+	alignas(64u) atomic_spin_lock_unaligned overflow_lock;
+	std::deque<T> overflow GUARDED_BY(overflow_lock);
+	//! amount of values in "overflow", allows checking for overflowed values without locking
+	std::atomic<size_t> overflow_count { 0u };
+	
+	//! tries to push the value into the ring, returns false if the ring is full ("value" is untouched then)
+	bool try_push_ring(T& value) {
+		auto pos = enqueue_pos.load(std::memory_order_relaxed);
+		cell_t* cell = nullptr;
+		for (;;) {
+			cell = &cells[pos & (capacity - 1u)];
+			const auto seq = cell->sequence.load(std::memory_order_acquire);
+			const auto diff = intptr_t(seq) - intptr_t(pos);
+			if (diff == 0) {
+				// cell is free -> try to claim it
+				if (enqueue_pos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (diff < 0) {
+				// ring is full
+				return false;
+			} else {
+				// another producer claimed this cell in the meantime
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+		cell->value = std::move(value);
+		cell->sequence.store(pos + 1u, std::memory_order_release);
+		return true;
+	}
+	
+	//! tries to pop a value from the ring, returns false if the ring is empty
+	bool try_pop_ring(T& value) {
+		auto& cell = cells[dequeue_pos & (capacity - 1u)];
+		if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos + 1u) {
+			// empty (or the producer of this cell hasn't finished yet)
+			return false;
+		}
+		value = std::move(cell.value);
+		cell.value = T {};
+		cell.sequence.store(dequeue_pos + capacity, std::memory_order_release);
+		++dequeue_pos;
+		return true;
+	}
+	
+};
+
+} // namespace fl
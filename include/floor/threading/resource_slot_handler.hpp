@@ -24,6 +24,7 @@
 #include <array>
 #include <cstdint>
 #include <cassert>
+#include <algorithm>
 #include <floor/threading/atomic_spin_lock.hpp>
 
 namespace fl {
@@ -66,6 +67,8 @@ struct resource_slot_handler {
 	
 	//! 1: slot is unused, 0: slot is used
 	alignas(64) std::atomic<slot_bitset_t> slots { slots_init_value() };
+	//! amount of threads that are blocked in acquire_slot() (release_slot() only needs to notify if this is non-zero)
+	std::atomic<uint32_t> waiter_count { 0u };
 	
 	//! tries to acquire a free slot index and returns it,
 	//! returns "invalid_slot_idx" on failure
@@ -89,19 +92,21 @@ struct resource_slot_handler {
 	}
 	
 	//! acquires an unused slot
+	//! NOTE: if all slots are in use, this blocks until a slot is released
 	uint8_t acquire_slot() {
 		// find the lowest unused (1) slot
 		auto cur_slots = slots.load();
 		uint32_t attempt = 0u;
 		do {
 			if (cur_slots == 0) [[unlikely]] {
-				// -> no free slot, wait
+				// -> no free slot, spin wait for a short while, then block until a slot is released
 				if (attempt < 16u) {
 					FLOOR_SPIN_WAIT();
 					++attempt;
 				} else {
-					std::this_thread::yield();
-					attempt = 0u;
+					waiter_count.fetch_add(1u);
+					slots.wait(0);
+					waiter_count.fetch_sub(1u);
 				}
 				cur_slots = slots.load();
 				continue;
@@ -124,8 +129,11 @@ struct resource_slot_handler {
 		auto cur_slots = slots.load();
 		do {
 			auto new_slots = slot_bitset_t(cur_slots ^ slot_idx_mask);
-			if (slots.compare_exchange_strong(cur_slots, new_slots, std::memory_order_acq_rel)) [[likely]] {
-				// -> success
+			if (slots.compare_exchange_strong(cur_slots, new_slots)) [[likely]] {
+				// -> success, wake up a blocked acquire_slot() if there is any
+				if (waiter_count.load() > 0u) [[unlikely]] {
+					slots.notify_one();
+				}
 				return;
 			}
 			// -> failure, retry
@@ -189,6 +197,125 @@ protected:
 	}
 };
 
+//! lock-free resource slot handler for large resource counts (thousands of slots):
+//! slots are split into shards of 64 slots that each reside in their own cache line, each thread starts its search at its
+//! own preferred shard (the shard it last acquired a slot from), so that concurrent acquisitions from different threads
+//! usually don't contend on the same atomic
+template <uint32_t resource_count>
+requires (resource_count > 0u)
+struct sharded_resource_slot_handler {
+	//! amount of slots per shard
+	static constexpr const uint32_t slots_per_shard { 64u };
+	//! amount of shards
+	static constexpr const uint32_t shard_count { (resource_count + slots_per_shard - 1u) / slots_per_shard };
+	
+	//! indicates an invalid slot / failure
+	static constexpr const uint32_t invalid_slot_idx { ~0u };
+	
+	//! single shard of 64 slots, 1: slot is unused, 0: slot is used
+	struct alignas(64) shard_t {
+		std::atomic<uint64_t> slots;
+	};
+	std::array<shard_t, shard_count> shards;
+	
+	//! incremented on each release while threads are blocked in acquire_slot()
+	alignas(64) std::atomic<uint32_t> release_epoch { 0u };
+	//! amount of threads that are blocked in acquire_slot()
+	std::atomic<uint32_t> waiter_count { 0u };
+	
+	sharded_resource_slot_handler() noexcept {
+		for (uint32_t shard_idx = 0; shard_idx < shard_count; ++shard_idx) {
+			// mark slots >= resource_count in the last shard as always-used
+			const auto shard_slot_count = std::min(resource_count - shard_idx * slots_per_shard, slots_per_shard);
+			shards[shard_idx].slots.store(shard_slot_count < 64u ? (1ull << shard_slot_count) - 1ull : ~0ull, std::memory_order_relaxed);
+		}
+	}
+	
+	//! tries to acquire a free slot index and returns it,
+	//! returns "invalid_slot_idx" on failure (all slots are in use)
+	uint32_t try_acquire_slot() {
+		auto& pref_shard_idx = preferred_shard();
+		for (uint32_t i = 0; i < shard_count; ++i) {
+			const auto shard_idx = (pref_shard_idx + i) % shard_count;
+			auto& shard_slots = shards[shard_idx].slots;
+			auto cur_slots = shard_slots.load(std::memory_order_relaxed);
+			while (cur_slots != 0u) {
+				// try to grab the lowest unused slot, if it has been taken in the meantime, retry with the remaining ones
+				const auto bit_idx = uint32_t(__builtin_ctzll(cur_slots));
+				const auto bit_mask = (1ull << bit_idx);
+				const auto prev_slots = shard_slots.fetch_and(~bit_mask, std::memory_order_acq_rel);
+				if ((prev_slots & bit_mask) != 0u) [[likely]] {
+					pref_shard_idx = shard_idx;
+					return shard_idx * slots_per_shard + bit_idx;
+				}
+				cur_slots = prev_slots;
+			}
+		}
+		return invalid_slot_idx;
+	}
+	
+	//! acquires an unused slot
+	//! NOTE: if all slots are in use, this blocks until a slot is released
+	uint32_t acquire_slot() {
+		for (uint32_t attempt = 0u; ; ++attempt) {
+			if (const auto slot_idx = try_acquire_slot(); slot_idx != invalid_slot_idx) [[likely]] {
+				return slot_idx;
+			}
+			if (attempt < 16u) {
+				FLOOR_SPIN_WAIT();
+				continue;
+			}
+			
+			// all slots are in use -> announce that we're waiting, then retry once more before blocking,
+			// otherwise we could miss a release that happened in between
+			waiter_count.fetch_add(1u);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto epoch = release_epoch.load();
+			if (const auto slot_idx = try_acquire_slot(); slot_idx != invalid_slot_idx) {
+				waiter_count.fetch_sub(1u);
+				return slot_idx;
+			}
+			release_epoch.wait(epoch);
+			waiter_count.fetch_sub(1u);
+		}
+	}
+	
+	//! releases a slot again
+	void release_slot(const uint32_t slot_idx) {
+		assert(slot_idx < resource_count);
+		const auto bit_mask = (1ull << (slot_idx % slots_per_shard));
+		const auto prev_slots = shards[slot_idx / slots_per_shard].slots.fetch_or(bit_mask, std::memory_order_acq_rel);
+		assert((prev_slots & bit_mask) == 0u && "slot was not in use");
+		(void)prev_slots;
+		
+		// wake up a blocked acquire_slot() if there is any
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiter_count.load(std::memory_order_relaxed) > 0u) [[unlikely]] {
+			release_epoch.fetch_add(1u);
+			release_epoch.notify_one();
+		}
+	}
+	
+	//! returns the amount of currently used slots
+	uint32_t get_used_slot_count() const {
+		uint32_t free_count = 0u;
+		for (const auto& shard : shards) {
+			free_count += uint32_t(__builtin_popcountll(shard.slots.load(std::memory_order_relaxed)));
+		}
+		return resource_count - free_count;
+	}
+	
+protected:
+	//! returns a reference to the shard the calling thread should start its search at
+	static uint32_t& preferred_shard() {
+		// initially distribute threads evenly across all shards
+		static std::atomic<uint32_t> thread_counter { 0u };
+		thread_local uint32_t shard_idx { thread_counter.fetch_add(1u, std::memory_order_relaxed) % shard_count };
+		return shard_idx;
+	}
+	
+};
+
 //! lock-free resource container using fixed allocation slots for small resource counts
 template <typename data_type, uint32_t resource_count>
 requires (resource_count > 0)
@@ -327,28 +454,18 @@ struct resource_slot_container_small {
 	}
 };
 
-//! lock-free resource container using fixed allocation slots for large resource counts
-//! NOTE: "resource_count" must be a multiple of the max platform resource count (128 or 64)
+//! lock-free resource container using fixed allocation slots for large resource counts (uses a sharded_resource_slot_handler)
 template <typename data_type, uint32_t resource_count>
 requires (resource_count > 0)
 struct resource_slot_container_large {
-	//! NOTE: can't put this in the class requires clause, because this would prevent resource_slot_container from working with smaller sizes
-	static_assert((resource_count % max_platform_resource_count) == 0, "resource_count must be a multiple of the max platform resource count");
-	
-	//! numbers of slots per resource_slot_handler
-	static constexpr const uint32_t slots_per_block { max_platform_resource_count };
-	//! we allocate/use multiple resource_slot_handler in here
-	static constexpr const uint32_t block_count { (resource_count + slots_per_block - 1u) / slots_per_block };
-	static_assert(block_count >= 1u);
-	
-	using slot_handler_t = resource_slot_handler<slots_per_block>;
+	using slot_handler_t = sharded_resource_slot_handler<resource_count>;
 	
 	//! encodes a single resource reference that is returned for external use
 	template <bool auto_release = true>
 	struct resource_t {
 	public:
 		data_type* res { nullptr };
-		static constexpr const uint8_t invalid_slot_idx { slot_handler_t::invalid_slot_idx };
+		static constexpr const uint32_t invalid_slot_idx { slot_handler_t::invalid_slot_idx };
 		
 	protected:
 		resource_slot_container_large* container { nullptr };
@@ -417,78 +534,52 @@ struct resource_slot_container_large {
 	using auto_release_resource_t = resource_t<true>;
 	using manual_release_resource_t = resource_t<false>;
 	
-	//! lock-free slot handlers
-	std::array<resource_slot_handler<slots_per_block>, block_count> slots {};
-	
-	//! when acquiring a slot, we perform a round-robin across "slots"
-	alignas(64) std::atomic<uint32_t> current_block { 0u };
+	//! lock-free slot handler
+	slot_handler_t slots;
 	
 	//! the actual fixed resource allocations
 	std::array<data_type, resource_count> resources {};
 	
 	//! acquires a resource (with auto-release on destruction)
 	auto_release_resource_t acquire_resource() {
-		auto slot_idx = acquire_slot();
+		auto slot_idx = slots.acquire_slot();
 		return { &resources[slot_idx], this, slot_idx };
 	}
 	
 	//! acquires a resource (without auto-release on destruction -> must manually call release_resource())
 	manual_release_resource_t acquire_resource_no_auto_release() {
-		auto slot_idx = acquire_slot();
+		auto slot_idx = slots.acquire_slot();
 		return { &resources[slot_idx], this, slot_idx };
 	}
 	
-	//! releases a resource slot again
-	void release_resource(const uint32_t slot_idx) {
-		release_slot(slot_idx);
+	//! tries to acquire a resource (with auto-release on destruction)
+	//! NOTE: test returned resource to check if the acquisition was successful
+	auto_release_resource_t try_acquire_resource() {
+		auto slot_idx = slots.try_acquire_slot();
+		if (slot_idx != slot_handler_t::invalid_slot_idx) [[likely]] {
+			return { &resources[slot_idx], this, slot_idx };
+		}
+		return {};
 	}
 	
-	//! returns the amount of currently used slots
-	uint32_t get_used_slot_count() const {
-		uint32_t total = 0u;
-		for (uint32_t i = 0; i < block_count; ++i) {
-			total += slots[i].get_used_slot_count();
+	//! tries to acquire a resource (without auto-release on destruction -> must manually call release_resource())
+	//! NOTE: test returned resource to check if the acquisition was successful
+	manual_release_resource_t try_acquire_resource_no_auto_release() {
+		auto slot_idx = slots.try_acquire_slot();
+		if (slot_idx != slot_handler_t::invalid_slot_idx) [[likely]] {
+			return { &resources[slot_idx], this, slot_idx };
 		}
-		return total;
+		return {};
 	}
 	
-protected:
-	//! acquires a slot from any of the resource_slot_handlers
-	uint32_t acquire_slot() {
-		uint32_t attempt = 0u;
-		do {
-			// iterate over all blocks and try to acquire a free slot (but don't spin wait inside any resource_slot_handler)
-			// also: offset our search by "current_block", so we don't always hit the same block/resource_slot_handler first
-			for (uint32_t block_offset = current_block, block_end = block_offset + block_count;
-				 block_offset < block_end; ++block_offset) {
-				const auto block_idx = (block_offset % block_count);
-				const auto slot_idx = slots[block_idx].try_acquire_slot();
-				if (slot_idx != resource_slot_handler<slots_per_block>::invalid_slot_idx) [[likely]] {
-					// advance current_block for round-robin fairness
-					current_block = block_idx;
-					// offset slot index by the per-block slots
-					return uint32_t(slot_idx) + block_idx * slots_per_block;
-				}
-			}
-			
-			// if we didn't find any free slot among all blocks, we spin wait or yield now, then try again
-			if (attempt < 16u) {
-				FLOOR_SPIN_WAIT();
-				++attempt;
-			} else {
-				std::this_thread::yield();
-				attempt = 0u;
-			}
-		} while (true);
+	//! releases a resource slot again
+	void release_resource(const uint32_t slot_idx) {
+		slots.release_slot(slot_idx);
 	}
 	
-	//! releases a slot from the resp. resource_slot_handler
-	void release_slot(const uint32_t slot_idx) {
-		assert(slot_idx < resource_count);
-		const auto block_idx = slot_idx / slots_per_block;
-		assert(block_idx < block_count);
-		const auto slot_idx_actual = uint8_t(slot_idx % slots_per_block);
-		slots[block_idx].release_slot(slot_idx_actual);
+	//! returns the amount of currently used slots
+	uint32_t get_used_slot_count() const {
+		return slots.get_used_slot_count();
 	}
 };
 
@@ -19,75 +19,61 @@
 #pragma once
 
 #include <floor/core/essentials.hpp>
-#include <thread>
-#include <atomic>
 #include <string>
 #include <functional>
-#include <floor/threading/thread_safety.hpp>
+#include <thread>
+#include <floor/threading/task_scheduler.hpp>
 #include <floor/threading/thread_helpers.hpp>
 #include <floor/core/logger.hpp>
 
 namespace fl::task {
 
-//! creates ("spawns") a new task that asynchronously executes the supplied function in a separate thread
-//! NOTE: memory management of the task object is not necessary as it will automatically self-destruct
-//! after completing the task op or after encountering an unhandled exception.
+//! executes the task op, logging any unhandled exception (only used internally)
+static inline void run_task_op(const std::function<void()>& op, const std::string& task_name) {
+	try {
+		op();
+	} catch (std::exception& exc) {
+		log_error("encountered an unhandled exception while running task \"$\": $", task_name, exc.what());
+	} catch (...) {
+		log_error("encountered an unhandled exception while running task \"$\"", task_name);
+	}
+}
+
+//! creates ("spawns") a new task that asynchronously executes the supplied function on the global task scheduler
+//! NOTE: memory management of the task object is not necessary as it will automatically be destroyed
+//! after completing the task op or after encountering an unhandled exception (which will be logged).
+//! NOTE: the op occupies a worker thread while it is running -> it must not block for a long time (waiting on
+//!       events/IO, long-running external processes, ...), use spawn_blocking() for this instead
 //! NOTE: example usage: task::spawn([]() { std::cout << "do something in here" << std::endl; });
 static inline void spawn(std::function<void()> op, const std::string task_name = "task") {
-	struct task {
-		task(std::function<void()> op_, const std::string task_name_) :
-		op(op_), task_name(task_name_),
-		thread_obj(&task::run, this, [this]() {
-			// the task thread is not allowed to run until the task thread object has been detached from the callers thread
-			while(!initialized) { std::this_thread::yield(); }
-			// finally: call the users task op
-			op();
-		}) {
-			thread_obj.detach();
-		}
-		~task() = default;
-		
-		const std::function<void()> op;
-		const std::string task_name;
-		std::atomic<bool> initialized { false };
-		std::thread thread_obj;
-		
-		std::unique_ptr<task> task_alloc;
-		
-		//! moves the outside task allocation to the interior and starts the task execution
-		void set_alloc_and_start(std::unique_ptr<task>&& alloc) {
-			task_alloc = std::move(alloc);
-			task_alloc->initialized = true;
-		}
-		
-		//! the tasks threads run method (only used internally)
-		static void run(task* this_task, std::function<void()> task_op) {
-			// the task thread is not allowed to run until the task thread object has been detached from the callers thread
-			while(!this_task->initialized) { std::this_thread::yield(); }
-			
-			set_current_thread_name(this_task->task_name);
-			
-			try {
-				// NOTE: this is the function object created above (not the users task op!)
-				task_op();
-			} catch (std::exception& exc) {
-				log_error("encountered an unhandled exception while running task \"$\": $",
-						  get_current_thread_name(), exc.what());
-			} catch (...) {
-				log_error("encountered an unhandled exception while running task \"$\"",
-						  get_current_thread_name());
-			}
-			this_task->task_alloc = nullptr;
-		}
-		
-		// prohibit copying
-		task(const task& tsk) = delete;
-		task& operator=(const task& tsk) = delete;
-		
-	};
-	auto task_obj = std::make_unique<task>(op, task_name);
-	auto task_ptr = task_obj.get();
-	task_ptr->set_alloc_and_start(std::move(task_obj));
+	(void)task_scheduler::get().spawn([op = std::move(op), task_name]() {
+		run_task_op(op, task_name);
+	});
+}
+
+//! creates ("spawns") a new task that asynchronously executes the supplied function in its own (detached) thread,
+//! this should be used for ops that block for a long time, so that they don't hold up any task scheduler workers
+//! NOTE: memory management is handled the same way as in spawn()
+static inline void spawn_blocking(std::function<void()> op, const std::string task_name = "task") {
+	std::thread([op = std::move(op), task_name]() {
+		set_current_thread_name(task_name);
+		run_task_op(op, task_name);
+	}).detach();
+}
+
+//! asynchronously executes "func" on the global task scheduler, returns a handle to the task,
+//! which can be used to wait for it, retrieve its result or to add continuations
+//! NOTE: example usage: auto result = task::async([]() { return 42; }).then([](int& val) { return val * 2; }).get();
+template <typename F>
+static inline auto async(F&& func) {
+	return task_scheduler::get().spawn(std::forward<F>(func));
+}
+
+//! executes "func(idx)" for all idx in [begin, end) in parallel on the global task scheduler and blocks until all have been executed,
+//! "grain_size" is the amount of consecutive indices that are executed as one chunk (0 = automatic)
+template <typename F>
+static inline void parallel_for(const size_t begin, const size_t end, F&& func, const size_t grain_size = 0u) {
+	task_scheduler::get().parallel_for(begin, end, std::forward<F>(func), grain_size);
 }
 
 } // namespace fl::task
@@ -0,0 +1,434 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <floor/threading/atomic_spin_lock.hpp>
+#include <floor/threading/thread_safety.hpp>
+#include <floor/core/essentials.hpp>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <optional>
+#include <string>
+#include <exception>
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+
+namespace fl {
+
+class task_scheduler;
+template <typename result_type> class task_handle;
+
+//! type-erased shared state of a task that is executed by a task_scheduler
+class task_state_base {
+public:
+	virtual ~task_state_base() = default;
+	
+	//! returns true if the task has finished executing (successfully or by throwing an exception)
+	bool is_done() const {
+		return done.load(std::memory_order_acquire);
+	}
+	
+	//! blocks until the task has finished executing
+	//! NOTE: when called from a worker thread of the same scheduler, other tasks are executed while waiting
+	void wait();
+	
+	//! returns the exception that has been thrown by the task (nullptr if none was thrown or the task isn't done yet)
+	std::exception_ptr get_exception() const {
+		return (is_done() ? exception : nullptr);
+	}
+	
+	//! rethrows the exception that has been thrown by the task (if any)
+	void rethrow_exception() const {
+		if (auto exc = get_exception(); exc) {
+			std::rethrow_exception(exc);
+		}
+	}
+	
+protected:
+	friend task_scheduler;
+	template <typename result_type> friend class task_handle;
+	
+	explicit task_state_base(task_scheduler& scheduler_) : scheduler(scheduler_) {}
+	
+	//! scheduler this task is executed by
+	task_scheduler& scheduler;
+	std::atomic<bool> done { false };
+	//! amount of worker threads that are currently waiting for this task
+	std::atomic<uint32_t> worker_waiter_count { 0u };
+	std::exception_ptr exception;
+	
+	atomic_spin_lock continuations_lock;
+	//! tasks that will be scheduled once this task has finished
+	std::vector<std::shared_ptr<task_state_base>> continuations GUARDED_BY(continuations_lock);
+	
+	//! executes the task op (and stores its result)
+	virtual void run() = 0;
+	
+	//! executes the task, marks it as done, wakes up all waiters and schedules all continuations
+	void execute() REQUIRES(!continuations_lock);
+	
+	//! schedules "continuation" once this task has finished (immediately if it has already finished)
+	void add_continuation(std::shared_ptr<task_state_base> continuation) REQUIRES(!continuations_lock);
+	
+};
+
+//! task state with a typed result
+template <typename result_type>
+class task_state : public task_state_base {
+public:
+	using task_result_type = result_type;
+	
+	//! waits for the task and returns its result, rethrows the exception of the task if it threw one
+	result_type& get() {
+		wait();
+		rethrow_exception();
+		return *result;
+	}
+	
+protected:
+	using task_state_base::task_state_base;
+	std::optional<result_type> result;
+	
+};
+
+template <>
+class task_state<void> : public task_state_base {
+public:
+	using task_result_type = void;
+	
+	//! waits for the task, rethrows the exception of the task if it threw one
+	void get() {
+		wait();
+		rethrow_exception();
+	}
+	
+protected:
+	using task_state_base::task_state_base;
+	
+};
+
+//! task state containing the actual task op
+//! NOTE: the op is destroyed right after it has been executed (i.e. all captured resources are released then)
+template <typename result_type, typename op_type>
+class task_state_impl final : public task_state<result_type> {
+public:
+	task_state_impl(task_scheduler& scheduler_, op_type&& op_) : task_state<result_type>(scheduler_), op(std::move(op_)) {}
+	
+protected:
+	std::optional<op_type> op;
+	
+	void run() override {
+		if constexpr (std::is_void_v<result_type>) {
+			(*op)();
+		} else {
+			this->result.emplace((*op)());
+		}
+		op.reset();
+	}
+	
+};
+
+//! handle to a task that has been spawned on a task_scheduler
+template <typename result_type>
+class task_handle {
+public:
+	task_handle() noexcept = default;
+	explicit task_handle(std::shared_ptr<task_state<result_type>> state_) noexcept : state(std::move(state_)) {}
+	
+	//! returns true if this refers to a task
+	bool is_valid() const {
+		return (state != nullptr);
+	}
+	
+	//! returns true if the task has finished executing
+	bool is_done() const {
+		return state->is_done();
+	}
+	
+	//! blocks until the task has finished executing
+	void wait() const {
+		state->wait();
+	}
+	
+	//! waits for the task and returns its result, rethrows the exception of the task if it threw one
+	decltype(auto) get() const {
+		return state->get();
+	}
+	
+	//! returns the exception that has been thrown by the task (nullptr if none was thrown or the task isn't done yet)
+	std::exception_ptr get_exception() const {
+		return state->get_exception();
+	}
+	
+	//! creates a continuation task that executes "func" once this task has finished,
+	//! "func" is called with a reference to the result of this task (no args if this task has no result)
+	//! NOTE: if this task threw an exception, "func" isn't called and the continuation task rethrows it instead
+	template <typename F>
+	auto then(F&& func) const;
+	
+	//! returns the underlying shared task state
+	const std::shared_ptr<task_state<result_type>>& get_state() const {
+		return state;
+	}
+	
+protected:
+	std::shared_ptr<task_state<result_type>> state;
+	
+};
+
+//! work-stealing task scheduler:
+//! each worker thread has its own task deque (the worker itself pushes/pops at the back, other workers steal from the front),
+//! tasks spawned from threads that aren't workers of this scheduler are put into a shared queue,
+//! idle worker threads sleep until new tasks are spawned (no busy waiting)
+class task_scheduler {
+public:
+	//! returns the global task scheduler (uses one worker thread per logical CPU core, created on first use)
+	static task_scheduler& get();
+	
+	//! creates a new scheduler with "worker_count" worker threads,
+	//! if "worker_count" is 0, this will use the amount of logical CPU cores
+	//! NOTE: worker threads are named "<name>_<index>"
+	explicit task_scheduler(const std::string name = "task", const uint32_t worker_count = 0u);
+	//! stops and joins all worker threads, tasks that haven't been executed yet are discarded
+	~task_scheduler();
+	
+	//! spawns a new task that executes "func" on one of the worker threads, returns a handle to the task
+	template <typename F>
+	auto spawn(F&& func) {
+		auto state = create_task(std::forward<F>(func));
+		schedule(state);
+		return task_handle<typename decltype(state)::element_type::task_result_type> { std::move(state) };
+	}
+	
+	//! executes "func(idx)" for all idx in [begin, end) in parallel and blocks until all have been executed,
+	//! "grain_size" is the amount of consecutive indices that are executed as one chunk (0 = automatic)
+	//! NOTE: the calling thread participates in the execution
+	//! NOTE: if "func" throws, no further chunks are started and the first exception is rethrown
+	template <typename F>
+	void parallel_for(const size_t begin, const size_t end, F&& func, size_t grain_size = 0u);
+	
+	//! tries to execute a single pending task on the calling thread, returns true if a task has been executed
+	bool try_run_one();
+	
+	//! returns the amount of worker threads
+	uint32_t get_worker_count() const {
+		return worker_count;
+	}
+	
+	//! returns true if the calling thread is a worker thread of this scheduler
+	bool is_worker_thread() const;
+	
+	// prohibit copying and moving
+	task_scheduler(const task_scheduler&) = delete;
+	task_scheduler& operator=(const task_scheduler&) = delete;
+	task_scheduler(task_scheduler&&) = delete;
+	task_scheduler& operator=(task_scheduler&&) = delete;
+	
+protected:
+	friend task_state_base;
+	template <typename result_type> friend class task_handle;
+	
+	//! creates a new task state for "func" (doesn't schedule it yet)
+	template <typename F>
+	auto create_task(F&& func) {
+		using op_type = std::decay_t<F>;
+		using result_type = std::decay_t<std::invoke_result_t<op_type&>>;
+		op_type op { std::forward<F>(func) };
+		return std::make_shared<task_state_impl<result_type, op_type>>(*this, std::move(op));
+	}
+	
+	//! schedules the specified task for execution
+	void schedule(std::shared_ptr<task_state_base> task);
+	
+	struct worker_t {
+		atomic_spin_lock queue_lock;
+		std::deque<std::shared_ptr<task_state_base>> queue GUARDED_BY(queue_lock);
+		std::thread thread;
+	};
+	const std::string name;
+	const uint32_t worker_count;
+	std::unique_ptr<worker_t[]> workers;
+	
+	atomic_spin_lock global_queue_lock;
+	//! tasks that have been spawned from non-worker threads
+	std::deque<std::shared_ptr<task_state_base>> global_queue GUARDED_BY(global_queue_lock);
+	
+	//! incremented whenever sleeping workers should wake up
+	alignas(64u) std::atomic<uint32_t> wake_epoch { 0u };
+	//! amount of worker threads that are currently sleeping (or are about to)
+	std::atomic<uint32_t> sleeping_worker_count { 0u };
+	std::atomic<bool> stop { false };
+	
+	//! worker thread function
+	void worker_run(const uint32_t worker_idx);
+	
+	//! returns the next task that should be executed by the specified worker (~0u if not a worker thread):
+	//! tasks of the worker itself, then tasks of the shared queue, then tasks stolen from other workers
+	std::shared_ptr<task_state_base> find_task(const uint32_t worker_idx);
+	
+	//! executes one pending task or if there is none, sleeps until new tasks are spawned or wake_all() is called,
+	//! sleeping is skipped if "abort_sleep" returns true after announcing the sleep
+	template <typename F>
+	void run_one_or_sleep(const uint32_t worker_idx, F&& abort_sleep) {
+		if (auto task = find_task(worker_idx); task) {
+			task->execute();
+			return;
+		}
+		sleeping_worker_count.fetch_add(1u);
+		const auto epoch = wake_epoch.load();
+		// recheck after announcing the sleep: a task that has been scheduled in the meantime would otherwise be missed
+		if (auto task = find_task(worker_idx); task) {
+			sleeping_worker_count.fetch_sub(1u);
+			task->execute();
+			return;
+		}
+		if (!abort_sleep()) {
+			wake_epoch.wait(epoch);
+		}
+		sleeping_worker_count.fetch_sub(1u);
+	}
+	
+	//! wakes up one sleeping worker thread (if any)
+	void wake_one();
+	//! wakes up all sleeping worker threads
+	void wake_all();
+	
+	//! returns the index of the calling worker thread if it is a worker of this scheduler, ~0u otherwise
+	uint32_t get_current_worker_index() const;
+	
+};
+
+template <typename result_type>
+template <typename F>
+auto task_handle<result_type>::then(F&& func) const {
+	auto continuation = state->scheduler.create_task([parent = state, cont_func = std::forward<F>(func)]() mutable {
+		// NOTE: the parent has already finished at this point, get() only rethrows its exception (if any)
+		if constexpr (std::is_void_v<result_type>) {
+			parent->get();
+			return cont_func();
+		} else {
+			return cont_func(parent->get());
+		}
+	});
+	state->add_continuation(continuation);
+	return task_handle<typename decltype(continuation)::element_type::task_result_type> { std::move(continuation) };
+}
+
+template <typename F>
+void task_scheduler::parallel_for(const size_t begin, const size_t end, F&& func, size_t grain_size) {
+	if (begin >= end) {
+		return;
+	}
+	const auto count = end - begin;
+	if (grain_size == 0u) {
+		// aim for ~4 chunks per worker for some load balancing
+		grain_size = std::max(count / (size_t(worker_count) * 4u), size_t(1u));
+	}
+	const auto chunk_count = (count + grain_size - 1u) / grain_size;
+	if (chunk_count == 1u) {
+		for (auto idx = begin; idx < end; ++idx) {
+			func(idx);
+		}
+		return;
+	}
+	
+	// all participants grab chunks from a shared counter until all chunks have been executed
+	std::atomic<size_t> next_chunk { 0u };
+	const auto run_chunks = [&]() {
+		try {
+			for (;;) {
+				const auto chunk = next_chunk.fetch_add(1u, std::memory_order_relaxed);
+				if (chunk >= chunk_count) {
+					return;
+				}
+				const auto chunk_begin = begin + chunk * grain_size;
+				const auto chunk_end = std::min(chunk_begin + grain_size, end);
+				for (auto idx = chunk_begin; idx < chunk_end; ++idx) {
+					func(idx);
+				}
+			}
+		} catch (...) {
+			// don't start any further chunks
+			next_chunk.store(chunk_count, std::memory_order_relaxed);
+			throw;
+		}
+	};
+	
+	const auto helper_count = std::min(size_t(worker_count), chunk_count - 1u);
+	std::vector<task_handle<void>> helpers;
+	helpers.reserve(helper_count);
+	for (size_t i = 0; i < helper_count; ++i) {
+		helpers.emplace_back(spawn([&run_chunks]() { run_chunks(); }));
+	}
+	
+	std::exception_ptr exception;
+	try {
+		run_chunks();
+	} catch (...) {
+		exception = std::current_exception();
+	}
+	// NOTE: must always wait for all helpers, since these reference this stack frame
+	for (const auto& helper : helpers) {
+		helper.wait();
+		if (!exception) {
+			exception = helper.get_exception();
+		}
+	}
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+//! group of tasks that are waited on together (structured join):
+//! all tasks that are run through this group must have finished before the group is destroyed
+class task_group {
+public:
+	explicit task_group(task_scheduler& scheduler_ = task_scheduler::get()) : scheduler(scheduler_) {}
+	//! waits for all tasks of this group (exceptions are discarded)
+	~task_group();
+	
+	//! spawns a new task in this group that executes "func"
+	template <typename F>
+	void run(F&& func) REQUIRES(!tasks_lock) {
+		auto handle = scheduler.spawn(std::forward<F>(func));
+		GUARD(tasks_lock);
+		tasks.emplace_back(handle.get_state());
+	}
+	
+	//! blocks until all tasks of this group have finished, rethrows the first exception that has been thrown by any task
+	void wait() REQUIRES(!tasks_lock);
+	
+	// prohibit copying and moving
+	task_group(const task_group&) = delete;
+	task_group& operator=(const task_group&) = delete;
+	task_group(task_group&&) = delete;
+	task_group& operator=(task_group&&) = delete;
+	
+protected:
+	task_scheduler& scheduler;
+	atomic_spin_lock tasks_lock;
+	std::vector<std::shared_ptr<task_state_base>> tasks GUARDED_BY(tasks_lock);
+	
+};
+
+} // namespace fl
@@ -57,6 +57,7 @@ public:
 	//! interfere with the thread communication and render all thread_base functions useless.
 	//! the run() method will be called continuously from inside thread_base while making sure that
 	//! all thread communication is being processed (finish execution, thread delay, pausing, ...).
+	//! NOTE: in wakeup-driven mode, run() is only called once the thread has been woken up (-> set_wakeup_driven())
 	virtual void run() = 0;
 	
 	//! pauses/halts the thread prior to the next run() iteration
@@ -66,10 +67,10 @@ public:
 	//! unpauses a previously halted thread
 	void unpause();
 	
-	//! this signals the thread to finish its execution and will actually finish after the current or next
-	//! run() call has returned. after that, it will kill the thread object and set the state to FINISHED.
+	//! this signals the thread to finish its execution and will actually finish after the current run() call has returned
+	//! (a sleeping thread is woken up immediately). after that, it will kill the thread object and set the state to FINISHED.
 	//! NOTE: this is a blocking call that won't return until the thread has been joined (or immediately returns
-	//! if the thread object doesn't exist, the thread is still in its initialized state or has already finished)
+	//! if the thread object doesn't exist or the thread has already finished)
 	void finish();
 	
 	//! sets the thread status (this should usually not be called from the outside)
@@ -88,6 +89,7 @@ public:
 	//! sets the delay (sleep time) in milliseconds that the thread will sleep after each run call
 	//! (49 days ought to be enough for anybody).
 	//! NOTE: you can disable this by setting the delay to 0
+	//! NOTE: in wakeup-driven mode, this is the max time the thread will sleep until run() is called without a wakeup (0 = infinite)
 	void set_thread_delay(const size_t delay);
 	//! returns the delay (sleep time) in milliseconds
 	size_t get_thread_delay() const;
@@ -98,6 +100,18 @@ public:
 	//! returns the "yield after run" flag
 	bool get_yield_after_run() const;
 	
+	//! if enabled, the thread sleeps until wakeup() is called (or the thread delay has elapsed if it is non-zero)
+	//! and only then calls run(), rather than calling run() continuously
+	//! NOTE: this is the preferred mode for threads that process work that is queued by other threads
+	void set_wakeup_driven(const bool state);
+	//! returns true if the thread is wakeup-driven
+	bool is_wakeup_driven() const;
+	
+	//! wakes up the thread: in wakeup-driven mode, this triggers the next run() call,
+	//! otherwise this cuts the current thread delay short
+	//! NOTE: multiple wakeups before the next run() call are coalesced into a single one
+	void wakeup();
+	
 	//! returns the given name of the thread
 	const std::string& get_thread_name() const;
 	
@@ -109,13 +123,21 @@ protected:
 	std::atomic<bool> thread_should_finish_flag { false };
 	std::atomic<bool> yield_after_run { true };
 	std::atomic<bool> thread_pause { false };
-	std::condition_variable pause_cv;
-	std::condition_variable delay_cv;
+	std::atomic<bool> wakeup_driven { false };
+	
+	//! held when waking up the thread or changing its state (start, unpause, finish)
+	std::mutex wakeup_lock;
+	//! signaled on wakeup() and on all thread state changes
+	std::condition_variable wakeup_cv;
+	//! set by wakeup(), reset once the thread has woken up (protected by "wakeup_lock")
+	bool wakeup_signaled { false };
 	
 	//! this _must_ be called from the inheriting class to actually start the thread
 	void start();
 	//! the threads internal run method (only used internally)
 	static int _thread_run(thread_base* this_thread_obj);
+	//! sleeps until wakeup() has been called, the thread should finish or "timeout_ms" has elapsed (if non-zero)
+	void wait_for_wakeup(const size_t timeout_ms);
 	
 	// prohibit copying
 	thread_base(const thread_base& tb);
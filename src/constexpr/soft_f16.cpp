@@ -17,6 +17,13 @@
  */
 
 #include <floor/constexpr/soft_f16.hpp>
+#include <algorithm>
+
+#if defined(__AVX512F__) || defined(__F16C__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 // just to make sure this is correct
 static_assert(sizeof(fl::soft_f16) == 2, "invalid soft 16-bit half floating point type size");
@@ -25,3 +32,65 @@ static_assert(sizeof(fl::soft_f16) == 2, "invalid soft 16-bit half floating poin
 static_assert(std::is_trivially_constructible_v<fl::soft_f16>, "soft 16-bit half floating point type must be trivially constructible");
 static_assert(std::is_trivially_copyable_v<fl::soft_f16>, "soft 16-bit half floating point type must be trivially copyable");
 static_assert(std::is_standard_layout_v<fl::soft_f16>);
+
+namespace fl {
+
+size_t convert_f32_to_f16(std::span<const float> src, std::span<soft_f16> dst) {
+	const auto count = std::min(src.size(), dst.size());
+	const auto src_ptr = src.data();
+	auto dst_ptr = dst.data();
+	size_t i = 0;
+#if defined(__AVX512F__)
+	for (; i + 16u <= count; i += 16u) {
+		const auto half_vals = _mm512_cvtps_ph(_mm512_loadu_ps(src_ptr + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_storeu_si256((__m256i*)(dst_ptr + i), half_vals);
+	}
+#endif
+#if defined(__F16C__)
+	for (; i + 8u <= count; i += 8u) {
+		const auto half_vals = _mm256_cvtps_ph(_mm256_loadu_ps(src_ptr + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm_storeu_si128((__m128i*)(dst_ptr + i), half_vals);
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	for (; i + 8u <= count; i += 8u) {
+		const auto half_vals_lo = vcvt_f16_f32(vld1q_f32(src_ptr + i));
+		const auto half_vals = vcvt_high_f16_f32(half_vals_lo, vld1q_f32(src_ptr + i + 4u));
+		vst1q_f16((float16_t*)(dst_ptr + i), half_vals);
+	}
+#endif
+	// remainder (or everything if there is no hardware support)
+	for (; i < count; ++i) {
+		dst_ptr[i] = src_ptr[i];
+	}
+	return count;
+}
+
+size_t convert_f16_to_f32(std::span<const soft_f16> src, std::span<float> dst) {
+	const auto count = std::min(src.size(), dst.size());
+	const auto src_ptr = src.data();
+	auto dst_ptr = dst.data();
+	size_t i = 0;
+#if defined(__AVX512F__)
+	for (; i + 16u <= count; i += 16u) {
+		_mm512_storeu_ps(dst_ptr + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(src_ptr + i))));
+	}
+#endif
+#if defined(__F16C__)
+	for (; i + 8u <= count; i += 8u) {
+		_mm256_storeu_ps(dst_ptr + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src_ptr + i))));
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	for (; i + 8u <= count; i += 8u) {
+		const auto half_vals = vld1q_f16((const float16_t*)(src_ptr + i));
+		vst1q_f32(dst_ptr + i, vcvt_f32_f16(vget_low_f16(half_vals)));
+		vst1q_f32(dst_ptr + i + 4u, vcvt_high_f32_f16(half_vals));
+	}
+#endif
+	// remainder (or everything if there is no hardware support)
+	for (; i < count; ++i) {
+		dst_ptr[i] = src_ptr[i].to_float();
+	}
+	return count;
+}
+
+} // namespace fl
@@ -0,0 +1,141 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/core/async_file_io.hpp>
+#include <floor/core/file_io.hpp>
+#include <floor/core/logger.hpp>
+#include <floor/threading/thread_helpers.hpp>
+#include <algorithm>
+
+namespace fl {
+
+//! max amount of I/O threads that are created when the thread count is determined automatically
+//! NOTE: more threads than this won't help with throughput, but only add contention in the file system
+static constexpr const uint32_t max_auto_thread_count { 8u };
+
+async_file_io::async_file_io(const uint32_t thread_count) {
+	const auto count = (thread_count != 0u ? thread_count : std::clamp(get_logical_core_count(), 1u, max_auto_thread_count));
+	threads.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		threads.emplace_back([this, i] { run(i); });
+	}
+}
+
+async_file_io::~async_file_io() {
+	{
+		std::unique_lock<std::mutex> lock(request_lock);
+		shutdown = true;
+	}
+	request_cv.notify_all();
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+void async_file_io::submit(request_t&& request) {
+	pending_count.fetch_add(1u, std::memory_order_acq_rel);
+	{
+		std::unique_lock<std::mutex> lock(request_lock);
+		requests.emplace(std::move(request));
+	}
+	request_cv.notify_one();
+}
+
+void async_file_io::run(const uint32_t thread_idx) {
+	set_current_thread_name("async_io_" + std::to_string(thread_idx));
+	for (;;) {
+		request_t request;
+		{
+			std::unique_lock<std::mutex> lock(request_lock);
+			request_cv.wait(lock, [this] { return (shutdown || !requests.empty()); });
+			if (requests.empty()) {
+				// shutdown and no more work
+				return;
+			}
+			request = std::move(requests.front());
+			requests.pop();
+		}
+		
+		request();
+		
+		if (pending_count.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+			// NOTE: must lock here, so that the notification can't be missed by wait_idle()
+			std::unique_lock<std::mutex> lock(request_lock);
+			idle_cv.notify_all();
+		}
+	}
+}
+
+void async_file_io::wait_idle() {
+	std::unique_lock<std::mutex> lock(request_lock);
+	idle_cv.wait(lock, [this] { return (pending_count.load(std::memory_order_acquire) == 0u); });
+}
+
+static async_file_io::read_result_t read_file_data(const std::string& filename) {
+	auto [data, size] = file_io::file_to_buffer(filename);
+	if (!data) {
+		log_error("failed to read file \"$\"", filename);
+		return {};
+	}
+	return { .data = std::move(data), .size = size, .success = true };
+}
+
+std::future<async_file_io::read_result_t> async_file_io::read_file(const std::string& filename) {
+	// NOTE: std::function must be copyable -> hold the promise in a shared_ptr
+	auto promise = std::make_shared<std::promise<read_result_t>>();
+	auto ret = promise->get_future();
+	submit([filename, promise] {
+		promise->set_value(read_file_data(filename));
+	});
+	return ret;
+}
+
+std::vector<std::future<async_file_io::read_result_t>> async_file_io::read_files(const std::vector<std::string>& filenames) {
+	std::vector<std::future<read_result_t>> ret;
+	ret.reserve(filenames.size());
+	for (const auto& filename : filenames) {
+		ret.emplace_back(read_file(filename));
+	}
+	return ret;
+}
+
+void async_file_io::read_file(const std::string& filename, read_completion_handler_t completion_handler) {
+	submit([filename, completion_handler = std::move(completion_handler)] {
+		completion_handler(filename, read_file_data(filename));
+	});
+}
+
+std::future<bool> async_file_io::write_file(const std::string& filename, std::vector<uint8_t>&& data) {
+	auto promise = std::make_shared<std::promise<bool>>();
+	auto ret = promise->get_future();
+	submit([filename, promise, data = std::make_shared<std::vector<uint8_t>>(std::move(data))] {
+		promise->set_value(file_io::buffer_to_file(filename, std::span<const uint8_t> { *data }));
+	});
+	return ret;
+}
+
+std::future<bool> async_file_io::write_file(const std::string& filename, const std::span<const uint8_t> data) {
+	auto promise = std::make_shared<std::promise<bool>>();
+	auto ret = promise->get_future();
+	submit([filename, promise, data] {
+		promise->set_value(file_io::buffer_to_file(filename, data));
+	});
+	return ret;
+}
+
+} // namespace fl
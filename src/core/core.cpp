@@ -22,6 +22,9 @@
 #include <thread>
 #include <chrono>
 #include <cassert>
+#include <cstring>
+#include <cerrno>
+#include <filesystem>
 
 #if defined(__WINDOWS__)
 #include <floor/core/platform_windows.hpp>
@@ -54,6 +57,10 @@
 #include <mach/mach_host.h>
 #elif defined(__linux__)
 #include <sys/sysinfo.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
 #endif
 
 #if (defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__))
@@ -778,6 +785,65 @@ std::string create_tmp_file_name(const std::string prefix, const std::string suf
 	return ret;
 }
 
+memory_file::memory_file(const std::string prefix, const std::string suffix, const bool keep_file_) : keep_file(keep_file_) {
+#if defined(__linux__)
+	if (!keep_file) {
+		// NOTE: child processes will open the file through the /proc path of this process -> no need to inherit the fd
+		fd = memfd_create((prefix + suffix).c_str(), MFD_CLOEXEC);
+		if (fd >= 0) {
+			path = "/proc/" + std::to_string(getpid()) + "/fd/" + std::to_string(fd);
+			return;
+		}
+		log_warn("failed to create in-memory file (falling back to a temporary file): $", strerror(errno));
+	}
+#endif
+	path = create_tmp_file_name(prefix, suffix);
+}
+
+memory_file::~memory_file() {
+#if defined(__linux__)
+	if (fd >= 0) {
+		close(fd);
+		return;
+	}
+#endif
+	if (!path.empty() && !keep_file) {
+		std::error_code ec {};
+		(void)std::filesystem::remove(path, ec);
+	}
+}
+
+bool memory_file::read(std::string& dst) const {
+#if defined(__linux__)
+	if (fd >= 0) {
+		struct stat file_stat {};
+		if (fstat(fd, &file_stat) != 0) {
+			log_error("failed to query in-memory file size: $", strerror(errno));
+			return false;
+		}
+		dst.resize(size_t(file_stat.st_size));
+		size_t read_size = 0;
+		while (read_size < dst.size()) {
+			const auto ret = pread(fd, dst.data() + read_size, dst.size() - read_size, off_t(read_size));
+			if (ret < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				log_error("failed to read in-memory file: $", strerror(errno));
+				return false;
+			} else if (ret == 0) {
+				// file shrunk in the meantime
+				dst.resize(read_size);
+				break;
+			}
+			read_size += size_t(ret);
+		}
+		return true;
+	}
+#endif
+	return file_io::file_to_string(path, dst);
+}
+
 std::string to_file_name(const std::string& str) {
 	std::string ret = str;
 	for(auto& ch : ret) {
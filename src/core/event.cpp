@@ -23,44 +23,114 @@
 #if defined(__APPLE__)
 #include <floor/darwin/darwin_helper.hpp>
 #endif
+#include <algorithm>
 
 namespace fl {
 
+namespace event_pool {
+//! block sizes of all size classes (larger objects are allocated from the heap)
+static constexpr const size_t size_class_block_size { 64u };
+static constexpr const size_t size_class_count { 4u };
+//! amount of blocks that are allocated at once when a size class pool is empty
+static constexpr const size_t blocks_per_chunk { 256u };
+
+struct free_block_t {
+	free_block_t* next;
+};
+struct size_class_pool_t {
+	atomic_spin_lock lock;
+	free_block_t* free_list GUARDED_BY(lock) { nullptr };
+};
+
+static std::array<size_class_pool_t, size_class_count>& get_pools() {
+	// NOTE: this is intentionally never destroyed, since event objects may still be destroyed during static destruction
+	static auto pools = new std::array<size_class_pool_t, size_class_count>;
+	return *pools;
+}
+
+void* allocate(const size_t size) {
+	const auto size_class = (std::max(size, size_t(1u)) - 1u) / size_class_block_size;
+	if (size_class >= size_class_count) {
+		return ::operator new(size);
+	}
+	auto& pool = get_pools()[size_class];
+	{
+		GUARD(pool.lock);
+		if (pool.free_list != nullptr) {
+			auto block = pool.free_list;
+			pool.free_list = block->next;
+			return block;
+		}
+	}
+	
+	// pool is empty -> allocate a new chunk (chunks are never freed), use the first block and add all others to the free list
+	const auto block_size = (size_class + 1u) * size_class_block_size;
+	auto chunk = (uint8_t*)::operator new(block_size * blocks_per_chunk);
+	for (size_t i = 1; i < blocks_per_chunk - 1u; ++i) {
+		((free_block_t*)(chunk + i * block_size))->next = (free_block_t*)(chunk + (i + 1u) * block_size);
+	}
+	auto last_block = (free_block_t*)(chunk + (blocks_per_chunk - 1u) * block_size);
+	{
+		GUARD(pool.lock);
+		last_block->next = pool.free_list;
+		pool.free_list = (free_block_t*)(chunk + block_size);
+	}
+	return chunk;
+}
+
+void deallocate(void* ptr, const size_t size) noexcept {
+	if (ptr == nullptr) {
+		return;
+	}
+	const auto size_class = (std::max(size, size_t(1u)) - 1u) / size_class_block_size;
+	if (size_class >= size_class_count) {
+		::operator delete(ptr);
+		return;
+	}
+	auto& pool = get_pools()[size_class];
+	auto block = (free_block_t*)ptr;
+	GUARD(pool.lock);
+	block->next = pool.free_list;
+	pool.free_list = block;
+}
+} // namespace event_pool
+
 event::event() : thread_base("event") {
 	const auto cur_time = SDL_GetTicks();
 	lm_double_click_timer = cur_time;
 	rm_double_click_timer = cur_time;
 	mm_double_click_timer = cur_time;
+	// only handle user events once there are any
+	this->set_wakeup_driven(true);
+	this->set_thread_delay(0);
 	this->start();
 }
 
 event::~event() {
 	// finish/kill the event thread before deleting any shared event data
 	finish();
+	
+	{
+		GUARD(handler_lock);
+		for (auto& handler_list : handler_table) {
+			delete handler_list.exchange(nullptr);
+		}
+		delete overflow_handler_table.exchange(nullptr);
+	}
+	synchronize_handlers();
 }
 
 void event::run() {
 	// user events are handled "asynchronously", so they don't
 	// interfere with other (internal) events or engine code
-	
-	// copy/move user events to a processing queue, so the queue can
-	// still be used in the other (main) event thread
-	user_queue_lock.lock();
-	user_event_queue_processing.swap(user_event_queue);
-	user_queue_lock.unlock();
-	
 	handle_user_events();
 }
 
 void event::handle_events() {
 	// handle queued events first
-	{
-		GUARD(queued_events_lock);
-		for (auto& queued_event : queued_events) {
-			handle_event(queued_event.first, std::move(queued_event.second));
-		}
-		queued_events.clear();
-	}
+	queued_events.consume([this](std::pair<EVENT_TYPE, std::shared_ptr<event_object>>&& queued_event) {
+		handle_event(queued_event.first, std::move(queued_event.second));
+	});
 	
 	// internal engine event handler
 	const auto coord_scale = (floor::get_hidpi() ? floor::get_scale_factor() : 1.0f);
@@ -94,19 +164,19 @@ void event::handle_events() {
 						case SDL_BUTTON_LEFT:
 							if (event_handle.button.down) {
 								handle_event(EVENT_TYPE::MOUSE_LEFT_DOWN,
-											 std::make_shared<mouse_left_down_event>(cur_ticks, mouse_coord));
+											 make_event<mouse_left_down_event>(cur_ticks, mouse_coord));
 							}
 							break;
 						case SDL_BUTTON_RIGHT:
 							if (event_handle.button.down) {
 								handle_event(EVENT_TYPE::MOUSE_RIGHT_DOWN,
-											 std::make_shared<mouse_right_down_event>(cur_ticks, mouse_coord));
+											 make_event<mouse_right_down_event>(cur_ticks, mouse_coord));
 							}
 							break;
 						case SDL_BUTTON_MIDDLE:
 							if (event_handle.button.down) {
 								handle_event(EVENT_TYPE::MOUSE_MIDDLE_DOWN,
-											 std::make_shared<mouse_middle_down_event>(cur_ticks, mouse_coord));
+											 make_event<mouse_middle_down_event>(cur_ticks, mouse_coord));
 							}
 							break;
 						default: break;
@@ -118,20 +188,20 @@ void event::handle_events() {
 						case SDL_BUTTON_LEFT:
 							if (!event_handle.button.down) {
 								handle_event(EVENT_TYPE::MOUSE_LEFT_UP,
-											 std::make_shared<mouse_left_up_event>(cur_ticks, mouse_coord));
+											 make_event<mouse_left_up_event>(cur_ticks, mouse_coord));
 								
 								if (cur_ticks - lm_double_click_timer < ldouble_click_time) {
 									// emit a double click event
 									handle_event(EVENT_TYPE::MOUSE_LEFT_DOUBLE_CLICK,
-												 std::make_shared<mouse_left_double_click_event>(cur_ticks,
-																								 prev_events[EVENT_TYPE::MOUSE_LEFT_DOWN],
-																								 prev_events[EVENT_TYPE::MOUSE_LEFT_UP]));
+												 make_event<mouse_left_double_click_event>(cur_ticks,
+																						   get_prev_mouse_event(EVENT_TYPE::MOUSE_LEFT_DOWN),
+																						   get_prev_mouse_event(EVENT_TYPE::MOUSE_LEFT_UP)));
 								} else {
 									// only emit a normal click event
 									handle_event(EVENT_TYPE::MOUSE_LEFT_CLICK,
-												 std::make_shared<mouse_left_click_event>(cur_ticks,
-																						  prev_events[EVENT_TYPE::MOUSE_LEFT_DOWN],
-																						  prev_events[EVENT_TYPE::MOUSE_LEFT_UP]));
+												 make_event<mouse_left_click_event>(cur_ticks,
+																					get_prev_mouse_event(EVENT_TYPE::MOUSE_LEFT_DOWN),
+																					get_prev_mouse_event(EVENT_TYPE::MOUSE_LEFT_UP)));
 								}
 								
 								lm_double_click_timer = cur_ticks;
@@ -140,20 +210,20 @@ void event::handle_events() {
 						case SDL_BUTTON_RIGHT:
 							if (!event_handle.button.down) {
 								handle_event(EVENT_TYPE::MOUSE_RIGHT_UP,
-											 std::make_shared<mouse_right_up_event>(cur_ticks, mouse_coord));
+											 make_event<mouse_right_up_event>(cur_ticks, mouse_coord));
 								
 								if (cur_ticks - rm_double_click_timer < rdouble_click_time) {
 									// emit a double click event
 									handle_event(EVENT_TYPE::MOUSE_RIGHT_DOUBLE_CLICK,
-												 std::make_shared<mouse_right_double_click_event>(cur_ticks,
-																								  prev_events[EVENT_TYPE::MOUSE_RIGHT_DOWN],
-																								  prev_events[EVENT_TYPE::MOUSE_RIGHT_UP]));
+												 make_event<mouse_right_double_click_event>(cur_ticks,
+																							get_prev_mouse_event(EVENT_TYPE::MOUSE_RIGHT_DOWN),
+																							get_prev_mouse_event(EVENT_TYPE::MOUSE_RIGHT_UP)));
 								} else {
 									// only emit a normal click event
 									handle_event(EVENT_TYPE::MOUSE_RIGHT_CLICK,
-												 std::make_shared<mouse_right_click_event>(cur_ticks,
-																						   prev_events[EVENT_TYPE::MOUSE_RIGHT_DOWN],
-																						   prev_events[EVENT_TYPE::MOUSE_RIGHT_UP]));
+												 make_event<mouse_right_click_event>(cur_ticks,
+																					 get_prev_mouse_event(EVENT_TYPE::MOUSE_RIGHT_DOWN),
+																					 get_prev_mouse_event(EVENT_TYPE::MOUSE_RIGHT_UP)));
 								}
 								
 								rm_double_click_timer = cur_ticks;
@@ -162,20 +232,20 @@ void event::handle_events() {
 						case SDL_BUTTON_MIDDLE:
 							if (!event_handle.button.down) {
 								handle_event(EVENT_TYPE::MOUSE_MIDDLE_UP,
-											 std::make_shared<mouse_middle_up_event>(cur_ticks, mouse_coord));
+											 make_event<mouse_middle_up_event>(cur_ticks, mouse_coord));
 								
 								if (cur_ticks - mm_double_click_timer < mdouble_click_time) {
 									// emit a double click event
 									handle_event(EVENT_TYPE::MOUSE_MIDDLE_DOUBLE_CLICK,
-												 std::make_shared<mouse_middle_double_click_event>(cur_ticks,
-																								   prev_events[EVENT_TYPE::MOUSE_MIDDLE_DOWN],
-																								   prev_events[EVENT_TYPE::MOUSE_MIDDLE_UP]));
+												 make_event<mouse_middle_double_click_event>(cur_ticks,
+																							 get_prev_mouse_event(EVENT_TYPE::MOUSE_MIDDLE_DOWN),
+																							 get_prev_mouse_event(EVENT_TYPE::MOUSE_MIDDLE_UP)));
 								} else {
 									// only emit a normal click event
 									handle_event(EVENT_TYPE::MOUSE_MIDDLE_CLICK,
-												 std::make_shared<mouse_middle_click_event>(cur_ticks,
-																							prev_events[EVENT_TYPE::MOUSE_MIDDLE_DOWN],
-																							prev_events[EVENT_TYPE::MOUSE_MIDDLE_UP]));
+												 make_event<mouse_middle_click_event>(cur_ticks,
+																					  get_prev_mouse_event(EVENT_TYPE::MOUSE_MIDDLE_DOWN),
+																					  get_prev_mouse_event(EVENT_TYPE::MOUSE_MIDDLE_UP)));
 								}
 								
 								mm_double_click_timer = cur_ticks;
@@ -193,7 +263,7 @@ void event::handle_events() {
 					const float2 abs_pos { event_handle.motion.x * coord_scale, event_handle.motion.y * coord_scale };
 					const float2 rel_move { event_handle.motion.xrel * coord_scale, event_handle.motion.yrel * coord_scale };
 					handle_event(EVENT_TYPE::MOUSE_MOVE,
-								 std::make_shared<mouse_move_event>(cur_ticks, abs_pos, rel_move));
+								 make_event<mouse_move_event>(cur_ticks, abs_pos, rel_move));
 					break;
 				}
 				case SDL_EVENT_MOUSE_WHEEL: {
@@ -204,7 +274,7 @@ void event::handle_events() {
 					if (event_handle.wheel.direction == SDL_MOUSEWHEEL_NORMAL) {
 						amount = -amount;
 					}
-					handle_event(EVENT_TYPE::MOUSE_WHEEL, std::make_shared<mouse_wheel_event>(cur_ticks, mouse_coord, amount));
+					handle_event(EVENT_TYPE::MOUSE_WHEEL, make_event<mouse_wheel_event>(cur_ticks, mouse_coord, amount));
 					break;
 				}
 				default: break;
@@ -220,18 +290,18 @@ void event::handle_events() {
 			if (event_type == SDL_EVENT_FINGER_DOWN) {
 				if (event_handle.tfinger.type == SDL_EVENT_FINGER_DOWN) {
 					handle_event(EVENT_TYPE::FINGER_DOWN,
-								 std::make_shared<finger_down_event>(cur_ticks, finger_coord, pressure, finger_id));
+								 make_event<finger_down_event>(cur_ticks, finger_coord, pressure, finger_id));
 				}
 			} else if (event_type == SDL_EVENT_FINGER_UP) {
 				if (event_handle.tfinger.type == SDL_EVENT_FINGER_UP) {
 					handle_event(EVENT_TYPE::FINGER_UP,
-								 std::make_shared<finger_up_event>(cur_ticks, finger_coord, pressure, finger_id));
+								 make_event<finger_up_event>(cur_ticks, finger_coord, pressure, finger_id));
 				}
 			} else if (event_type == SDL_EVENT_FINGER_MOTION) {
 				if (event_handle.tfinger.type == SDL_EVENT_FINGER_MOTION) {
 					const float2 rel_move { event_handle.tfinger.dx, event_handle.tfinger.dy };
 					handle_event(EVENT_TYPE::FINGER_MOVE,
-								 std::make_shared<finger_move_event>(cur_ticks, finger_coord, rel_move, pressure, finger_id));
+								 make_event<finger_move_event>(cur_ticks, finger_coord, rel_move, pressure, finger_id));
 				}
 			}
 		} else {
@@ -239,23 +309,23 @@ void event::handle_events() {
 			switch (event_type) {
 				case SDL_EVENT_KEY_UP:
 					handle_event(EVENT_TYPE::KEY_UP,
-								 std::make_shared<key_up_event>(cur_ticks, event_handle.key.key));
+								 make_event<key_up_event>(cur_ticks, event_handle.key.key));
 					break;
 				case SDL_EVENT_KEY_DOWN:
 					if ((mod_state & platform_copy_paste_modifier) != 0 && event_handle.key.key == SDLK_V) {
 						handle_event(EVENT_TYPE::TEXT_PASTE,
-									 std::make_shared<text_paste_event>(cur_ticks, SDL_HasClipboardText() ? SDL_GetClipboardText() : ""));
+									 make_event<text_paste_event>(cur_ticks, SDL_HasClipboardText() ? SDL_GetClipboardText() : ""));
 					}
 					
 					// always emit this, even when TEXT_PASTE is also emitted
 					handle_event(EVENT_TYPE::KEY_DOWN,
-								 std::make_shared<key_up_event>(cur_ticks, event_handle.key.key));
+								 make_event<key_up_event>(cur_ticks, event_handle.key.key));
 					break;
 				case SDL_EVENT_TEXT_INPUT: {
 					const auto codes = unicode::utf8_to_unicode(event_handle.text.text);
 					for (const auto& code : codes) {
 						handle_event(EVENT_TYPE::UNICODE_INPUT,
-									 std::make_shared<unicode_input_event>(cur_ticks, code));
+									 make_event<unicode_input_event>(cur_ticks, code));
 					}
 					break;
 				}
@@ -263,15 +333,15 @@ void event::handle_events() {
 				case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED: {
 					const size2 new_size((size_t)event_handle.window.data1, (size_t)event_handle.window.data2);
 					handle_event(EVENT_TYPE::WINDOW_RESIZE,
-								 std::make_shared<window_resize_event>(cur_ticks, new_size));
+								 make_event<window_resize_event>(cur_ticks, new_size));
 					break;
 				}
 				case SDL_EVENT_QUIT:
-					handle_event(EVENT_TYPE::QUIT, std::make_shared<quit_event>(cur_ticks));
+					handle_event(EVENT_TYPE::QUIT, make_event<quit_event>(cur_ticks));
 					break;
 				case SDL_EVENT_CLIPBOARD_UPDATE:
 					handle_event(EVENT_TYPE::CLIPBOARD_UPDATE,
-								 std::make_shared<clipboard_update_event>(cur_ticks, SDL_HasClipboardText() ? SDL_GetClipboardText() : ""));
+								 make_event<clipboard_update_event>(cur_ticks, SDL_HasClipboardText() ? SDL_GetClipboardText() : ""));
 					break;
 				default: break;
 			}
@@ -308,142 +378,294 @@ void event::set_mdouble_click_time(uint32_t dctime) {
 	mdouble_click_time = dctime;
 }
 
+const event::handler_list_t* event::get_handler_list(const EVENT_TYPE type) const {
+	if (const auto idx = get_handler_table_index(type); idx) [[likely]] {
+		return handler_table[*idx].load();
+	}
+	const auto overflow_table = overflow_handler_table.load();
+	if (overflow_table == nullptr) {
+		return nullptr;
+	}
+	const auto iter = std::lower_bound(overflow_table->begin(), overflow_table->end(), type, [](const auto& entry, const EVENT_TYPE& type_) {
+		return (entry.first < type_);
+	});
+	if (iter == overflow_table->end() || iter->first != type) {
+		return nullptr;
+	}
+	return &iter->second;
+}
+
+template <typename F>
+void event::modify_handler_list(const EVENT_TYPE type, F&& modifier) {
+	if (const auto idx = get_handler_table_index(type); idx) {
+		auto& entry = handler_table[*idx];
+		const auto old_list = entry.load();
+		auto new_list = (old_list != nullptr ? std::make_unique<handler_list_t>(*old_list) : std::make_unique<handler_list_t>());
+		modifier(*new_list);
+		entry.store(!new_list->empty() ? new_list.release() : nullptr);
+		if (old_list != nullptr) {
+			retired_handler_lists.emplace_back(old_list);
+		}
+		return;
+	}
+	
+	// event type doesn't fit into the flat table -> modify a copy of the overflow table
+	const auto old_table = overflow_handler_table.load();
+	auto new_table = (old_table != nullptr ? std::make_unique<overflow_handler_table_t>(*old_table) : std::make_unique<overflow_handler_table_t>());
+	auto iter = std::lower_bound(new_table->begin(), new_table->end(), type, [](const auto& entry, const EVENT_TYPE& type_) {
+		return (entry.first < type_);
+	});
+	if (iter == new_table->end() || iter->first != type) {
+		iter = new_table->emplace(iter, type, handler_list_t {});
+	}
+	modifier(iter->second);
+	if (iter->second.empty()) {
+		new_table->erase(iter);
+	}
+	overflow_handler_table.store(!new_table->empty() ? new_table.release() : nullptr);
+	if (old_table != nullptr) {
+		retired_overflow_handler_tables.emplace_back(old_table);
+	}
+}
+
+//! amount of dispatches the current thread is in (> 0 if we're inside an event handler)
+static thread_local uint32_t thread_dispatch_depth { 0u };
+
+void event::reclaim_handler_lists() {
+	if (retired_handler_lists.empty() && retired_overflow_handler_tables.empty()) {
+		return;
+	}
+	// NOTE: any dispatch that starts after this point will only see the newly published handler lists
+	if (active_dispatch_counts[0].load() != 0u || active_dispatch_counts[1].load() != 0u) {
+		return;
+	}
+	retired_handler_lists.clear();
+	retired_overflow_handler_tables.clear();
+}
+
+void event::synchronize_handlers() {
+	if (thread_dispatch_depth > 0u) {
+		// called from an event handler -> can't wait on our own dispatch, defer to a later add/remove call
+		return;
+	}
+	
+	GUARD(synchronize_lock);
+	// grab all lists that have been retired up to now, any dispatch that starts after this point will only see newer lists
+	std::vector<std::unique_ptr<const handler_list_t>> handler_lists;
+	std::vector<std::unique_ptr<const overflow_handler_table_t>> overflow_handler_tables;
+	{
+		GUARD(handler_lock);
+		handler_lists.swap(retired_handler_lists);
+		overflow_handler_tables.swap(retired_overflow_handler_tables);
+	}
+	if (handler_lists.empty() && overflow_handler_tables.empty()) {
+		return;
+	}
+	
+	// advance the epoch and wait until all dispatches of the previous epoch have finished:
+	// new dispatches are counted in the other slot, so this only waits on dispatches that may still use the retired lists
+	// NOTE: dispatches of even older epochs have already been waited on by previous synchronizations
+	const auto prev_epoch = dispatch_epoch.fetch_add(1u);
+	auto& prev_active_count = active_dispatch_counts[prev_epoch & 1u];
+	spin_wait_condition([&prev_active_count]() { return (prev_active_count.load() == 0u); });
+	// -> retired lists are deleted here
+}
+
+//! counts an active dispatch in the slot of the current dispatch epoch for the lifetime of this object
+class dispatch_scope {
+public:
+	dispatch_scope(std::atomic<uint64_t>& dispatch_epoch, std::array<std::atomic<uint32_t>, 2>& active_dispatch_counts) {
+		for (;;) {
+			const auto epoch = dispatch_epoch.load();
+			active_dispatch_count = &active_dispatch_counts[epoch & 1u];
+			active_dispatch_count->fetch_add(1u);
+			// if the epoch has been advanced in the meantime, we might not be waited on -> retry in the new epoch
+			if (dispatch_epoch.load() == epoch) [[likely]] {
+				break;
+			}
+			active_dispatch_count->fetch_sub(1u);
+		}
+		++thread_dispatch_depth;
+	}
+	~dispatch_scope() {
+		--thread_dispatch_depth;
+		active_dispatch_count->fetch_sub(1u);
+	}
+	
+protected:
+	std::atomic<uint32_t>* active_dispatch_count { nullptr };
+};
+
 void event::add_event_handler(handler_f& handler_, EVENT_TYPE type) {
 	GUARD(handler_lock);
-	handlers.emplace(type, handler_);
+	modify_handler_list(type, [&handler_](handler_list_t& list) {
+		list.handlers.emplace_back(&handler_);
+	});
+	reclaim_handler_lists();
 }
 
 void event::add_inline_event_handler(handler_f& handler_, EVENT_TYPE type) {
 	GUARD(handler_lock);
-	inline_handlers.emplace(type, handler_);
+	modify_handler_list(type, [&handler_](handler_list_t& list) {
+		list.inline_handlers.emplace_back(&handler_);
+	});
+	reclaim_handler_lists();
 }
 
 void event::add_internal_event_handler(internal_handler_f& handler_, EVENT_TYPE type) {
 	GUARD(handler_lock);
-	internal_handlers.emplace(type, handler_);
+	modify_handler_list(type, [&handler_](handler_list_t& list) {
+		list.internal_handlers.emplace_back(&handler_);
+	});
+	reclaim_handler_lists();
 }
 
 void event::add_event(const EVENT_TYPE type, std::shared_ptr<event_object> obj) {
 	// queue event, this will later be handled by handle_events()
 	// NOTE: this is required for multi-threaded correctness
-	GUARD(queued_events_lock);
-	queued_events.emplace_back(type, std::move(obj));
+	queued_events.push({ type, std::move(obj) });
 }
 
 void event::handle_event(const EVENT_TYPE& type, std::shared_ptr<event_object> obj) {
-	// set/override last event for this type
-	prev_events[type] = obj;
-	
-	// call internal event handlers directly
-	GUARD(handler_lock);
-	
-	const auto inline_range = inline_handlers.equal_range(type);
-	for (auto iter = inline_range.first; iter != inline_range.second; ++iter) {
-		iter->second(type, obj);
+	// set/override last event for this type if it's needed later on
+	if (const auto prev_idx = get_prev_mouse_event_index(type); prev_idx) {
+		prev_mouse_events[*prev_idx] = obj;
 	}
 	
-	const auto range = internal_handlers.equal_range(type);
-	for (auto iter = range.first; iter != range.second; ++iter) {
-		iter->second(type, obj);
+	// call inline and internal event handlers directly
+	{
+		dispatch_scope scope(dispatch_epoch, active_dispatch_counts);
+		if (const auto list = get_handler_list(type); list != nullptr) {
+			for (const auto& handler : list->inline_handlers) {
+				(*handler)(type, obj);
+			}
+			for (const auto& handler : list->internal_handlers) {
+				(*handler)(type, obj);
+			}
+		}
 	}
 	
-	// push to user event queue (these will be handled later on)
-	user_queue_lock.lock();
-	user_event_queue.push(make_pair(type, obj));
-	user_queue_lock.unlock();
+	// push to user event queue (these will be handled later on) and trigger the event thread
+	user_event_queue.push({ type, std::move(obj) });
+	wakeup();
 }
 
 void event::handle_user_events() {
-	while (!user_event_queue_processing.empty()) {
-		// pop next event
-		auto evt = user_event_queue_processing.front();
-		user_event_queue_processing.pop();
-		
+	user_event_queue.consume([this](std::pair<EVENT_TYPE, std::shared_ptr<event_object>>&& evt) {
 		// call user event handlers
-		GUARD(handler_lock);
-		
-		const auto range = handlers.equal_range(evt.first);
-		for (auto iter = range.first; iter != range.second; iter++) {
-			if (iter->second(evt.first, evt.second)) {
+		dispatch_scope scope(dispatch_epoch, active_dispatch_counts);
+		const auto list = get_handler_list(evt.first);
+		if (list == nullptr) {
+			return;
+		}
+		for (const auto& handler : list->handlers) {
+			if ((*handler)(evt.first, evt.second)) {
 				// -> event handled, abort now
 				break;
 			}
 		}
+	});
+}
+
+//! removes all occurrences of "handler_" from "handlers"
+template <typename handler_type>
+static void remove_handler(std::vector<handler_type*>& handlers, const handler_type& handler_) {
+	// good old pointer comparison ...
+	std::erase(handlers, &handler_);
+}
+
+//! removes the first occurrence of "handler_" from "handlers"
+template <typename handler_type>
+static void remove_first_handler(std::vector<handler_type*>& handlers, const handler_type& handler_) {
+	if (auto iter = std::find(handlers.begin(), handlers.end(), &handler_); iter != handlers.end()) {
+		handlers.erase(iter);
 	}
 }
 
-void event::remove_event_handler(const handler_f& handler_) {
-	GUARD(handler_lock);
-	for (auto handler_iter = handlers.cbegin(); handler_iter != handlers.cend(); ) {
-		// good old pointer comparison ...
-		if (&handler_iter->second == &handler_) {
-			handler_iter = handlers.erase(handler_iter);
-		} else {
-			++handler_iter;
+//! calls "modifier(handler_list_t&)" for all event types that currently have handlers
+template <typename F>
+void event::modify_all_handler_lists(F&& modifier) {
+	for (uint32_t idx = 0; idx < handler_table.size(); ++idx) {
+		if (handler_table[idx].load() != nullptr) {
+			const auto type = EVENT_TYPE((1u << (24u + idx / handler_table_types_per_category)) + idx % handler_table_types_per_category);
+			modify_handler_list(type, modifier);
+		}
+	}
+	if (const auto overflow_table = overflow_handler_table.load(); overflow_table != nullptr) {
+		std::vector<EVENT_TYPE> types;
+		for (const auto& entry : *overflow_table) {
+			types.emplace_back(entry.first);
+		}
+		for (const auto& type : types) {
+			modify_handler_list(type, modifier);
 		}
 	}
 }
 
+void event::remove_event_handler(const handler_f& handler_) {
+	{
+		GUARD(handler_lock);
+		modify_all_handler_lists([&handler_](handler_list_t& list) {
+			remove_handler(list.handlers, handler_);
+		});
+	}
+	synchronize_handlers();
+}
+
 void event::remove_inline_event_handler(const handler_f& handler_) {
-	GUARD(handler_lock);
-	for (auto handler_iter = inline_handlers.cbegin(); handler_iter != inline_handlers.cend(); ) {
-		// good old pointer comparison ...
-		if (&handler_iter->second == &handler_) {
-			handler_iter = inline_handlers.erase(handler_iter);
-		} else {
-			++handler_iter;
-		}
+	{
+		GUARD(handler_lock);
+		modify_all_handler_lists([&handler_](handler_list_t& list) {
+			remove_handler(list.inline_handlers, handler_);
+		});
 	}
+	synchronize_handlers();
 }
 
 void event::remove_event_types_from_handler(const handler_f& handler_, const std::set<EVENT_TYPE>& types) {
-	GUARD(handler_lock);
-	for (const auto& type : types) {
-		const auto range = handlers.equal_range(type);
-		for (auto iter = range.first; iter != range.second; iter++) {
-			if (&iter->second == &handler_) {
-				handlers.erase(iter);
-				break;
-			}
+	{
+		GUARD(handler_lock);
+		for (const auto& type : types) {
+			modify_handler_list(type, [&handler_](handler_list_t& list) {
+				remove_first_handler(list.handlers, handler_);
+			});
 		}
 	}
+	synchronize_handlers();
 }
 
 void event::remove_event_types_from_inline_handler(const handler_f& handler_, const std::set<EVENT_TYPE>& types) {
-	GUARD(handler_lock);
-	for (const auto& type : types) {
-		const auto range = inline_handlers.equal_range(type);
-		for (auto iter = range.first; iter != range.second; iter++) {
-			if (&iter->second == &handler_) {
-				inline_handlers.erase(iter);
-				break;
-			}
+	{
+		GUARD(handler_lock);
+		for (const auto& type : types) {
+			modify_handler_list(type, [&handler_](handler_list_t& list) {
+				remove_first_handler(list.inline_handlers, handler_);
+			});
 		}
 	}
+	synchronize_handlers();
 }
 
 void event::remove_internal_event_handler(const internal_handler_f& handler_) {
-	GUARD(handler_lock);
-	for(auto handler_iter = internal_handlers.cbegin(); handler_iter != internal_handlers.cend(); ) {
-		if (&handler_iter->second == &handler_) {
-			handler_iter = internal_handlers.erase(handler_iter);
-		} else {
-			++handler_iter;
-		}
+	{
+		GUARD(handler_lock);
+		modify_all_handler_lists([&handler_](handler_list_t& list) {
+			remove_handler(list.internal_handlers, handler_);
+		});
 	}
+	synchronize_handlers();
 }
 
 void event::remove_internal_event_types_from_handler(const internal_handler_f& handler_, const std::set<EVENT_TYPE>& types) {
-	GUARD(handler_lock);
-	for (const auto& type : types) {
-		const auto range = internal_handlers.equal_range(type);
-		for (auto iter = range.first; iter != range.second; iter++) {
-			if (&iter->second == &handler_) {
-				internal_handlers.erase(iter);
-				break;
-			}
+	{
+		GUARD(handler_lock);
+		for (const auto& type : types) {
+			modify_handler_list(type, [&handler_](handler_list_t& list) {
+				remove_first_handler(list.internal_handlers, handler_);
+			});
 		}
 	}
+	synchronize_handlers();
 }
 
 } // namespace fl
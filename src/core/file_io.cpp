@@ -234,6 +234,10 @@ std::pair<aligned_ptr<uint8_t>, size_t> file_io::file_to_buffer_uncached(const s
 #endif
 }
 
+mapped_file file_io::map_file(const std::string& filename, const mapped_file::ACCESS_PATTERN access_pattern) {
+	return mapped_file(filename, access_pattern);
+}
+
 bool file_io::file_to_string(const std::string& filename, std::string& str) {
 	file_io file(filename, file_io::OPEN_TYPE::READ_BINARY);
 	if(!file.is_open()) {
@@ -24,6 +24,7 @@
 #include <floor/core/core.hpp>
 #include <floor/core/cpp_ext.hpp>
 #include <cassert>
+#include <ranges>
 
 //#define FLOOR_DEBUG_PARSER 1
 //#define FLOOR_DEBUG_PARSER_SET_NAMES 1
@@ -49,7 +50,7 @@ void json_value::print(std::ostream& stream, const uint32_t depth) const {
 			stream << (arg ? "true" : "false");
 		} else if constexpr (std::is_same_v<value_type, json_object>) {
 			const std::string space_string((depth + 1) * 4, ' ');
-			stream << "{" << std::endl;
+			stream << "{\n";
 			size_t i = 0, count = size(arg);
 			for (const auto& entry : arg) {
 				stream << space_string << '\"' << entry.first << "\": ";
@@ -57,20 +58,20 @@ void json_value::print(std::ostream& stream, const uint32_t depth) const {
 				if (i < count - 1) {
 					stream << ",";
 				}
-				stream << std::endl;
+				stream << '\n';
 				++i;
 			}
 			stream << std::string(depth * 4, ' ') << "}";
 		} else if constexpr (std::is_same_v<value_type, json_array>) {
 			const std::string space_string((depth + 1) * 4, ' ');
-			stream << "[" << std::endl;
+			stream << "[\n";
 			for (size_t i = 0, count = size(arg); i < count; ++i) {
 				stream << space_string;
 				arg[i].print(stream, depth + 1);
 				if (i < count - 1) {
 					stream << ",";
 				}
-				stream << std::endl;
+				stream << '\n';
 			}
 			stream << std::string(depth * 4, ' ') << "]";
 		} else {
@@ -80,7 +81,7 @@ void json_value::print(std::ostream& stream, const uint32_t depth) const {
 	
 	// one last newline if this is @ depth 0
 	if (depth == 0) {
-		stream << std::endl;
+		stream << '\n';
 	}
 }
 
@@ -694,11 +695,12 @@ struct json_grammar {
 					switch(jnode->type) {
 						case json_node::JSON_NODE_TYPE::OBJECT: {
 							auto onode = (object_node*)jnode;
+							// insert all members at once (only sorts once)
 							json_object obj;
-							for (auto& object : onode->objects) {
-								obj.emplace(std::move(((member_node*)object.get())->name),
-											std::move(((value_node*)((member_node*)object.get())->value.get())->value));
-							}
+							obj.insert_range(onode->objects | std::views::transform([](auto& object) {
+								auto mnode = (member_node*)object.get();
+								return std::pair { std::move(mnode->name), std::move(((value_node*)mnode->value.get())->value) };
+							}));
 							onode->objects.clear();
 							return { std::make_shared<value_node>(json_value { std::move(obj) }) };
 						}
@@ -842,6 +844,56 @@ document create_document_from_string(const std::string& json_data, const std::st
 	floor_return_no_nrvo(doc);
 }
 
+const json_value* json_value::find(const std::string_view key) const {
+	const auto object_ptr = std::get_if<json_object>(&value);
+	if (!object_ptr) {
+		return nullptr;
+	}
+	const auto iter = object_ptr->find(key);
+	if (iter == object_ptr->end()) {
+		return nullptr;
+	}
+	return &iter->second;
+}
+
+const json_value* json_value::find_path(const std::string_view path) const {
+	const json_value* cur_node = this;
+	for (size_t pos = 0; pos < path.size();) {
+		auto dot_pos = path.find('.', pos);
+		if (dot_pos == std::string_view::npos) {
+			dot_pos = path.size();
+		}
+		cur_node = cur_node->find(path.substr(pos, dot_pos - pos));
+		if (!cur_node) {
+			return nullptr;
+		}
+		pos = dot_pos + 1;
+	}
+	return cur_node;
+}
+
+json_path::json_path(const std::string_view path_str_) : path_str(path_str_) {
+	for (size_t pos = 0; pos < path_str.size();) {
+		auto dot_pos = path_str.find('.', pos);
+		if (dot_pos == std::string::npos) {
+			dot_pos = path_str.size();
+		}
+		keys.emplace_back(path_str.substr(pos, dot_pos - pos));
+		pos = dot_pos + 1;
+	}
+}
+
+const json_value* json_path::resolve(const json_value& root) const {
+	const json_value* cur_node = &root;
+	for (const auto& key : keys) {
+		cur_node = cur_node->find(key);
+		if (!cur_node) {
+			return nullptr;
+		}
+	}
+	return cur_node;
+}
+
 template <typename T> static std::pair<bool, T> extract_value(const document& doc, const std::string& path) {
 	// empty path -> return root value
 	if(path.empty()) {
@@ -856,44 +908,37 @@ template <typename T> static std::pair<bool, T> extract_value(const document& do
 		return { false, T {} };
 	}
 	
-	// tokenize input path, then traverse
-	const auto path_stack = core::tokenize(path, '.');
+	// traverse the path without tokenizing it first (no allocations)
+	const std::string_view path_view = path;
 	const json_value* cur_node = &doc.root;
-	for (size_t i = 0, count = path_stack.size(); i < count; ++i) {
-		const auto& key = path_stack[i];
-		bool found = false;
-		const auto object_ptr = std::get_if<json_object>(&cur_node->value);
-		assert(object_ptr);
-		if (!object_ptr) { // should never happen if we get here, but just in case ...
-			return { false, T {} };
+	for (size_t pos = 0; pos < path_view.size();) {
+		auto dot_pos = path_view.find('.', pos);
+		if (dot_pos == std::string_view::npos) {
+			dot_pos = path_view.size();
 		}
-		for (auto&& member : *object_ptr) {
-			if(member.first == key) {
-				// is leaf?
-				if(i == count - 1) {
-					const auto ret = member.second.get<T>();
-					if(!ret.first) {
-						log_error("type mismatch: value of \"$\" is not of the requested type!", path);
-					}
-					return ret;
-				}
-				// set to next child node
-				cur_node = &member.second;
-				found = true;
-				break;
-			}
+		const auto key = path_view.substr(pos, dot_pos - pos);
+		
+		// check if the current node is actually a json object
+		if (cur_node->value.index() != (size_t)json_value::VALUE_TYPE::OBJECT) {
+			log_error("found child node ($) is not a json object (path: $)!", path_view.substr(0, pos - 1), path);
+			return { false, T {} };
 		}
 		
 		// didn't find it -> abort
-		if(!found) {
+		cur_node = cur_node->find(key);
+		if (!cur_node) {
 			return { false, T {} };
 		}
 		
-		// check if child node is actually a json object
-		if (cur_node->value.index() != (size_t)json_value::VALUE_TYPE::OBJECT) {
-			log_error("found child node ($) is not a json object (path: $)!", key, path);
-			return { false, T {} };
+		// is leaf?
+		if (dot_pos == path_view.size()) {
+			auto ret = cur_node->get<T>();
+			if (!ret.first) {
+				log_error("type mismatch: value of \"$\" is not of the requested type!", path);
+			}
+			return ret;
 		}
+		pos = dot_pos + 1;
 	}
 	return { false, T {} };
 }
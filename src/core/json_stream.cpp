@@ -0,0 +1,926 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/core/json_stream.hpp>
+#include <floor/core/logger.hpp>
+#include <floor/core/cpp_ext.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace fl::json {
+using namespace std::literals;
+
+//! if "ch" must be escaped, writes the escape sequence to "escaped_ch" and returns its length, returns 0 otherwise
+static inline size_t escape_char(const uint8_t ch, char (&escaped_ch)[6]) {
+	static constexpr const char hex_chars[] { "0123456789abcdef" };
+	if (ch >= 0x20u && ch != '"' && ch != '\\') {
+		return 0;
+	}
+	escaped_ch[0] = '\\';
+	switch (ch) {
+		case '"': escaped_ch[1] = '"'; return 2;
+		case '\\': escaped_ch[1] = '\\'; return 2;
+		case '\b': escaped_ch[1] = 'b'; return 2;
+		case '\f': escaped_ch[1] = 'f'; return 2;
+		case '\n': escaped_ch[1] = 'n'; return 2;
+		case '\r': escaped_ch[1] = 'r'; return 2;
+		case '\t': escaped_ch[1] = 't'; return 2;
+		default:
+			escaped_ch[1] = 'u';
+			escaped_ch[2] = '0';
+			escaped_ch[3] = '0';
+			escaped_ch[4] = hex_chars[ch >> 4u];
+			escaped_ch[5] = hex_chars[ch & 0xFu];
+			return 6;
+	}
+}
+
+void escape_string(const std::string_view str, std::string& dst) {
+	size_t run_start = 0;
+	char escaped_ch[6];
+	for (size_t i = 0, count = str.size(); i < count; ++i) {
+		const auto escaped_len = escape_char((uint8_t)str[i], escaped_ch);
+		if (escaped_len == 0) {
+			continue;
+		}
+		dst.append(str.data() + run_start, i - run_start);
+		dst.append(escaped_ch, escaped_len);
+		run_start = i + 1;
+	}
+	dst.append(str.data() + run_start, str.size() - run_start);
+}
+
+//////////////////////////////////////////
+// stream_reader
+
+//! states of the reader state machine
+enum class READER_STATE : uint32_t {
+	//! expecting a value (root value, after ':', or after ',' in an array)
+	VALUE,
+	//! after '[': expecting a value or ']'
+	ARRAY_FIRST,
+	//! after '{': expecting a key or '}'
+	OBJECT_FIRST,
+	//! after ',' in an object: expecting a key
+	KEY,
+	//! after a key: expecting ':'
+	COLON,
+	//! after a value in an object/array: expecting ',' or the end of the object/array
+	NEXT,
+	//! after a complete root value: expecting EOF (or another root value)
+	ROOT_END,
+};
+
+stream_reader::stream_reader(stream_handler& handler_, const stream_reader_options& options_) :
+handler(handler_), options(options_) {}
+
+bool stream_reader::parse(std::istream& stream, const std::string& identifier_) {
+	if (!chunk_buffer) {
+		chunk_buffer = std::make_unique_for_overwrite<char[]>(std::max(options.chunk_size, size_t(64u)));
+	}
+	input_stream = &stream;
+	identifier = identifier_;
+	cur = nullptr;
+	end = nullptr;
+	chunk_begin = nullptr;
+	chunk_offset = 0;
+	const auto ret = run();
+	input_stream = nullptr;
+	return ret;
+}
+
+bool stream_reader::parse(const std::span<const char> data, const std::string& identifier_) {
+	input_stream = nullptr;
+	identifier = identifier_;
+	cur = data.data();
+	end = data.data() + data.size();
+	chunk_begin = cur;
+	chunk_offset = 0;
+	return run();
+}
+
+bool stream_reader::parse_file(const std::string& filename) {
+	std::ifstream file(filename, std::ios::in | std::ios::binary);
+	if (!file.is_open()) {
+		log_error("failed to open json file \"$\"!", filename);
+		return false;
+	}
+	return parse(file, filename);
+}
+
+bool stream_reader::refill() {
+	if (input_stream == nullptr || !input_stream->good()) {
+		return false;
+	}
+	chunk_offset += uint64_t(end - chunk_begin);
+	input_stream->read(chunk_buffer.get(), std::streamsize(std::max(options.chunk_size, size_t(64u))));
+	const auto read_size = size_t(input_stream->gcount());
+	chunk_begin = chunk_buffer.get();
+	cur = chunk_begin;
+	end = chunk_begin + read_size;
+	return (read_size > 0);
+}
+
+bool stream_reader::error(const std::string_view msg) const {
+	log_error("$: offset $: parsing failed: $", identifier, chunk_offset + uint64_t(cur - chunk_begin), msg);
+	return false;
+}
+
+bool stream_reader::skip_whitespace() {
+	for (;;) {
+		const auto ch = peek();
+		switch (ch) {
+			case ' ': case '\t': case '\n': case '\r':
+				++cur;
+				break;
+			case '#':
+			case '/': {
+				++cur;
+				bool is_single_line = (ch == '#');
+				if (!is_single_line) {
+					char comment_ch = 0;
+					if (!next(comment_ch)) {
+						return error("invalid '/' at EOF");
+					}
+					if (comment_ch == '/') {
+						is_single_line = true;
+					} else if (comment_ch != '*') {
+						return error("invalid '/' character - expected a comment?");
+					}
+				}
+				if (is_single_line) {
+					for (char comment_ch = 0; next(comment_ch) && comment_ch != '\n';) {}
+				} else {
+					for (char comment_ch = 0, prev_ch = 0;; prev_ch = comment_ch) {
+						if (!next(comment_ch)) {
+							return error("unterminated /* comment (premature EOF)");
+						}
+						if (prev_ch == '*' && comment_ch == '/') {
+							break;
+						}
+					}
+				}
+				break;
+			}
+			default:
+				return true;
+		}
+	}
+}
+
+bool stream_reader::parse_hex4(uint32_t& value) {
+	value = 0;
+	for (uint32_t i = 0; i < 4; ++i) {
+		char ch = 0;
+		if (!next(ch)) {
+			return error("premature EOF in \\u escape sequence");
+		}
+		value <<= 4u;
+		if (ch >= '0' && ch <= '9') {
+			value |= uint32_t(ch - '0');
+		} else if (ch >= 'a' && ch <= 'f') {
+			value |= uint32_t(ch - 'a' + 10);
+		} else if (ch >= 'A' && ch <= 'F') {
+			value |= uint32_t(ch - 'A' + 10);
+		} else {
+			return error("invalid \\u escape sequence");
+		}
+	}
+	return true;
+}
+
+//! appends the specified code point as UTF-8 to "dst"
+static void append_utf8(std::string& dst, const uint32_t code_point) {
+	if (code_point < 0x80u) {
+		dst += char(code_point);
+	} else if (code_point < 0x800u) {
+		dst += char(0xC0u | (code_point >> 6u));
+		dst += char(0x80u | (code_point & 0x3Fu));
+	} else if (code_point < 0x10000u) {
+		dst += char(0xE0u | (code_point >> 12u));
+		dst += char(0x80u | ((code_point >> 6u) & 0x3Fu));
+		dst += char(0x80u | (code_point & 0x3Fu));
+	} else {
+		dst += char(0xF0u | (code_point >> 18u));
+		dst += char(0x80u | ((code_point >> 12u) & 0x3Fu));
+		dst += char(0x80u | ((code_point >> 6u) & 0x3Fu));
+		dst += char(0x80u | (code_point & 0x3Fu));
+	}
+}
+
+bool stream_reader::parse_string(std::string_view& str) {
+	++cur; // skip "
+	scratch.clear();
+	bool use_scratch = false;
+	for (;;) {
+		if (cur == end && !refill()) {
+			return error("unterminated string (premature EOF)");
+		}
+		
+		// fast scan until the end of the string, an escape sequence or the end of the current chunk
+		const char* run_end = cur;
+		while (run_end != end && *run_end != '"' && *run_end != '\\' && (uint8_t)*run_end >= 0x20u) {
+			++run_end;
+		}
+		if (run_end == end) {
+			// string continues in the next chunk
+			scratch.append(cur, run_end);
+			use_scratch = true;
+			cur = run_end;
+			continue;
+		}
+		if (*run_end == '"') {
+			if (!use_scratch) {
+				// no escape sequences and no chunk boundary -> directly use the input data
+				str = { cur, size_t(run_end - cur) };
+			} else {
+				scratch.append(cur, run_end);
+				str = scratch;
+			}
+			cur = run_end + 1;
+			return true;
+		}
+		if ((uint8_t)*run_end < 0x20u) {
+			cur = run_end;
+			return error("invalid control character in string");
+		}
+		
+		// escape sequence
+		scratch.append(cur, run_end);
+		use_scratch = true;
+		cur = run_end + 1;
+		char esc_ch = 0;
+		if (!next(esc_ch)) {
+			return error("unterminated string (premature EOF)");
+		}
+		for (;;) {
+			switch (esc_ch) {
+				case '"': scratch += '"'; break;
+				case '\\': scratch += '\\'; break;
+				case '/': scratch += '/'; break;
+				case 'b': scratch += '\b'; break;
+				case 'f': scratch += '\f'; break;
+				case 'n': scratch += '\n'; break;
+				case 'r': scratch += '\r'; break;
+				case 't': scratch += '\t'; break;
+				case 'u': {
+					uint32_t code_point = 0;
+					if (!parse_hex4(code_point)) {
+						return false;
+					}
+					if (code_point >= 0xD800u && code_point <= 0xDBFFu && peek() == '\\') {
+						// high surrogate followed by another escape sequence: combine if it is a low surrogate
+						++cur;
+						if (!next(esc_ch)) {
+							return error("unterminated string (premature EOF)");
+						}
+						if (esc_ch != 'u') {
+							append_utf8(scratch, code_point);
+							// handle the other escape sequence
+							continue;
+						}
+						uint32_t low_surrogate = 0;
+						if (!parse_hex4(low_surrogate)) {
+							return false;
+						}
+						if (low_surrogate >= 0xDC00u && low_surrogate <= 0xDFFFu) {
+							append_utf8(scratch, 0x10000u + ((code_point - 0xD800u) << 10u) + (low_surrogate - 0xDC00u));
+						} else {
+							append_utf8(scratch, code_point);
+							append_utf8(scratch, low_surrogate);
+						}
+						break;
+					}
+					append_utf8(scratch, code_point);
+					break;
+				}
+				default:
+					return error("invalid escape sequence");
+			}
+			break;
+		}
+	}
+}
+
+bool stream_reader::parse_number() {
+	// collect all number chars (numbers may cross chunk boundaries)
+	scratch.clear();
+	for (int ch = peek(); ch >= 0; ch = peek()) {
+		if ((ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E') {
+			scratch += char(ch);
+			++cur;
+		} else {
+			break;
+		}
+	}
+	
+	// validate the JSON number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+	const auto is_digit = [this](const size_t idx) {
+		return (idx < scratch.size() && scratch[idx] >= '0' && scratch[idx] <= '9');
+	};
+	size_t idx = 0;
+	bool is_fp = false;
+	if (scratch[idx] == '-') {
+		++idx;
+	}
+	if (!is_digit(idx)) {
+		return error("invalid number");
+	}
+	if (scratch[idx] == '0') {
+		++idx;
+	} else {
+		while (is_digit(idx)) {
+			++idx;
+		}
+	}
+	if (idx < scratch.size() && scratch[idx] == '.') {
+		is_fp = true;
+		if (!is_digit(++idx)) {
+			return error("invalid number: expected a digit after '.'");
+		}
+		while (is_digit(idx)) {
+			++idx;
+		}
+	}
+	if (idx < scratch.size() && (scratch[idx] == 'e' || scratch[idx] == 'E')) {
+		is_fp = true;
+		++idx;
+		if (idx < scratch.size() && (scratch[idx] == '+' || scratch[idx] == '-')) {
+			++idx;
+		}
+		if (!is_digit(idx)) {
+			return error("invalid number: expected a digit in the exponent");
+		}
+		while (is_digit(idx)) {
+			++idx;
+		}
+	}
+	if (idx != scratch.size()) {
+		return error("invalid number");
+	}
+	
+	if (!is_fp) {
+		int64_t int_value = 0;
+		const auto [ptr, ec] = std::from_chars(scratch.data(), scratch.data() + scratch.size(), int_value);
+		if (ec == std::errc() && ptr == scratch.data() + scratch.size()) {
+			return handler.on_int(int_value);
+		}
+		// out of range -> parse as floating point value
+	}
+	return handler.on_fp(strtod(scratch.c_str(), nullptr));
+}
+
+bool stream_reader::parse_keyword(const std::string_view keyword) {
+	for (const auto& keyword_ch : keyword) {
+		char ch = 0;
+		if (!next(ch) || ch != keyword_ch) {
+			return error("invalid keyword");
+		}
+	}
+	return true;
+}
+
+bool stream_reader::run() {
+	container_stack.clear();
+	root_value_count = 0;
+	
+	auto state = READER_STATE::VALUE;
+	// called after each complete value
+	const auto finish_value = [this, &state] {
+		if (container_stack.empty()) {
+			++root_value_count;
+			state = READER_STATE::ROOT_END;
+		} else {
+			state = READER_STATE::NEXT;
+		}
+	};
+	
+	for (;;) {
+		if (!skip_whitespace()) {
+			return false;
+		}
+		const auto ch = peek();
+		if (ch < 0) {
+			if (state == READER_STATE::ROOT_END) {
+				return true;
+			}
+			return error(root_value_count == 0 && container_stack.empty() ? "no JSON value" : "premature EOF");
+		}
+		
+		switch (state) {
+			case READER_STATE::ROOT_END:
+				if (!options.allow_multiple_root_values) {
+					return error("unexpected data after the root value");
+				}
+				state = READER_STATE::VALUE;
+				continue;
+			case READER_STATE::OBJECT_FIRST:
+			case READER_STATE::KEY: {
+				if (ch == '}' && state == READER_STATE::OBJECT_FIRST) {
+					++cur;
+					container_stack.pop_back();
+					if (!handler.on_object_end()) {
+						return false;
+					}
+					finish_value();
+					continue;
+				}
+				if (ch != '"') {
+					return error("expected a member key string");
+				}
+				std::string_view key;
+				if (!parse_string(key) || !handler.on_key(key)) {
+					return false;
+				}
+				state = READER_STATE::COLON;
+				continue;
+			}
+			case READER_STATE::COLON:
+				if (ch != ':') {
+					return error("expected ':' after member key");
+				}
+				++cur;
+				state = READER_STATE::VALUE;
+				continue;
+			case READER_STATE::NEXT: {
+				const auto container_type = container_stack.back();
+				if (ch == ',') {
+					++cur;
+					state = (container_type == CONTAINER_TYPE::OBJECT ? READER_STATE::KEY : READER_STATE::VALUE);
+					continue;
+				}
+				if (ch == '}' && container_type == CONTAINER_TYPE::OBJECT) {
+					++cur;
+					container_stack.pop_back();
+					if (!handler.on_object_end()) {
+						return false;
+					}
+					finish_value();
+					continue;
+				}
+				if (ch == ']' && container_type == CONTAINER_TYPE::ARRAY) {
+					++cur;
+					container_stack.pop_back();
+					if (!handler.on_array_end()) {
+						return false;
+					}
+					finish_value();
+					continue;
+				}
+				return error(container_type == CONTAINER_TYPE::OBJECT ? "expected ',' or '}' in object" : "expected ',' or ']' in array");
+			}
+			case READER_STATE::ARRAY_FIRST:
+				if (ch == ']') {
+					++cur;
+					container_stack.pop_back();
+					if (!handler.on_array_end()) {
+						return false;
+					}
+					finish_value();
+					continue;
+				}
+				[[fallthrough]];
+			case READER_STATE::VALUE:
+				break;
+		}
+		
+		// parse a value
+		switch (ch) {
+			case '{':
+			case '[': {
+				if (container_stack.size() >= options.max_depth) {
+					return error("max nesting depth exceeded");
+				}
+				++cur;
+				const auto is_object = (ch == '{');
+				container_stack.emplace_back(is_object ? CONTAINER_TYPE::OBJECT : CONTAINER_TYPE::ARRAY);
+				if (!(is_object ? handler.on_object_begin() : handler.on_array_begin())) {
+					return false;
+				}
+				state = (is_object ? READER_STATE::OBJECT_FIRST : READER_STATE::ARRAY_FIRST);
+				continue;
+			}
+			case '"': {
+				std::string_view str;
+				if (!parse_string(str) || !handler.on_string(str)) {
+					return false;
+				}
+				break;
+			}
+			case 'n':
+				if (!parse_keyword("null"sv) || !handler.on_null()) {
+					return false;
+				}
+				break;
+			case 't':
+				if (!parse_keyword("true"sv) || !handler.on_bool(true)) {
+					return false;
+				}
+				break;
+			case 'f':
+				if (!parse_keyword("false"sv) || !handler.on_bool(false)) {
+					return false;
+				}
+				break;
+			case '-':
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9':
+				if (!parse_number()) {
+					return false;
+				}
+				break;
+			default:
+				return error("invalid character, expected a value");
+		}
+		finish_value();
+	}
+}
+
+//////////////////////////////////////////
+// json_value_builder
+
+bool json_value_builder::add_value(json_value&& value) {
+	if (value_stack.empty()) {
+		return root_value_callback(std::move(value));
+	}
+	auto& container = value_stack.back();
+	if (auto obj_ptr = std::get_if<json_object>(&container.value); obj_ptr) {
+		obj_ptr->emplace(std::move(key_stack.back()), std::move(value));
+		key_stack.pop_back();
+	} else {
+		std::get<json_array>(container.value).emplace_back(std::move(value));
+	}
+	return true;
+}
+
+bool json_value_builder::on_null() {
+	return add_value(json_value { nullptr });
+}
+
+bool json_value_builder::on_bool(const bool value) {
+	return add_value(json_value { value });
+}
+
+bool json_value_builder::on_int(const int64_t value) {
+	return add_value(json_value { value });
+}
+
+bool json_value_builder::on_fp(const double value) {
+	return add_value(json_value { value });
+}
+
+bool json_value_builder::on_string(const std::string_view str) {
+	std::string escaped_str;
+	escaped_str.reserve(str.size());
+	escape_string(str, escaped_str);
+	return add_value(json_value { std::move(escaped_str) });
+}
+
+bool json_value_builder::on_key(const std::string_view key) {
+	std::string escaped_key;
+	escaped_key.reserve(key.size());
+	escape_string(key, escaped_key);
+	key_stack.emplace_back(std::move(escaped_key));
+	return true;
+}
+
+bool json_value_builder::on_object_begin() {
+	value_stack.emplace_back(json_object {});
+	return true;
+}
+
+bool json_value_builder::on_object_end() {
+	auto obj = std::move(value_stack.back());
+	value_stack.pop_back();
+	return add_value(std::move(obj));
+}
+
+bool json_value_builder::on_array_begin() {
+	value_stack.emplace_back(json_array {});
+	return true;
+}
+
+bool json_value_builder::on_array_end() {
+	auto arr = std::move(value_stack.back());
+	value_stack.pop_back();
+	return add_value(std::move(arr));
+}
+
+//////////////////////////////////////////
+// stream_writer
+
+stream_writer::stream_writer(std::ostream& stream_, const stream_writer_options& options_) :
+stream(stream_), options(options_), buffer(std::make_unique_for_overwrite<char[]>(std::max(options_.buffer_size, size_t(1u)))) {}
+
+stream_writer::~stream_writer() {
+	if (!container_stack.empty()) {
+		log_error("JSON stream writer destroyed with $ unterminated objects/arrays", container_stack.size());
+	}
+	flush();
+}
+
+void stream_writer::flush_buffer() {
+	if (buffer_pos > 0) {
+		stream.write(buffer.get(), std::streamsize(buffer_pos));
+		buffer_pos = 0;
+	}
+}
+
+void stream_writer::flush() {
+	flush_buffer();
+	stream.flush();
+}
+
+void stream_writer::append(const char* data, const size_t size) {
+	const auto buffer_size = std::max(options.buffer_size, size_t(1u));
+	if (buffer_pos + size > buffer_size) {
+		flush_buffer();
+		if (size >= buffer_size) {
+			// too large for the buffer -> write directly
+			stream.write(data, std::streamsize(size));
+			return;
+		}
+	}
+	memcpy(buffer.get() + buffer_pos, data, size);
+	buffer_pos += size;
+}
+
+void stream_writer::append_indent(const size_t depth) {
+	static constexpr const std::string_view spaces { "                                                                " };
+	for (size_t space_count = depth * options.indent; space_count > 0;) {
+		const auto count = std::min(space_count, spaces.size());
+		append(spaces.data(), count);
+		space_count -= count;
+	}
+}
+
+void stream_writer::append_escaped(const std::string_view str) {
+	size_t run_start = 0;
+	char escaped_ch[6];
+	for (size_t i = 0, count = str.size(); i < count; ++i) {
+		const auto escaped_len = escape_char((uint8_t)str[i], escaped_ch);
+		if (escaped_len == 0) {
+			continue;
+		}
+		append(str.data() + run_start, i - run_start);
+		append(escaped_ch, escaped_len);
+		run_start = i + 1;
+	}
+	append(str.data() + run_start, str.size() - run_start);
+}
+
+bool stream_writer::begin_value() {
+	if (container_stack.empty()) {
+		return true;
+	}
+	auto& container = container_stack.back();
+	if (container.is_object) {
+		if (!container.has_key) {
+			log_error("JSON stream writer: can't write an object member value without a key");
+			return false;
+		}
+		// separator and indentation have been written by write_key()
+		container.has_key = false;
+		return true;
+	}
+	if (container.count > 0) {
+		append(',');
+	}
+	if (options.pretty) {
+		append('\n');
+		append_indent(container_stack.size());
+	}
+	return true;
+}
+
+void stream_writer::end_value() {
+	if (container_stack.empty()) {
+		// end of root value
+		append('\n');
+		return;
+	}
+	++container_stack.back().count;
+}
+
+bool stream_writer::write_key(const std::string_view key) {
+	if (container_stack.empty() || !container_stack.back().is_object) {
+		log_error("JSON stream writer: can't write a key outside of an object");
+		return false;
+	}
+	auto& container = container_stack.back();
+	if (container.has_key) {
+		log_error("JSON stream writer: a key has already been written");
+		return false;
+	}
+	if (container.count > 0) {
+		append(',');
+	}
+	if (options.pretty) {
+		append('\n');
+		append_indent(container_stack.size());
+	}
+	append('"');
+	append_escaped(key);
+	append(options.pretty ? "\": "sv : "\":"sv);
+	container.has_key = true;
+	return true;
+}
+
+bool stream_writer::begin_object() {
+	if (!begin_value()) {
+		return false;
+	}
+	append('{');
+	container_stack.emplace_back(container_t { .is_object = true, .has_key = false, .count = 0u });
+	return true;
+}
+
+bool stream_writer::begin_array() {
+	if (!begin_value()) {
+		return false;
+	}
+	append('[');
+	container_stack.emplace_back(container_t { .is_object = false, .has_key = false, .count = 0u });
+	return true;
+}
+
+bool stream_writer::end_container(const bool is_object) {
+	if (container_stack.empty() || container_stack.back().is_object != is_object) {
+		log_error("JSON stream writer: no $ to end", is_object ? "object" : "array");
+		return false;
+	}
+	const auto& container = container_stack.back();
+	if (container.has_key) {
+		log_error("JSON stream writer: missing value for the last object member");
+		return false;
+	}
+	const auto is_empty = (container.count == 0);
+	container_stack.pop_back();
+	if (options.pretty && !is_empty) {
+		append('\n');
+		append_indent(container_stack.size());
+	}
+	append(is_object ? '}' : ']');
+	end_value();
+	return true;
+}
+
+bool stream_writer::end_object() {
+	return end_container(true);
+}
+
+bool stream_writer::end_array() {
+	return end_container(false);
+}
+
+bool stream_writer::write_null() {
+	if (!begin_value()) {
+		return false;
+	}
+	append("null"sv);
+	end_value();
+	return true;
+}
+
+bool stream_writer::write_bool(const bool value) {
+	if (!begin_value()) {
+		return false;
+	}
+	append(value ? "true"sv : "false"sv);
+	end_value();
+	return true;
+}
+
+bool stream_writer::write_int(const int64_t value) {
+	if (!begin_value()) {
+		return false;
+	}
+	char num_str[24];
+	const auto [ptr, ec] = std::to_chars(std::begin(num_str), std::end(num_str), value);
+	append(num_str, size_t(ptr - num_str));
+	end_value();
+	return true;
+}
+
+bool stream_writer::write_uint(const uint64_t value) {
+	if (!begin_value()) {
+		return false;
+	}
+	char num_str[24];
+	const auto [ptr, ec] = std::to_chars(std::begin(num_str), std::end(num_str), value);
+	append(num_str, size_t(ptr - num_str));
+	end_value();
+	return true;
+}
+
+bool stream_writer::write_fp(const double value) {
+	if (!std::isfinite(value)) {
+		// inf/nan can't be represented in JSON
+		return write_null();
+	}
+	if (!begin_value()) {
+		return false;
+	}
+	// shortest representation that round-trips
+	char num_str[32];
+	const auto [ptr, ec] = std::to_chars(std::begin(num_str), std::end(num_str), value);
+	const std::string_view num_view { num_str, size_t(ptr - num_str) };
+	append(num_view);
+	if (num_view.find_first_of(".e"sv) == std::string_view::npos) {
+		// ensure this is read back as a floating point value
+		append(".0"sv);
+	}
+	end_value();
+	return true;
+}
+
+bool stream_writer::write_string(const std::string_view str) {
+	if (!begin_value()) {
+		return false;
+	}
+	append('"');
+	append_escaped(str);
+	append('"');
+	end_value();
+	return true;
+}
+
+bool stream_writer::write_value(const json_value& value) {
+	return std::visit([this](const auto& arg) {
+		using value_type = std::decay_t<decltype(arg)>;
+		if constexpr (std::is_same_v<value_type, std::nullptr_t>) {
+			return write_null();
+		} else if constexpr (std::is_same_v<value_type, int64_t>) {
+			return write_int(arg);
+		} else if constexpr (std::is_same_v<value_type, double>) {
+			return write_fp(arg);
+		} else if constexpr (std::is_same_v<value_type, std::string>) {
+			if (!begin_value()) {
+				return false;
+			}
+			append('"');
+			append(arg);
+			append('"');
+			end_value();
+			return true;
+		} else if constexpr (std::is_same_v<value_type, bool>) {
+			return write_bool(arg);
+		} else if constexpr (std::is_same_v<value_type, json_object>) {
+			if (!begin_object()) {
+				return false;
+			}
+			for (const auto& entry : arg) {
+				// NOTE: keys are written as-is (see write_value())
+				auto& container = container_stack.back();
+				if (container.count > 0) {
+					append(',');
+				}
+				if (options.pretty) {
+					append('\n');
+					append_indent(container_stack.size());
+				}
+				append('"');
+				append(entry.first);
+				append(options.pretty ? "\": "sv : "\":"sv);
+				container.has_key = true;
+				if (!write_value(entry.second)) {
+					return false;
+				}
+			}
+			return end_object();
+		} else if constexpr (std::is_same_v<value_type, json_array>) {
+			if (!begin_array()) {
+				return false;
+			}
+			for (const auto& elem : arg) {
+				if (!write_value(elem)) {
+					return false;
+				}
+			}
+			return end_array();
+		} else {
+			instantiation_trap_dependent_type(value_type, "unhandled value type");
+		}
+	}, value.value);
+}
+
+} // namespace fl::json
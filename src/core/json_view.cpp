@@ -0,0 +1,658 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/core/json_view.hpp>
+#include <floor/core/unicode.hpp>
+#include <floor/core/logger.hpp>
+#include <floor/core/file_io.hpp>
+#include <algorithm>
+#include <charconv>
+#include <ranges>
+#include <cstdlib>
+#include <cstring>
+
+namespace fl::json {
+using namespace std::literals;
+
+void* arena_allocator::allocate_bytes(const size_t size, const size_t alignment) {
+	// align the current offset
+	auto offset = (cur_offset + alignment - 1u) & ~(alignment - 1u);
+	if (cur_block_ptr == nullptr || offset + size > cur_block_size) {
+		// allocate a new block (large allocations get their own block)
+		const auto new_block_size = std::max(block_size, size + alignment);
+		blocks.emplace_back(std::make_unique_for_overwrite<uint8_t[]>(new_block_size));
+		cur_block_ptr = blocks.back().get();
+		cur_block_size = new_block_size;
+		allocated_size += new_block_size;
+		offset = ((size_t(cur_block_ptr) + alignment - 1u) & ~(alignment - 1u)) - size_t(cur_block_ptr);
+	}
+	cur_offset = offset + size;
+	return cur_block_ptr + offset;
+}
+
+const view_value* view_value::find(const std::string_view key) const {
+	if (type != VALUE_TYPE::OBJECT) {
+		return nullptr;
+	}
+	const auto members_span = get_members();
+	const auto iter = std::lower_bound(members_span.begin(), members_span.end(), key, [](const view_member& member, const std::string_view& key_) {
+		return (member.key < key_);
+	});
+	if (iter == members_span.end() || iter->key != key) {
+		return nullptr;
+	}
+	return &iter->value;
+}
+
+json_value view_value::to_json_value() const {
+	switch (type) {
+		case VALUE_TYPE::NULL_VALUE:
+			return json_value { nullptr };
+		case VALUE_TYPE::BOOL_VALUE:
+			return json_value { bool_value };
+		case VALUE_TYPE::INT_NUMBER:
+			return json_value { int_value };
+		case VALUE_TYPE::FP_NUMBER:
+			return json_value { fp_value };
+		case VALUE_TYPE::STRING:
+			return json_value { std::string { str_data, count } };
+		case VALUE_TYPE::OBJECT: {
+			json_object obj;
+			obj.insert_range(get_members() | std::views::transform([](const view_member& member) {
+				return std::pair { std::string { member.key }, member.value.to_json_value() };
+			}));
+			return json_value { std::move(obj) };
+		}
+		case VALUE_TYPE::ARRAY: {
+			json_array arr;
+			arr.reserve(count);
+			for (const auto& elem : get_elements()) {
+				arr.emplace_back(elem.to_json_value());
+			}
+			return json_value { std::move(arr) };
+		}
+	}
+	return json_value { nullptr };
+}
+
+void view_value::print(std::ostream& stream, const uint32_t depth) const {
+	switch (type) {
+		case VALUE_TYPE::NULL_VALUE:
+			stream << "null";
+			break;
+		case VALUE_TYPE::BOOL_VALUE:
+			stream << (bool_value ? "true" : "false");
+			break;
+		case VALUE_TYPE::INT_NUMBER:
+			stream << int_value;
+			break;
+		case VALUE_TYPE::FP_NUMBER:
+			stream << fp_value;
+			break;
+		case VALUE_TYPE::STRING:
+			stream << '\"' << std::string_view { str_data, count } << '\"';
+			break;
+		case VALUE_TYPE::OBJECT: {
+			const std::string space_string((depth + 1) * 4, ' ');
+			stream << "{\n";
+			for (uint32_t i = 0; i < count; ++i) {
+				stream << space_string << '\"' << members[i].key << "\": ";
+				members[i].value.print(stream, depth + 1);
+				if (i < count - 1) {
+					stream << ",";
+				}
+				stream << '\n';
+			}
+			stream << std::string(depth * 4, ' ') << "}";
+			break;
+		}
+		case VALUE_TYPE::ARRAY: {
+			const std::string space_string((depth + 1) * 4, ' ');
+			stream << "[\n";
+			for (uint32_t i = 0; i < count; ++i) {
+				stream << space_string;
+				elements[i].print(stream, depth + 1);
+				if (i < count - 1) {
+					stream << ",";
+				}
+				stream << '\n';
+			}
+			stream << std::string(depth * 4, ' ') << "]";
+			break;
+		}
+	}
+	
+	// one last newline if this is @ depth 0
+	if (depth == 0) {
+		stream << '\n';
+	}
+}
+
+const view_value* view_document::find(const std::string_view path) const {
+	if (!valid) {
+		return nullptr;
+	}
+	const view_value* cur_node = &root;
+	for (size_t pos = 0; pos < path.size();) {
+		auto dot_pos = path.find('.', pos);
+		if (dot_pos == std::string_view::npos) {
+			dot_pos = path.size();
+		}
+		cur_node = cur_node->find(path.substr(pos, dot_pos - pos));
+		if (cur_node == nullptr) {
+			return nullptr;
+		}
+		pos = dot_pos + 1;
+	}
+	return cur_node;
+}
+
+document view_document::to_document() const {
+	document doc;
+	if (valid) {
+		doc.root = root.to_json_value();
+		doc.valid = true;
+	}
+	return doc;
+}
+
+void view_document::print(std::ostream& stream) const {
+	const auto cur_flags = stream.flags();
+	const auto cur_precision = stream.precision();
+	
+	stream.setf(std::ios::dec | std::ios::showpoint);
+	stream.precision(19);
+	root.print(stream);
+	
+	stream.setf(cur_flags);
+	stream.precision(cur_precision);
+}
+
+//! single-pass recursive descent JSON parser that directly builds the view DOM
+class json_view_parser {
+public:
+	json_view_parser(const std::string_view source_, const std::string& identifier_, arena_allocator& storage_) :
+	source(source_), identifier(identifier_), storage(storage_), iter(source_.data()), end(source_.data() + source_.size()) {}
+	
+	bool parse(view_value& root) {
+		if (!skip_whitespace() || !parse_value(root, 0u) || !skip_whitespace()) {
+			return false;
+		}
+		if (iter != end) {
+			return error("unexpected data after the root value");
+		}
+		return true;
+	}
+
+protected:
+	//! max nesting depth of objects/arrays (prevents stack overflows with malicious input)
+	static constexpr const uint32_t max_depth { 512u };
+	
+	const std::string_view source;
+	const std::string& identifier;
+	arena_allocator& storage;
+	const char* iter;
+	const char* const end;
+	
+	//! scratch space for members/elements of all currently open objects/arrays:
+	//! children are pushed here and are moved into the arena once the object/array is complete
+	std::vector<view_member> member_stack;
+	std::vector<view_value> element_stack;
+	
+	bool error(const std::string_view msg) {
+		// compute line and column
+		size_t line = 1, column = 1;
+		for (const char* ptr = source.data(); ptr < iter && ptr < end; ++ptr) {
+			if (*ptr == '\n') {
+				++line;
+				column = 1;
+			} else {
+				++column;
+			}
+		}
+		log_error("$:$:$: parsing failed: $", identifier, line, column, msg);
+		return false;
+	}
+	
+	//! skips whitespace and comments, returns false on an unterminated comment
+	bool skip_whitespace() {
+		while (iter != end) {
+			switch (*iter) {
+				case ' ': case '\t': case '\n': case '\r':
+					++iter;
+					break;
+				case '#':
+					for (++iter; iter != end && *iter != '\n'; ++iter) {}
+					break;
+				case '/':
+					if (iter + 1 == end) {
+						return error("invalid '/' at EOF");
+					}
+					if (iter[1] == '/') {
+						for (iter += 2; iter != end && *iter != '\n'; ++iter) {}
+					} else if (iter[1] == '*') {
+						const auto comment_start = iter;
+						for (iter += 2; ; ++iter) {
+							if (iter == end || iter + 1 == end) {
+								iter = comment_start;
+								return error("unterminated /* comment (premature EOF)");
+							}
+							if (iter[0] == '*' && iter[1] == '/') {
+								iter += 2;
+								break;
+							}
+						}
+					} else {
+						return error("invalid '/' character - expected a comment?");
+					}
+					break;
+				default:
+					return true;
+			}
+		}
+		return true;
+	}
+	
+	bool parse_value(view_value& value, const uint32_t depth) {
+		if (iter == end) {
+			return error("premature EOF, expected a value");
+		}
+		switch (*iter) {
+			case '{':
+				return parse_object(value, depth);
+			case '[':
+				return parse_array(value, depth);
+			case '"': {
+				std::string_view str;
+				if (!parse_string(str)) {
+					return false;
+				}
+				value.type = view_value::VALUE_TYPE::STRING;
+				value.count = uint32_t(str.size());
+				value.str_data = str.data();
+				return true;
+			}
+			case 'n':
+				if (!parse_keyword("null"sv)) {
+					return false;
+				}
+				value.type = view_value::VALUE_TYPE::NULL_VALUE;
+				return true;
+			case 't':
+				if (!parse_keyword("true"sv)) {
+					return false;
+				}
+				value.type = view_value::VALUE_TYPE::BOOL_VALUE;
+				value.bool_value = true;
+				return true;
+			case 'f':
+				if (!parse_keyword("false"sv)) {
+					return false;
+				}
+				value.type = view_value::VALUE_TYPE::BOOL_VALUE;
+				value.bool_value = false;
+				return true;
+			case '-':
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9':
+				return parse_number(value);
+			default:
+				return error("invalid character, expected a value");
+		}
+	}
+	
+	bool parse_keyword(const std::string_view keyword) {
+		if (size_t(end - iter) < keyword.size() || std::string_view { iter, keyword.size() } != keyword) {
+			return error("invalid keyword");
+		}
+		iter += keyword.size();
+		return true;
+	}
+	
+	bool parse_number(view_value& value) {
+		// validate the JSON number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+		const auto number_start = iter;
+		bool is_fp = false;
+		if (*iter == '-') {
+			++iter;
+		}
+		if (iter == end || *iter < '0' || *iter > '9') {
+			return error("invalid number");
+		}
+		if (*iter == '0') {
+			++iter;
+		} else {
+			while (iter != end && *iter >= '0' && *iter <= '9') {
+				++iter;
+			}
+		}
+		if (iter != end && *iter == '.') {
+			is_fp = true;
+			++iter;
+			if (iter == end || *iter < '0' || *iter > '9') {
+				return error("invalid number: expected a digit after '.'");
+			}
+			while (iter != end && *iter >= '0' && *iter <= '9') {
+				++iter;
+			}
+		}
+		if (iter != end && (*iter == 'e' || *iter == 'E')) {
+			is_fp = true;
+			++iter;
+			if (iter != end && (*iter == '+' || *iter == '-')) {
+				++iter;
+			}
+			if (iter == end || *iter < '0' || *iter > '9') {
+				return error("invalid number: expected a digit in the exponent");
+			}
+			while (iter != end && *iter >= '0' && *iter <= '9') {
+				++iter;
+			}
+		}
+		
+		if (!is_fp) {
+			int64_t int_value = 0;
+			const auto [ptr, ec] = std::from_chars(number_start, iter, int_value);
+			if (ec == std::errc() && ptr == iter) {
+				value.type = view_value::VALUE_TYPE::INT_NUMBER;
+				value.int_value = int_value;
+				return true;
+			}
+			// out of range -> parse as floating point value
+		}
+		
+		// NOTE: strtod requires a terminated string, numbers are short, so just copy it to the stack
+		char number_str[128];
+		const auto number_len = size_t(iter - number_start);
+		if (number_len >= std::size(number_str)) {
+			return error("number is too long");
+		}
+		memcpy(number_str, number_start, number_len);
+		number_str[number_len] = '\0';
+		value.type = view_value::VALUE_TYPE::FP_NUMBER;
+		value.fp_value = strtod(number_str, nullptr);
+		return true;
+	}
+	
+	static bool is_hex_char(const char ch) {
+		return ((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F'));
+	}
+	
+	static uint32_t hex_to_uint(const char* hex) {
+		uint32_t ret = 0;
+		for (uint32_t i = 0; i < 4; ++i) {
+			const auto ch = hex[i];
+			ret <<= 4u;
+			ret |= uint32_t(ch >= '0' && ch <= '9' ? ch - '0' : (ch >= 'a' && ch <= 'f' ? ch - 'a' + 10 : ch - 'A' + 10));
+		}
+		return ret;
+	}
+	
+	//! parses a string literal, "str" will either point into the source data (no escape sequences),
+	//! or to an unescaped copy in the arena
+	bool parse_string(std::string_view& str) {
+		const auto str_start = ++iter; // skip "
+		bool has_escapes = false;
+		for (;; ++iter) {
+			if (iter == end) {
+				return error("unterminated string (premature EOF)");
+			}
+			if (*iter == '"') {
+				break;
+			}
+			if (*iter == '\\') {
+				has_escapes = true;
+				if (++iter == end) {
+					return error("unterminated string (premature EOF)");
+				}
+				switch (*iter) {
+					case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+						break;
+					case 'u':
+						if (end - iter < 5 || !is_hex_char(iter[1]) || !is_hex_char(iter[2]) ||
+							!is_hex_char(iter[3]) || !is_hex_char(iter[4])) {
+							return error("invalid \\u escape sequence");
+						}
+						iter += 4;
+						break;
+					default:
+						return error("invalid escape sequence");
+				}
+			} else if ((uint8_t)*iter < 0x20u) {
+				return error("invalid control character in string");
+			}
+		}
+		const auto str_end = iter++; // skip "
+		const auto raw_size = size_t(str_end - str_start);
+		if (raw_size > size_t(UINT32_MAX)) {
+			return error("string is too long");
+		}
+		
+		if (!has_escapes) {
+			str = { str_start, raw_size };
+			return true;
+		}
+		
+		// unescape into the arena (unescaped data is never larger than the escaped data)
+		auto dst = storage.allocate<char>(raw_size);
+		auto dst_ptr = dst;
+		for (auto src_ptr = str_start; src_ptr < str_end; ++src_ptr) {
+			if (*src_ptr != '\\') {
+				*dst_ptr++ = *src_ptr;
+				continue;
+			}
+			switch (*++src_ptr) {
+				case '"': *dst_ptr++ = '"'; break;
+				case '\\': *dst_ptr++ = '\\'; break;
+				case '/': *dst_ptr++ = '/'; break;
+				case 'b': *dst_ptr++ = '\b'; break;
+				case 'f': *dst_ptr++ = '\f'; break;
+				case 'n': *dst_ptr++ = '\n'; break;
+				case 'r': *dst_ptr++ = '\r'; break;
+				case 't': *dst_ptr++ = '\t'; break;
+				case 'u': {
+					uint32_t code_point = hex_to_uint(src_ptr + 1);
+					src_ptr += 4;
+					// combine UTF-16 surrogate pairs
+					if (code_point >= 0xD800u && code_point <= 0xDBFFu &&
+						str_end - src_ptr >= 7 && src_ptr[1] == '\\' && src_ptr[2] == 'u' &&
+						is_hex_char(src_ptr[3]) && is_hex_char(src_ptr[4]) && is_hex_char(src_ptr[5]) && is_hex_char(src_ptr[6])) {
+						const auto low_surrogate = hex_to_uint(src_ptr + 3);
+						if (low_surrogate >= 0xDC00u && low_surrogate <= 0xDFFFu) {
+							code_point = 0x10000u + ((code_point - 0xD800u) << 10u) + (low_surrogate - 0xDC00u);
+							src_ptr += 6;
+						}
+					}
+					// encode as UTF-8 (at most 4 bytes, while the escape sequence is at least 6 bytes)
+					if (code_point < 0x80u) {
+						*dst_ptr++ = char(code_point);
+					} else if (code_point < 0x800u) {
+						*dst_ptr++ = char(0xC0u | (code_point >> 6u));
+						*dst_ptr++ = char(0x80u | (code_point & 0x3Fu));
+					} else if (code_point < 0x10000u) {
+						*dst_ptr++ = char(0xE0u | (code_point >> 12u));
+						*dst_ptr++ = char(0x80u | ((code_point >> 6u) & 0x3Fu));
+						*dst_ptr++ = char(0x80u | (code_point & 0x3Fu));
+					} else {
+						*dst_ptr++ = char(0xF0u | (code_point >> 18u));
+						*dst_ptr++ = char(0x80u | ((code_point >> 12u) & 0x3Fu));
+						*dst_ptr++ = char(0x80u | ((code_point >> 6u) & 0x3Fu));
+						*dst_ptr++ = char(0x80u | (code_point & 0x3Fu));
+					}
+					break;
+				}
+				default:
+					floor_unreachable();
+			}
+		}
+		str = { dst, size_t(dst_ptr - dst) };
+		return true;
+	}
+	
+	bool parse_object(view_value& value, const uint32_t depth) {
+		if (depth >= max_depth) {
+			return error("max nesting depth exceeded");
+		}
+		++iter; // skip {
+		const auto stack_start = member_stack.size();
+		if (!skip_whitespace()) {
+			return false;
+		}
+		if (iter != end && *iter == '}') {
+			++iter;
+		} else {
+			for (;;) {
+				if (iter == end || *iter != '"') {
+					return error("expected a member key string");
+				}
+				view_member member;
+				if (!parse_string(member.key)) {
+					return false;
+				}
+				if (!skip_whitespace()) {
+					return false;
+				}
+				if (iter == end || *iter != ':') {
+					return error("expected ':' after member key");
+				}
+				++iter;
+				if (!skip_whitespace() || !parse_value(member.value, depth + 1) || !skip_whitespace()) {
+					return false;
+				}
+				member_stack.emplace_back(member);
+				
+				if (iter == end) {
+					return error("unterminated object (premature EOF)");
+				}
+				if (*iter == ',') {
+					++iter;
+					if (!skip_whitespace()) {
+						return false;
+					}
+					continue;
+				}
+				if (*iter == '}') {
+					++iter;
+					break;
+				}
+				return error("expected ',' or '}' in object");
+			}
+		}
+		
+		// move all members into the arena and sort them by key
+		// NOTE: stable sort + lower_bound lookup -> the first member wins with duplicate keys (same as json::document)
+		const auto member_count = member_stack.size() - stack_start;
+		auto members = storage.allocate<view_member>(member_count);
+		std::uninitialized_copy(member_stack.begin() + ptrdiff_t(stack_start), member_stack.end(), members);
+		member_stack.resize(stack_start);
+		std::stable_sort(members, members + member_count, [](const view_member& lhs, const view_member& rhs) {
+			return (lhs.key < rhs.key);
+		});
+		
+		value.type = view_value::VALUE_TYPE::OBJECT;
+		value.count = uint32_t(member_count);
+		value.members = members;
+		return true;
+	}
+	
+	bool parse_array(view_value& value, const uint32_t depth) {
+		if (depth >= max_depth) {
+			return error("max nesting depth exceeded");
+		}
+		++iter; // skip [
+		const auto stack_start = element_stack.size();
+		if (!skip_whitespace()) {
+			return false;
+		}
+		if (iter != end && *iter == ']') {
+			++iter;
+		} else {
+			for (;;) {
+				view_value elem;
+				if (!parse_value(elem, depth + 1) || !skip_whitespace()) {
+					return false;
+				}
+				element_stack.emplace_back(elem);
+				
+				if (iter == end) {
+					return error("unterminated array (premature EOF)");
+				}
+				if (*iter == ',') {
+					++iter;
+					if (!skip_whitespace()) {
+						return false;
+					}
+					continue;
+				}
+				if (*iter == ']') {
+					++iter;
+					break;
+				}
+				return error("expected ',' or ']' in array");
+			}
+		}
+		
+		// move all elements into the arena
+		const auto elem_count = element_stack.size() - stack_start;
+		auto elements = storage.allocate<view_value>(elem_count);
+		std::uninitialized_copy(element_stack.begin() + ptrdiff_t(stack_start), element_stack.end(), elements);
+		element_stack.resize(stack_start);
+		
+		value.type = view_value::VALUE_TYPE::ARRAY;
+		value.count = uint32_t(elem_count);
+		value.elements = elements;
+		return true;
+	}
+
+};
+
+view_document create_view_document(const std::string& filename) {
+	auto json_data = std::make_unique<std::string>();
+	if (!file_io::file_to_string(filename, *json_data)) {
+		log_error("failed to read json file \"$\"!", filename);
+		return {};
+	}
+	auto doc = create_view_document_from_string(*json_data, filename);
+	if (doc.valid) {
+		// NOTE: moving the unique_ptr doesn't move the string data
+		doc.owned_source = std::move(json_data);
+	}
+	floor_return_no_nrvo(doc);
+}
+
+view_document create_view_document_from_string(const std::string_view json_data, const std::string identifier) {
+	const auto is_valid_utf8 = unicode::validate_utf8(json_data);
+	if (!is_valid_utf8.first) {
+		log_error("JSON data \"$\" is not UTF-8 encoded or contains invalid UTF-8 code points!",
+				  identifier);
+		return {};
+	}
+	
+	view_document doc;
+	// start with a block size that is proportional to the source size (most data is referenced, not copied)
+	doc.storage = std::make_unique<arena_allocator>(std::clamp(json_data.size(), size_t(4096u), size_t(4u * 1024u * 1024u)));
+	json_view_parser parser(json_data, identifier, *doc.storage);
+	if (!parser.parse(doc.root)) {
+		log_error("parsing of JSON data \"$\" failed!", identifier);
+		return {};
+	}
+	doc.valid = true;
+	floor_return_no_nrvo(doc);
+}
+
+} // namespace fl::json
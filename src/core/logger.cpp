@@ -21,11 +21,17 @@
 #endif
 #include <fstream>
 #include <chrono>
-#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <algorithm>
+#include <new>
 #include <floor/core/logger.hpp>
 #include <floor/threading/thread_base.hpp>
 #include <floor/threading/atomic_spin_lock.hpp>
 #include <floor/constexpr/const_math.hpp>
+#include <floor/threading/task.hpp>
+#include <floor/core/bcm.hpp>
+#include <floor/core/file_io.hpp>
 
 #include <SDL3/SDL.h>
 
@@ -33,26 +39,351 @@
 #include <floor/darwin/darwin_helper.hpp>
 #endif
 
+#if !defined(__WINDOWS__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <climits>
+#else
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
 //! enable this to print the thread id in each log message
 #define FLOOR_LOG_THREAD_ID 0
 
 namespace fl {
 using namespace std::literals;
 
-using log_entry_t = std::pair<logger::LOG_TYPE, std::string>;
+//! formatted log entry
+struct log_entry_t {
+	//! global sequence number, determines the output order
+	uint64_t seq;
+	logger::LOG_TYPE type;
+	std::string str;
+};
+
+//! per-thread single-producer/single-consumer ring buffer that contains deferred log records
+//! NOTE: records are 8-byte aligned and always stored contiguously, a record size of 0 signals a wrap-around
+struct deferred_log_ring_t {
+	static constexpr const size_t capacity { 256u * 1024u };
+	static constexpr const size_t record_alignment { 8u };
+	
+	std::unique_ptr<uint8_t[]> data { std::make_unique<uint8_t[]>(capacity) };
+	//! total amount of bytes that have been written by the producer thread
+	alignas(64) std::atomic<uint64_t> write_pos { 0u };
+	//! total amount of bytes that have been consumed by the logger thread
+	alignas(64) std::atomic<uint64_t> read_pos { 0u };
+	//! set once the producer thread has exited
+	std::atomic<bool> producer_exited { false };
+	//! size of the currently acquired record, including a potential wrap-around (only accessed by the producer)
+	uint64_t acquired_size { 0u };
+};
+
+//! header of a deferred log record, this is directly followed by the binary encoded arguments
+struct deferred_log_record_t {
+	//! size of the record, including this header and padding (0 signals a wrap-around)
+	uint32_t size;
+	logger::LOG_TYPE type;
+	uint64_t seq;
+	std::chrono::system_clock::time_point time;
+	const char* file;
+	const char* func;
+	const logger::format_view_t* format;
+	void (*format_func)(std::stringstream& buffer, const logger::format_view_t& format, const uint8_t* arg_data);
+	uint32_t err_idx;
+};
+
+//! owns the deferred log ring of the current thread and signals the logger thread once the thread exits
+struct deferred_log_ring_holder_t {
+	std::shared_ptr<deferred_log_ring_t> ring;
+	
+	~deferred_log_ring_holder_t() {
+		if (ring) {
+			ring->producer_exited = true;
+		}
+	}
+};
+static thread_local deferred_log_ring_holder_t deferred_ring_holder;
+
+//! persistent log file sink:
+//! entries are gathered during a logger thread run and are then written with as few syscalls as possible (writev),
+//! the file is optionally rotated based on its size and/or age
+//! NOTE: must not use the logger itself, all errors are directly written to std::cerr
+class log_file_sink {
+public:
+	log_file_sink(const std::string& filename_, const bool append_mode, const logger::file_sink_options_t& options_) :
+	filename(filename_), options(options_) {
+		open(!append_mode);
+	}
+	~log_file_sink() {
+		flush();
+		close();
+		wait_for_compression();
+	}
+	
+	bool is_open() const {
+		return (fd >= 0);
+	}
+	
+	//! adds the specified data for writing, this must stay alive until flush() is called
+	void add(const char* data, const size_t size) {
+		if (size == 0) {
+			return;
+		}
+		chunks.emplace_back(data, size);
+		chunks_size += size;
+	}
+	
+	//! writes all added data, rotating the file beforehand if necessary
+	void flush() {
+		if (chunks.empty() || !is_open()) {
+			chunks.clear();
+			chunks_size = 0;
+			return;
+		}
+		
+		if (needs_rotation()) {
+			rotate();
+			if (!is_open()) {
+				chunks.clear();
+				chunks_size = 0;
+				return;
+			}
+		}
+		
+#if !defined(__WINDOWS__)
+		static constexpr const size_t max_iov_count { IOV_MAX };
+		std::vector<iovec> iovs;
+		iovs.reserve(std::min(chunks.size(), max_iov_count));
+		for (size_t chunk_idx = 0, chunk_count = chunks.size(); chunk_idx < chunk_count;) {
+			iovs.clear();
+			for (; chunk_idx < chunk_count && iovs.size() < max_iov_count; ++chunk_idx) {
+				iovs.emplace_back(iovec { (void*)chunks[chunk_idx].first, chunks[chunk_idx].second });
+			}
+			
+			// write everything, handling partial writes and interrupts
+			size_t iov_offset = 0;
+			while (iov_offset < iovs.size()) {
+				const auto written = writev(fd, &iovs[iov_offset], int(std::min(iovs.size() - iov_offset, size_t(INT_MAX))));
+				if (written < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					std::cerr << "LOG ERROR: failed to write to log file (" << filename << "): " << strerror(errno) << std::endl;
+					chunks.clear();
+					chunks_size = 0;
+					return;
+				}
+				file_size += uint64_t(written);
+				auto remaining = size_t(written);
+				while (iov_offset < iovs.size() && remaining >= iovs[iov_offset].iov_len) {
+					remaining -= iovs[iov_offset].iov_len;
+					++iov_offset;
+				}
+				if (remaining > 0) {
+					iovs[iov_offset].iov_base = (uint8_t*)iovs[iov_offset].iov_base + remaining;
+					iovs[iov_offset].iov_len -= remaining;
+				}
+			}
+		}
+#else
+		for (const auto& chunk : chunks) {
+			auto data = chunk.first;
+			auto size = chunk.second;
+			while (size > 0) {
+				const auto written = _write(fd, data, (unsigned int)std::min(size, size_t(INT_MAX)));
+				if (written < 0) {
+					std::cerr << "LOG ERROR: failed to write to log file (" << filename << ")" << std::endl;
+					chunks.clear();
+					chunks_size = 0;
+					return;
+				}
+				file_size += uint64_t(written);
+				data += written;
+				size -= size_t(written);
+			}
+		}
+#endif
+		chunks.clear();
+		chunks_size = 0;
+	}
+	
+protected:
+	const std::string filename;
+	const logger::file_sink_options_t options;
+	int fd { -1 };
+	uint64_t file_size { 0u };
+	std::chrono::steady_clock::time_point open_time;
+	
+	//! data that will be written on the next flush(): (pointer, size)
+	std::vector<std::pair<const char*, size_t>> chunks;
+	size_t chunks_size { 0u };
+	
+	struct rotated_file_t {
+		//! file name of the rotated log file (w/o ".bcm")
+		std::string name;
+		//! if the file is compressed in the background: set once compression has finished (successfully or not)
+		std::shared_ptr<std::atomic<bool>> compression_done;
+	};
+	//! rotated log files that have been created by this sink (oldest first)
+	std::deque<rotated_file_t> rotated_files;
+	
+	void open(const bool truncate) {
+#if !defined(__WINDOWS__)
+		fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+#else
+		fd = _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | (truncate ? _O_TRUNC : 0), _S_IREAD | _S_IWRITE);
+#endif
+		if (fd < 0) {
+			std::cerr << "LOG ERROR: couldn't open log file (" << filename << ")!" << std::endl;
+			return;
+		}
+		std::error_code ec {};
+		const auto cur_file_size = std::filesystem::file_size(filename, ec);
+		file_size = (!ec ? uint64_t(cur_file_size) : 0u);
+		open_time = std::chrono::steady_clock::now();
+	}
+	
+	void close() {
+		if (fd >= 0) {
+#if !defined(__WINDOWS__)
+			::close(fd);
+#else
+			_close(fd);
+#endif
+			fd = -1;
+		}
+	}
+	
+	bool needs_rotation() const {
+		if (file_size == 0) {
+			return false;
+		}
+		if (options.max_file_size > 0 && file_size + chunks_size > options.max_file_size) {
+			return true;
+		}
+		if (options.max_file_age > 0 &&
+			std::chrono::steady_clock::now() - open_time >= std::chrono::seconds(options.max_file_age)) {
+			return true;
+		}
+		return false;
+	}
+	
+	//! renames the current log file to "<filename>.<date>-<time>[.<counter>]" and opens a new empty log file
+	void rotate() {
+		close();
+		
+		char time_str[64] { '\0' };
+		const auto cur_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+		struct tm local_time {};
+#if !defined(__WINDOWS__)
+		const auto has_local_time = (localtime_r(&cur_time, &local_time) != nullptr);
+#else
+		const auto has_local_time = (localtime_s(&local_time, &cur_time) == 0);
+#endif
+		if (has_local_time) {
+			strftime(time_str, sizeof(time_str), "%Y%m%d-%H%M%S", &local_time);
+		}
+		const auto rotated_base_name = filename + "." + time_str;
+		auto rotated_name = rotated_base_name;
+		std::error_code ec {};
+		for (uint32_t counter = 1; std::filesystem::exists(rotated_name, ec) ||
+			 std::filesystem::exists(rotated_name + ".bcm", ec); ++counter) {
+			rotated_name = rotated_base_name + "." + std::to_string(counter);
+		}
+		
+		std::filesystem::rename(filename, rotated_name, ec);
+		if (ec) {
+			std::cerr << "LOG ERROR: failed to rotate log file (" << filename << "): " << ec.message() << std::endl;
+			// continue writing to the current file
+			open(false);
+			return;
+		}
+		
+		if (options.compress_rotated_files) {
+			// compress in the background, so that logging isn't stalled
+			// NOTE: this is blocking file I/O + heavy CPU work -> don't occupy a task scheduler worker
+			auto compression_done = std::make_shared<std::atomic<bool>>(false);
+			task::spawn_blocking([rotated_name, compression_done]() {
+				// NOTE: must always signal completion (the sink waits for this on destruction), so handle all exceptions in here
+				try {
+					auto [data, data_size] = file_io::file_to_buffer(rotated_name);
+					if (data) {
+						const auto compressed_data = bcm::bcm_compress({ data.get(), data_size });
+						if (!compressed_data.empty() && file_io::buffer_to_file(rotated_name + ".bcm", compressed_data)) {
+							std::error_code remove_ec {};
+							std::filesystem::remove(rotated_name, remove_ec);
+						} else {
+							std::cerr << "LOG ERROR: failed to compress rotated log file (" << rotated_name << ")" << std::endl;
+						}
+					}
+				} catch (...) {
+					std::cerr << "LOG ERROR: failed to compress rotated log file (" << rotated_name << ")" << std::endl;
+				}
+				compression_done->store(true);
+				compression_done->notify_all();
+			}, "log_compress");
+			rotated_files.emplace_back(rotated_file_t { rotated_name, std::move(compression_done) });
+		} else {
+			rotated_files.emplace_back(rotated_file_t { rotated_name, nullptr });
+		}
+		
+		remove_old_rotated_files();
+		open(true);
+	}
+	
+	//! blocks until the compression of all rotated files has finished
+	//! NOTE: files are only removed from "rotated_files" once compression has finished, so this covers all outstanding ones
+	void wait_for_compression() {
+		for (const auto& rotated_file : rotated_files) {
+			if (rotated_file.compression_done) {
+				rotated_file.compression_done->wait(false);
+			}
+		}
+	}
+	
+	//! removes the oldest rotated files if there are more than allowed
+	//! NOTE: files that are still being compressed are kept until compression has finished (-> removed on a later rotation)
+	void remove_old_rotated_files() {
+		while (options.max_rotated_files > 0 && rotated_files.size() > options.max_rotated_files) {
+			const auto& rotated_file = rotated_files.front();
+			if (rotated_file.compression_done && !rotated_file.compression_done->load()) {
+				break;
+			}
+			// remove whichever file exists (compression may have failed)
+			std::error_code ec {};
+			std::filesystem::remove(rotated_file.name, ec);
+			std::filesystem::remove(rotated_file.name + ".bcm", ec);
+			rotated_files.pop_front();
+		}
+	}
+	
+};
+
 static struct logger_state_t {
 	std::string log_filename;
 	std::string msg_filename;
-	std::unique_ptr<std::ofstream> log_file { nullptr };
-	std::unique_ptr<std::ofstream> msg_file { nullptr };
+	std::unique_ptr<log_file_sink> log_file;
+	std::unique_ptr<log_file_sink> msg_file;
+	
+	//! max verbosity of messages that are written to the console
+	std::atomic<logger::LOG_TYPE> console_verbosity { logger::LOG_TYPE::UNDECORATED };
+	//! max verbosity of messages that are written to the log file(s)
+	std::atomic<logger::LOG_TYPE> file_verbosity { logger::LOG_TYPE::UNDECORATED };
 	
 	std::atomic<uint32_t> err_counter { 0u };
+	std::atomic<uint64_t> seq_counter { 0u };
 	
 	atomic_spin_lock store_lock;
 	std::vector<log_entry_t> store GUARDED_BY(store_lock);
 	std::vector<log_entry_t> output_store;
 	
-	std::atomic<logger::LOG_TYPE> verbosity { logger::LOG_TYPE::UNDECORATED };
+	//! all deferred log rings of all threads that have used deferred logging
+	safe_mutex rings_lock;
+	std::vector<std::shared_ptr<deferred_log_ring_t>> rings GUARDED_BY(rings_lock);
+	
 	bool append_mode { false };
 	bool use_time { true };
 	bool use_color { true };
@@ -60,8 +391,6 @@ static struct logger_state_t {
 	bool synchronous { false };
 	bool file_logging { true };
 	
-	std::mutex run_cv_lock;
-	std::condition_variable run_cv;
 	std::atomic<bool> initialized { false };
 	std::atomic<bool> destroying { false };
 } logger_state {};
@@ -71,65 +400,143 @@ public:
 	std::atomic<uint32_t> run_num { 0 };
 	
 	logger_thread() : thread_base("logger") {
-		this->set_thread_delay(0); // never sleep in thread_base
-		this->set_yield_after_run(false); // never yield
+		// only run when triggered
+		// NOTE: in deferred mode, non-error messages don't trigger the logger thread -> also run every 50ms
+		this->set_wakeup_driven(true);
+		this->set_thread_delay(logger::is_deferred() ? 50 : 0);
 		this->start();
 	}
 	~logger_thread() override {
 		// finish (kill the logger thread) and run once more to make sure everything has been saved/printed
-		set_thread_should_finish();
-		logger_state.run_cv.notify_all();
 		finish();
 		run();
 		
-		if (logger_state.log_file) {
-			logger_state.log_file->close();
-			logger_state.log_file.reset();
-		}
-		if (logger_state.msg_file) {
-			logger_state.msg_file->close();
-			logger_state.msg_file.reset();
-		}
+		// NOTE: this flushes and closes the files
+		logger_state.log_file.reset();
+		logger_state.msg_file.reset();
 	}
 	
-	void run() override REQUIRES(!logger_state.store_lock);
+	void run() override REQUIRES(!logger_state.store_lock, !logger_state.rings_lock);
+	
+	//! make this public
+	using thread_base::wakeup;
 };
+//! owned by init()/destroy(), must not be accessed anywhere else
 static std::unique_ptr<logger_thread> log_thread;
+//! logger thread that is accessed by all logging threads (via log_thread_ref_t) + the amount of threads currently accessing it
+//! NOTE: destroy() clears the pointer first and then waits until there are no more users before destroying the logger thread
+static std::atomic<logger_thread*> log_thread_ptr { nullptr };
+static std::atomic<uint32_t> log_thread_users { 0u };
 
-static inline void write_log_entry(log_entry_t&& entry) {
-	if (entry.first != logger::LOG_TYPE::ERROR_MSG) {
-		std::cout << entry.second;
-	} else {
-		std::cerr << entry.second;
+//! provides safe access to the logger thread (if there is one) for the lifetime of this object
+class log_thread_ref_t {
+public:
+	log_thread_ref_t() {
+		// NOTE: both must be sequentially consistent, so that either destroy() sees this user or we see the cleared pointer
+		++log_thread_users;
+		thread = log_thread_ptr.load();
+	}
+	~log_thread_ref_t() {
+		--log_thread_users;
 	}
+	log_thread_ref_t(const log_thread_ref_t&) = delete;
+	log_thread_ref_t& operator=(const log_thread_ref_t&) = delete;
 	
-	if (!logger_state.file_logging) {
-		return;
+	logger_thread* operator->() const {
+		return thread;
+	}
+	explicit operator bool() const {
+		return (thread != nullptr);
 	}
 	
-	if (entry.second[0] == 0x1B) {
-		// strip the color information when writing to the log file
-		entry.second.erase(0, 5);
-		entry.second.erase(5, 3);
+protected:
+	logger_thread* thread { nullptr };
+};
+
+//! triggers the logger thread to write all stored log entries
+static inline void trigger_log_thread() {
+	if (const log_thread_ref_t thread_ref; thread_ref) {
+		thread_ref->wakeup();
+	}
+}
+
+//! writes the entry to the console and/or adds it to the log file sink, returns true if it was written to the console
+static inline bool write_log_entry(const log_entry_t& entry, const logger::LOG_TYPE console_verbosity, const logger::LOG_TYPE file_verbosity) {
+	const auto write_to_console = (entry.type <= console_verbosity);
+	if (write_to_console) {
+		if (entry.type != logger::LOG_TYPE::ERROR_MSG) {
+			std::cout << entry.str;
+		} else {
+			std::cerr << entry.str;
+		}
 	}
 	
-	// if "separate msg file logging" is enabled and the log type is "msg", log to the msg file
-	if (entry.first == logger::LOG_TYPE::SIMPLE_MSG && logger_state.msg_file) {
-		*logger_state.msg_file << entry.second;
+	if (!logger_state.file_logging || entry.type > file_verbosity) {
+		return write_to_console;
 	}
+	
+	// if "separate msg file logging" is enabled and the log type is "msg", log to the msg file
 	// else: just output to the standard log file
-	else {
-		*logger_state.log_file << entry.second;
+	auto& file = (entry.type == logger::LOG_TYPE::SIMPLE_MSG && logger_state.msg_file ? logger_state.msg_file : logger_state.log_file);
+	if (!file) {
+		return write_to_console;
+	}
+	
+	if (entry.str.size() >= 13 && entry.str[0] == 0x1B) {
+		// strip the color information when writing to the log file:
+		// "\033[3?m" + 5 chars type tag + "\033[m" + the actual message
+		file->add(&entry.str[5], 5);
+		file->add(&entry.str[13], entry.str.size() - 13);
+	} else {
+		file->add(entry.str.data(), entry.str.size());
 	}
+	return write_to_console;
 }
 
-void logger_thread::run() {
-	{
-		// wait until work is triggered (notified) or timeout after 500ms
-		std::unique_lock<std::mutex> run_lock_guard(logger_state.run_cv_lock);
-		logger_state.run_cv.wait_for(run_lock_guard, 500ms);
+static void write_log_prefix(std::stringstream& buffer, const logger::LOG_TYPE& type, const char* file, const char* func,
+							 const std::chrono::system_clock::time_point& time, const uint32_t err_idx);
+
+//! formats all deferred log records of all threads and adds them to "output"
+//! NOTE: only called by the logger thread
+static void format_deferred_log_records(std::vector<log_entry_t>& output) REQUIRES(!logger_state.rings_lock) {
+	GUARD(logger_state.rings_lock);
+	for (auto ring_iter = logger_state.rings.begin(); ring_iter != logger_state.rings.end();) {
+		auto& ring = **ring_iter;
+		// NOTE: must query this before the write position, so that we don't miss any last records
+		const auto producer_exited = ring.producer_exited.load();
+		const auto write_pos = ring.write_pos.load(std::memory_order_acquire);
+		auto read_pos = ring.read_pos.load(std::memory_order_relaxed);
+		while (read_pos < write_pos) {
+			const auto offset = read_pos % deferred_log_ring_t::capacity;
+			const auto record_ptr = &ring.data[offset];
+			uint32_t record_size = 0;
+			memcpy(&record_size, record_ptr, sizeof(record_size));
+			if (record_size == 0) {
+				// wrap-around
+				read_pos += deferred_log_ring_t::capacity - offset;
+				continue;
+			}
+			
+			const auto& record = *(const deferred_log_record_t*)record_ptr;
+			std::stringstream buffer;
+			write_log_prefix(buffer, record.type, record.file, record.func, record.time, record.err_idx);
+			record.format_func(buffer, *record.format, record_ptr + sizeof(deferred_log_record_t));
+			buffer << std::endl;
+			output.emplace_back(log_entry_t { record.seq, record.type, buffer.str() });
+			read_pos += record_size;
+		}
+		ring.read_pos.store(read_pos, std::memory_order_release);
+		
+		// remove the ring once it has been fully consumed and its thread no longer exists
+		if (producer_exited && read_pos == write_pos) {
+			ring_iter = logger_state.rings.erase(ring_iter);
+		} else {
+			++ring_iter;
+		}
 	}
-	
+}
+
+void logger_thread::run() {
 	// swap the (empty) log output store/queue with the (probably non-empty) log output store
 	// note that this is a constant complexity operation, which makes log writing+output almost non-interrupting
 	{
@@ -137,50 +544,40 @@ void logger_thread::run() {
 		logger_state.output_store.swap(logger_state.store);
 	}
 	
+	// format all deferred log records and restore the global log order
+	const auto immediate_entry_count = logger_state.output_store.size();
+	format_deferred_log_records(logger_state.output_store);
+	if (logger_state.output_store.size() != immediate_entry_count) {
+		std::stable_sort(logger_state.output_store.begin(), logger_state.output_store.end(), [](const log_entry_t& lhs, const log_entry_t& rhs) {
+			return (lhs.seq < rhs.seq);
+		});
+	}
+	
 	if (logger_state.output_store.empty()) {
 		++run_num;
 		return;
 	}
 	
-	// in append mode, close the file and reopen it in append mode
-	if (logger_state.file_logging && logger_state.append_mode) {
-		if (logger_state.log_file->is_open()) {
-			logger_state.log_file->close();
-			logger_state.log_file->clear();
-		}
-		logger_state.log_file->open(logger_state.log_filename, std::ofstream::app | std::ofstream::out);
-		
-		if (logger_state.msg_file) {
-			if (logger_state.msg_file->is_open()) {
-				logger_state.msg_file->close();
-				logger_state.msg_file->clear();
-			}
-			logger_state.msg_file->open(logger_state.msg_filename, std::ofstream::app | std::ofstream::out);
-		}
-	}
-	
 	// write all log store entries
-	for (auto& entry : logger_state.output_store) {
+	const auto console_verbosity = logger_state.console_verbosity.load();
+	const auto file_verbosity = logger_state.file_verbosity.load();
+	bool wrote_to_console = false;
+	for (const auto& entry : logger_state.output_store) {
 		// finally: output
-		write_log_entry(std::move(entry));
+		wrote_to_console |= write_log_entry(entry, console_verbosity, file_verbosity);
+	}
+	if (wrote_to_console) {
+		std::cout.flush();
+		std::cerr.flush();
 	}
-	std::cout.flush();
-	std::cerr.flush();
 	if (logger_state.file_logging) {
-		logger_state.log_file->flush();
+		// NOTE: entries must still be alive at this point
+		if (logger_state.log_file) {
+			logger_state.log_file->flush();
+		}
 		if (logger_state.msg_file) {
 			logger_state.msg_file->flush();
 		}
-		
-		// in append mode, always close the file after writing to it
-		if (logger_state.append_mode) {
-			logger_state.log_file->close();
-			logger_state.log_file->clear();
-			if (logger_state.msg_file) {
-				logger_state.msg_file->close();
-				logger_state.msg_file->clear();
-			}
-		}
 	}
 	
 	// now that everything has been written, clear the output store
@@ -198,7 +595,9 @@ void logger::init(const size_t verbosity,
 				  const bool synchronous_logging,
 				  const bool file_logging,
 				  const std::string& log_filename_,
-				  const std::string& msg_filename_) {
+				  const std::string& msg_filename_,
+				  const bool deferred_logging,
+				  const file_sink_options_t& file_options) {
 	// only allow single init
 	if (logger_state.initialized.exchange(true)) {
 		return;
@@ -207,6 +606,9 @@ void logger::init(const size_t verbosity,
 	// always call destroy on program exit
 	atexit([] { logger::destroy(); });
 	
+	// if no separate file verbosity is specified, use the same verbosity for the console and the log file(s)
+	const auto file_verbosity = file_options.file_verbosity.value_or((logger::LOG_TYPE)verbosity);
+	
 	logger_state.file_logging = file_logging;
 	if (logger_state.file_logging) {
 		// if either is empty, use the default log/msg file name, with special treatment on iOS
@@ -236,24 +638,23 @@ void logger::init(const size_t verbosity,
 			logger_state.msg_filename = msg_filename_;
 		}
 		
-		logger_state.log_file = std::make_unique<std::ofstream>(logger_state.log_filename, (append_mode ? std::ofstream::app | std::ofstream::out : std::ofstream::out));
-		if (!logger_state.log_file->is_open()) {
-			std::cerr << "LOG ERROR: couldn't open log file (" << logger_state.log_filename << ")!" << std::endl;
-		}
+		// NOTE: sinks print an error themselves if the file couldn't be opened
+		logger_state.log_file = std::make_unique<log_file_sink>(logger_state.log_filename, append_mode, file_options);
 		
-		if (separate_msg_file && verbosity >= (size_t)logger::LOG_TYPE::SIMPLE_MSG) {
-			logger_state.msg_file = std::make_unique<std::ofstream>(logger_state.msg_filename, (append_mode ? std::ofstream::app | std::ofstream::out : std::ofstream::out));
-			if (!logger_state.msg_file->is_open()) {
-				std::cerr << "LOG ERROR: couldn't open msg log file (" << logger_state.msg_filename << ")!" << std::endl;
-			}
+		if (separate_msg_file && file_verbosity >= logger::LOG_TYPE::SIMPLE_MSG) {
+			logger_state.msg_file = std::make_unique<log_file_sink>(logger_state.msg_filename, append_mode, file_options);
 		}
 	}
 	
-	logger_state.verbosity = (logger::LOG_TYPE)verbosity;
+	logger_state.console_verbosity = (logger::LOG_TYPE)verbosity;
+	logger_state.file_verbosity = file_verbosity;
+	logger::verbosity = std::max(logger_state.console_verbosity.load(), file_verbosity);
 	logger_state.append_mode = append_mode;
 	logger_state.use_time = use_time;
 	logger_state.use_color = use_color;
 	logger_state.synchronous = synchronous_logging;
+	// NOTE: deferred logging is pointless when logging synchronously
+	logger::deferred = (deferred_logging && !synchronous_logging);
 #if defined(__WINDOWS__)
 	if (logger_state.use_color) {
 		// disable color in Windows cmd/powershell
@@ -270,6 +671,9 @@ void logger::init(const size_t verbosity,
 	
 	// create+start the logger thread
 	log_thread = std::make_unique<logger_thread>();
+	log_thread_ptr = log_thread.get();
+	// write everything that has been logged up to now
+	trigger_log_thread();
 }
 
 void logger::destroy() {
@@ -283,6 +687,13 @@ void logger::destroy() {
 	}
 	
 	log_msg("killing logger ...");
+	// all further messages are logged immediately, deferred ones will still be written by the last logger thread run
+	deferred = false;
+	// stop all further logger thread accesses and wait until all current ones are done before destroying it
+	log_thread_ptr = nullptr;
+	while (log_thread_users > 0u) {
+		std::this_thread::yield();
+	}
 	log_thread = nullptr;
 	
 	logger_state.initialized = false;
@@ -290,23 +701,33 @@ void logger::destroy() {
 }
 
 void logger::flush() {
-	if (!log_thread) {
+	const log_thread_ref_t thread_ref;
+	if (!thread_ref) {
 		return;
 	}
-	const uint32_t cur_run = log_thread->run_num;
-	while (cur_run == log_thread->run_num) {
+	const uint32_t cur_run = thread_ref->run_num;
+	thread_ref->wakeup();
+	while (cur_run == thread_ref->run_num) {
 		std::this_thread::yield();
 	}
 }
 
 bool logger::prepare_log(std::stringstream& buffer, const LOG_TYPE& type, const char* file, const char* func) {
 	// check verbosity level and leave or continue accordingly
-	if (logger_state.verbosity < type) {
+	if (!is_enabled(type)) {
 		return false;
 	}
 	
+	write_log_prefix(buffer, type, file, func, std::chrono::system_clock::now(),
+					 (type == LOG_TYPE::ERROR_MSG ? logger_state.err_counter++ : 0u));
+	return true;
+}
+
+static void write_log_prefix(std::stringstream& buffer, const logger::LOG_TYPE& type, const char* file, const char* func,
+							 const std::chrono::system_clock::time_point& time, const uint32_t err_idx) {
+	using LOG_TYPE = logger::LOG_TYPE;
 	if (type == logger::LOG_TYPE::UNDECORATED) {
-		return true;
+		return;
 	}
 	
 	if (logger_state.use_color && logger_state.use_unicode_color) {
@@ -349,8 +770,7 @@ bool logger::prepare_log(std::stringstream& buffer, const LOG_TYPE& type, const
 	if (logger_state.use_time) {
 		buffer << "[";
 		char time_str[64] { '\0' };
-		const auto system_now = std::chrono::system_clock::now();
-		const auto cur_time = std::chrono::system_clock::to_time_t(system_now);
+		const auto cur_time = std::chrono::system_clock::to_time_t(time);
 		struct tm local_time {};
 #if !defined(__WINDOWS__)
 		if (localtime_r(&cur_time, &local_time)) {
@@ -364,7 +784,7 @@ bool logger::prepare_log(std::stringstream& buffer, const LOG_TYPE& type, const
 		buffer << time_str;
 		buffer << ".";
 		buffer << std::setw(const_math::int_width(std::chrono::system_clock::period::den) - 1);
-		buffer << system_now.time_since_epoch().count() % std::chrono::system_clock::period::den << std::setw(0);
+		buffer << time.time_since_epoch().count() % std::chrono::system_clock::period::den << std::setw(0);
 		buffer << "]";
 	}
 	
@@ -375,51 +795,123 @@ bool logger::prepare_log(std::stringstream& buffer, const LOG_TYPE& type, const
 	buffer << " ";
 	
 	if (type == LOG_TYPE::ERROR_MSG) {
-		buffer << "#" << logger_state.err_counter++ << ": ";
+		buffer << "#" << err_idx << ": ";
 	}
 	
 	if (type != logger::LOG_TYPE::SIMPLE_MSG) {
 		buffer << (file ? file : "") << ": " << (func ? func : "") << "(): ";
 	}
-	
-	return true;
 }
 
-void logger::log_internal(std::stringstream& buffer, const LOG_TYPE& type, const char* str) REQUIRES(!logger_state.store_lock) {
+void logger::log_internal(std::stringstream& buffer, const LOG_TYPE& type) REQUIRES(!logger_state.store_lock) {
 	// this is the final log function
-	if (str) {
-		while (*str) {
-			buffer << *str++;
-		}
-	}
 	buffer << std::endl;
 	
 	// add string to log store/queue
+	const log_thread_ref_t thread_ref;
 	uint32_t cur_run = 0;
 	{
 		GUARD(logger_state.store_lock);
-		logger_state.store.emplace_back(type, buffer.str());
-		if (logger_state.synchronous && log_thread) {
+		logger_state.store.emplace_back(log_entry_t { logger_state.seq_counter++, type, buffer.str() });
+		if (logger_state.synchronous && thread_ref) {
 			// similar to flush(): query current run number here ...
-			cur_run = log_thread->run_num;
+			cur_run = thread_ref->run_num;
 		}
 	}
 	// trigger logger thread
-	logger_state.run_cv.notify_all();
-	if (logger_state.synchronous && log_thread) {
+	if (!thread_ref) {
+		return;
+	}
+	thread_ref->wakeup();
+	if (logger_state.synchronous) {
 		// ... then wait until it has changed
-		while (cur_run == log_thread->run_num) {
+		while (cur_run == thread_ref->run_num) {
 			std::this_thread::yield();
 		}
 	}
 }
 
-void logger::set_verbosity(const LOG_TYPE& verbosity) {
-	logger_state.verbosity = verbosity;
+void logger::set_verbosity(const LOG_TYPE& verbosity_) {
+	logger_state.console_verbosity = verbosity_;
+	logger_state.file_verbosity = verbosity_;
+	verbosity = verbosity_;
+}
+
+void logger::set_console_verbosity(const LOG_TYPE& verbosity_) {
+	logger_state.console_verbosity = verbosity_;
+	verbosity = std::max(verbosity_, logger_state.file_verbosity.load());
+}
+
+void logger::set_file_verbosity(const LOG_TYPE& verbosity_) {
+	logger_state.file_verbosity = verbosity_;
+	verbosity = std::max(logger_state.console_verbosity.load(), verbosity_);
 }
 
 logger::LOG_TYPE logger::get_verbosity() {
-	return logger_state.verbosity;
+	return verbosity;
+}
+
+uint8_t* logger::acquire_deferred(const LOG_TYPE type, const char* file, const char* func, const format_view_t* format,
+								  deferred_format_func_t format_func, const size_t arg_size) REQUIRES(!logger_state.rings_lock) {
+	// don't hog the ring with huge messages
+	const auto record_size = ((sizeof(deferred_log_record_t) + arg_size + deferred_log_ring_t::record_alignment - 1u) /
+							  deferred_log_ring_t::record_alignment) * deferred_log_ring_t::record_alignment;
+	if (record_size > deferred_log_ring_t::capacity / 4u) {
+		return nullptr;
+	}
+	
+	// create the ring for this thread on first use
+	if (!deferred_ring_holder.ring) {
+		deferred_ring_holder.ring = std::make_shared<deferred_log_ring_t>();
+		GUARD(logger_state.rings_lock);
+		logger_state.rings.emplace_back(deferred_ring_holder.ring);
+	}
+	auto& ring = *deferred_ring_holder.ring;
+	
+	// records must be contiguous -> skip the remainder of the ring if the record doesn't fit
+	const auto write_pos = ring.write_pos.load(std::memory_order_relaxed);
+	const auto offset = write_pos % deferred_log_ring_t::capacity;
+	const auto contiguous_size = deferred_log_ring_t::capacity - offset;
+	const auto required_size = (record_size <= contiguous_size ? record_size : contiguous_size + record_size);
+	if (write_pos + required_size - ring.read_pos.load(std::memory_order_acquire) > deferred_log_ring_t::capacity) {
+		// ring is full -> log immediately and make sure the logger thread catches up
+		trigger_log_thread();
+		return nullptr;
+	}
+	
+	auto record_ptr = &ring.data[offset];
+	if (record_size > contiguous_size) {
+		const uint32_t wrap_around_marker = 0u;
+		memcpy(record_ptr, &wrap_around_marker, sizeof(wrap_around_marker));
+		record_ptr = &ring.data[0];
+	}
+	ring.acquired_size = required_size;
+	
+	new (record_ptr) deferred_log_record_t {
+		.size = uint32_t(record_size),
+		.type = type,
+		.seq = logger_state.seq_counter++,
+		.time = std::chrono::system_clock::now(),
+		.file = file,
+		.func = func,
+		.format = format,
+		.format_func = format_func,
+		.err_idx = (type == LOG_TYPE::ERROR_MSG ? logger_state.err_counter++ : 0u),
+	};
+	return record_ptr + sizeof(deferred_log_record_t);
+}
+
+void logger::commit_deferred(const LOG_TYPE type) {
+	auto& ring = *deferred_ring_holder.ring;
+	const auto write_pos = ring.write_pos.load(std::memory_order_relaxed) + ring.acquired_size;
+	ring.write_pos.store(write_pos, std::memory_order_release);
+	
+	// errors should be written as soon as possible, everything else will be written on the next (timed) logger thread run,
+	// unless the ring is filling up
+	if (type == LOG_TYPE::ERROR_MSG ||
+		write_pos - ring.read_pos.load(std::memory_order_relaxed) > deferred_log_ring_t::capacity / 2u) {
+		trigger_log_thread();
+	}
 }
 
 bool logger::is_initialized() {
@@ -0,0 +1,171 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/core/mapped_file.hpp>
+#include <floor/core/platform.hpp>
+#include <floor/core/logger.hpp>
+#include <utility>
+
+#if defined(__WINDOWS__)
+#include <floor/core/platform_windows.hpp>
+#include <floor/core/essentials.hpp> // cleanup
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fl {
+
+mapped_file::mapped_file(const std::string& filename, const ACCESS_PATTERN access_pattern) {
+#if defined(__WINDOWS__)
+	file_handle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							  (access_pattern == ACCESS_PATTERN::SEQUENTIAL ? FILE_FLAG_SEQUENTIAL_SCAN :
+							   (access_pattern == ACCESS_PATTERN::RANDOM ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL)),
+							  nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		file_handle = nullptr;
+		log_error("failed to open file \"$\" for mapping", filename);
+		return;
+	}
+	LARGE_INTEGER file_size {};
+	if (!GetFileSizeEx(file_handle, &file_size)) {
+		log_error("failed to query the size of file \"$\"", filename);
+		close();
+		return;
+	}
+	data_size = size_t(file_size.QuadPart);
+	if (data_size == 0) {
+		// can't map empty files, but this is still valid
+		valid = true;
+		return;
+	}
+	mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping_handle == nullptr) {
+		log_error("failed to create file mapping for \"$\"", filename);
+		close();
+		return;
+	}
+	data_ptr = (const uint8_t*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+	if (data_ptr == nullptr) {
+		log_error("failed to map file \"$\"", filename);
+		close();
+		return;
+	}
+#else
+	const auto fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		log_error("failed to open file \"$\" for mapping", filename);
+		return;
+	}
+	struct stat file_stat {};
+	if (fstat(fd, &file_stat) != 0) {
+		log_error("failed to query the size of file \"$\"", filename);
+		::close(fd);
+		return;
+	}
+	data_size = size_t(file_stat.st_size);
+	if (data_size == 0) {
+		// can't map empty files, but this is still valid
+		::close(fd);
+		valid = true;
+		return;
+	}
+	auto mapping = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// NOTE: the mapping keeps its own reference to the file
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		log_error("failed to map file \"$\"", filename);
+		data_size = 0;
+		return;
+	}
+	data_ptr = (const uint8_t*)mapping;
+	
+	if (access_pattern != ACCESS_PATTERN::NORMAL) {
+		// NOTE: this is only a hint, ignore if this fails
+		(void)posix_madvise(mapping, data_size, (access_pattern == ACCESS_PATTERN::SEQUENTIAL ?
+												 POSIX_MADV_SEQUENTIAL : POSIX_MADV_RANDOM));
+	}
+#endif
+	valid = true;
+}
+
+mapped_file::~mapped_file() {
+	close();
+}
+
+mapped_file::mapped_file(mapped_file&& mfile) noexcept :
+data_ptr(std::exchange(mfile.data_ptr, nullptr)),
+data_size(std::exchange(mfile.data_size, 0u)),
+valid(std::exchange(mfile.valid, false)),
+file_handle(std::exchange(mfile.file_handle, nullptr)),
+mapping_handle(std::exchange(mfile.mapping_handle, nullptr)) {}
+
+mapped_file& mapped_file::operator=(mapped_file&& mfile) noexcept {
+	if (this != &mfile) {
+		close();
+		data_ptr = std::exchange(mfile.data_ptr, nullptr);
+		data_size = std::exchange(mfile.data_size, 0u);
+		valid = std::exchange(mfile.valid, false);
+		file_handle = std::exchange(mfile.file_handle, nullptr);
+		mapping_handle = std::exchange(mfile.mapping_handle, nullptr);
+	}
+	return *this;
+}
+
+void mapped_file::close() {
+#if defined(__WINDOWS__)
+	if (data_ptr != nullptr) {
+		UnmapViewOfFile(data_ptr);
+	}
+	if (mapping_handle != nullptr) {
+		CloseHandle(mapping_handle);
+		mapping_handle = nullptr;
+	}
+	if (file_handle != nullptr) {
+		CloseHandle(file_handle);
+		file_handle = nullptr;
+	}
+#else
+	if (data_ptr != nullptr) {
+		munmap((void*)data_ptr, data_size);
+	}
+#endif
+	data_ptr = nullptr;
+	data_size = 0;
+	valid = false;
+}
+
+void mapped_file::prefetch(const size_t offset, const size_t size) const {
+	if (data_ptr == nullptr || offset >= data_size) {
+		return;
+	}
+	const auto prefetch_size = std::min(size, data_size - offset);
+#if defined(__WINDOWS__)
+	WIN32_MEMORY_RANGE_ENTRY range { .VirtualAddress = (void*)(data_ptr + offset), .NumberOfBytes = prefetch_size };
+	(void)PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+	// madvise requires a page-aligned address
+	static const auto page_size = size_t(sysconf(_SC_PAGESIZE));
+	const auto aligned_offset = offset & ~(page_size - 1u);
+	(void)posix_madvise((void*)(data_ptr + aligned_offset), prefetch_size + (offset - aligned_offset), POSIX_MADV_WILLNEED);
+#endif
+}
+
+} // namespace fl
@@ -17,19 +17,88 @@
  */
 
 #include <floor/core/unicode.hpp>
+#include <floor/core/essentials.hpp>
+#include <cstring>
 
 #if defined(__APPLE__)
 #include <floor/darwin/darwin_helper.hpp>
 #endif
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define FLOOR_UNICODE_SIMD 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FLOOR_UNICODE_SIMD 1
+#endif
+
 namespace fl::unicode {
 
+//! size of a SIMD block and the unit of all bulk operations
+static constexpr const size_t block_size { 16u };
+
+//! returns true if the 16 bytes at "ptr" are all ASCII
+static inline bool is_ascii_block(const char* ptr) {
+#if defined(__SSSE3__)
+	return (_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ptr)) == 0);
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	return (vmaxvq_u8(vld1q_u8((const uint8_t*)ptr)) < 0x80u);
+#else
+	uint64_t words[2];
+	memcpy(words, ptr, sizeof(words));
+	return ((words[0] | words[1]) & 0x8080'8080'8080'8080ull) == 0u;
+#endif
+}
+
+//! returns the offset of the first block starting at "offset" that is not all ASCII (or the start of the remainder)
+static inline size_t skip_ascii_blocks(const std::string_view& str, size_t offset) {
+	const auto size = str.size();
+	// check 4 blocks at once while possible
+	while (offset + 4u * block_size <= size) {
+#if defined(__SSSE3__)
+		const auto ptr = (const __m128i*)(str.data() + offset);
+		const auto combined = _mm_or_si128(_mm_or_si128(_mm_loadu_si128(ptr), _mm_loadu_si128(ptr + 1)),
+										   _mm_or_si128(_mm_loadu_si128(ptr + 2), _mm_loadu_si128(ptr + 3)));
+		if (_mm_movemask_epi8(combined) != 0) {
+			break;
+		}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+		const auto ptr = (const uint8_t*)(str.data() + offset);
+		const auto combined = vorrq_u8(vorrq_u8(vld1q_u8(ptr), vld1q_u8(ptr + 16)),
+									   vorrq_u8(vld1q_u8(ptr + 32), vld1q_u8(ptr + 48)));
+		if (vmaxvq_u8(combined) >= 0x80u) {
+			break;
+		}
+#else
+		if (!is_ascii_block(str.data() + offset) || !is_ascii_block(str.data() + offset + block_size) ||
+			!is_ascii_block(str.data() + offset + 2u * block_size) || !is_ascii_block(str.data() + offset + 3u * block_size)) {
+			break;
+		}
+#endif
+		offset += 4u * block_size;
+	}
+	while (offset + block_size <= size && is_ascii_block(str.data() + offset)) {
+		offset += block_size;
+	}
+	return offset;
+}
+
+//! returns the offset of the first non-ASCII char starting at "offset" (or str.size() if there is none)
+static inline size_t skip_ascii(const std::string_view& str, size_t offset) {
+	const auto size = str.size();
+	offset = skip_ascii_blocks(str, offset);
+	while (offset < size && (uint8_t(str[offset]) & 0x80u) == 0u) {
+		++offset;
+	}
+	return offset;
+}
+
 template <typename iter_type>
 static std::pair<bool, uint32_t> gen_iter_decode_utf8_char(iter_type& iter, const iter_type& end_iter) {
 	// figure out how long the utf-8 char is (how many bytes)
 	uint32_t size = 0;
 	const uint32_t char_code = ((uint32_t)*iter) & 0xFFu;
-	while((char_code & (1u << (7u - size))) != 0u) {
+	while(size < 8u && (char_code & (1u << (7u - size))) != 0u) {
 		++size;
 	}
 	
@@ -82,25 +151,52 @@ std::pair<bool, uint32_t> decode_utf8_char(std::string_view::const_iterator& ite
 #endif
 
 std::vector<uint32_t> utf8_to_unicode(const std::string_view& str) {
-	std::vector<uint32_t> ret;
-	
-	const auto end_iter = str.cend();
-	for(auto iter = str.cbegin(); iter != end_iter; ++iter) {
-		const auto code = decode_utf8_char(iter, end_iter);
-		if(!code.first) return ret;
-		ret.emplace_back(code.second);
-	}
-	
+	std::vector<uint32_t> ret(str.size());
+	ret.resize(utf8_to_unicode(str, ret));
 	return ret;
 }
 
+size_t utf8_to_unicode(const std::string_view& str, std::span<uint32_t> dst) {
+	const auto size = str.size();
+	auto dst_ptr = dst.data();
+	size_t offset = 0;
+	while (offset < size) {
+		// ASCII fast path: widen whole blocks (auto-vectorized)
+		while (offset + block_size <= size && is_ascii_block(str.data() + offset)) {
+			for (size_t i = 0; i < block_size; ++i) {
+				dst_ptr[i] = uint8_t(str[offset + i]);
+			}
+			dst_ptr += block_size;
+			offset += block_size;
+		}
+		if (offset == size) {
+			break;
+		}
+		
+		auto iter = str.data() + offset;
+		const auto code = decode_utf8_char(iter, str.data() + size);
+		if (!code.first) {
+			break;
+		}
+		*dst_ptr++ = code.second;
+		offset = size_t(iter - str.data()) + 1u;
+	}
+	return size_t(dst_ptr - dst.data());
+}
+
 std::string unicode_to_utf8(const std::vector<uint32_t>& codes) {
-	std::string ret;
+	std::string ret(codes.size() * 4u, '\0');
+	ret.resize(unicode_to_utf8(codes, ret));
+	return ret;
+}
+
+size_t unicode_to_utf8(const std::span<const uint32_t> codes, std::span<char> dst) {
+	auto dst_ptr = dst.data();
 	for(const auto& code : codes) {
 		if((code & 0xFFFFFF80u) == 0u) {
 			// ascii char, only accept 0x09 (tab) and 0x20 to 0x7F (0x00 to 0x1F are used as control bytes)
 			if(code >= 0x20u || code == 0x09u) {
-				ret += (char)(code & 0xFFu);
+				*dst_ptr++ = (char)(code & 0xFFu);
 			}
 		}
 		else {
@@ -108,36 +204,44 @@ std::string unicode_to_utf8(const std::vector<uint32_t>& codes) {
 			if(code >= 0x80u && code <= 0x7FFu) {
 				// unicode: 00000yyy xxxxxxxx
 				// uft-8  : 110yyyxx 10xxxxxx
-				ret += (char)(0xC0u | ((code & 0x7C0u) >> 6u));
-				ret += (char)(0x80u | (code & 0x3Fu));
+				*dst_ptr++ = (char)(0xC0u | ((code & 0x7C0u) >> 6u));
+				*dst_ptr++ = (char)(0x80u | (code & 0x3Fu));
 			}
 			else if(code >= 0x800u && code <= 0xFFFFu) {
 				// unicode: yyyyyyyy xxxxxxxx
 				// uft-8  : 1110yyyy 10yyyyxx 10xxxxxx
-				ret += (char)(0xE0u | ((code & 0xF000u) >> 12u));
-				ret += (char)(0x80u | ((code & 0xFC0u) >> 6u));
-				ret += (char)(0x80u | (code & 0x3Fu));
+				*dst_ptr++ = (char)(0xE0u | ((code & 0xF000u) >> 12u));
+				*dst_ptr++ = (char)(0x80u | ((code & 0xFC0u) >> 6u));
+				*dst_ptr++ = (char)(0x80u | (code & 0x3Fu));
 			}
 			else if(code >= 0x10000u && code <= 0x1FFFFFu) {
 				// unicode: 000zzzzz yyyyyyyy xxxxxxxx
 				// uft-8  : 11110zzz 10zzyyyy 10yyyyxx 10xxxxxx
-				ret += (char)(0xF0u | ((code & 0x1C0000u) >> 18u));
-				ret += (char)(0x80u | ((code & 0x3F000u) >> 12u));
-				ret += (char)(0x80u | ((code & 0xFC0u) >> 6u));
-				ret += (char)(0x80u | (code & 0x3Fu));
+				*dst_ptr++ = (char)(0xF0u | ((code & 0x1C0000u) >> 18u));
+				*dst_ptr++ = (char)(0x80u | ((code & 0x3F000u) >> 12u));
+				*dst_ptr++ = (char)(0x80u | ((code & 0xFC0u) >> 6u));
+				*dst_ptr++ = (char)(0x80u | (code & 0x3Fu));
 			}
 			else {
 				// invalid -> abort
-				return ret;
+				break;
 			}
 		}
 	}
-	return ret;
+	return size_t(dst_ptr - dst.data());
 }
 
 std::pair<bool, std::string::const_iterator> validate_utf8_string(const std::string& str) {
 	const auto end_iter = str.cend();
 	for(auto iter = str.cbegin(); iter != end_iter; ++iter) {
+		// skip over all ASCII chars (these are always valid)
+		const auto offset = size_t(iter - str.cbegin());
+		const auto non_ascii_offset = skip_ascii(str, offset);
+		if (non_ascii_offset == str.size()) {
+			break;
+		}
+		iter += ptrdiff_t(non_ascii_offset - offset);
+		
 		const auto code = decode_utf8_char(iter, end_iter);
 		if(!code.first) {
 			return { false, iter };
@@ -146,6 +250,291 @@ std::pair<bool, std::string::const_iterator> validate_utf8_string(const std::str
 	return { true, str.cend() };
 }
 
+bool is_ascii(const std::string_view& str) {
+	return (skip_ascii(str, 0u) == str.size());
+}
+
+//! strictly decodes a single utf-8 code point at "offset" (RFC 3629: no overlong encodings, no surrogates, max U+10FFFF),
+//! returns the size of the code sequence in bytes and sets "code", or returns 0 if it is invalid
+static inline uint32_t decode_utf8_char_strict(const std::string_view& str, const size_t offset, uint32_t& code) {
+	const auto remaining = str.size() - offset;
+	const auto byte_0 = uint32_t(uint8_t(str[offset]));
+	if (byte_0 < 0x80u) {
+		code = byte_0;
+		return 1u;
+	}
+	
+	uint32_t size = 0u, min_code = 0u;
+	if ((byte_0 & 0xE0u) == 0xC0u) {
+		size = 2u;
+		min_code = 0x80u;
+		code = byte_0 & 0x1Fu;
+	} else if ((byte_0 & 0xF0u) == 0xE0u) {
+		size = 3u;
+		min_code = 0x800u;
+		code = byte_0 & 0x0Fu;
+	} else if ((byte_0 & 0xF8u) == 0xF0u) {
+		size = 4u;
+		min_code = 0x10000u;
+		code = byte_0 & 0x07u;
+	} else {
+		// continuation byte or invalid lead byte
+		return 0u;
+	}
+	if (size > remaining) {
+		return 0u;
+	}
+	for (uint32_t i = 1; i < size; ++i) {
+		const auto byte_i = uint32_t(uint8_t(str[offset + i]));
+		if ((byte_i & 0xC0u) != 0x80u) {
+			return 0u;
+		}
+		code = (code << 6u) | (byte_i & 0x3Fu);
+	}
+	if (code < min_code || code > 0x10FFFFu || (code >= 0xD800u && code <= 0xDFFFu)) {
+		return 0u;
+	}
+	return size;
+}
+
+//! strict scalar validation starting at "offset"
+static std::pair<bool, size_t> validate_utf8_scalar(const std::string_view& str, size_t offset) {
+	const auto size = str.size();
+	while (offset < size) {
+		offset = skip_ascii(str, offset);
+		if (offset == size) {
+			break;
+		}
+		uint32_t code = 0u;
+		const auto code_size = decode_utf8_char_strict(str, offset, code);
+		if (code_size == 0u) {
+			return { false, offset };
+		}
+		offset += code_size;
+	}
+	return { true, size };
+}
+
+//! returns the offset of the code sequence that contains the byte at "offset"
+//! (i.e. moves back over at most 3 continuation bytes)
+static inline size_t find_code_sequence_start(const std::string_view& str, size_t offset) {
+	for (uint32_t i = 0; i < 3u && offset > 0u && (uint8_t(str[offset]) & 0xC0u) == 0x80u; ++i) {
+		--offset;
+	}
+	return offset;
+}
+
+#if defined(FLOOR_UNICODE_SIMD)
+// vectorized utf-8 validation based on the "lookup" algorithm of simdutf/simdjson:
+// J. Keiser, D. Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte", https://arxiv.org/abs/2010.03090
+// -> each byte is classified by its high nibble and the high/low nibbles of the previous byte (3 table lookups),
+//    the AND of these classifications is non-zero for all invalid 2-byte combinations,
+//    3/4-byte sequences are then checked by comparing with the bytes 2 and 3 positions back
+namespace simd_validation {
+static constexpr const uint8_t TOO_SHORT { 1u << 0u }; // lead byte or ASCII followed by a lead byte or ASCII
+static constexpr const uint8_t TOO_LONG { 1u << 1u }; // ASCII followed by a continuation
+static constexpr const uint8_t OVERLONG_3 { 1u << 2u };
+static constexpr const uint8_t TOO_LARGE { 1u << 3u };
+static constexpr const uint8_t SURROGATE { 1u << 4u };
+static constexpr const uint8_t OVERLONG_2 { 1u << 5u };
+static constexpr const uint8_t TOO_LARGE_1000 { 1u << 6u };
+static constexpr const uint8_t OVERLONG_4 { 1u << 6u };
+static constexpr const uint8_t TWO_CONTS { 1u << 7u }; // two continuations
+static constexpr const uint8_t CARRY { TOO_SHORT | TOO_LONG | TWO_CONTS };
+
+alignas(16) static constexpr const uint8_t byte_1_high_table[16] {
+	// 0_______ ________ <ASCII in byte 1>
+	TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+	// 10______ ________ <continuation in byte 1>
+	TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+	// 1100____ ________ <two byte lead in byte 1>
+	TOO_SHORT | OVERLONG_2,
+	// 1101____ ________ <two byte lead in byte 1>
+	TOO_SHORT,
+	// 1110____ ________ <three byte lead in byte 1>
+	TOO_SHORT | OVERLONG_3 | SURROGATE,
+	// 1111____ ________ <four+ byte lead in byte 1>
+	TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+alignas(16) static constexpr const uint8_t byte_1_low_table[16] {
+	// ____0000 ________
+	CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+	// ____0001 ________
+	CARRY | OVERLONG_2,
+	// ____001_ ________
+	CARRY,
+	CARRY,
+	// ____0100 ________
+	CARRY | TOO_LARGE,
+	// ____0101 ________
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	// ____011_ ________
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	// ____1___ ________
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	// ____1101 ________
+	CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+	CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+alignas(16) static constexpr const uint8_t byte_2_high_table[16] {
+	// ________ 0_______ <ASCII in byte 2>
+	TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+	// ________ 1000____
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+	// ________ 1001____
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+	// ________ 101_____
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+	TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+	// ________ 11______ <lead byte in byte 2>
+	TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+//! the last 3 bytes of a block must not be the start of an incomplete multi-byte sequence (if the next block is ASCII or at the end)
+alignas(16) static constexpr const uint8_t incomplete_max_table[16] {
+	0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+	0xF0u - 1u, 0xE0u - 1u, 0xC0u - 1u,
+};
+
+#if defined(__SSSE3__)
+using block_t = __m128i;
+static floor_inline_always block_t load(const char* ptr) { return _mm_loadu_si128((const __m128i*)ptr); }
+static floor_inline_always block_t load_table(const uint8_t* table) { return _mm_load_si128((const __m128i*)table); }
+static floor_inline_always block_t zero() { return _mm_setzero_si128(); }
+static floor_inline_always bool is_ascii(const block_t& block) { return (_mm_movemask_epi8(block) == 0); }
+static floor_inline_always bool any(const block_t& block) { return (_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm_setzero_si128())) != 0xFFFF); }
+//! returns the block shifted by N bytes, with the last N bytes of "prev" in front
+template <int N> static floor_inline_always block_t prev(const block_t& cur, const block_t& prev) { return _mm_alignr_epi8(cur, prev, 16 - N); }
+static floor_inline_always block_t lookup(const block_t& table, const block_t& idx) { return _mm_shuffle_epi8(table, idx); }
+static floor_inline_always block_t shr4(const block_t& block) { return _mm_and_si128(_mm_srli_epi16(block, 4), _mm_set1_epi8(0x0F)); }
+static floor_inline_always block_t low4(const block_t& block) { return _mm_and_si128(block, _mm_set1_epi8(0x0F)); }
+static floor_inline_always block_t and_(const block_t& a, const block_t& b) { return _mm_and_si128(a, b); }
+static floor_inline_always block_t or_(const block_t& a, const block_t& b) { return _mm_or_si128(a, b); }
+static floor_inline_always block_t xor_(const block_t& a, const block_t& b) { return _mm_xor_si128(a, b); }
+static floor_inline_always block_t sat_sub(const block_t& a, const block_t& b) { return _mm_subs_epu8(a, b); }
+static floor_inline_always block_t splat(const uint8_t val) { return _mm_set1_epi8(char(val)); }
+#else
+using block_t = uint8x16_t;
+static floor_inline_always block_t load(const char* ptr) { return vld1q_u8((const uint8_t*)ptr); }
+static floor_inline_always block_t load_table(const uint8_t* table) { return vld1q_u8(table); }
+static floor_inline_always block_t zero() { return vdupq_n_u8(0u); }
+static floor_inline_always bool is_ascii(const block_t& block) { return (vmaxvq_u8(block) < 0x80u); }
+static floor_inline_always bool any(const block_t& block) { return (vmaxvq_u8(block) != 0u); }
+template <int N> static floor_inline_always block_t prev(const block_t& cur, const block_t& prev) { return vextq_u8(prev, cur, 16 - N); }
+static floor_inline_always block_t lookup(const block_t& table, const block_t& idx) { return vqtbl1q_u8(table, idx); }
+static floor_inline_always block_t shr4(const block_t& block) { return vshrq_n_u8(block, 4); }
+static floor_inline_always block_t low4(const block_t& block) { return vandq_u8(block, vdupq_n_u8(0x0Fu)); }
+static floor_inline_always block_t and_(const block_t& a, const block_t& b) { return vandq_u8(a, b); }
+static floor_inline_always block_t or_(const block_t& a, const block_t& b) { return vorrq_u8(a, b); }
+static floor_inline_always block_t xor_(const block_t& a, const block_t& b) { return veorq_u8(a, b); }
+static floor_inline_always block_t sat_sub(const block_t& a, const block_t& b) { return vqsubq_u8(a, b); }
+static floor_inline_always block_t splat(const uint8_t val) { return vdupq_n_u8(val); }
+#endif
+
+//! returns non-zero bytes for all invalid bytes in "input" (with "prev_input" being the previous block)
+static floor_inline_always block_t check_block(const block_t& input, const block_t& prev_input) {
+	const auto prev_1 = prev<1>(input, prev_input);
+	const auto byte_1_high = lookup(load_table(byte_1_high_table), shr4(prev_1));
+	const auto byte_1_low = lookup(load_table(byte_1_low_table), low4(prev_1));
+	const auto byte_2_high = lookup(load_table(byte_2_high_table), shr4(input));
+	const auto special_cases = and_(and_(byte_1_high, byte_1_low), byte_2_high);
+	
+	// bytes 2/3 positions after a 3/4-byte lead byte must be continuations
+	const auto prev_2 = prev<2>(input, prev_input);
+	const auto prev_3 = prev<3>(input, prev_input);
+	const auto is_third_byte = sat_sub(prev_2, splat(0xE0u - 0x80u));
+	const auto is_fourth_byte = sat_sub(prev_3, splat(0xF0u - 0x80u));
+	const auto must_be_2_3_cont = and_(or_(is_third_byte, is_fourth_byte), splat(0x80u));
+	return xor_(must_be_2_3_cont, special_cases);
+}
+
+//! returns non-zero bytes if the block ends with an incomplete multi-byte sequence
+static floor_inline_always block_t is_incomplete(const block_t& input) {
+	return sat_sub(input, load_table(incomplete_max_table));
+}
+} // namespace simd_validation
+#endif
+
+std::pair<bool, size_t> validate_utf8(const std::string_view& str) {
+	const auto size = str.size();
+	size_t offset = 0;
+#if defined(FLOOR_UNICODE_SIMD)
+	using namespace simd_validation;
+	auto prev_input = zero();
+	auto prev_incomplete = zero();
+	for (; offset + block_size <= size; offset += block_size) {
+		const auto input = load(str.data() + offset);
+		if (is_ascii(input)) {
+			// only need to check if the previous block ended with an incomplete sequence
+			if (any(prev_incomplete)) {
+				return validate_utf8_scalar(str, find_code_sequence_start(str, offset - 1u));
+			}
+			prev_input = zero();
+			prev_incomplete = zero();
+			// skip all directly following ASCII blocks (-> no need for the full block state handling),
+			// the next block is either non-ASCII or the start of the remainder
+			offset = skip_ascii_blocks(str, offset + block_size) - block_size;
+			continue;
+		}
+		const auto error = check_block(input, prev_input);
+		prev_input = input;
+		prev_incomplete = is_incomplete(input);
+		if (any(error)) {
+			// error in this block or at the end of the previous block -> find the exact position
+			return validate_utf8_scalar(str, find_code_sequence_start(str, offset > 0u ? offset - 1u : 0u));
+		}
+	}
+	if (offset == size && !any(prev_incomplete)) {
+		return { true, size };
+	}
+	// validate the remainder (including a possibly incomplete sequence at the end of the last block)
+	if (offset > 0u) {
+		offset = find_code_sequence_start(str, offset - 1u);
+	}
+#endif
+	return validate_utf8_scalar(str, offset);
+}
+
+std::pair<bool, size_t> utf8_to_utf16(const std::string_view& str, std::span<char16_t> dst) {
+	const auto size = str.size();
+	auto dst_ptr = dst.data();
+	size_t offset = 0;
+	while (offset < size) {
+		// ASCII fast path: widen whole blocks (auto-vectorized)
+		while (offset + block_size <= size && is_ascii_block(str.data() + offset)) {
+			for (size_t i = 0; i < block_size; ++i) {
+				dst_ptr[i] = char16_t(uint8_t(str[offset + i]));
+			}
+			dst_ptr += block_size;
+			offset += block_size;
+		}
+		if (offset == size) {
+			break;
+		}
+		
+		uint32_t code = 0u;
+		const auto code_size = decode_utf8_char_strict(str, offset, code);
+		if (code_size == 0u) {
+			return { false, size_t(dst_ptr - dst.data()) };
+		}
+		if (code < 0x10000u) {
+			*dst_ptr++ = char16_t(code);
+		} else {
+			// -> surrogate pair
+			code -= 0x10000u;
+			*dst_ptr++ = char16_t(0xD800u + (code >> 10u));
+			*dst_ptr++ = char16_t(0xDC00u + (code & 0x3FFu));
+		}
+		offset += code_size;
+	}
+	return { true, size_t(dst_ptr - dst.data()) };
+}
+
 #if defined(__APPLE__)
 std::string utf8_decomp_to_precomp(const std::string& str) {
 	return darwin_helper::utf8_decomp_to_precomp(str);
@@ -195,7 +195,8 @@ bool device_image::provide_minify_program(device_context& ctx, std::shared_ptr<d
 
 void device_image::build_mip_map_minification_program() const {
 	// build mip-map minify functions (do so in a separate thread so that we don't hold up anything)
-	task::spawn([ctx = dev.context]() {
+	// NOTE: this is a full (and potentially very slow) compile -> don't occupy a task scheduler worker
+	task::spawn_blocking([ctx = dev.context]() {
 		const toolchain::compile_options options {
 			// suppress any debug output for this, we only want to have console/log output if something goes wrong
 			.silence_debug_output = true
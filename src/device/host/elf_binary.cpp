@@ -28,6 +28,7 @@
 #include <floor/core/core.hpp>
 #include <floor/threading/thread_helpers.hpp>
 #include <string_view>
+#include <cstddef>
 
 #if !defined(__WINDOWS__)
 #include <dlfcn.h>
@@ -416,6 +417,26 @@ struct relocation_t {
 	}
 };
 
+//! kind of a pre-linked symbol
+enum class PRELINKED_SYMBOL_KIND : uint32_t {
+	//! symbol has not been (or could not be) resolved
+	UNRESOLVED,
+	//! instance-independent external address (host function/builtin/variable) -> "value" is the address
+	EXTERNAL,
+	//! per-instance ID/size variable -> "value" is the offset into elf_binary::instance_ids_t
+	INSTANCE_ID,
+	//! per-instance global offset table
+	GOT,
+	//! per-instance mapped section -> "value" is the section index
+	SECTION,
+};
+
+//! symbol that has been resolved once per binary, so that instantiation only needs to add per-instance addresses
+struct prelinked_symbol_t {
+	PRELINKED_SYMBOL_KIND kind { PRELINKED_SYMBOL_KIND::UNRESOLVED };
+	uint64_t value { 0u };
+};
+
 struct elf_binary::elf_info_t {
 	const elf64_header_t& header;
 	const elf64_section_header_entry_t* section_headers { nullptr };
@@ -440,6 +461,16 @@ struct elf_binary::elf_info_t {
 	//! contains all "internal" execution instances for this binary
 	std::vector<internal_instance_t> instances;
 	
+	//! pre-linked symbols (indexed by symbol index)
+	//! NOTE: only symbols that are used by exec or rodata relocations are resolved
+	std::vector<prelinked_symbol_t> prelinked_symbols;
+	//! the one exec section in this binary
+	const section_t* exec_section { nullptr };
+	//! function name -> offset in the exec section
+	std::vector<std::pair<std::string, uint64_t>> function_offsets;
+	//! amount of GOT entries that are required by each instance
+	uint64_t GOT_entry_count { 0u };
+	
 	bool is_valid() const {
 		if (section_headers == nullptr || section_header_entries.empty() || sections.empty() || symbols.empty()) {
 			return false;
@@ -516,6 +547,11 @@ void elf_binary::init_elf() {
 		return;
 	}
 	
+	// resolve all symbols once
+	if (!prelink()) {
+		return;
+	}
+	
 	// map global r/o memory
 	if (!map_global_ro_memory()) {
 		return;
@@ -1066,32 +1102,20 @@ bool elf_binary::instantiate(const uint32_t instance_idx) {
 		}
 	}
 	
-	// find all read-write and exec sections that need to be allocated:
-	// section -> offset
-	std::vector<std::pair<const section_t*, uint64_t>> rw_sections;
-	std::vector<std::pair<const section_t*, uint64_t>> exec_sections;
+	// check if there are any read-write sections that need to be allocated
+	// NOTE: the exec section has already been determined in prelink()
+	bool has_rw_sections = false;
 	for (const auto& section : info->sections) {
-		if (!has_flag<ELF_SECTION_FLAG::ALLOCATE>(section.header_ptr->flags)) {
-			continue;
-		}
-		
-		const auto is_writable = has_flag<ELF_SECTION_FLAG::WRITE>(section.header_ptr->flags);
-		const auto is_exec = has_flag<ELF_SECTION_FLAG::EXECUTABLE>(section.header_ptr->flags);
-		if (is_writable && !is_exec) {
-			rw_sections.emplace_back(std::pair { &section, 0u });
-		} else if (!is_writable && is_exec) {
-			exec_sections.emplace_back(std::pair { &section, 0u });
+		if (has_flag<ELF_SECTION_FLAG::ALLOCATE>(section.header_ptr->flags) &&
+			has_flag<ELF_SECTION_FLAG::WRITE>(section.header_ptr->flags) &&
+			!has_flag<ELF_SECTION_FLAG::EXECUTABLE>(section.header_ptr->flags)) {
+			has_rw_sections = true;
+			break;
 		}
 	}
 	
-	// we should have exactly one exec section and one/zero BSS
-	if (exec_sections.size() != 1) {
-		log_error("must have exactly one exec section");
-		return false;
-	}
-	
 	// allocate read-write/BSS section(s)
-	if (!rw_sections.empty()) {
+	if (has_rw_sections) {
 		if (!map_memory<ELF_SECTION_FLAG::WRITE, ELF_SECTION_FLAG::EXECUTABLE>(instance.rw_memory, info->sections, binary.get(),
 																			   instance.section_map, ".bss")) {
 			log_error("failed to map read-write memory for instance");
@@ -1108,7 +1132,7 @@ bool elf_binary::instantiate(const uint32_t instance_idx) {
 	
 	// allocate read-exec section
 	{
-		const auto& sec = *exec_sections.front().first->header_ptr;
+		const auto& sec = *info->exec_section->header_ptr;
 		instance.exec_memory = make_aligned_ptr<uint8_t>(sec.size);
 		memcpy(instance.exec_memory.get(), &binary[sec.offset], sec.size);
 		if (sec.size < instance.exec_memory.allocation_size()) {
@@ -1119,65 +1143,17 @@ bool elf_binary::instantiate(const uint32_t instance_idx) {
 			return false;
 		}
 		// NOTE: delay rx protection to after we've done the relocations
-		instance.section_map.emplace(exec_sections.front().first, instance.exec_memory.get());
+		instance.section_map.emplace(info->exec_section, instance.exec_memory.get());
 	}
 	
 	// can now get the function pointers
-	for (const auto& sym : info->symbols) {
-		if (sym.name.empty() || !(sym.symbol_ptr->binding == ELF_SYMBOL_BINDING::GLOBAL && sym.symbol_ptr->type == ELF_SYMBOL_TYPE::CODE)) {
-			continue;
-		}
-		if (&info->sections[sym.symbol_ptr->section_header_table_index] != exec_sections[0].first) {
-			continue;
-		}
-		ext_instance.functions.emplace(std::string(sym.name), instance.exec_memory.get() + sym.symbol_ptr->value);
+	ext_instance.functions.reserve(info->function_offsets.size());
+	for (const auto& func : info->function_offsets) {
+		ext_instance.functions.emplace(func.first, instance.exec_memory.get() + func.second);
 	}
 	
-	// perform relocation
-	
-	// figure out how many GOT entries we need
-	uint64_t got_entry_count = 0;
-	const auto is_got_entry_reloc = [](const elf64_relocation_addend_entry_t* reloc_ptr) {
-#if defined(__x86_64__)
-		if (reloc_ptr->type_x86_64 == ELF_RELOCATION_TYPE_X86_64::GOT64) {
-			return true;
-		}
-#elif defined(__aarch64__)
-		switch (reloc_ptr->type_arm64) {
-			default:
-				break;
-			// GOT-relative offsets inline relocations
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G0:
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G0_NC:
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G1:
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G1_NC:
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G2:
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G2_NC:
-			case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G3:
-			// GOT-relative instruction relocations
-			case ELF_RELOCATION_TYPE_ARM64::GOT_LD_PREL19:
-			case ELF_RELOCATION_TYPE_ARM64::LD64_GOTOFF_LO15:
-			case ELF_RELOCATION_TYPE_ARM64::ADR_GOT_PAGE:
-			case ELF_RELOCATION_TYPE_ARM64::LD64_GOT_LO12_NC:
-			case ELF_RELOCATION_TYPE_ARM64::LD64_GOTPAGE_LO15:
-				return true;
-		}
-#else
-#error "unhandled arch"
-#endif
-		return false;
-	};
-	for (const auto& relocation : info->exec_relocations) {
-		if (is_got_entry_reloc(relocation.reloc_ptr)) {
-			++got_entry_count;
-		}
-	}
-	for (const auto& relocation : info->rodata_relocations) {
-		if (is_got_entry_reloc(relocation.reloc_ptr)) {
-			++got_entry_count;
-		}
-	}
-	instance.init_GOT(got_entry_count);
+	// perform relocation (all symbols have already been resolved in prelink())
+	instance.init_GOT(info->GOT_entry_count);
 	
 	if (!perform_relocations(instance, ext_instance, info->exec_relocations, instance.exec_memory)) {
 		return false;
@@ -1220,38 +1196,165 @@ bool elf_binary::instantiate(const uint32_t instance_idx) {
 	return true;
 }
 
-const void* elf_binary::resolve_symbol(internal_instance_t& instance, instance_t& ext_instance, const symbol_t& sym) {
-	const void* ext_sym_ptr = nullptr;
+//! returns true if the specified relocation allocates a GOT entry
+static bool is_got_entry_reloc(const elf64_relocation_addend_entry_t& reloc) {
+#if defined(__x86_64__)
+	if (reloc.type_x86_64 == ELF_RELOCATION_TYPE_X86_64::GOT64) {
+		return true;
+	}
+#elif defined(__aarch64__)
+	switch (reloc.type_arm64) {
+		default:
+			break;
+		// GOT-relative offsets inline relocations
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G0:
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G0_NC:
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G1:
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G1_NC:
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G2:
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G2_NC:
+		case ELF_RELOCATION_TYPE_ARM64::MOVW_GOTOFF_G3:
+		// GOT-relative instruction relocations
+		case ELF_RELOCATION_TYPE_ARM64::GOT_LD_PREL19:
+		case ELF_RELOCATION_TYPE_ARM64::LD64_GOTOFF_LO15:
+		case ELF_RELOCATION_TYPE_ARM64::ADR_GOT_PAGE:
+		case ELF_RELOCATION_TYPE_ARM64::LD64_GOT_LO12_NC:
+		case ELF_RELOCATION_TYPE_ARM64::LD64_GOTPAGE_LO15:
+			return true;
+	}
+#else
+#error "unhandled arch"
+#endif
+	return false;
+}
+
+//! returns true if the specified relocation needs to resolve its symbol
+static bool is_symbol_reloc(const elf64_relocation_addend_entry_t& reloc) {
+#if defined(__x86_64__)
+	// NOTE: symbol is ignored for GOTPC64
+	return (reloc.type_x86_64 != ELF_RELOCATION_TYPE_X86_64::NONE && reloc.type_x86_64 != ELF_RELOCATION_TYPE_X86_64::GOTPC64);
+#elif defined(__aarch64__)
+	return (reloc.type_arm64 != ELF_RELOCATION_TYPE_ARM64::NONE && reloc.type_arm64 != ELF_RELOCATION_TYPE_ARM64::NONE_256);
+#else
+#error "unhandled arch"
+#endif
+}
+
+bool elf_binary::prelink() {
+	// find the exec section: we must have exactly one
+	for (const auto& section : info->sections) {
+		if (has_flag<ELF_SECTION_FLAG::ALLOCATE>(section.header_ptr->flags) &&
+			has_flag<ELF_SECTION_FLAG::EXECUTABLE>(section.header_ptr->flags) &&
+			!has_flag<ELF_SECTION_FLAG::WRITE>(section.header_ptr->flags)) {
+			if (info->exec_section != nullptr) {
+				log_error("must have exactly one exec section");
+				return false;
+			}
+			info->exec_section = &section;
+		}
+	}
+	if (info->exec_section == nullptr) {
+		log_error("must have exactly one exec section");
+		return false;
+	}
+	
+	// function name -> offset in the exec section
+	for (const auto& sym : info->symbols) {
+		if (sym.name.empty() || !(sym.symbol_ptr->binding == ELF_SYMBOL_BINDING::GLOBAL && sym.symbol_ptr->type == ELF_SYMBOL_TYPE::CODE)) {
+			continue;
+		}
+		if (&info->sections[sym.symbol_ptr->section_header_table_index] != info->exec_section) {
+			continue;
+		}
+		info->function_offsets.emplace_back(sym.name, sym.symbol_ptr->value);
+	}
+	
+	// resolve each symbol that is used by a relocation exactly once + figure out how many GOT entries we need
+	info->prelinked_symbols.resize(info->symbols.size());
+	for (const auto* relocations : { &info->exec_relocations, &info->rodata_relocations }) {
+		for (const auto& relocation : *relocations) {
+			const auto& reloc = *relocation.reloc_ptr;
+			if (is_got_entry_reloc(reloc)) {
+				++info->GOT_entry_count;
+			}
+			if (!is_symbol_reloc(reloc)) {
+				continue;
+			}
+			if (reloc.symbol_index == 0) {
+				log_error("section relocation not implemented yet");
+				return false;
+			}
+			if (!relocation.symbol_ptr) {
+				log_error("invalid symbol index for relocation: $", reloc.symbol_index);
+				return false;
+			}
+			
+			auto& prelinked_sym = info->prelinked_symbols[reloc.symbol_index];
+			if (prelinked_sym.kind != PRELINKED_SYMBOL_KIND::UNRESOLVED) {
+				continue;
+			}
+			if (!prelink_symbol(*relocation.symbol_ptr, prelinked_sym)) {
+				return false;
+			}
+		}
+	}
+	
+	return true;
+}
+
+bool elf_binary::prelink_symbol(const symbol_t& sym, prelinked_symbol_t& prelinked_sym) const {
+	if (!(sym.symbol_ptr->section_header_table_index == 0 &&
+		  (sym.symbol_ptr->binding == ELF_SYMBOL_BINDING::GLOBAL || sym.symbol_ptr->binding == ELF_SYMBOL_BINDING::WEAK))) {
+		// -> internal
+		if (sym.symbol_ptr->type != ELF_SYMBOL_TYPE::SECTION &&
+			sym.symbol_ptr->type != ELF_SYMBOL_TYPE::CODE &&
+			sym.symbol_ptr->type != ELF_SYMBOL_TYPE::DATA) {
+			log_error("non-external symbol for relocation: $ (type: $)", sym.name, (uint32_t)sym.symbol_ptr->type);
+			return false;
+		}
+		if (sym.symbol_ptr->section_header_table_index >= info->sections.size()) {
+			log_error("section index is out-of-bounds: $", sym.symbol_ptr->section_header_table_index);
+			return false;
+		}
+		prelinked_sym = { PRELINKED_SYMBOL_KIND::SECTION, sym.symbol_ptr->section_header_table_index };
+		return true;
+	}
 	
+	// -> external
+	// per-instance IDs/sizes
 	// TODO: handle floor specific symbols that need to be handled per execution later on
+	static const std::pair<std::string_view, size_t> instance_id_symbols[] {
+		{ "floor_global_idx", offsetof(instance_ids_t, instance_global_idx) },
+		{ "floor_global_work_size", offsetof(instance_ids_t, instance_global_work_size) },
+		{ "floor_local_idx", offsetof(instance_ids_t, instance_local_idx) },
+		{ "floor_local_work_size", offsetof(instance_ids_t, instance_local_work_size) },
+		{ "floor_group_idx", offsetof(instance_ids_t, instance_group_idx) },
+		{ "floor_group_size", offsetof(instance_ids_t, instance_group_size) },
+		{ "floor_work_dim", offsetof(instance_ids_t, instance_work_dim) },
+		{ "floor_sub_group_id", offsetof(instance_ids_t, instance_sub_group_idx) },
+		{ "floor_sub_group_local_id", offsetof(instance_ids_t, instance_sub_group_local_idx) },
+		{ "floor_sub_group_size", offsetof(instance_ids_t, instance_sub_group_size) },
+		{ "floor_num_sub_groups", offsetof(instance_ids_t, instance_num_sub_groups) },
+	};
+	for (const auto& id_sym : instance_id_symbols) {
+		if (sym.name == id_sym.first) {
+			prelinked_sym = { PRELINKED_SYMBOL_KIND::INSTANCE_ID, id_sym.second };
+			return true;
+		}
+	}
+	if (sym.name == "_GLOBAL_OFFSET_TABLE_") {
+		prelinked_sym = { PRELINKED_SYMBOL_KIND::GOT, 0u };
+		return true;
+	}
+	
+	// instance-independent symbols
 	// TODO: retrieve all allowed external functions/ptrs before loading a binary
-	if (sym.name == "floor_global_idx") {
-		ext_sym_ptr = &ext_instance.ids.instance_global_idx;
-	} else if (sym.name == "floor_global_work_size") {
-		ext_sym_ptr = &ext_instance.ids.instance_global_work_size;
-	} else if (sym.name == "floor_local_idx") {
-		ext_sym_ptr = &ext_instance.ids.instance_local_idx;
-	} else if (sym.name == "floor_local_work_size") {
-		ext_sym_ptr = &ext_instance.ids.instance_local_work_size;
-	} else if (sym.name == "floor_group_idx") {
-		ext_sym_ptr = &ext_instance.ids.instance_group_idx;
-	} else if (sym.name == "floor_group_size") {
-		ext_sym_ptr = &ext_instance.ids.instance_group_size;
-	} else if (sym.name == "floor_work_dim") {
-		ext_sym_ptr = &ext_instance.ids.instance_work_dim;
-	} else if (sym.name == "floor_sub_group_id") {
-		ext_sym_ptr = &ext_instance.ids.instance_sub_group_idx;
-	} else if (sym.name == "floor_sub_group_local_id") {
-		ext_sym_ptr = &ext_instance.ids.instance_sub_group_local_idx;
-	} else if (sym.name == "floor_sub_group_size") {
-		ext_sym_ptr = &ext_instance.ids.instance_sub_group_size;
-	} else if (sym.name == "floor_num_sub_groups") {
-		ext_sym_ptr = &ext_instance.ids.instance_num_sub_groups;
-	} else if (sym.name == "global_barrier" ||
-			   sym.name == "local_barrier" ||
-			   sym.name == "barrier" ||
-			   sym.name == "image_barrier" ||
-			   sym.name == "floor_host_compute_device_barrier") {
+	const void* ext_sym_ptr = nullptr;
+	if (sym.name == "global_barrier" ||
+		sym.name == "local_barrier" ||
+		sym.name == "barrier" ||
+		sym.name == "image_barrier" ||
+		sym.name == "floor_host_compute_device_barrier") {
 		ext_sym_ptr = get_external_symbol_ptr<true>("floor_host_compute_device_barrier");
 	} else if (sym.name == "simd_barrier" ||
 			   sym.name == "floor_host_compute_device_simd_barrier") {
@@ -1260,12 +1363,6 @@ const void* elf_binary::resolve_symbol(internal_instance_t& instance, instance_t
 		ext_sym_ptr = get_external_symbol_ptr<true>("floor_host_compute_device_printf_buffer");
 	} else if (sym.name.starts_with("floor_host_compute_device_simd_shuffle_")) {
 		ext_sym_ptr = get_external_symbol_ptr<true>(sym.name);
-	} else if (sym.name == "_GLOBAL_OFFSET_TABLE_") {
-		if (!instance.GOT) {
-			log_error("GOT is empty");
-			return nullptr;
-		}
-		ext_sym_ptr = &instance.GOT[0];
 	} else {
 		// normal symbol
 		static const auto& floor_builtins = floor_get_c_to_floor_builtin_map();
@@ -1277,55 +1374,38 @@ const void* elf_binary::resolve_symbol(internal_instance_t& instance, instance_t
 	}
 	if (ext_sym_ptr == nullptr) {
 		log_error("external symbol $ could not be resolved", sym.name);
-		return nullptr;
-	}
-	return ext_sym_ptr;
-}
-
-const void* elf_binary::resolve_section(internal_instance_t& instance, const symbol_t& sym) {
-	if (sym.symbol_ptr->section_header_table_index >= info->sections.size()) {
-		log_error("section index is out-of-bounds: $", sym.symbol_ptr->section_header_table_index);
-		return nullptr;
-	}
-	const auto& sec = info->sections[sym.symbol_ptr->section_header_table_index];
-	const auto sec_iter = instance.section_map.find(&sec);
-	if (sec_iter == instance.section_map.end()) {
-		log_error("failed to find section: $", sym.symbol_ptr->section_header_table_index);
-		return nullptr;
+		return false;
 	}
-	return sec_iter->second;
+	prelinked_sym = { PRELINKED_SYMBOL_KIND::EXTERNAL, uint64_t(ext_sym_ptr) };
+	return true;
 }
 
 const void* elf_binary::resolve(internal_instance_t& instance, instance_t& ext_instance, const relocation_t& relocation) {
-	const void* resolved_ptr = nullptr;
-	const auto& reloc = *relocation.reloc_ptr;
-	if (reloc.symbol_index != 0) {
-		// symbol relocation
-		if (relocation.symbol_ptr) {
-			const auto& sym = *relocation.symbol_ptr;
-			if (sym.symbol_ptr->section_header_table_index == 0 &&
-				(sym.symbol_ptr->binding == ELF_SYMBOL_BINDING::GLOBAL || sym.symbol_ptr->binding == ELF_SYMBOL_BINDING::WEAK)) {
-				// -> external
-				resolved_ptr = resolve_symbol(instance, ext_instance, sym);
-			} else {
-				if (sym.symbol_ptr->type == ELF_SYMBOL_TYPE::SECTION ||
-					sym.symbol_ptr->type == ELF_SYMBOL_TYPE::CODE ||
-					sym.symbol_ptr->type == ELF_SYMBOL_TYPE::DATA) {
-					resolved_ptr = resolve_section(instance, sym);
-				} else {
-					log_error("non-external symbol for relocation: $ (type: $)", sym.name, (uint32_t)sym.symbol_ptr->type);
-					return nullptr;
-				}
-			}
-		} else {
-			log_error("invalid symbol index for relocation: $", reloc.symbol_index);
+	const auto& prelinked_sym = info->prelinked_symbols[relocation.reloc_ptr->symbol_index];
+	switch (prelinked_sym.kind) {
+		case PRELINKED_SYMBOL_KIND::UNRESOLVED:
+			log_error("unresolved symbol for relocation: $", relocation.symbol_ptr->name);
 			return nullptr;
+		case PRELINKED_SYMBOL_KIND::EXTERNAL:
+			return (const void*)prelinked_sym.value;
+		case PRELINKED_SYMBOL_KIND::INSTANCE_ID:
+			return (const uint8_t*)&ext_instance.ids + prelinked_sym.value;
+		case PRELINKED_SYMBOL_KIND::GOT:
+			if (!instance.GOT) {
+				log_error("GOT is empty");
+				return nullptr;
+			}
+			return &instance.GOT[0];
+		case PRELINKED_SYMBOL_KIND::SECTION: {
+			const auto sec_iter = instance.section_map.find(&info->sections[prelinked_sym.value]);
+			if (sec_iter == instance.section_map.end()) {
+				log_error("failed to find section: $", prelinked_sym.value);
+				return nullptr;
+			}
+			return sec_iter->second;
 		}
-	} else {
-		log_error("section relocation not implemented yet");
-		return nullptr;
 	}
-	return resolved_ptr;
+	floor_unreachable();
 }
 
 bool elf_binary::perform_relocations(internal_instance_t& instance,
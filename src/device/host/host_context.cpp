@@ -28,6 +28,7 @@
 #include <floor/device/host/elf_binary.hpp>
 #include <floor/device/host/host_function.hpp>
 #include <floor/threading/thread_helpers.hpp>
+#include <floor/threading/job_graph.hpp>
 #include <floor/floor.hpp>
 
 #if defined(__APPLE__)
@@ -342,21 +343,75 @@ std::shared_ptr<device_image> host_context::wrap_image(const device_queue& cqueu
 }
 
 std::shared_ptr<device_program> host_context::create_program_from_archive_binaries(universal_binary::archive_binaries& bins) {
+	// devices that use the same binary only need to parse/instantiate it once
+	std::vector<uint64_t> dev_keys;
+	dev_keys.reserve(devices.size());
+	for (const auto& dev_best_bin : bins.dev_binaries) {
+		dev_keys.emplace_back(uint64_t(dev_best_bin.first));
+	}
+	
 	// create the program
-	host_program::program_map_type prog_map;
-	for (size_t i = 0, dev_count = devices.size(); i < dev_count; ++i) {
-		const auto host_dev = (const host_device*)devices[i].get();
-		const auto& dev_best_bin = bins.dev_binaries[i];
+	return add_program(create_host_programs(dev_keys, [this, &bins](const host_device& host_dev, const size_t dev_idx) {
+		const auto& dev_best_bin = bins.dev_binaries[dev_idx];
 		const auto func_info = universal_binary::translate_function_info(dev_best_bin);
-		prog_map.insert_or_assign(host_dev,
-								  create_host_program_internal(*host_dev,
-															   {},
-															   dev_best_bin.first->data.data(),
-															   dev_best_bin.first->data.size(),
-															   func_info,
-															   false /* TODO: true? */));
+		return create_host_program_internal(host_dev,
+											{},
+											dev_best_bin.first->data.data(),
+											dev_best_bin.first->data.size(),
+											func_info,
+											false /* TODO: true? */);
+	}));
+}
+
+host_program::program_map_type host_context::create_host_programs(const std::vector<uint64_t>& dev_keys,
+																  const std::function<host_program::host_program_entry(const host_device&,
+																													   const size_t dev_idx)>& create_entry) const {
+	// map each device to its unique key/program (in order of first occurrence)
+	std::vector<uint64_t> unique_keys;
+	std::vector<size_t> first_dev_idx; // per unique key
+	std::vector<size_t> dev_program_idx(devices.size(), 0u);
+	for (size_t dev_idx = 0, dev_count = devices.size(); dev_idx < dev_count; ++dev_idx) {
+		const auto key_iter = std::find(unique_keys.begin(), unique_keys.end(), dev_keys[dev_idx]);
+		if (key_iter != unique_keys.end()) {
+			dev_program_idx[dev_idx] = size_t(std::distance(unique_keys.begin(), key_iter));
+		} else {
+			dev_program_idx[dev_idx] = unique_keys.size();
+			unique_keys.emplace_back(dev_keys[dev_idx]);
+			first_dev_idx.emplace_back(dev_idx);
+		}
+	}
+	
+	// create all unique programs, in parallel if there is more than one
+	std::vector<host_program::host_program_entry> unique_programs(unique_keys.size());
+	if (unique_programs.size() == 1) {
+		unique_programs[0] = create_entry(*(const host_device*)devices[first_dev_idx[0]].get(), first_dev_idx[0]);
+	} else if (unique_programs.size() > 1) {
+		job_graph program_jobs("host_prog");
+		for (size_t prog_idx = 0, prog_count = unique_programs.size(); prog_idx < prog_count; ++prog_idx) {
+			program_jobs.add_job([this, &create_entry, &unique_programs, &first_dev_idx, prog_idx] {
+				const auto dev_idx = first_dev_idx[prog_idx];
+				unique_programs[prog_idx] = create_entry(*(const host_device*)devices[dev_idx].get(), dev_idx);
+				// NOTE: a failed program creation has already been reported and must not cancel the creation for other devices
+				return true;
+			});
+		}
+		(void)program_jobs.execute_and_wait();
 	}
-	return add_program(std::move(prog_map));
+	
+	host_program::program_map_type prog_map;
+	for (size_t dev_idx = 0, dev_count = devices.size(); dev_idx < dev_count; ++dev_idx) {
+		prog_map.insert_or_assign((const host_device*)devices[dev_idx].get(), unique_programs[dev_program_idx[dev_idx]]);
+	}
+	return prog_map;
+}
+
+std::vector<uint64_t> host_context::get_cpu_tier_program_keys() const {
+	std::vector<uint64_t> dev_keys;
+	dev_keys.reserve(devices.size());
+	for (const auto& dev : devices) {
+		dev_keys.emplace_back(uint64_t(((const host_device*)dev.get())->cpu_tier));
+	}
+	return dev_keys;
 }
 
 std::shared_ptr<device_program> host_context::add_universal_binary(const std::string& file_name) {
@@ -411,15 +466,11 @@ std::shared_ptr<device_program> host_context::add_program_file(const std::string
 		return std::make_shared<host_program>(*fastest_device, host_program::program_map_type {});
 	}
 	
-	// compile the source file for all devices in the context
-	host_program::program_map_type prog_map;
+	// compile the source file for all devices in the context (once per CPU tier)
 	options.target = toolchain::TARGET::HOST_COMPUTE_CPU;
-	for(const auto& dev : devices) {
-		const auto host_dev = (const host_device*)dev.get();
-		prog_map.insert_or_assign(host_dev,
-								  create_host_program(*host_dev, toolchain::compile_program_file(*dev, file_name, options)));
-	}
-	return add_program(std::move(prog_map));
+	return add_program(create_host_programs(get_cpu_tier_program_keys(), [this, &file_name, &options](const host_device& host_dev, const size_t) {
+		return create_host_program(host_dev, toolchain::compile_program_file(host_dev, file_name, options));
+	}));
 }
 
 std::shared_ptr<device_program> host_context::add_program_source(const std::string& source_code,
@@ -438,15 +489,11 @@ std::shared_ptr<device_program> host_context::add_program_source(const std::stri
 		return std::make_shared<host_program>(*fastest_device, host_program::program_map_type {});
 	}
 	
-	// compile the source code for all devices in the context
-	host_program::program_map_type prog_map;
+	// compile the source code for all devices in the context (once per CPU tier)
 	options.target = toolchain::TARGET::HOST_COMPUTE_CPU;
-	for(const auto& dev : devices) {
-		const auto host_dev = (const host_device*)dev.get();
-		prog_map.insert_or_assign(host_dev,
-								  create_host_program(*host_dev, toolchain::compile_program(*dev, source_code, options)));
-	}
-	return add_program(std::move(prog_map));
+	return add_program(create_host_programs(get_cpu_tier_program_keys(), [this, &source_code, &options](const host_device& host_dev, const size_t) {
+		return create_host_program(host_dev, toolchain::compile_program(host_dev, source_code, options));
+	}));
 }
 
 host_program::host_program_entry host_context::create_host_program(const host_device& dev,
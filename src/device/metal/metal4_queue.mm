@@ -47,6 +47,8 @@ struct metal4_completion_cmd_t {
 	const metal_device* mtl_dev { nullptr };
 	metal4_command_buffer cmd_buffer {};
 	metal4_queue::command_buffer_completion_handler_f completion_handler;
+	//! time of the submission/commit of this command (used for timeout handling)
+	uint64_t submit_time_ms { 0u };
 };
 
 //! the command completion handler/pool implementation
@@ -62,6 +64,11 @@ struct metal4_command_pool {
 	const bool no_blocking { false };
 	static inline std::atomic<bool> is_ctx_shutdown { false };
 	
+	//! notified from the Metal feedback handler whenever any command buffer has completed,
+	//! waited on by the completion waiter thread (in metal4_command_buffer_completion_impl::wait_any)
+	static inline std::mutex any_completed_cv_lock;
+	static inline std::condition_variable any_completed_cv;
+	
 	metal4_command_pool(const metal_device& dev_) :
 	dev(dev_), no_blocking(!has_flag<DEVICE_CONTEXT_FLAGS::METAL_BLOCKING>(dev.context->get_context_flags())) {}
 	
@@ -247,6 +254,7 @@ struct metal4_command_pool {
 					.mtl_dev = &dev,
 					.cmd_buffer = std::move(cmd_buffer),
 					.completion_handler = std::move(completion_handler),
+					.submit_time_ms = core::unix_timestamp_ms(),
 				};
 				mtl_cmd_completion_handler->add_cmd_completion(std::move(cmd_compl));
 			}
@@ -457,6 +465,13 @@ metal4_command_pool* create_or_get_thread_command_pool(const metal_device& dev)
 				
 				compl_state.completed = true;
 				compl_state.completed_cv.notify_one();
+				
+				// wake the completion waiter thread
+				// NOTE: must lock here, so that we can't notify in between its predicate check and it starting to wait
+				{
+					std::lock_guard<std::mutex> any_completed_lock_guard(metal4_command_pool::any_completed_cv_lock);
+				}
+				metal4_command_pool::any_completed_cv.notify_all();
 			};
 		}
 		
@@ -464,8 +479,42 @@ metal4_command_pool* create_or_get_thread_command_pool(const metal_device& dev)
 	}
 }
 
-//! called to complete (wait for) a single "metal4_completion_cmd_t"
+//! called to check for and complete a single "metal4_completion_cmd_t"
 struct metal4_command_buffer_completion_impl {
+	//! returns true if the Metal feedback handler has signaled completion of "cmd" or if "cmd" has timed out
+	//! NOTE: if the context is being shut down, complete() will handle the clean up
+	static bool is_complete(metal4_cmd_completion_handler::cmd_t& cmd) {
+		auto& compl_state = cmd.pool->cmd_resources.resources[cmd.cmd_buffer.index];
+		if (compl_state.completed || metal4_command_pool::is_ctx_shutdown) {
+			return true;
+		}
+		if (core::unix_timestamp_ms() - cmd.submit_time_ms >= 60'000u) [[unlikely]] {
+			log_error("command buffer (\"$\") timeout", safe_string(cmd.cmd_buffer.name));
+			// NOTE: still need to properly complete/clean up the command buffer even if there was an error
+			compl_state.completed = true;
+			return true;
+		}
+		return false;
+	}
+	
+	//! blocks until the Metal feedback handler has signaled completion of any of "cmds" or "max_wait" has elapsed
+	static bool wait_any(std::span<metal4_cmd_completion_handler::cmd_t* const> cmds, const bool /* cmds_changed */,
+						 const std::chrono::microseconds max_wait) {
+		std::unique_lock<std::mutex> any_completed_lock_guard(metal4_command_pool::any_completed_cv_lock);
+		metal4_command_pool::any_completed_cv.wait_for(any_completed_lock_guard, max_wait, [&cmds] {
+			if (metal4_command_pool::is_ctx_shutdown) {
+				return true;
+			}
+			for (const auto& cmd : cmds) {
+				if (cmd->pool->cmd_resources.resources[cmd->cmd_buffer.index].completed) {
+					return true;
+				}
+			}
+			return false;
+		});
+		return true;
+	}
+	
 	static void complete(metal4_cmd_completion_handler::cmd_t& cmd) {
 		metal4_command_pool::metal4_complete_cmd_buffer(*cmd.pool, std::move(cmd.cmd_buffer), std::move(cmd.completion_handler));
 		cmd.cmd_buffer.reset();
@@ -117,7 +117,8 @@ REQUIRES(!args_lock) {
 	// TODO: implement signaling of "signal_fences"
 	
 	if ((handler->needs_param_workaround && has_tmp_buffers) || completion_handler) {
-		task::spawn([handler, wait_evt, user_compl_handler = std::move(completion_handler)]() {
+		// NOTE: this blocks until the kernel has finished -> must not occupy a task scheduler worker
+		task::spawn_blocking([handler, wait_evt, user_compl_handler = std::move(completion_handler)]() {
 			CL_CALL_IGNORE(clWaitForEvents(1, &wait_evt), "waiting for kernel execution failed")
 			// NOTE: will hold onto all tmp buffers of handler until the end of this scope, then auto-destruct everything
 			
@@ -19,6 +19,10 @@
 #include <floor/device/spirv_handler.hpp>
 #include <floor/core/logger.hpp>
 #include <floor/core/file_io.hpp>
+#include <floor/threading/task.hpp>
+#include <numeric>
+#include <atomic>
+#include <string_view>
 
 namespace fl::spirv_handler {
 using namespace std::literals;
@@ -49,18 +53,36 @@ std::unique_ptr<uint32_t[]> load_binary(const std::string& file_name, size_t& co
 	floor_return_no_nrvo(code);
 }
 
-spirv_handler::container load_container(const std::string& file_name) {
-	std::string data { "" };
-	if(!file_io::file_to_string(file_name, data)) {
+//! min amount of container entries at which entries are validated in parallel
+static constexpr const uint32_t min_parallel_entry_count { 4u };
+//! min amount of container entries at which entries are processed in parallel when no validation is performed
+//! NOTE: w/o validation, per-entry processing is only a few small copies -> only worth it for very large containers
+static constexpr const uint32_t min_parallel_entry_count_no_validation { 1024u };
+
+spirv_handler::container load_container(const std::string& file_name, const container_load_options options) {
+	// read the whole file into 4-byte aligned memory that is then owned by the container -> no further copies necessary
+	size_t data_size = 0;
+	auto data = load_binary(file_name, data_size);
+	if(data == nullptr) {
 		log_error("failed to load spir-v container (\"$\")", file_name);
 		return {};
 	}
-	return load_container_from_memory((const uint8_t*)data.data(), data.size(), file_name);
+	
+	auto zero_copy_options = options;
+	zero_copy_options.zero_copy = true;
+	auto ret = load_container_from_memory((const uint8_t*)data.get(), data_size, file_name, zero_copy_options);
+	if(ret.valid && !ret.spirv_data) {
+		// entries directly reference "data" -> container must own it
+		// NOTE: if the SPIR-V data wasn't aligned, it has already been copied into "spirv_data" and "data" is no longer needed
+		ret.spirv_data = std::move(data);
+	}
+	floor_return_no_nrvo(ret);
 }
 
 spirv_handler::container load_container_from_memory(const uint8_t* data_ptr_,
 													const size_t& data_size_,
-													const std::string identifier) {
+													const std::string identifier,
+													const container_load_options options) {
 	// reasonable size assumption
 	if(data_size_ >= 0x80000000) {
 		log_error("container too large");
@@ -102,16 +124,14 @@ spirv_handler::container load_container_from_memory(const uint8_t* data_ptr_,
 	// header entries
 	container ret;
 	ret.entries.resize(entry_count);
+	std::vector<uint32_t> function_entry_counts(entry_count, 0u);
 	uint32_t running_offset = 0;
 	for(uint32_t i = 0; i < entry_count; ++i) {
 		auto& entry = ret.entries[i];
 		
 		//
-		uint32_t function_entry_count = 0;
-		memcpy(&function_entry_count, data_ptr, sizeof(function_entry_count));
-		data_ptr += sizeof(function_entry_count);
-		entry.function_types.resize(function_entry_count);
-		entry.function_names.resize(function_entry_count);
+		memcpy(&function_entry_counts[i], data_ptr, sizeof(uint32_t));
+		data_ptr += sizeof(uint32_t);
 		
 		//
 		entry.data_word_count = 0;
@@ -123,20 +143,34 @@ spirv_handler::container load_container_from_memory(const uint8_t* data_ptr_,
 		running_offset += entry.data_word_count;
 	}
 	
-	// get the actual spir-v data in one big chunk
+	// the actual spir-v data in one big chunk:
+	// if possible, directly reference it, otherwise copy it into 4-byte aligned memory
 	const auto spirv_data_size = running_offset * sizeof(uint32_t);
 	if(cur_size + spirv_data_size > data_size) {
 		log_error("invalid spir-v data size");
 		return {};
 	}
-	ret.spirv_data = std::make_unique<uint32_t[]>(running_offset);
-	memcpy(ret.spirv_data.get(), data_ptr, spirv_data_size);
+	const uint32_t* spirv_data_ptr = nullptr;
+	if(options.zero_copy && (size_t(data_ptr) % alignof(uint32_t)) == 0u) {
+		spirv_data_ptr = (const uint32_t*)data_ptr;
+	} else {
+		ret.spirv_data = std::make_unique<uint32_t[]>(running_offset);
+		memcpy(ret.spirv_data.get(), data_ptr, spirv_data_size);
+		spirv_data_ptr = ret.spirv_data.get();
+	}
+	for(auto& entry : ret.entries) {
+		entry.code = { spirv_data_ptr + entry.data_offset, entry.data_word_count };
+	}
 	data_ptr += spirv_data_size;
 	cur_size += spirv_data_size;
 	
-	// get the per-entry/module metadata
-	for(auto& entry : ret.entries) {
-		const auto function_entry_count = (uint32_t)entry.function_types.size();
+	// determine where the per-entry/module metadata is located:
+	// since function names have a variable length, this must be done sequentially, actual processing is done later on
+	std::vector<const uint8_t*> function_types_ptrs(entry_count, nullptr);
+	std::vector<std::string_view> function_names;
+	function_names.reserve(std::accumulate(function_entry_counts.begin(), function_entry_counts.end(), size_t(0u)));
+	for(uint32_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+		const auto function_entry_count = function_entry_counts[entry_idx];
 		
 		//
 		const auto func_types_size = function_entry_count * sizeof(toolchain::FUNCTION_TYPE);
@@ -144,19 +178,20 @@ spirv_handler::container load_container_from_memory(const uint8_t* data_ptr_,
 			log_error("invalid function types size");
 			return {};
 		}
-		memcpy(entry.function_types.data(), data_ptr, func_types_size);
+		function_types_ptrs[entry_idx] = data_ptr;
 		data_ptr += func_types_size;
 		cur_size += func_types_size;
 		
 		//
 		for(uint32_t i = 0; i < function_entry_count; ++i) {
-			if(std::find(data_ptr, data_end_ptr, '\0') == data_end_ptr) {
+			const auto name_end_ptr = std::find(data_ptr, data_end_ptr, '\0');
+			if(name_end_ptr == data_end_ptr) {
 				log_error("function name has no terminator");
 				return {};
 			}
-			entry.function_names[i] = (const char*)data_ptr; // string is \0 terminated
+			function_names.emplace_back((const char*)data_ptr, size_t(name_end_ptr - data_ptr));
 			
-			auto padded_len = (uint32_t)entry.function_names[i].size();
+			auto padded_len = (uint32_t)function_names.back().size();
 			padded_len += 4u - (padded_len % 4u);
 			if(cur_size + padded_len > data_size) {
 				log_error("invalid function name size (not padded?)");
@@ -167,9 +202,94 @@ spirv_handler::container load_container_from_memory(const uint8_t* data_ptr_,
 		}
 	}
 	
+	// process the per-entry/module metadata + validate each module if requested
+	std::vector<size_t> first_function_name_idx(entry_count, 0u);
+	for(uint32_t entry_idx = 1; entry_idx < entry_count; ++entry_idx) {
+		first_function_name_idx[entry_idx] = first_function_name_idx[entry_idx - 1] + function_entry_counts[entry_idx - 1];
+	}
+	const auto process_entry = [&](const uint32_t entry_idx) {
+		auto& entry = ret.entries[entry_idx];
+		const auto function_entry_count = function_entry_counts[entry_idx];
+		
+		entry.function_types.resize(function_entry_count);
+		memcpy(entry.function_types.data(), function_types_ptrs[entry_idx], function_entry_count * sizeof(toolchain::FUNCTION_TYPE));
+		
+		entry.function_names.reserve(function_entry_count);
+		const auto name_iter = function_names.begin() + ptrdiff_t(first_function_name_idx[entry_idx]);
+		for(auto iter = name_iter; iter != name_iter + function_entry_count; ++iter) {
+			entry.function_names.emplace_back(*iter);
+		}
+		
+		if(options.validate) {
+			return validate_module(entry.code, identifier);
+		}
+		return true;
+	};
+	
+	if(options.parallel && entry_count >= (options.validate ? min_parallel_entry_count : min_parallel_entry_count_no_validation)) {
+		std::atomic<bool> success { true };
+		task::parallel_for(0u, entry_count, [&process_entry, &success](const size_t entry_idx) {
+			if(!process_entry(uint32_t(entry_idx))) {
+				success = false;
+			}
+		});
+		if(!success) {
+			log_error("failed to process spir-v container entries$", identifier.empty() ? ""s : " (in \"" + identifier + "\")");
+			return {};
+		}
+	} else {
+		for(uint32_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+			if(!process_entry(entry_idx)) {
+				log_error("failed to process spir-v container entries$", identifier.empty() ? ""s : " (in \"" + identifier + "\")");
+				return {};
+			}
+		}
+	}
+	
 	// done
 	ret.valid = true;
 	floor_return_no_nrvo(ret);
 }
 
+bool validate_module(const std::span<const uint32_t> code, const std::string& identifier) {
+	const auto in_identifier = (identifier.empty() ? ""s : " (in \"" + identifier + "\")");
+	
+	// header: magic, version, generator, id bound, schema
+	static constexpr const uint32_t spirv_magic { 0x07230203u };
+	static constexpr const size_t header_word_count { 5u };
+	if(code.size() < header_word_count) {
+		log_error("spir-v module is too small: $ words$", code.size(), in_identifier);
+		return false;
+	}
+	if(code[0] != spirv_magic) {
+		log_error("invalid spir-v magic: $X$", code[0], in_identifier);
+		return false;
+	}
+	const auto major_version = (code[1] >> 16u) & 0xFFu;
+	const auto minor_version = (code[1] >> 8u) & 0xFFu;
+	if((code[1] & 0xFF0000FFu) != 0u || major_version != 1u || minor_version > 6u) {
+		log_error("invalid or unsupported spir-v version: $X$", code[1], in_identifier);
+		return false;
+	}
+	if(code[3] == 0u) {
+		log_error("invalid spir-v id bound$", in_identifier);
+		return false;
+	}
+	if(code[4] != 0u) {
+		log_error("invalid spir-v schema: $X$", code[4], in_identifier);
+		return false;
+	}
+	
+	// instructions: lower 16 bits are the opcode, upper 16 bits are the word count (including the opcode word)
+	for(size_t word_idx = header_word_count, word_count = code.size(); word_idx < word_count;) {
+		const auto instr_word_count = (code[word_idx] >> 16u);
+		if(instr_word_count == 0u || word_idx + instr_word_count > word_count) {
+			log_error("invalid spir-v instruction word count $ at word #$'$", instr_word_count, word_idx, in_identifier);
+			return false;
+		}
+		word_idx += instr_word_count;
+	}
+	return true;
+}
+
 } // namespace fl::spirv_handler
@@ -21,8 +21,9 @@
 #include <floor/core/cpp_ext.hpp>
 #include <regex>
 #include <climits>
-#include <filesystem>
 #include <cassert>
+#include <charconv>
+#include <algorithm>
 
 #include <floor/device/opencl/opencl_device.hpp>
 #include <floor/device/cuda/cuda_device.hpp>
@@ -41,18 +42,41 @@ using namespace std::literals;
 
 bool create_floor_function_info(const std::string& ffi_file_name,
 								std::vector<function_info>& functions,
-								const uint32_t toolchain_version floor_unused) {
+								const uint32_t toolchain_version) {
 	std::string ffi;
 	if (!file_io::file_to_string(ffi_file_name, ffi)) {
 		log_error("failed to retrieve floor function info from \"$\"", ffi_file_name);
 		return false;
 	}
+	return create_floor_function_info_from_memory(ffi, functions, toolchain_version);
+}
+
+bool create_floor_function_info_from_memory(const std::string_view ffi,
+											std::vector<function_info>& functions,
+											const uint32_t toolchain_version floor_unused) {
+	// NOTE: this parses the function info line-by-line and token-by-token directly from the input,
+	//       i.e. no intermediate line or token strings are created
+	functions.reserve(std::max(size_t(std::count(ffi.begin(), ffi.end(), '\n')), size_t(1)) - 1);
+	
+	// returns the next ','-separated token in "line" and advances "line" past it
+	const auto next_token = [](std::string_view& line) {
+		const auto comma_pos = line.find(',');
+		const auto token = line.substr(0, comma_pos);
+		line.remove_prefix(comma_pos == std::string_view::npos ? line.size() : comma_pos + 1);
+		return token;
+	};
+	// parses an unsigned integer token (with strtoull semantics: invalid input -> 0)
+	const auto to_uint = [](const std::string_view token) {
+		uint64_t val = 0;
+		(void)std::from_chars(token.data(), token.data() + token.size(), val, 10);
+		return val;
+	};
 	
-	const auto lines = core::tokenize(ffi, '\n');
-	functions.reserve(std::max(lines.size(), size_t(1)) - 1);
-	for (const auto& line : lines) {
+	for (size_t line_start = 0, ffi_size = ffi.size(); line_start < ffi_size;) {
+		const auto line_end = std::min(ffi.find('\n', line_start), ffi_size);
+		const auto line = ffi.substr(line_start, line_end - line_start);
+		line_start = line_end + 1;
 		if (line.empty()) continue;
-		const auto tokens = core::tokenize(line, ',');
 		
 		// at least 8 w/o any args:
 		// functions : <version>,<func_name>,<type>,<flags>,<local_size_x>,<local_size_y>,<local_size_z>,<simd-width>,<args...>
@@ -60,24 +84,26 @@ bool create_floor_function_info(const std::string& ffi_file_name,
 		// NOTE: arg-buffer entry must come after the function entry that uses it
 		// NOTE: for an argument buffer struct local_size_* is 0
 		static constexpr const uint32_t function_token_count { 8u };
-		if (tokens.size() < function_token_count) {
+		const auto token_count = size_t(std::count(line.begin(), line.end(), ',')) + 1u;
+		if (token_count < function_token_count) {
 			log_error("invalid function info entry: $", line);
 			return false;
 		}
-		const auto& token_version = tokens[0];
-		const auto& token_name = tokens[1];
-		const auto& token_type = tokens[2];
-		const auto& token_flags = tokens[3];
+		auto remaining_line = line;
+		const auto token_version = next_token(remaining_line);
+		const auto token_name = next_token(remaining_line);
+		const auto token_type = next_token(remaining_line);
+		const auto token_flags = next_token(remaining_line);
 		// -> functions
-		const auto& token_req_local_size_x = tokens[4];
-		const auto& token_req_local_size_y = tokens[5];
-		const auto& token_req_local_size_z = tokens[6];
-		const auto& token_req_simd_width = tokens[7];
+		const auto token_req_local_size_x = next_token(remaining_line);
+		const auto token_req_local_size_y = next_token(remaining_line);
+		const auto token_req_local_size_z = next_token(remaining_line);
+		const auto token_req_simd_width = next_token(remaining_line);
 		// -> argument buffer
-		const auto& token_arg_num = tokens[4];
+		const auto& token_arg_num = token_req_local_size_x;
 		
 		//
-		static constexpr const char floor_functions_version[] { "7" };
+		static constexpr const std::string_view floor_functions_version { "7" };
 		if (token_version != floor_functions_version) {
 			log_error("invalid floor function info version, expected $, got $!",
 					  floor_functions_version, token_version);
@@ -99,21 +125,21 @@ bool create_floor_function_info(const std::string& ffi_file_name,
 			return false;
 		}
 		
-		const auto func_flags = (FUNCTION_FLAGS)strtoull(token_flags.c_str(), nullptr, 10);
+		const auto func_flags = (FUNCTION_FLAGS)to_uint(token_flags);
 		
 		uint3 required_local_size {};
 		uint32_t required_simd_width { 0u };
 		if (func_type != FUNCTION_TYPE::ARGUMENT_BUFFER_STRUCT) {
 			required_local_size = {
-				(uint32_t)strtoull(token_req_local_size_x.c_str(), nullptr, 10),
-				(uint32_t)strtoull(token_req_local_size_y.c_str(), nullptr, 10),
-				(uint32_t)strtoull(token_req_local_size_z.c_str(), nullptr, 10),
+				(uint32_t)to_uint(token_req_local_size_x),
+				(uint32_t)to_uint(token_req_local_size_y),
+				(uint32_t)to_uint(token_req_local_size_z),
 			};
-			required_simd_width = (uint32_t)strtoull(token_req_simd_width.c_str(), nullptr, 10);
+			required_simd_width = (uint32_t)to_uint(token_req_simd_width);
 		}
 		
 		function_info info {
-			.name = token_name,
+			.name = std::string(token_name),
 			.required_local_size = required_local_size,
 			.required_simd_width = required_simd_width,
 			.type = func_type,
@@ -130,12 +156,14 @@ bool create_floor_function_info(const std::string& ffi_file_name,
 		
 		// each arg: size,array_extent,address_space,access,image_type,flags
 		static constexpr const uint32_t arg_token_count { 6u };
-		assert(((tokens.size() - function_token_count) % arg_token_count) == 0u && "invalid args token count");
-		for (size_t i = function_token_count, count = tokens.size(); i < count; i += arg_token_count) {
+		assert(((token_count - function_token_count) % arg_token_count) == 0u && "invalid args token count");
+		info.args.reserve((token_count - function_token_count) / arg_token_count);
+		for (size_t i = function_token_count; i < token_count; i += arg_token_count) {
 			uint64_t arg_tokens[arg_token_count];
 			for (uint32_t j = 0; j < arg_token_count; ++j) {
-				assert(!tokens[i + j].empty());
-				arg_tokens[j] = strtoull(tokens[i + j].c_str(), nullptr, 10);
+				const auto arg_token = next_token(remaining_line);
+				assert(!arg_token.empty());
+				arg_tokens[j] = to_uint(arg_token);
 			}
 			
 			info.args.emplace_back(arg_info {
@@ -156,7 +184,7 @@ bool create_floor_function_info(const std::string& ffi_file_name,
 		}
 		
 		if (info.type == FUNCTION_TYPE::ARGUMENT_BUFFER_STRUCT) {
-			const auto arg_idx = (uint32_t)strtoull(token_arg_num.c_str(), nullptr, 10);
+			const auto arg_idx = (uint32_t)to_uint(token_arg_num);
 			
 			bool found_func = false;
 			for (auto riter = functions.rbegin(); riter != functions.rend(); ++riter) {
@@ -183,7 +211,7 @@ bool create_floor_function_info(const std::string& ffi_file_name,
 				return false;
 			}
 		} else {
-			functions.emplace_back(info);
+			functions.emplace_back(std::move(info));
 		}
 	}
 	
@@ -1095,11 +1123,11 @@ program_data compile_input(const std::string& input,
 	clang_cmd += " -DFLOOR_ASSERT=" + assert_str;
 	clang_cmd += " -DFLOOR_ASSERT_" + assert_str;
 	
-	// floor function info
-	std::string function_info_file_name;
+	// floor function info: written by the compiler directly into memory (unless temporary files should be kept)
+	std::unique_ptr<core::memory_file> function_info_file;
 	if (!build_pch) {
-		function_info_file_name = core::create_tmp_file_name("ffi", ".txt");
-		clang_cmd += " -Xclang -floor-function-info=" + function_info_file_name;
+		function_info_file = std::make_unique<core::memory_file>("ffi", ".txt", floor::get_toolchain_keep_temp());
+		clang_cmd += " -Xclang -floor-function-info=" + function_info_file->get_path();
 	}
 	
 	// target specific compute info
@@ -1220,8 +1248,17 @@ program_data compile_input(const std::string& input,
 		options.cli +
 		" -m64"
 	};
+	// output binary: this is written into memory if it is consumed right here (SPIR, PTX) or if this has been requested
+	const bool in_memory_output = (!build_pch &&
+								   (options.target == TARGET::SPIR || options.target == TARGET::PTX || options.in_memory_binary));
+	std::unique_ptr<core::memory_file> output_file;
 	if (!build_pch) {
-		compiled_file_or_code = core::create_tmp_file_name("", '.' + output_file_type);
+		if (in_memory_output && !metal_preprocess) {
+			output_file = std::make_unique<core::memory_file>("", '.' + output_file_type, floor::get_toolchain_keep_temp());
+			compiled_file_or_code = output_file->get_path();
+		} else {
+			compiled_file_or_code = core::create_tmp_file_name("", '.' + output_file_type);
+		}
 		if (options.target != TARGET::HOST_COMPUTE_CPU && options.target != TARGET::PTX) {
 			clang_cmd += " -emit-llvm";
 		}
@@ -1246,7 +1283,12 @@ program_data compile_input(const std::string& input,
 	// build the final preprocess and compile commands here
 	std::string metal_pp_compile_cmd, metal_final_output_file;
 	if (metal_preprocess) {
-		metal_final_output_file = core::create_tmp_file_name("", '.' + metal_final_output_file_type);
+		if (in_memory_output) {
+			output_file = std::make_unique<core::memory_file>("", '.' + metal_final_output_file_type, floor::get_toolchain_keep_temp());
+			metal_final_output_file = output_file->get_path();
+		} else {
+			metal_final_output_file = core::create_tmp_file_name("", '.' + metal_final_output_file_type);
+		}
 		metal_pp_compile_cmd = clang_cmd + metal_emit_format + " -Wno-everything";
 		metal_pp_compile_cmd += " -emit-llvm -c -o " + metal_final_output_file + " " + compiled_file_or_code;
 #if !defined(_MSC_VER)
@@ -1307,13 +1349,14 @@ program_data compile_input(const std::string& input,
 	// grab floor function info and create the internal per-function info
 	std::vector<function_info> functions;
 	if (!build_pch) {
-		if (!create_floor_function_info(function_info_file_name, functions, toolchain_version)) {
-			log_error("failed to create internal floor function info");
+		std::string ffi;
+		if (!function_info_file->read(ffi)) {
+			log_error("failed to retrieve floor function info from \"$\"", function_info_file->get_path());
 			return {};
 		}
-		if (!floor::get_toolchain_keep_temp()) {
-			std::error_code ec {};
-			(void)std::filesystem::remove(function_info_file_name, ec);
+		if (!create_floor_function_info_from_memory(ffi, functions, toolchain_version)) {
+			log_error("failed to create internal floor function info");
+			return {};
 		}
 	}
 	
@@ -1321,17 +1364,11 @@ program_data compile_input(const std::string& input,
 	if (!build_pch) {
 		if (options.target == TARGET::SPIR) {
 			std::string spir_bc_data;
-			if (!file_io::file_to_string(compiled_file_or_code, spir_bc_data)) {
+			if (!output_file->read(spir_bc_data)) {
 				log_error("failed to read SPIR 1.2 .bc file");
 				return {};
 			}
 			
-			// cleanup
-			if (!floor::get_toolchain_keep_temp()) {
-				std::error_code ec {};
-				(void)std::filesystem::remove(compiled_file_or_code, ec);
-			}
-			
 			// move spir data
 			compiled_file_or_code.swap(spir_bc_data);
 		} else if (options.target == TARGET::AIR) {
@@ -1339,19 +1376,13 @@ program_data compile_input(const std::string& input,
 		} else if (options.target == TARGET::PTX) {
 			// check if we have sane output
 			std::string ptx_code;
-			if (!file_io::file_to_string(compiled_file_or_code, ptx_code)) {
+			if (!output_file->read(ptx_code)) {
 				log_error("PTX compilation failed!");
 				return {};
 			}
 			// add an explicit zero terminator so that we can later on use this when loading the module (where we can't specify a size)
 			ptx_code += '\0';
 			
-			// cleanup
-			if (!floor::get_toolchain_keep_temp()) {
-				std::error_code ec {};
-				(void)std::filesystem::remove(compiled_file_or_code, ec);
-			}
-			
 			if (ptx_code == "" || ptx_code.find("Generated by LLVM NVPTX Back-End") == std::string::npos) {
 				log_error("PTX compilation failed!\n$", ptx_code);
 				return {};
@@ -1455,6 +1486,18 @@ program_data compile_input(const std::string& input,
 		} else if (options.target == TARGET::HOST_COMPUTE_CPU) {
 			// nop, already a binary
 		}
+		
+		// SPIR-V/AIR/Host-Compute: retrieve the binary data if in-memory output was requested
+		if (options.in_memory_binary &&
+			options.target != TARGET::SPIR &&
+			options.target != TARGET::PTX) {
+			std::string bin_data;
+			if (!output_file->read(bin_data)) {
+				log_error("failed to read compiled binary from \"$\"", compiled_file_or_code);
+				return {};
+			}
+			compiled_file_or_code.swap(bin_data);
+		}
 	}
 	
 	return { true, compiled_file_or_code, functions, options };
@@ -25,12 +25,9 @@
 #include <floor/device/host/host_device.hpp>
 #include <floor/device/vulkan/vulkan_device.hpp>
 #include <floor/core/file_io.hpp>
-#include <floor/threading/task.hpp>
-#include <floor/threading/thread_helpers.hpp>
+#include <floor/threading/job_graph.hpp>
 #include <floor/core/bcm.hpp>
 #include <floor/floor.hpp>
-#include <chrono>
-#include <deque>
 
 namespace std {
 	template <> struct hash<fl::universal_binary::target_v7> : public hash<uint64_t> {
@@ -286,6 +283,8 @@ namespace fl::universal_binary {
 		auto options = user_options;
 		// always ignore run-time info, we want a reproducible and specific build
 		options.ignore_runtime_info = true;
+		// we always want the binary data in memory
+		options.in_memory_binary = true;
 		
 		uint32_t toolchain_version = 0;
 		std::shared_ptr<device> dev;
@@ -680,12 +679,111 @@ namespace fl::universal_binary {
 		return { true, toolchain_version, program };
 	}
 	
+	//! serializes the function info and binary data of the specified program into "dst"
+	static bool serialize_binary(const toolchain::program_data& bin, std::vector<uint8_t>& dst) {
+		// static header
+		binary_dynamic_v7 bin_data {
+			.static_binary_header = {
+				.function_count = 0u, // -> will be incremented below
+				.function_info_size = 0, // N/A yet
+				.binary_size = uint32_t(bin.data_or_filename.size()),
+				.flags = {
+					._unused_flags = 0u,
+				},
+			},
+		};
+		// NOTE: bin_data.data must not even be written/copied here
+		
+		// convert function info
+		bin_data.function_info.reserve(bin.function_info.size());
+		const std::function<bool(const toolchain::function_info&, const uint32_t)> create_bin_function_info =
+		[&bin_data, &create_bin_function_info](const toolchain::function_info& func, const uint32_t argument_buffer_index) {
+			function_info_dynamic_v7 finfo {
+				.static_function_info = {
+					.function_info_version = function_info_version,
+					.type = func.type,
+					.flags = func.flags,
+					.arg_count = uint32_t(func.args.size()),
+					.local_size = func.required_local_size,
+					.simd_width = func.required_simd_width,
+					.argument_buffer_index = (func.type == toolchain::FUNCTION_TYPE::ARGUMENT_BUFFER_STRUCT ? argument_buffer_index : 0u),
+				},
+				.name = func.name,
+				.args = {}, // need proper conversion
+			};
+			bin_data.static_binary_header.function_info_size += sizeof(finfo.static_function_info);
+			bin_data.static_binary_header.function_info_size += finfo.name.size() + 1 /* \0 */;
+			
+			// convert/create args
+			finfo.args.reserve(func.args.size());
+			std::vector<std::pair<const toolchain::function_info*, uint32_t>> arg_buffers;
+			for (uint32_t arg_idx = 0, arg_count = (uint32_t)func.args.size(); arg_idx < arg_count; ++arg_idx) {
+				const auto& arg = func.args[arg_idx];
+				finfo.args.emplace_back(function_info_dynamic_v7::arg_info {
+					.size = arg.size,
+					.array_extent = arg.array_extent,
+					.address_space = arg.address_space,
+					.access = arg.access,
+					.image_type = arg.image_type,
+					.flags = arg.flags,
+				});
+				if (has_flag<toolchain::ARG_FLAG::ARGUMENT_BUFFER>(arg.flags)) {
+					if (!arg.argument_buffer_info) {
+						log_error("missing argument buffer info for function $", finfo.name);
+						return false;
+					}
+					// delay argument buffer function info creation until after we have written the info for this function
+					arg_buffers.emplace_back(&*arg.argument_buffer_info, arg_idx);
+				}
+			}
+			++bin_data.static_binary_header.function_count;
+			bin_data.static_binary_header.function_info_size += sizeof(function_info_dynamic_v7::arg_info) * finfo.args.size();
+			bin_data.function_info.emplace_back(std::move(finfo));
+			
+			// write argument buffer info
+			for (const auto& arg_buffer_info : arg_buffers) {
+				create_bin_function_info(*arg_buffer_info.first, arg_buffer_info.second);
+			}
+			
+			return true;
+		};
+		for (const auto& func : bin.function_info) {
+			if (!create_bin_function_info(func, 0u)) {
+				return false;
+			}
+		}
+		
+		dst.reserve(sizeof(bin_data.static_binary_header) + bin_data.static_binary_header.function_info_size + bin.data_or_filename.size());
+		
+		// write static header
+		const std::span static_binary_header_data { (const uint8_t*)&bin_data.static_binary_header, sizeof(bin_data.static_binary_header) };
+		dst.insert(dst.end(), static_binary_header_data.begin(), static_binary_header_data.end());
+		
+		// write dynamic binary part
+		for (const auto& finfo : bin_data.function_info) {
+			const std::span static_function_info_data { (const uint8_t*)&finfo.static_function_info, sizeof(finfo.static_function_info) };
+			dst.insert(dst.end(), static_function_info_data.begin(), static_function_info_data.end());
+			
+			dst.insert(dst.end(), finfo.name.begin(), finfo.name.end());
+			dst.emplace_back(0 /* string zero terminator */);
+			
+			const std::span finfo_args_data {
+				(const uint8_t*)finfo.args.data(),
+				finfo.args.size() * sizeof(typename decltype(finfo.args)::value_type)
+			};
+			dst.insert(dst.end(), finfo_args_data.begin(), finfo_args_data.end());
+		}
+		dst.insert(dst.end(), bin.data_or_filename.begin(), bin.data_or_filename.end());
+		return true;
+	}
+	
 	static bool build_archive(const std::string& src_input,
 							  const bool is_file_input,
 							  const std::string& dst_archive_file_name,
 							  const toolchain::compile_options& options,
 							  const std::vector<target>& targets_in,
-							  const bool use_precompiled_header) {
+							  const bool use_precompiled_header,
+							  const uint32_t max_build_jobs) {
 		// make sure we can open the output file before we start doing anything else
 		file_io archive(dst_archive_file_name, file_io::OPEN_TYPE::WRITE_BINARY);
 		if (!archive.is_open()) {
@@ -700,17 +798,11 @@ namespace fl::universal_binary {
 			unique_targets_in.emplace(target);
 		}
 		
-		// create a thread pool of #logical-CPUs threads that build all targets
+		// sanitize targets
 		const auto target_count = unique_targets_in.size();
-		const auto compile_job_count = uint32_t(std::min(size_t(get_logical_core_count()), target_count));
-		
-		// enqueue + sanitize targets
-		safe_mutex targets_lock;
 		std::vector<target_v7> targets;
-		std::deque<std::pair<size_t, target>> remaining_targets;
-		auto unique_target_iter = unique_targets_in.begin();
-		for (size_t i = 0; i < target_count; ++i, ++unique_target_iter) {
-			auto target = *unique_target_iter;
+		targets.reserve(target_count);
+		for (auto target : unique_targets_in) {
 			switch (target.common.type) {
 				case PLATFORM_TYPE::NONE:
 					log_error("invalid target type");
@@ -731,106 +823,68 @@ namespace fl::universal_binary {
 					target.vulkan._unused = 0;
 					break;
 			}
-			
 			targets.emplace_back(target);
-			remaining_targets.emplace_back(i, target);
 		}
 		
-		safe_mutex prog_data_lock;
-		std::vector<std::unique_ptr<toolchain::program_data>> targets_prog_data(target_count);
-		std::vector<uint32_t> targets_toolchain_version(target_count);
-		std::vector<sha_256::hash_t> targets_hashes(target_count);
-		
-		std::atomic<uint32_t> remaining_compile_jobs { compile_job_count };
-		std::atomic<bool> compilation_successful { true };
-		for (uint32_t i = 0; i < compile_job_count; ++i) {
-			task::spawn([&src_input, &is_file_input, &options, &use_precompiled_header,
-						 &targets_lock, &remaining_targets,
-						 &prog_data_lock, &targets_prog_data, &targets_toolchain_version, &targets_hashes,
-						 &remaining_compile_jobs,
-						 &compilation_successful]() {
-				while (compilation_successful) {
-					// get a target
-					std::pair<size_t, target> build_target;
-					{
-						GUARD(targets_lock);
-						if (remaining_targets.empty()) {
-							break;
-						}
-						build_target = remaining_targets[0];
-						remaining_targets.pop_front();
-					}
-					
-					// compile the target
-					auto compile_ret = compile_target(src_input, is_file_input, options, build_target.second, use_precompiled_header);
-					if (!compile_ret.success || !compile_ret.prog_data.valid) {
-						compilation_successful = false;
-						break;
-					}
-					
-					// TODO: cleanup binary as in opencl_context/vulkan_context + in general for other backends?
-					
-					// for SPIR-V, AIR and Host-Compute, the binary data is written as a file -> read it so we have it in memory
-					if (compile_ret.prog_data.options.target == toolchain::TARGET::SPIRV_OPENCL ||
-						compile_ret.prog_data.options.target == toolchain::TARGET::SPIRV_VULKAN ||
-						compile_ret.prog_data.options.target == toolchain::TARGET::AIR ||
-						compile_ret.prog_data.options.target == toolchain::TARGET::HOST_COMPUTE_CPU) {
-						std::string bin_data;
-						if (!file_io::file_to_string(compile_ret.prog_data.data_or_filename, bin_data)) {
-							compilation_successful = false;
-							break;
-						}
-						compile_ret.prog_data.data_or_filename = std::move(bin_data);
-					}
-					
-					// compute binary hash
-					const auto binary_hash = sha_256::compute_hash((const uint8_t*)compile_ret.prog_data.data_or_filename.c_str(),
-																   compile_ret.prog_data.data_or_filename.size());
-					
-					// add to program data array
-					{
-						auto prog_data = std::make_unique<toolchain::program_data>();
-						*prog_data = std::move(compile_ret.prog_data);
-						
-						GUARD(prog_data_lock);
-						targets_prog_data[build_target.first] = std::move(prog_data);
-						targets_toolchain_version[build_target.first] = compile_ret.toolchain_version;
-						targets_hashes[build_target.first] = binary_hash;
-					}
-				}
-				--remaining_compile_jobs;
-			}, "build_job_" + std::to_string(i));
-		}
+		// per-target build state, each entry is only ever accessed by the jobs of its target
+		struct target_build_t {
+			compile_return_t compile_ret;
+			sha_256::hash_t hash;
+			std::vector<uint8_t> binary_data;
+		};
+		std::vector<target_build_t> target_builds(target_count);
 		
-		while (remaining_compile_jobs > 0) {
-			std::this_thread::sleep_for(250ms);
-			std::this_thread::yield();
+		// create a pipeline of jobs for each target: compile (directly into memory) -> hash -> serialize
+		// NOTE: #jobs that run concurrently default to #logical-CPUs, but can be limited (e.g. for memory reasons),
+		//       the first failing job will cancel all remaining jobs
+		job_graph build_jobs("build_job", max_build_jobs);
+		for (size_t i = 0; i < target_count; ++i) {
+			auto& build = target_builds[i];
+			const auto& build_target = targets[i];
+			
+			// compile the target
+			const auto compile_job = build_jobs.add_job([&src_input, &is_file_input, &options, &use_precompiled_header,
+														 &build, &build_target]() {
+				build.compile_ret = compile_target(src_input, is_file_input, options, build_target, use_precompiled_header);
+				return (build.compile_ret.success && build.compile_ret.prog_data.valid);
+			});
+			
+			// TODO: cleanup binary as in opencl_context/vulkan_context + in general for other backends?
+			
+			// compute binary hash
+			const auto hash_job = build_jobs.add_job([&build]() {
+				const auto& bin_data = build.compile_ret.prog_data.data_or_filename;
+				build.hash = sha_256::compute_hash((const uint8_t*)bin_data.c_str(), bin_data.size());
+				return true;
+			}, { compile_job });
+			
+			// serialize function info + binary
+			build_jobs.add_job([&build]() {
+				return serialize_binary(build.compile_ret.prog_data, build.binary_data);
+			}, { hash_job });
 		}
-		
-		// check success and output validity
-		if (!compilation_successful) {
+		if (!build_jobs.execute_and_wait()) {
 			return false;
 		}
-		for (const auto& prog_data : targets_prog_data) {
-			if (prog_data == nullptr) {
-				return false;
-			}
-		}
 		
 		// write binary
 		header_dynamic_v7 header {
 			.static_header = {
 				.binary_format_version = binary_format_version,
-				.binary_count = uint32_t(targets_prog_data.size()),
+				.binary_count = uint32_t(target_count),
 				.flags = {
 					.is_compressed = options.compress_binaries ? 1u : 0u,
 					._unused_flags = 0u,
 				},
 			},
 			.targets = targets,
-			.toolchain_versions = std::move(targets_toolchain_version),
-			.hashes = std::move(targets_hashes),
 		};
+		header.toolchain_versions.reserve(target_count);
+		header.hashes.reserve(target_count);
+		for (const auto& build : target_builds) {
+			header.toolchain_versions.emplace_back(build.compile_ret.toolchain_version);
+			header.hashes.emplace_back(build.hash);
+		}
 		// NOTE: proper offsets are written later on
 		header.offsets.resize(header.static_header.binary_count);
 		
@@ -844,107 +898,19 @@ namespace fl::universal_binary {
 							header.toolchain_versions.size() * sizeof(typename decltype(header.toolchain_versions)::value_type));
 		archive.write_block(header.hashes.data(), header.hashes.size() * sizeof(typename decltype(header.hashes)::value_type));
 		
-		// binaries
+		// binaries: already serialized per target -> only need to concatenate them
 		const auto binary_base_offset = uint64_t(ar_stream.tellp());
+		size_t binaries_size = 0;
+		for (const auto& build : target_builds) {
+			binaries_size += build.binary_data.size();
+		}
 		std::vector<uint8_t> binaries_data;
-		binaries_data.reserve(128u * 1024u);
+		binaries_data.reserve(binaries_size);
 		for (size_t i = 0; i < target_count; ++i) {
-			const auto& bin = *targets_prog_data[i];
-			
-			// remember offset
 			header.offsets[i] = binary_base_offset + binaries_data.size();
-			
-			// static header
-			binary_dynamic_v7 bin_data {
-				.static_binary_header = {
-					.function_count = 0u, // -> will be incremented below
-					.function_info_size = 0, // N/A yet
-					.binary_size = uint32_t(bin.data_or_filename.size()),
-					.flags = {
-						._unused_flags = 0u,
-					},
-				},
-			};
-			// NOTE: bin_data.data must not even be written/copied here
-			
-			// convert function info
-			bin_data.function_info.reserve(bin.function_info.size());
-			const std::function<bool(const toolchain::function_info&, const uint32_t)> create_bin_function_info =
-			[&bin_data, &create_bin_function_info](const toolchain::function_info& func, const uint32_t argument_buffer_index) {
-				function_info_dynamic_v7 finfo {
-					.static_function_info = {
-						.function_info_version = function_info_version,
-						.type = func.type,
-						.flags = func.flags,
-						.arg_count = uint32_t(func.args.size()),
-						.local_size = func.required_local_size,
-						.simd_width = func.required_simd_width,
-						.argument_buffer_index = (func.type == toolchain::FUNCTION_TYPE::ARGUMENT_BUFFER_STRUCT ? argument_buffer_index : 0u),
-					},
-					.name = func.name,
-					.args = {}, // need proper conversion
-				};
-				bin_data.static_binary_header.function_info_size += sizeof(finfo.static_function_info);
-				bin_data.static_binary_header.function_info_size += finfo.name.size() + 1 /* \0 */;
-				
-				// convert/create args
-				finfo.args.reserve(func.args.size());
-				std::vector<std::pair<const toolchain::function_info*, uint32_t>> arg_buffers;
-				for (uint32_t arg_idx = 0, arg_count = (uint32_t)func.args.size(); arg_idx < arg_count; ++arg_idx) {
-					const auto& arg = func.args[arg_idx];
-					finfo.args.emplace_back(function_info_dynamic_v7::arg_info {
-						.size = arg.size,
-						.array_extent = arg.array_extent,
-						.address_space = arg.address_space,
-						.access = arg.access,
-						.image_type = arg.image_type,
-						.flags = arg.flags,
-					});
-					if (has_flag<toolchain::ARG_FLAG::ARGUMENT_BUFFER>(arg.flags)) {
-						if (!arg.argument_buffer_info) {
-							log_error("missing argument buffer info for function $", finfo.name);
-							return false;
-						}
-						// delay argument buffer function info creation until after we have written the info for this function
-						arg_buffers.emplace_back(&*arg.argument_buffer_info, arg_idx);
-					}
-				}
-				++bin_data.static_binary_header.function_count;
-				bin_data.static_binary_header.function_info_size += sizeof(function_info_dynamic_v7::arg_info) * finfo.args.size();
-				bin_data.function_info.emplace_back(std::move(finfo));
-				
-				// write argument buffer info
-				for (const auto& arg_buffer_info : arg_buffers) {
-					create_bin_function_info(*arg_buffer_info.first, arg_buffer_info.second);
-				}
-				
-				return true;
-			};
-			for (const auto& func : bin.function_info) {
-				if (!create_bin_function_info(func, 0u)) {
-					return false;
-				}
-			}
-			
-			// write static header
-			const std::span static_binary_header_data { (const uint8_t*)&bin_data.static_binary_header, sizeof(bin_data.static_binary_header) };
-			binaries_data.insert(binaries_data.end(), static_binary_header_data.begin(), static_binary_header_data.end());
-			
-			// write dynamic binary part
-			for (const auto& finfo : bin_data.function_info) {
-				const std::span static_function_info_data { (const uint8_t*)&finfo.static_function_info, sizeof(finfo.static_function_info) };
-				binaries_data.insert(binaries_data.end(), static_function_info_data.begin(), static_function_info_data.end());
-				
-				binaries_data.insert(binaries_data.end(), finfo.name.begin(), finfo.name.end());
-				binaries_data.emplace_back(0 /* string zero terminator */);
-				
-				const std::span finfo_args_data {
-					(const uint8_t*)finfo.args.data(),
-					finfo.args.size() * sizeof(typename decltype(finfo.args)::value_type)
-				};
-				binaries_data.insert(binaries_data.end(), finfo_args_data.begin(), finfo_args_data.end());
-			}
-			binaries_data.insert(binaries_data.end(), bin.data_or_filename.begin(), bin.data_or_filename.end());
+			binaries_data.insert(binaries_data.end(), target_builds[i].binary_data.begin(), target_builds[i].binary_data.end());
+			// no longer needed
+			target_builds[i].binary_data = {};
 		}
 		
 		// write compressed binary data or raw binary data?
@@ -966,16 +932,18 @@ namespace fl::universal_binary {
 								 const std::string& dst_archive_file_name,
 								 const toolchain::compile_options& options,
 								 const std::vector<target>& targets,
-								 const bool use_precompiled_header) {
-		return build_archive(src_file_name, true, dst_archive_file_name, options, targets, use_precompiled_header);
+								 const bool use_precompiled_header,
+								 const uint32_t max_build_jobs) {
+		return build_archive(src_file_name, true, dst_archive_file_name, options, targets, use_precompiled_header, max_build_jobs);
 	}
 	
 	bool build_archive_from_memory(const std::string& src_code,
 								   const std::string& dst_archive_file_name,
 								   const toolchain::compile_options& options,
 								   const std::vector<target>& targets,
-								   const bool use_precompiled_header) {
-		return build_archive(src_code, false, dst_archive_file_name, options, targets, use_precompiled_header);
+								   const bool use_precompiled_header,
+								   const uint32_t max_build_jobs) {
+		return build_archive(src_code, false, dst_archive_file_name, options, targets, use_precompiled_header, max_build_jobs);
 	}
 	
 	std::pair<const binary_dynamic_v7*, const target_v7>
@@ -87,10 +87,8 @@ static inline constexpr auto convert_log_format(const char (&format)[format_len]
 
 #define PRIu64 "_"
 #define VMA_LEAK_LOG_FORMAT(format, ...) \
-fl::logger::log<count_printf_format_args(format)>(fl::logger::LOG_TYPE::DEBUG_MSG, __FILE_NAME__, __func__, \
-												  (fl::make_const_string("VMA: leak: ") + \
-												   convert_log_format<count_printf_format_args(format)>(format)).data(), \
-												  ##__VA_ARGS__)
+fl::logger::log<fl::make_const_string("VMA: leak: ") + convert_log_format<count_printf_format_args(format)>(format)>( \
+	fl::logger::LOG_TYPE::DEBUG_MSG, __FILE_NAME__, __func__, ##__VA_ARGS__)
 
 #if FLOOR_VMA_DEBUGGING
 #define VMA_DEBUG_LOG(str) log_debug("VMA: $", str)
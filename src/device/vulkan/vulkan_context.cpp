@@ -3545,9 +3545,10 @@ std::shared_ptr<device_program> vulkan_context::create_program_from_archive_bina
 		const auto& dev_best_bin = bins.dev_binaries[i];
 		const auto func_info = universal_binary::translate_function_info(dev_best_bin);
 		
+		// NOTE: binary data outlives the container -> no need to copy it
 		auto container = spirv_handler::load_container_from_memory(dev_best_bin.first->data.data(),
 																   dev_best_bin.first->data.size(),
-																   identifier);
+																   identifier, { .zero_copy = true });
 		if(!container.valid) return {}; // already prints an error
 		
 		prog_map.insert_or_assign(vlk_dev, create_vulkan_program_internal(container, func_info));
@@ -3653,7 +3654,7 @@ vulkan_context::create_vulkan_program_internal(const spirv_handler::container& c
 		
 		// we must create a copy of the program data
 		auto program_storage = std::make_shared<uint32_t[]>(entry.data_word_count);
-		memcpy(program_storage.get(), &container.spirv_data[entry.data_offset], entry.data_word_count * sizeof(uint32_t));
+		memcpy(program_storage.get(), entry.code.data(), entry.code.size_bytes());
 		std::span<const uint32_t> code_span { program_storage.get(), entry.data_word_count };
 		ret.programs.emplace_back(std::move(program_storage), code_span);
 	}
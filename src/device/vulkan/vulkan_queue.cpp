@@ -33,6 +33,7 @@
 #include <floor/threading/thread_helpers.hpp>
 #include <floor/floor.hpp>
 #include <chrono>
+#include <span>
 
 namespace fl {
 using namespace std::literals;
@@ -95,13 +96,31 @@ struct vulkan_completion_cmd_t {
 //! the command completion handler/pool implementation
 using vulkan_cmd_completion_handler = generic_cmd_completion_handler<vulkan_completion_cmd_t, vulkan_command_buffer_completion_impl>;
 
-//! called to complete (wait for) a single "vulkan_completion_cmd_t"
+//! called to check/wait for and complete "vulkan_completion_cmd_t"s
 struct vulkan_command_buffer_completion_impl {
+	//! returns true if the work sema of "cmd" has been signaled (or the device has been lost)
+	static bool is_complete(vulkan_cmd_completion_handler::cmd_t& cmd);
+	
+	//! blocks until the work sema of any of "cmds" (on the device of the oldest command) has been signaled or "max_wait" has elapsed,
+	//! returns false if waiting failed
+	static bool wait_any(std::span<vulkan_cmd_completion_handler::cmd_t* const> cmds, const bool cmds_changed,
+						 const std::chrono::microseconds max_wait);
+	
+	//! blocks until the work sema of "cmd" has been signaled or "max_wait" has elapsed, returns false if waiting failed
+	static bool wait(vulkan_cmd_completion_handler::cmd_t& cmd, const std::chrono::microseconds max_wait);
+	
 	static void complete(vulkan_cmd_completion_handler::cmd_t& cmd) {
 		vulkan_complete_cmd_buffer(*cmd.pool, *cmd.vk_dev, std::move(cmd.cmd_buffer), cmd.work_sema, cmd.work_sema_signal_value,
 								   std::move(cmd.completion_handler));
 		cmd.cmd_buffer.reset();
 	}
+	
+protected:
+	//! wait data of the previous wait_any() call (only rebuilt if the commands have changed)
+	//! NOTE: only accessed by the single completion waiter thread
+	static inline const vulkan_device* wait_vk_dev { nullptr };
+	static inline std::vector<VkSemaphore> wait_semas;
+	static inline std::vector<uint64_t> wait_values;
 };
 
 //! the command completion handler instance
@@ -385,6 +404,77 @@ void vulkan_complete_cmd_buffer(vulkan_command_pool_t& pool,
 	pool.cmd_resources.release_resource(cmd_buffer.index);
 }
 
+bool vulkan_command_buffer_completion_impl::is_complete(vulkan_cmd_completion_handler::cmd_t& cmd) {
+	uint64_t sema_value = 0u;
+	const auto status = vkGetSemaphoreCounterValue(cmd.vk_dev->device, cmd.work_sema, &sema_value);
+	if (status == VK_SUCCESS) {
+		return (sema_value >= cmd.work_sema_signal_value);
+	} else if (status == VK_ERROR_DEVICE_LOST) {
+		// -> complete() will handle this
+		return true;
+	} else if (status != VK_NOT_READY) {
+		// can't query the status -> let complete() do a blocking wait, which will also report the error
+		// NOTE: don't log anything in here, this would otherwise be logged on every poll
+		return true;
+	}
+	return false;
+}
+
+bool vulkan_command_buffer_completion_impl::wait_any(std::span<vulkan_cmd_completion_handler::cmd_t* const> cmds,
+													 const bool cmds_changed,
+													 const std::chrono::microseconds max_wait) {
+	// NOTE: can only wait on semaphores of the same device -> wait on all commands of the device of the oldest command,
+	//       commands of other devices will be checked again once this returns (after "max_wait" at the latest)
+	// NOTE: "sema_wait_polling" only applies to the blocking completion in vulkan_complete_cmd_buffer(),
+	//       the waiter thread always blocks, since it would otherwise occupy a CPU core while any command is pending
+	if (cmds_changed || wait_semas.empty()) {
+		wait_vk_dev = cmds[0]->vk_dev;
+		wait_semas.clear();
+		wait_values.clear();
+		for (const auto& cmd : cmds) {
+			if (cmd->vk_dev != wait_vk_dev) {
+				continue;
+			}
+			wait_semas.emplace_back(cmd->work_sema);
+			wait_values.emplace_back(cmd->work_sema_signal_value);
+		}
+	}
+	
+	const VkSemaphoreWaitInfo wait_info {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+		.pNext = nullptr,
+		.flags = VK_SEMAPHORE_WAIT_ANY_BIT,
+		.semaphoreCount = uint32_t(wait_semas.size()),
+		.pSemaphores = wait_semas.data(),
+		.pValues = wait_values.data(),
+	};
+	const auto wait_ret = vkWaitSemaphores(wait_vk_dev->device, &wait_info, uint64_t(std::chrono::nanoseconds(max_wait).count()));
+	if (wait_ret != VK_SUCCESS && wait_ret != VK_TIMEOUT && wait_ret != VK_ERROR_DEVICE_LOST) {
+		log_error("waiting for work semas failed: $ ($)", vulkan_error_to_string(wait_ret), wait_ret);
+		return false;
+	}
+	// NOTE: on device loss, is_complete() will signal completion
+	return true;
+}
+
+bool vulkan_command_buffer_completion_impl::wait(vulkan_cmd_completion_handler::cmd_t& cmd, const std::chrono::microseconds max_wait) {
+	const VkSemaphoreWaitInfo wait_info {
+		.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+		.pNext = nullptr,
+		.flags = 0u,
+		.semaphoreCount = 1u,
+		.pSemaphores = &cmd.work_sema,
+		.pValues = &cmd.work_sema_signal_value,
+	};
+	const auto wait_ret = vkWaitSemaphores(cmd.vk_dev->device, &wait_info, uint64_t(std::chrono::nanoseconds(max_wait).count()));
+	if (wait_ret != VK_SUCCESS && wait_ret != VK_TIMEOUT && wait_ret != VK_ERROR_DEVICE_LOST) {
+		log_error("waiting for work sema failed: $ ($)", vulkan_error_to_string(wait_ret), wait_ret);
+		return false;
+	}
+	// NOTE: on device loss, is_complete() will signal completion
+	return true;
+}
+
 //! stores all Vulkan command pool instances
 struct vulkan_command_pool_storage {
 	//! access to "cmd_pools" must be thread-safe
@@ -344,6 +344,12 @@ bool floor::init(const init_state& state) {
 		config.log_use_time = config_doc.get<bool>("logging.use_time", true);
 		config.log_use_color = config_doc.get<bool>("logging.use_color", true);
 		config.log_synchronous = config_doc.get<bool>("logging.synchronous", false);
+		config.log_deferred = config_doc.get<bool>("logging.deferred", false);
+		config.file_verbosity = config_doc.get<uint32_t>("logging.file_verbosity", config.verbosity);
+		config.log_max_file_size = config_doc.get<uint64_t>("logging.max_file_size", 0);
+		config.log_max_file_age = config_doc.get<uint64_t>("logging.max_file_age", 0);
+		config.log_max_rotated_files = config_doc.get<uint32_t>("logging.max_rotated_files", 0);
+		config.log_compress_rotated_files = config_doc.get<bool>("logging.compress_rotated_files", false);
 		config.file_logging = config_doc.get<bool>("logging.file_logging", true);
 		config.log_filename = config_doc.get<std::string>("logging.log_filename", "");
 		config.msg_filename = config_doc.get<std::string>("logging.msg_filename", "");
@@ -687,7 +693,13 @@ bool floor::init(const init_state& state) {
 	// init logger and print out floor info
 	logger::init((uint32_t)config.verbosity, config.separate_msg_file, config.append_mode,
 				 config.log_use_time, config.log_use_color, config.log_synchronous, config.file_logging,
-				 config.log_filename, config.msg_filename);
+				 config.log_filename, config.msg_filename, config.log_deferred, {
+		.file_verbosity = (logger::LOG_TYPE)config.file_verbosity,
+		.max_file_size = config.log_max_file_size,
+		.max_file_age = config.log_max_file_age,
+		.max_rotated_files = config.log_max_rotated_files,
+		.compress_rotated_files = config.log_compress_rotated_files,
+	});
 	log_debug("$", (FLOOR_VERSION_STRING).c_str());
 	
 	[[maybe_unused]] const uint64_t wanted_locked_memory_size = std::max(get_logical_core_count(), 1u) * 32u * 1024u * 1024u;
@@ -0,0 +1,225 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/math/bvh.hpp>
+#include <numeric>
+#include <algorithm>
+
+namespace fl {
+
+//! amount of bins that are used to find the best SAH split
+static constexpr const uint32_t sah_bin_count { 16u };
+
+//! node of the intermediate binary tree
+struct bvh_build_node_t {
+	bboxf bounds;
+	//! inner node: indices of both children
+	uint32_t left { bvh::invalid_index };
+	uint32_t right { bvh::invalid_index };
+	//! leaf: primitive range in "prim_indices"
+	uint32_t prim_offset { 0u };
+	uint32_t prim_count { 0u };
+	
+	bool is_leaf() const {
+		return (prim_count > 0u);
+	}
+};
+
+static float surface_area(const bboxf& box) {
+	const auto diag = box.diagonal();
+	return 2.0f * (diag.x * diag.y + diag.y * diag.z + diag.z * diag.x);
+}
+
+void bvh::build(std::span<const bboxf> prim_bounds_, const uint32_t max_leaf_size) {
+	nodes.clear();
+	prim_indices.clear();
+	prim_bounds.assign(prim_bounds_.begin(), prim_bounds_.end());
+	bounds = {};
+	if (prim_bounds.empty()) {
+		return;
+	}
+	
+	const auto prim_count = uint32_t(prim_bounds.size());
+	prim_indices.resize(prim_count);
+	std::iota(prim_indices.begin(), prim_indices.end(), 0u);
+	std::vector<float3> centroids(prim_count);
+	for (uint32_t i = 0; i < prim_count; ++i) {
+		centroids[i] = prim_bounds[i].center();
+		bounds.extend(prim_bounds[i]);
+	}
+	
+	// build a binary tree using binned SAH
+	// NOTE: this is done iteratively, so that degenerate inputs can't overflow the call stack
+	struct build_task_t {
+		uint32_t node;
+		uint32_t begin;
+		uint32_t end;
+		uint32_t depth;
+	};
+	std::vector<bvh_build_node_t> build_nodes;
+	build_nodes.reserve(prim_count * 2u);
+	build_nodes.emplace_back();
+	std::vector<build_task_t> tasks { { 0u, 0u, prim_count, 0u } };
+	while (!tasks.empty()) {
+		const auto task = tasks.back();
+		tasks.pop_back();
+		const auto count = task.end - task.begin;
+		
+		bboxf node_bounds, centroid_bounds;
+		for (uint32_t i = task.begin; i < task.end; ++i) {
+			node_bounds.extend(prim_bounds[prim_indices[i]]);
+			centroid_bounds.extend(centroids[prim_indices[i]]);
+		}
+		build_nodes[task.node].bounds = node_bounds;
+		
+		if (count <= max_leaf_size || task.depth + 1u >= max_build_depth) {
+			build_nodes[task.node].prim_offset = task.begin;
+			build_nodes[task.node].prim_count = count;
+			continue;
+		}
+		
+		// split along the axis with the largest centroid extent
+		const auto extent = centroid_bounds.diagonal();
+		const uint32_t axis = (extent.x > extent.y && extent.x > extent.z ? 0u : (extent.y > extent.z ? 1u : 2u));
+		const auto begin_iter = prim_indices.begin() + task.begin;
+		const auto end_iter = prim_indices.begin() + task.end;
+		auto mid = task.begin;
+		if (extent[axis] > 0.0f) {
+			// bin all primitives by their centroid
+			struct bin_t {
+				bboxf bounds;
+				uint32_t count { 0u };
+			};
+			std::array<bin_t, sah_bin_count> bins {};
+			const auto bin_scale = float(sah_bin_count) / extent[axis];
+			const auto bin_index = [&](const uint32_t prim_idx) {
+				return std::min(uint32_t((centroids[prim_idx][axis] - centroid_bounds.min[axis]) * bin_scale), sah_bin_count - 1u);
+			};
+			for (uint32_t i = task.begin; i < task.end; ++i) {
+				auto& bin = bins[bin_index(prim_indices[i])];
+				bin.bounds.extend(prim_bounds[prim_indices[i]]);
+				++bin.count;
+			}
+			
+			// SAH cost of splitting after bin #i: area(left) * count(left) + area(right) * count(right)
+			// -> sweep from the right to get all right side costs, then sweep from the left to find the best split
+			std::array<float, sah_bin_count - 1u> right_costs {};
+			bboxf right_bounds;
+			uint32_t right_count = 0u;
+			for (uint32_t i = sah_bin_count - 1u; i > 0u; --i) {
+				right_bounds.extend(bins[i].bounds);
+				right_count += bins[i].count;
+				right_costs[i - 1u] = (right_count > 0u ? surface_area(right_bounds) * float(right_count) : 0.0f);
+			}
+			bboxf left_bounds;
+			uint32_t left_count = 0u;
+			float best_cost = ext::limits<float>::max;
+			uint32_t best_split = 0u;
+			for (uint32_t i = 0; i < sah_bin_count - 1u; ++i) {
+				left_bounds.extend(bins[i].bounds);
+				left_count += bins[i].count;
+				if (left_count == 0u || left_count == count) {
+					continue;
+				}
+				if (const auto cost = surface_area(left_bounds) * float(left_count) + right_costs[i]; cost < best_cost) {
+					best_cost = cost;
+					best_split = i;
+				}
+			}
+			if (best_cost < ext::limits<float>::max) {
+				mid = uint32_t(std::partition(begin_iter, end_iter, [&](const uint32_t prim_idx) {
+					return (bin_index(prim_idx) <= best_split);
+				}) - prim_indices.begin());
+			}
+		}
+		if (mid == task.begin || mid == task.end) {
+			// no meaningful split possible (e.g. all centroids are equal) -> split at the median
+			mid = task.begin + count / 2u;
+			std::nth_element(begin_iter, prim_indices.begin() + mid, end_iter, [&](const uint32_t lhs, const uint32_t rhs) {
+				return (centroids[lhs][axis] < centroids[rhs][axis]);
+			});
+		}
+		
+		const auto left = uint32_t(build_nodes.size());
+		build_nodes.emplace_back();
+		build_nodes.emplace_back();
+		build_nodes[task.node].left = left;
+		build_nodes[task.node].right = left + 1u;
+		tasks.emplace_back(build_task_t { left + 1u, mid, task.end, task.depth + 1u });
+		tasks.emplace_back(build_task_t { left, task.begin, mid, task.depth + 1u });
+	}
+	
+	// collapse the binary tree into a 4-wide tree:
+	// the children of each wide node are gathered by repeatedly opening the inner child with the largest surface area
+	nodes.reserve(build_nodes.size() / 2u + 1u);
+	nodes.emplace_back();
+	std::vector<std::pair<uint32_t, uint32_t>> collapse_tasks { { 0u, 0u } };
+	while (!collapse_tasks.empty()) {
+		const auto [build_idx, node_idx] = collapse_tasks.back();
+		collapse_tasks.pop_back();
+		
+		std::array<uint32_t, node_width> children {};
+		uint32_t child_count = 0u;
+		if (build_nodes[build_idx].is_leaf()) {
+			// only happens for the root node
+			children[child_count++] = build_idx;
+		} else {
+			children[child_count++] = build_nodes[build_idx].left;
+			children[child_count++] = build_nodes[build_idx].right;
+			while (child_count < node_width) {
+				uint32_t open_idx = invalid_index;
+				float max_area = -1.0f;
+				for (uint32_t i = 0; i < child_count; ++i) {
+					const auto& child = build_nodes[children[i]];
+					if (const auto area = surface_area(child.bounds); !child.is_leaf() && area > max_area) {
+						max_area = area;
+						open_idx = i;
+					}
+				}
+				if (open_idx == invalid_index) {
+					break;
+				}
+				const auto& opened = build_nodes[children[open_idx]];
+				children[open_idx] = opened.left;
+				children[child_count++] = opened.right;
+			}
+		}
+		
+		node_t node;
+		for (uint32_t i = 0; i < node_width; ++i) {
+			// NOTE: unused children get the bounds of the first child, these are never hit due to "child_mask"
+			const auto& child = build_nodes[children[i < child_count ? i : 0u]];
+			node.child_bounds.set(i, child.bounds);
+			if (i >= child_count) {
+				continue;
+			}
+			node.child_mask |= 1u << i;
+			if (child.is_leaf()) {
+				node.child_index[i] = child.prim_offset;
+				node.child_prim_count[i] = child.prim_count;
+			} else {
+				node.child_index[i] = uint32_t(nodes.size());
+				nodes.emplace_back();
+				collapse_tasks.emplace_back(children[i], node.child_index[i]);
+			}
+		}
+		nodes[node_idx] = node;
+	}
+}
+
+} // namespace fl
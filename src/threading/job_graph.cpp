@@ -0,0 +1,217 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/threading/job_graph.hpp>
+#include <floor/threading/thread_helpers.hpp>
+#include <floor/core/logger.hpp>
+#include <stdexcept>
+
+namespace fl {
+
+job_graph::job_graph(const std::string name_, const uint32_t max_concurrency_) :
+name(name_), max_concurrency(max_concurrency_ > 0u ? max_concurrency_ : std::max(get_logical_core_count(), 1u)) {}
+
+job_graph::~job_graph() {
+	bool has_started = false;
+	{
+		std::unique_lock<std::mutex> lock_guard(jobs_lock);
+		has_started = started;
+	}
+	if (has_started) {
+		(void)wait();
+	}
+}
+
+job_graph::job_id job_graph::add_job(job_func_t op, const std::vector<job_id>& dependencies) {
+	std::unique_lock<std::mutex> lock_guard(jobs_lock);
+	if (started) {
+		throw std::runtime_error("can't add jobs to an already started job graph");
+	}
+
+	const auto id = job_id(jobs.size());
+	auto job = std::make_unique<job_t>();
+	job->op = std::move(op);
+	job->result_future = job->result.get_future().share();
+	for (const auto& dep : dependencies) {
+		// NOTE: only allowing dependencies on already added jobs ensures that the graph is always acyclic
+		if (dep >= id) {
+			throw std::runtime_error("invalid job dependency: " + std::to_string(dep));
+		}
+		jobs[dep]->dependents.emplace_back(id);
+		++job->unresolved_dependency_count;
+	}
+	jobs.emplace_back(std::move(job));
+	return id;
+}
+
+bool job_graph::execute() {
+	std::unique_lock<std::mutex> lock_guard(jobs_lock);
+	if (started) {
+		return false;
+	}
+	started = true;
+
+	const auto job_count = uint32_t(jobs.size());
+	completion_latch = std::make_unique<std::latch>(job_count);
+	if (job_count == 0) {
+		return true;
+	}
+	if (cancelled) {
+		// cancelled before execution -> don't start anything
+		cancel_pending_jobs();
+		return true;
+	}
+
+	for (job_id id = 0; id < job_count; ++id) {
+		if (jobs[id]->unresolved_dependency_count == 0u) {
+			ready_queue.emplace_back(id);
+		}
+	}
+
+	const auto worker_count = std::min(max_concurrency, job_count);
+	workers.reserve(worker_count);
+	for (uint32_t i = 0; i < worker_count; ++i) {
+		workers.emplace_back(&job_graph::worker_run, this, i);
+	}
+	return true;
+}
+
+bool job_graph::wait() {
+	std::vector<std::thread> joinable_workers;
+	{
+		std::unique_lock<std::mutex> lock_guard(jobs_lock);
+		if (!started) {
+			return false;
+		}
+		joinable_workers = std::move(workers);
+		workers.clear();
+	}
+
+	completion_latch->wait();
+	for (auto& worker : joinable_workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+	return !failed && !cancelled;
+}
+
+void job_graph::cancel() {
+	{
+		std::unique_lock<std::mutex> lock_guard(jobs_lock);
+		if (started && finished_job_count == uint32_t(jobs.size())) {
+			// all jobs have already completed -> nothing to cancel, don't change the result
+			return;
+		}
+		cancel_pending_jobs();
+	}
+	jobs_cv.notify_all();
+}
+
+std::shared_future<bool> job_graph::get_future(const job_id id) const {
+	std::unique_lock<std::mutex> lock_guard(jobs_lock);
+	return jobs.at(id)->result_future;
+}
+
+job_graph::JOB_STATUS job_graph::get_job_status(const job_id id) const {
+	std::unique_lock<std::mutex> lock_guard(jobs_lock);
+	return jobs.at(id)->status;
+}
+
+uint32_t job_graph::get_job_count() const {
+	std::unique_lock<std::mutex> lock_guard(jobs_lock);
+	return uint32_t(jobs.size());
+}
+
+void job_graph::worker_run(const uint32_t worker_idx) {
+	set_current_thread_name(name + "_" + std::to_string(worker_idx));
+
+	const auto job_count = uint32_t(jobs.size());
+	for (;;) {
+		job_t* job = nullptr;
+		{
+			std::unique_lock<std::mutex> lock_guard(jobs_lock);
+			jobs_cv.wait(lock_guard, [this, &job_count] {
+				return (!ready_queue.empty() || finished_job_count == job_count);
+			});
+			if (ready_queue.empty()) {
+				// all done
+				return;
+			}
+			job = jobs[ready_queue.front()].get();
+			ready_queue.pop_front();
+			job->status = JOB_STATUS::RUNNING;
+		}
+
+		bool success = false;
+		try {
+			success = job->op();
+		} catch (std::exception& exc) {
+			log_error("encountered an unhandled exception while running job in \"$\": $", get_current_thread_name(), exc.what());
+		} catch (...) {
+			log_error("encountered an unhandled exception while running job in \"$\"", get_current_thread_name());
+		}
+
+		{
+			std::unique_lock<std::mutex> lock_guard(jobs_lock);
+			finish_job(*job, success);
+		}
+		// NOTE: either new jobs are ready, all jobs have finished or everything has been cancelled -> always wake up all
+		jobs_cv.notify_all();
+	}
+}
+
+void job_graph::finish_job(job_t& job, const bool success) {
+	job.status = (success ? JOB_STATUS::SUCCEEDED : JOB_STATUS::FAILED);
+	job.result.set_value(success);
+	++finished_job_count;
+	completion_latch->count_down();
+
+	if (!success) {
+		failed = true;
+		cancel_pending_jobs();
+		return;
+	}
+
+	// schedule dependents that are now ready in front of all other ready jobs
+	for (auto dep_iter = job.dependents.rbegin(); dep_iter != job.dependents.rend(); ++dep_iter) {
+		auto& dep_job = *jobs[*dep_iter];
+		if (--dep_job.unresolved_dependency_count == 0u && dep_job.status == JOB_STATUS::PENDING) {
+			ready_queue.emplace_front(*dep_iter);
+		}
+	}
+}
+
+void job_graph::cancel_pending_jobs() {
+	cancelled = true;
+	ready_queue.clear();
+	if (!started) {
+		// nothing has been set up yet, jobs will be cancelled in execute()
+		return;
+	}
+	for (auto& job : jobs) {
+		if (job->status == JOB_STATUS::PENDING) {
+			job->status = JOB_STATUS::CANCELLED;
+			job->result.set_value(false);
+			++finished_job_count;
+			completion_latch->count_down();
+		}
+	}
+}
+
+} // namespace fl
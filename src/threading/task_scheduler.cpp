@@ -0,0 +1,236 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <floor/threading/task_scheduler.hpp>
+#include <floor/threading/thread_helpers.hpp>
+
+namespace fl {
+
+//! scheduler of the current worker thread (nullptr if this isn't a worker thread)
+static thread_local const task_scheduler* current_scheduler { nullptr };
+//! index of the current worker thread in "current_scheduler"
+static thread_local uint32_t current_worker_idx { ~0u };
+
+void task_state_base::wait() {
+	if (is_done()) {
+		return;
+	}
+	
+	const auto worker_idx = scheduler.get_current_worker_index();
+	if (worker_idx == ~0u) {
+		// not a worker thread of the scheduler -> simply block
+		done.wait(false, std::memory_order_acquire);
+		return;
+	}
+	
+	// worker thread: execute other tasks while waiting (this task may depend on these),
+	// only sleep when there is nothing else to do
+	// NOTE: the worker waiter count signals execute() that sleeping workers must be woken up once this task is done
+	worker_waiter_count.fetch_add(1u);
+	while (!done.load()) {
+		scheduler.run_one_or_sleep(worker_idx, [this]() {
+			return done.load();
+		});
+	}
+	worker_waiter_count.fetch_sub(1u);
+}
+
+void task_state_base::execute() {
+	try {
+		run();
+	} catch (...) {
+		exception = std::current_exception();
+	}
+	
+	std::vector<std::shared_ptr<task_state_base>> scheduled_continuations;
+	{
+		GUARD(continuations_lock);
+		scheduled_continuations.swap(continuations);
+		done.store(true);
+	}
+	done.notify_all();
+	if (worker_waiter_count.load() > 0u) {
+		scheduler.wake_all();
+	}
+	
+	for (auto& continuation : scheduled_continuations) {
+		auto& cont_scheduler = continuation->scheduler;
+		cont_scheduler.schedule(std::move(continuation));
+	}
+}
+
+void task_state_base::add_continuation(std::shared_ptr<task_state_base> continuation) {
+	{
+		GUARD(continuations_lock);
+		if (!done.load()) {
+			continuations.emplace_back(std::move(continuation));
+			return;
+		}
+	}
+	// already done -> schedule now
+	auto& cont_scheduler = continuation->scheduler;
+	cont_scheduler.schedule(std::move(continuation));
+}
+
+task_scheduler& task_scheduler::get() {
+	static task_scheduler global_scheduler;
+	return global_scheduler;
+}
+
+task_scheduler::task_scheduler(const std::string name_, const uint32_t worker_count_) :
+name(name_), worker_count(worker_count_ > 0u ? worker_count_ : std::max(get_logical_core_count(), 1u)),
+workers(std::make_unique<worker_t[]>(worker_count)) {
+	for (uint32_t i = 0; i < worker_count; ++i) {
+		workers[i].thread = std::thread(&task_scheduler::worker_run, this, i);
+	}
+}
+
+task_scheduler::~task_scheduler() {
+	stop = true;
+	wake_all();
+	for (uint32_t i = 0; i < worker_count; ++i) {
+		if (workers[i].thread.joinable()) {
+			workers[i].thread.join();
+		}
+	}
+}
+
+bool task_scheduler::is_worker_thread() const {
+	return (current_scheduler == this);
+}
+
+uint32_t task_scheduler::get_current_worker_index() const {
+	return (current_scheduler == this ? current_worker_idx : ~0u);
+}
+
+void task_scheduler::schedule(std::shared_ptr<task_state_base> task) {
+	if (const auto worker_idx = get_current_worker_index(); worker_idx != ~0u) {
+		auto& worker = workers[worker_idx];
+		GUARD(worker.queue_lock);
+		worker.queue.emplace_back(std::move(task));
+	} else {
+		GUARD(global_queue_lock);
+		global_queue.emplace_back(std::move(task));
+	}
+	wake_one();
+}
+
+void task_scheduler::wake_one() {
+	// NOTE: only increment + notify if anyone is actually sleeping (avoids the syscall in the common case)
+	if (sleeping_worker_count.load() > 0u) {
+		wake_epoch.fetch_add(1u);
+		wake_epoch.notify_one();
+	}
+}
+
+void task_scheduler::wake_all() {
+	wake_epoch.fetch_add(1u);
+	wake_epoch.notify_all();
+}
+
+std::shared_ptr<task_state_base> task_scheduler::find_task(const uint32_t worker_idx) {
+	// own tasks first (LIFO -> most recently spawned tasks are most likely still in cache)
+	if (worker_idx != ~0u) {
+		auto& worker = workers[worker_idx];
+		GUARD(worker.queue_lock);
+		if (!worker.queue.empty()) {
+			auto task = std::move(worker.queue.back());
+			worker.queue.pop_back();
+			return task;
+		}
+	}
+	// then tasks that have been spawned from outside
+	{
+		GUARD(global_queue_lock);
+		if (!global_queue.empty()) {
+			auto task = std::move(global_queue.front());
+			global_queue.pop_front();
+			return task;
+		}
+	}
+	// finally: steal the oldest task of another worker
+	const auto start_idx = (worker_idx != ~0u ? worker_idx + 1u : 0u);
+	for (uint32_t i = 0; i < worker_count; ++i) {
+		const auto victim_idx = (start_idx + i) % worker_count;
+		if (victim_idx == worker_idx) {
+			continue;
+		}
+		auto& victim = workers[victim_idx];
+		GUARD(victim.queue_lock);
+		if (!victim.queue.empty()) {
+			auto task = std::move(victim.queue.front());
+			victim.queue.pop_front();
+			return task;
+		}
+	}
+	return {};
+}
+
+bool task_scheduler::try_run_one() {
+	if (auto task = find_task(get_current_worker_index()); task) {
+		task->execute();
+		return true;
+	}
+	return false;
+}
+
+void task_scheduler::worker_run(const uint32_t worker_idx) {
+	current_scheduler = this;
+	current_worker_idx = worker_idx;
+	set_current_thread_name(name + "_" + std::to_string(worker_idx));
+	
+	while (!stop.load()) {
+		run_one_or_sleep(worker_idx, [this]() {
+			return stop.load();
+		});
+	}
+}
+
+task_group::~task_group() {
+	try {
+		wait();
+	} catch (...) {
+		// ignore
+	}
+}
+
+void task_group::wait() {
+	std::exception_ptr exception;
+	for (;;) {
+		// NOTE: tasks may add further tasks to this group while we're waiting
+		std::vector<std::shared_ptr<task_state_base>> waiting_tasks;
+		{
+			GUARD(tasks_lock);
+			if (tasks.empty()) {
+				break;
+			}
+			waiting_tasks.swap(tasks);
+		}
+		for (const auto& task : waiting_tasks) {
+			task->wait();
+			if (!exception) {
+				exception = task->get_exception();
+			}
+		}
+	}
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+} // namespace fl
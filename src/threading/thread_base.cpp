@@ -39,32 +39,47 @@ void thread_base::start() {
 		return;
 	}
 	
-	thread_status = THREAD_STATUS::RUNNING;
+	{
+		std::unique_lock<std::mutex> wakeup_lock_guard(wakeup_lock);
+		thread_status = THREAD_STATUS::RUNNING;
+	}
+	wakeup_cv.notify_all();
 }
 
 int thread_base::_thread_run(thread_base* this_thread_obj) {
 	set_current_thread_name(this_thread_obj->thread_name);
 	
 	// wait until start() was called
-	while (this_thread_obj->thread_status != THREAD_STATUS::RUNNING &&
-		   !this_thread_obj->thread_should_finish()) {
-		std::this_thread::sleep_for(20ms);
+	{
+		std::unique_lock<std::mutex> wakeup_lock_guard(this_thread_obj->wakeup_lock);
+		this_thread_obj->wakeup_cv.wait(wakeup_lock_guard, [this_thread_obj] {
+			return (this_thread_obj->thread_status == THREAD_STATUS::RUNNING || this_thread_obj->thread_should_finish());
+		});
 	}
 	
-	// dummy lock for CV waiting
-	std::mutex cv_mtx;
-	
 	// if the "finish flag" has been set in the mean time, don't rerun
 	while (!this_thread_obj->thread_should_finish()) {
+		// in wakeup-driven mode: sleep until woken up or the delay/timeout has elapsed
+		if (this_thread_obj->is_wakeup_driven()) {
+			this_thread_obj->wait_for_wakeup(this_thread_obj->get_thread_delay());
+			if (this_thread_obj->thread_should_finish()) {
+				break;
+			}
+		}
+		
 		// pause/halt thread if set
 		if (this_thread_obj->thread_pause) {
 			this_thread_obj->set_thread_status(THREAD_STATUS::PAUSED);
-			while (this_thread_obj->thread_pause) {
-				std::unique_lock<std::mutex> pause_lock_guard(cv_mtx);
-				// NOTE: timeout after 5s so that we don't have an infinite loop
-				(void)this_thread_obj->pause_cv.wait_for(pause_lock_guard, 5s);
+			{
+				std::unique_lock<std::mutex> wakeup_lock_guard(this_thread_obj->wakeup_lock);
+				this_thread_obj->wakeup_cv.wait(wakeup_lock_guard, [this_thread_obj] {
+					return (!this_thread_obj->thread_pause || this_thread_obj->thread_should_finish());
+				});
 			}
 			this_thread_obj->set_thread_status(THREAD_STATUS::RUNNING);
+			if (this_thread_obj->thread_should_finish()) {
+				break;
+			}
 		}
 		
 		// run
@@ -79,13 +94,12 @@ int thread_base::_thread_run(thread_base* this_thread_obj) {
 		}
 		
 		// again: if the "finish flag" has been set, don't wait, but continue immediately
-		if (!this_thread_obj->thread_should_finish()) {
+		if (!this_thread_obj->thread_should_finish() && !this_thread_obj->is_wakeup_driven()) {
 			// reduce system load and make other locks possible
 			const size_t thread_delay = this_thread_obj->get_thread_delay();
 			if (thread_delay > 0) {
-				// wait on a CV rather than a simple sleep_for, so that we can quickly abort threads with a long delay
-				std::unique_lock<std::mutex> delay_lock_guard(cv_mtx);
-				(void)this_thread_obj->delay_cv.wait_for(delay_lock_guard, std::chrono::milliseconds(thread_delay));
+				// wait rather than a simple sleep_for, so that we can quickly abort threads with a long delay
+				this_thread_obj->wait_for_wakeup(thread_delay);
 			} else {
 				if (this_thread_obj->get_yield_after_run()) {
 					// just yield when delay == 0 and "yield after run" flag is set
@@ -99,27 +113,51 @@ int thread_base::_thread_run(thread_base* this_thread_obj) {
 	return 0;
 }
 
+void thread_base::wait_for_wakeup(const size_t timeout_ms) {
+	std::unique_lock<std::mutex> wakeup_lock_guard(wakeup_lock);
+	const auto wakeup_pred = [this] {
+		return (wakeup_signaled || thread_should_finish());
+	};
+	if (timeout_ms > 0) {
+		(void)wakeup_cv.wait_for(wakeup_lock_guard, std::chrono::milliseconds(timeout_ms), wakeup_pred);
+	} else {
+		wakeup_cv.wait(wakeup_lock_guard, wakeup_pred);
+	}
+	wakeup_signaled = false;
+}
+
+void thread_base::wakeup() {
+	{
+		std::unique_lock<std::mutex> wakeup_lock_guard(wakeup_lock);
+		if (wakeup_signaled) {
+			// already signaled, but not woken up yet
+			return;
+		}
+		wakeup_signaled = true;
+	}
+	wakeup_cv.notify_all();
+}
+
 void thread_base::pause() {
 	thread_pause = true;
 }
 
 void thread_base::unpause() {
-	thread_pause = false;
-	pause_cv.notify_one();
+	{
+		std::unique_lock<std::mutex> wakeup_lock_guard(wakeup_lock);
+		thread_pause = false;
+	}
+	wakeup_cv.notify_all();
 }
 
 void thread_base::finish() {
 	if (thread_obj != nullptr) {
-		if ((get_thread_status() == THREAD_STATUS::FINISHED && !thread_obj->joinable()) ||
-			get_thread_status() == THREAD_STATUS::INIT) {
-			// already finished or uninitialized, nothing to do here
+		if (get_thread_status() == THREAD_STATUS::FINISHED && !thread_obj->joinable()) {
+			// already finished, nothing to do here
 		} else {
-			// signal thread to finish
+			// signal thread to finish (this also wakes it up if it is sleeping, paused or hasn't been started yet)
 			set_thread_should_finish();
 			
-			// ensure thread is unpaused
-			unpause();
-			
 			// this will block until the thread is finished
 			if (thread_obj->joinable()) {
 				thread_obj->join();
@@ -149,9 +187,12 @@ bool thread_base::is_running() const {
 }
 
 void thread_base::set_thread_should_finish() {
-	thread_should_finish_flag = true;
-	// wake up if thread is sleeping in delay
-	delay_cv.notify_one();
+	{
+		std::unique_lock<std::mutex> wakeup_lock_guard(wakeup_lock);
+		thread_should_finish_flag = true;
+	}
+	// wake up if thread is sleeping (delay, wakeup-driven, paused or not started yet)
+	wakeup_cv.notify_all();
 }
 
 bool thread_base::thread_should_finish() {
@@ -174,6 +215,14 @@ bool thread_base::get_yield_after_run() const {
 	return yield_after_run;
 }
 
+void thread_base::set_wakeup_driven(const bool state) {
+	wakeup_driven = state;
+}
+
+bool thread_base::is_wakeup_driven() const {
+	return wakeup_driven;
+}
+
 const std::string& thread_base::get_thread_name() const {
 	return thread_name;
 }
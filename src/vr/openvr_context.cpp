@@ -394,46 +394,46 @@ std::vector<std::shared_ptr<event_object>> openvr_context::handle_input() REQUIR
 					if (data.bActive && data.bChanged) {
 						switch (action.second.event_type) {
 							case EVENT_TYPE::VR_APP_MENU_PRESS:
-								events.emplace_back(std::make_shared<vr_app_menu_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_app_menu_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_APP_MENU_TOUCH:
-								events.emplace_back(std::make_shared<vr_app_menu_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_app_menu_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_MAIN_PRESS:
-								events.emplace_back(std::make_shared<vr_main_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_main_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_MAIN_TOUCH:
-								events.emplace_back(std::make_shared<vr_main_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_main_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_SYSTEM_PRESS:
-								events.emplace_back(std::make_shared<vr_system_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_system_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_SYSTEM_TOUCH:
-								events.emplace_back(std::make_shared<vr_system_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_system_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_TRACKPAD_PRESS:
-								events.emplace_back(std::make_shared<vr_trackpad_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_trackpad_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_TRACKPAD_TOUCH:
-								events.emplace_back(std::make_shared<vr_trackpad_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_trackpad_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_THUMBSTICK_PRESS:
-								events.emplace_back(std::make_shared<vr_thumbstick_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_thumbstick_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_THUMBSTICK_TOUCH:
-								events.emplace_back(std::make_shared<vr_thumbstick_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_thumbstick_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_TRIGGER_PRESS:
-								events.emplace_back(std::make_shared<vr_trigger_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_trigger_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_TRIGGER_TOUCH:
-								events.emplace_back(std::make_shared<vr_trigger_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_trigger_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_GRIP_PRESS:
-								events.emplace_back(std::make_shared<vr_grip_press_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_grip_press_event>(cur_time, action.second.side, data.bState));
 								break;
 							case EVENT_TYPE::VR_GRIP_TOUCH:
-								events.emplace_back(std::make_shared<vr_grip_touch_event>(cur_time, action.second.side, data.bState));
+								events.emplace_back(make_event<vr_grip_touch_event>(cur_time, action.second.side, data.bState));
 								break;
 							default:
 								log_error("unknown/unhandled VR event: $", action.first);
@@ -452,26 +452,26 @@ std::vector<std::shared_ptr<event_object>> openvr_context::handle_input() REQUIR
 					if (data.bActive && (data.deltaX != 0.0f || data.deltaY != 0.0f || data.deltaZ != 0.0f)) {
 						switch (action.second.event_type) {
 							case EVENT_TYPE::VR_TRACKPAD_MOVE:
-								events.emplace_back(std::make_shared<vr_trackpad_move_event>(cur_time, action.second.side,
+								events.emplace_back(make_event<vr_trackpad_move_event>(cur_time, action.second.side,
 																						float2{ data.x, data.y },
 																						float2{ data.deltaX, data.deltaY }));
 								break;
 							case EVENT_TYPE::VR_THUMBSTICK_MOVE:
-								events.emplace_back(std::make_shared<vr_thumbstick_move_event>(cur_time, action.second.side,
+								events.emplace_back(make_event<vr_thumbstick_move_event>(cur_time, action.second.side,
 																						  float2{ data.x, data.y },
 																						  float2{ data.deltaX, data.deltaY }));
 								break;
 							case EVENT_TYPE::VR_TRIGGER_PULL:
-								events.emplace_back(std::make_shared<vr_trigger_pull_event>(cur_time, action.second.side, data.x, data.deltaX));
+								events.emplace_back(make_event<vr_trigger_pull_event>(cur_time, action.second.side, data.x, data.deltaX));
 								break;
 							case EVENT_TYPE::VR_GRIP_PULL:
-								events.emplace_back(std::make_shared<vr_grip_pull_event>(cur_time, action.second.side, data.x, data.deltaX));
+								events.emplace_back(make_event<vr_grip_pull_event>(cur_time, action.second.side, data.x, data.deltaX));
 								break;
 							case EVENT_TYPE::VR_TRACKPAD_FORCE:
-								events.emplace_back(std::make_shared<vr_trackpad_force_event>(cur_time, action.second.side, data.x, data.deltaX));
+								events.emplace_back(make_event<vr_trackpad_force_event>(cur_time, action.second.side, data.x, data.deltaX));
 								break;
 							case EVENT_TYPE::VR_GRIP_FORCE:
-								events.emplace_back(std::make_shared<vr_grip_force_event>(cur_time, action.second.side, data.x, data.deltaX));
+								events.emplace_back(make_event<vr_grip_force_event>(cur_time, action.second.side, data.x, data.deltaX));
 								break;
 							default:
 								log_error("unknown/unhandled VR event: $", action.first);
@@ -1178,52 +1178,52 @@ void openxr_context::add_hand_bool_event(std::vector<std::shared_ptr<event_objec
 	const auto cur_time = convert_time_to_ticks(state.lastChangeTime);
 	switch (event_type) {
 		case EVENT_TYPE::VR_SYSTEM_PRESS:
-			events.emplace_back(std::make_shared<vr_system_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_system_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_SYSTEM_TOUCH:
-			events.emplace_back(std::make_shared<vr_system_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_system_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_MAIN_PRESS:
-			events.emplace_back(std::make_shared<vr_main_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_main_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_MAIN_TOUCH:
-			events.emplace_back(std::make_shared<vr_main_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_main_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_APP_MENU_PRESS:
-			events.emplace_back(std::make_shared<vr_app_menu_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_app_menu_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_APP_MENU_TOUCH:
-			events.emplace_back(std::make_shared<vr_app_menu_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_app_menu_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_GRIP_PRESS:
-			events.emplace_back(std::make_shared<vr_grip_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_grip_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_GRIP_TOUCH:
-			events.emplace_back(std::make_shared<vr_grip_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_grip_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_TRIGGER_PRESS:
-			events.emplace_back(std::make_shared<vr_trigger_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_trigger_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_TRIGGER_TOUCH:
-			events.emplace_back(std::make_shared<vr_trigger_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_trigger_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_THUMBSTICK_PRESS:
-			events.emplace_back(std::make_shared<vr_thumbstick_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_thumbstick_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_THUMBSTICK_TOUCH:
-			events.emplace_back(std::make_shared<vr_thumbstick_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_thumbstick_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_TRACKPAD_PRESS:
-			events.emplace_back(std::make_shared<vr_trackpad_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_trackpad_press_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_TRACKPAD_TOUCH:
-			events.emplace_back(std::make_shared<vr_trackpad_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_trackpad_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_THUMBREST_TOUCH:
-			events.emplace_back(std::make_shared<vr_thumbrest_touch_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_thumbrest_touch_event>(cur_time, side, state.currentState));
 			break;
 		case EVENT_TYPE::VR_SHOULDER_PRESS:
-			events.emplace_back(std::make_shared<vr_shoulder_press_event>(cur_time, side, state.currentState));
+			events.emplace_back(make_event<vr_shoulder_press_event>(cur_time, side, state.currentState));
 			break;
 		default:
 			log_error("unknown/unhandled VR event: $", event_type);
@@ -1240,47 +1240,47 @@ void openxr_context::add_hand_float_event(std::vector<std::shared_ptr<event_obje
 	const auto& emulate = hand_input_emulation[!side ? 0 : 1];
 	switch (event_type) {
 		case EVENT_TYPE::VR_TRIGGER_PULL:
-			events.emplace_back(std::make_shared<vr_trigger_pull_event>(cur_time, side, state.currentState, delta));
+			events.emplace_back(make_event<vr_trigger_pull_event>(cur_time, side, state.currentState, delta));
 			if (emulate.trigger_press) {
 				if (prev_state.f < emulation_trigger_force && cur_state >= emulation_trigger_force) {
-					events.emplace_back(std::make_shared<vr_trigger_press_event>(cur_time, side, true));
+					events.emplace_back(make_event<vr_trigger_press_event>(cur_time, side, true));
 				} else if (prev_state.f >= emulation_trigger_force && cur_state < emulation_trigger_force) {
-					events.emplace_back(std::make_shared<vr_trigger_press_event>(cur_time, side, false));
+					events.emplace_back(make_event<vr_trigger_press_event>(cur_time, side, false));
 				}
 			}
 			break;
 		case EVENT_TYPE::VR_GRIP_PULL:
-			events.emplace_back(std::make_shared<vr_grip_pull_event>(cur_time, side, state.currentState, delta));
+			events.emplace_back(make_event<vr_grip_pull_event>(cur_time, side, state.currentState, delta));
 			if (emulate.grip_touch) {
 				if (prev_state.f == 0.0f && cur_state > 0.0f) {
-					events.emplace_back(std::make_shared<vr_grip_touch_event>(cur_time, side, true));
+					events.emplace_back(make_event<vr_grip_touch_event>(cur_time, side, true));
 				} else if (prev_state.f > 0.0f && cur_state == 0.0f) {
-					events.emplace_back(std::make_shared<vr_grip_touch_event>(cur_time, side, false));
+					events.emplace_back(make_event<vr_grip_touch_event>(cur_time, side, false));
 				}
 			}
 			break;
 		case EVENT_TYPE::VR_GRIP_FORCE:
-			events.emplace_back(std::make_shared<vr_grip_force_event>(cur_time, side, state.currentState, delta));
+			events.emplace_back(make_event<vr_grip_force_event>(cur_time, side, state.currentState, delta));
 			if (emulate.grip_press) {
 				if (prev_state.f < emulation_trigger_force && cur_state >= emulation_trigger_force) {
-					events.emplace_back(std::make_shared<vr_grip_press_event>(cur_time, side, true));
+					events.emplace_back(make_event<vr_grip_press_event>(cur_time, side, true));
 				} else if (prev_state.f >= emulation_trigger_force && cur_state < emulation_trigger_force) {
-					events.emplace_back(std::make_shared<vr_grip_press_event>(cur_time, side, false));
+					events.emplace_back(make_event<vr_grip_press_event>(cur_time, side, false));
 				}
 			}
 			break;
 		case EVENT_TYPE::VR_TRACKPAD_FORCE:
-			events.emplace_back(std::make_shared<vr_trackpad_force_event>(cur_time, side, state.currentState, delta));
+			events.emplace_back(make_event<vr_trackpad_force_event>(cur_time, side, state.currentState, delta));
 			if (emulate.trackpad_press) {
 				if (prev_state.f < emulation_trigger_force && cur_state >= emulation_trigger_force) {
-					events.emplace_back(std::make_shared<vr_trackpad_press_event>(cur_time, side, true));
+					events.emplace_back(make_event<vr_trackpad_press_event>(cur_time, side, true));
 				} else if (prev_state.f >= emulation_trigger_force && cur_state < emulation_trigger_force) {
-					events.emplace_back(std::make_shared<vr_trackpad_press_event>(cur_time, side, false));
+					events.emplace_back(make_event<vr_trackpad_press_event>(cur_time, side, false));
 				}
 			}
 			break;
 		case EVENT_TYPE::VR_THUMBREST_FORCE:
-			events.emplace_back(std::make_shared<vr_thumbrest_force_event>(cur_time, side, state.currentState, delta));
+			events.emplace_back(make_event<vr_thumbrest_force_event>(cur_time, side, state.currentState, delta));
 			break;
 		default:
 			log_error("unknown/unhandled VR event: $", event_type);
@@ -1297,10 +1297,10 @@ void openxr_context::add_hand_float2_event(std::vector<std::shared_ptr<event_obj
 	const auto delta = cur_state - prev_state.f2;
 	switch (event_type) {
 		case EVENT_TYPE::VR_TRACKPAD_MOVE:
-			events.emplace_back(std::make_shared<vr_trackpad_move_event>(cur_time, side, cur_state, delta));
+			events.emplace_back(make_event<vr_trackpad_move_event>(cur_time, side, cur_state, delta));
 			break;
 		case EVENT_TYPE::VR_THUMBSTICK_MOVE:
-			events.emplace_back(std::make_shared<vr_thumbstick_move_event>(cur_time, side, cur_state, delta));
+			events.emplace_back(make_event<vr_thumbstick_move_event>(cur_time, side, cur_state, delta));
 			break;
 		default:
 			log_error("unknown/unhandled VR event: $", event_type);
@@ -0,0 +1,111 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/threading/atomic_shared_ptr.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <latch>
+#include <vector>
+#include <string>
+#include <version>
+
+using namespace fl;
+using namespace std::literals;
+
+//! mutex-protected shared_ptr (-> lock-based baseline)
+template <typename T>
+struct locked_shared_ptr {
+	mutable std::mutex mtx;
+	std::shared_ptr<T> sptr;
+	
+	explicit locked_shared_ptr(std::shared_ptr<T> sptr_) : sptr(std::move(sptr_)) {}
+	std::shared_ptr<T> load() const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return sptr;
+	}
+	void store(std::shared_ptr<T> new_sptr) {
+		std::lock_guard<std::mutex> lock(mtx);
+		sptr.swap(new_sptr);
+	}
+};
+
+static constexpr const uint32_t ops_per_thread { 200'000u };
+
+//! runs "thread_count" threads that each perform "ops_per_thread" loads, with every "store_interval"th op being a store instead
+//! (0 = loads only), returns the wall time in nanoseconds
+template <typename ptr_type>
+static double bench_contention(const uint32_t thread_count, const uint32_t store_interval) {
+	ptr_type ptr { std::make_shared<uint64_t>(1u) };
+	// pre-allocate all stored objects, so that we don't measure make_shared
+	std::vector<std::vector<std::shared_ptr<uint64_t>>> store_objects(thread_count);
+	if (store_interval > 0u) {
+		for (auto& objects : store_objects) {
+			for (uint32_t i = 0; i < ops_per_thread / store_interval; ++i) {
+				objects.emplace_back(std::make_shared<uint64_t>(i));
+			}
+		}
+	}
+	return test::benchmark([&ptr, &store_objects, thread_count, store_interval] {
+		std::latch start_latch { thread_count };
+		std::vector<std::thread> threads;
+		for (uint32_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+			threads.emplace_back([&ptr, &store_objects, &start_latch, thread_idx, store_interval] {
+				start_latch.arrive_and_wait();
+				uint64_t sum = 0u;
+				uint32_t store_idx = 0u;
+				for (uint32_t i = 0; i < ops_per_thread; ++i) {
+					if (store_interval > 0u && (i % store_interval) == 0u && store_idx < store_objects[thread_idx].size()) {
+						ptr.store(store_objects[thread_idx][store_idx++]);
+					} else {
+						sum += *ptr.load();
+					}
+				}
+				test::do_not_optimize(sum);
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+	}, 5u);
+}
+
+template <typename ptr_type>
+static double run_bench(const std::string& name, const uint32_t thread_count, const uint32_t store_interval, const double baseline_ns) {
+	const auto ns = bench_contention<ptr_type>(thread_count, store_interval);
+	test::print_benchmark(name, ns, uint64_t(thread_count) * ops_per_thread, 0u, baseline_ns);
+	return ns;
+}
+
+int main(int, char**) {
+	std::printf("atomic_shared_ptr under contention (wall time per op over all threads, speedup relative to the mutex baseline):\n");
+	const auto max_thread_count = std::max(std::thread::hardware_concurrency(), 2u);
+	for (const uint32_t store_interval : { 0u, 10u }) {
+		for (uint32_t thread_count = 1u; thread_count <= max_thread_count; thread_count *= 2u) {
+			std::printf("%u thread(s), %s:\n", thread_count, (store_interval == 0u ? "loads only" : "90% loads / 10% stores"));
+			const auto baseline = run_bench<locked_shared_ptr<uint64_t>>("  mutex + std::shared_ptr", thread_count, store_interval, 0.0);
+			run_bench<atomic_shared_ptr<uint64_t>>("  fl::atomic_shared_ptr", thread_count, store_interval, baseline);
+#if defined(__cpp_lib_atomic_shared_ptr)
+			run_bench<std::atomic<std::shared_ptr<uint64_t>>>("  std::atomic<std::shared_ptr>", thread_count, store_interval, baseline);
+#endif
+		}
+	}
+	return 0;
+}
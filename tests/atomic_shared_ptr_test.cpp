@@ -0,0 +1,165 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/threading/atomic_shared_ptr.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+using namespace fl;
+using namespace std::literals;
+
+//! tracks the amount of live instances (-> checks that every stored object is destroyed exactly once)
+struct tracked_object {
+	static inline std::atomic<int64_t> live_count { 0 };
+	const uint32_t value;
+	
+	explicit tracked_object(const uint32_t value_) : value(value_) {
+		live_count.fetch_add(1);
+	}
+	~tracked_object() {
+		live_count.fetch_sub(1);
+	}
+};
+
+//! provides access to the external reference count to simulate outstanding readers
+struct test_atomic_shared_ptr : public atomic_shared_ptr<tracked_object> {
+	using atomic_shared_ptr<tracked_object>::atomic_shared_ptr;
+	
+	void add_external_refs(const int64_t count) {
+		word.fetch_add(uint64_t(count) * count_one);
+	}
+	void remove_external_refs(const int64_t count) {
+		word.fetch_sub(uint64_t(count) * count_one);
+	}
+	static constexpr int64_t get_max_external_count() {
+		return max_external_count;
+	}
+};
+
+int main(int, char**) {
+	// single-threaded semantics
+	{
+		atomic_shared_ptr<tracked_object> asptr;
+		FLOOR_TEST_CHECK(!asptr);
+		FLOOR_TEST_CHECK(asptr.load() == nullptr);
+		
+		auto obj_1 = std::make_shared<tracked_object>(1u);
+		asptr.store(obj_1);
+		FLOOR_TEST_CHECK(asptr.load() == obj_1);
+		FLOOR_TEST_CHECK(asptr->value == 1u);
+		FLOOR_TEST_CHECK(asptr.use_count() == 2);
+		
+		auto obj_2 = std::make_shared<tracked_object>(2u);
+		auto prev = asptr.exchange(obj_2);
+		FLOOR_TEST_CHECK(prev == obj_1);
+		FLOOR_TEST_CHECK(asptr.load() == obj_2);
+		
+		// failing CAS updates "expected"
+		auto expected = obj_1;
+		FLOOR_TEST_CHECK(!asptr.compare_exchange_strong(expected, std::make_shared<tracked_object>(3u)));
+		FLOOR_TEST_CHECK(expected == obj_2);
+		FLOOR_TEST_CHECK(asptr.load() == obj_2);
+		
+		// succeeding CAS
+		FLOOR_TEST_CHECK(asptr.compare_exchange_strong(expected, obj_1));
+		FLOOR_TEST_CHECK(asptr.load() == obj_1);
+		
+		// CAS on an empty atomic_shared_ptr
+		asptr.reset();
+		FLOOR_TEST_CHECK(!asptr);
+		std::shared_ptr<tracked_object> empty_expected;
+		FLOOR_TEST_CHECK(asptr.compare_exchange_strong(empty_expected, obj_2));
+		FLOOR_TEST_CHECK(asptr.load() == obj_2);
+		
+		prev = nullptr;
+		obj_1 = nullptr;
+		obj_2 = nullptr;
+		expected = nullptr;
+		FLOOR_TEST_CHECK(tracked_object::live_count == 1);
+	}
+	FLOOR_TEST_CHECK(tracked_object::live_count == 0);
+	
+	// a saturated external count must make readers wait instead of overflowing it
+	{
+		test_atomic_shared_ptr asptr { std::make_shared<tracked_object>(42u) };
+		asptr.add_external_refs(test_atomic_shared_ptr::get_max_external_count());
+		std::atomic<bool> loaded { false };
+		std::thread reader([&asptr, &loaded] {
+			const auto obj = asptr.load();
+			loaded = (obj && obj->value == 42u);
+		});
+		std::this_thread::sleep_for(50ms);
+		FLOOR_TEST_CHECK(!loaded);
+		asptr.remove_external_refs(test_atomic_shared_ptr::get_max_external_count());
+		reader.join();
+		FLOOR_TEST_CHECK(loaded);
+		FLOOR_TEST_CHECK(asptr.use_count() == 1);
+	}
+	FLOOR_TEST_CHECK(tracked_object::live_count == 0);
+	
+	// concurrent readers and writers
+	{
+		static constexpr const uint32_t thread_count { 8u };
+		static constexpr const uint32_t iterations { 50'000u };
+		atomic_shared_ptr<tracked_object> asptr { std::make_shared<tracked_object>(0u) };
+		std::atomic<uint32_t> cas_successes { 0u };
+		std::atomic<uint32_t> invalid_reads { 0u };
+		std::vector<std::thread> threads;
+		for (uint32_t thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+			threads.emplace_back([&asptr, &cas_successes, &invalid_reads, thread_idx] {
+				for (uint32_t i = 0; i < iterations; ++i) {
+					switch ((thread_idx + i) % 8u) {
+						case 0:
+							asptr.store(std::make_shared<tracked_object>(i));
+							break;
+						case 1:
+							(void)asptr.exchange(std::make_shared<tracked_object>(i));
+							break;
+						case 2: {
+							auto expected = asptr.load();
+							if (asptr.compare_exchange_strong(expected, std::make_shared<tracked_object>(i))) {
+								cas_successes.fetch_add(1u);
+							}
+							break;
+						}
+						default: {
+							const auto obj = asptr.get();
+							if (!obj || obj->value >= iterations) {
+								invalid_reads.fetch_add(1u);
+							}
+							break;
+						}
+					}
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		FLOOR_TEST_CHECK(invalid_reads == 0u);
+		FLOOR_TEST_CHECK(cas_successes > 0u);
+		FLOOR_TEST_CHECK(tracked_object::live_count == 1);
+		FLOOR_TEST_CHECK(asptr.use_count() == 1);
+	}
+	FLOOR_TEST_CHECK(tracked_object::live_count == 0);
+	
+	return test::finish("atomic_shared_ptr");
+}
@@ -0,0 +1,205 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/math/bvh.hpp>
+#include <limits>
+#include <random>
+#include <vector>
+#include <string>
+
+using namespace fl;
+
+//! random boxes in [-100, 100]^3 with sizes in [0.1, 2]
+static std::vector<bboxf> make_boxes(const size_t count, std::mt19937& rng) {
+	std::uniform_real_distribution<float> pos_dist { -100.0f, 100.0f };
+	std::uniform_real_distribution<float> size_dist { 0.1f, 2.0f };
+	std::vector<bboxf> boxes;
+	boxes.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		const float3 pos { pos_dist(rng), pos_dist(rng), pos_dist(rng) };
+		boxes.emplace_back(pos, pos + float3 { size_dist(rng), size_dist(rng), size_dist(rng) });
+	}
+	return boxes;
+}
+
+//! coherent rays: pinhole camera at (0, 0, -150) looking at +z, "width" x "height" pixels, rows of 8 adjacent pixels
+//! are consecutive (-> each group of 8 rays forms a coherent packet)
+static std::vector<ray> make_camera_rays(const uint32_t width, const uint32_t height) {
+	std::vector<ray> rays;
+	rays.reserve(width * height);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const float3 dir { (float(x) / float(width)) * 1.2f - 0.6f, (float(y) / float(height)) * 1.2f - 0.6f, 1.0f };
+			rays.emplace_back(float3 { 0.0f, 0.0f, -150.0f }, dir.normalized());
+		}
+	}
+	return rays;
+}
+
+//! returns the entry distance of "r" into "box" if it is hit within [0, t_max], or +inf otherwise
+static float intersect_box(const bboxf& box, const ray& r, const float t_max) {
+	float t_near = 0.0f;
+	return (prepared_ray(r).intersect(box, t_max, t_near) ? t_near : std::numeric_limits<float>::infinity());
+}
+
+//! one ray vs. "boxes" stored SoA in batches of "lane_count"
+template <uint32_t lane_count>
+static double bench_ray_vs_box_batches(const std::vector<bboxf>& boxes, const std::vector<ray>& rays, const double baseline_ns) {
+	std::vector<bbox_batch<lane_count>> batches;
+	for (size_t i = 0; i < boxes.size(); i += lane_count) {
+		batches.emplace_back(bbox_batch<lane_count>::load(&boxes[i], uint32_t(std::min(boxes.size() - i, size_t(lane_count)))));
+	}
+	const auto ns = test::benchmark([&batches, &rays] {
+		uint32_t hit_count = 0u;
+		for (const auto& r : rays) {
+			const prepared_ray pray(r);
+			for (const auto& batch : batches) {
+				typename bbox_batch<lane_count>::simd_type t_near;
+				hit_count += uint32_t(std::popcount(pray.intersect(batch, ext::limits<float>::max, t_near)));
+			}
+		}
+		test::do_not_optimize(hit_count);
+	});
+	test::print_benchmark("  prepared_ray vs. bbox_batch<" + std::to_string(lane_count) + ">", ns, rays.size() * boxes.size(), 0u, baseline_ns);
+	return ns;
+}
+
+//! "rays" in packets of "lane_count" vs. each box of "boxes"
+template <uint32_t lane_count>
+static double bench_ray_packet_vs_box(const std::vector<bboxf>& boxes, const std::vector<ray>& rays, const double baseline_ns) {
+	std::vector<ray_packet<lane_count>> packets;
+	for (size_t i = 0; i + lane_count <= rays.size(); i += lane_count) {
+		packets.emplace_back(&rays[i], lane_count);
+	}
+	const auto ns = test::benchmark([&packets, &boxes] {
+		uint32_t hit_count = 0u;
+		for (const auto& box : boxes) {
+			for (const auto& packet : packets) {
+				hit_count += uint32_t(std::popcount(packet.intersect(box)));
+			}
+		}
+		test::do_not_optimize(hit_count);
+	});
+	test::print_benchmark("  ray_packet<" + std::to_string(lane_count) + "> vs. bboxf", ns, packets.size() * lane_count * boxes.size(), 0u, baseline_ns);
+	return ns;
+}
+
+int main(int, char**) {
+	std::mt19937 rng { 42u };
+	
+	// ray/box tests (ns per ray/box test, speedup relative to bbox::intersect)
+	{
+		const auto boxes = make_boxes(4096u, rng);
+		const auto rays = make_camera_rays(32u, 16u);
+		std::printf("ray/box tests (%zu rays x %zu boxes):\n", rays.size(), boxes.size());
+		const auto baseline = test::benchmark([&boxes, &rays] {
+			uint32_t hit_count = 0u;
+			for (const auto& r : rays) {
+				for (const auto& box : boxes) {
+					const auto t = box.intersect(r);
+					hit_count += (t.x <= t.y && t.y >= 0.0f ? 1u : 0u);
+				}
+			}
+			test::do_not_optimize(hit_count);
+		});
+		test::print_benchmark("  bbox::intersect", baseline, rays.size() * boxes.size());
+		const auto prepared_ns = test::benchmark([&boxes, &rays] {
+			uint32_t hit_count = 0u;
+			for (const auto& r : rays) {
+				const prepared_ray pray(r);
+				for (const auto& box : boxes) {
+					float t_near = 0.0f;
+					hit_count += (pray.intersect(box, ext::limits<float>::max, t_near) ? 1u : 0u);
+				}
+			}
+			test::do_not_optimize(hit_count);
+		});
+		test::print_benchmark("  prepared_ray vs. bboxf", prepared_ns, rays.size() * boxes.size(), 0u, baseline);
+		bench_ray_vs_box_batches<4u>(boxes, rays, baseline);
+		bench_ray_vs_box_batches<8u>(boxes, rays, baseline);
+		bench_ray_vs_box_batches<16u>(boxes, rays, baseline);
+		bench_ray_packet_vs_box<4u>(boxes, rays, baseline);
+		bench_ray_packet_vs_box<8u>(boxes, rays, baseline);
+		bench_ray_packet_vs_box<16u>(boxes, rays, baseline);
+	}
+	
+	// BVH (ns per ray, speedup relative to a brute force closest hit search over all boxes)
+	for (const size_t box_count : { 10'000uz, 100'000uz }) {
+		const auto boxes = make_boxes(box_count, rng);
+		const auto rays = make_camera_rays(256u, 256u);
+		std::printf("BVH (%zu boxes, %zu coherent rays):\n", boxes.size(), rays.size());
+		
+		bvh tree;
+		const auto build_ns = test::benchmark([&tree, &boxes] {
+			tree.build(boxes);
+		}, 3u);
+		test::print_benchmark("  build (per box)", build_ns, boxes.size());
+		
+		// brute force baseline (only on a subset of the rays, since it is O(#boxes) per ray)
+		static constexpr const size_t brute_force_ray_count { 64u };
+		const auto brute_force_ns = test::benchmark([&boxes, &rays] {
+			for (size_t i = 0; i < brute_force_ray_count; ++i) {
+				float closest = ext::limits<float>::max;
+				for (const auto& box : boxes) {
+					closest = std::min(closest, intersect_box(box, rays[i * (rays.size() / brute_force_ray_count)], closest));
+				}
+				test::do_not_optimize(closest);
+			}
+		}, 3u) / double(brute_force_ray_count);
+		test::print_benchmark("  brute force closest hit", brute_force_ns, 1u);
+		
+		const auto prim_intersect = [&boxes](const uint32_t prim, const ray& r, const float t_max) {
+			return intersect_box(boxes[prim], r, t_max);
+		};
+		const auto single_ns = test::benchmark([&tree, &rays, &prim_intersect] {
+			uint32_t hit_count = 0u;
+			for (const auto& r : rays) {
+				hit_count += (tree.intersect(r, prim_intersect) ? 1u : 0u);
+			}
+			test::do_not_optimize(hit_count);
+		});
+		test::print_benchmark("  bvh::intersect(ray)", single_ns, rays.size(), 0u, brute_force_ns * double(rays.size()));
+		
+		const auto packet_ns = test::benchmark([&tree, &rays, &prim_intersect] {
+			uint32_t hit_count = 0u;
+			std::array<bvh::hit_t, 8u> hits;
+			for (size_t i = 0; i < rays.size(); i += 8u) {
+				tree.intersect(ray_packet<8u>(&rays[i], 8u), prim_intersect, std::span<bvh::hit_t, 8u> { hits });
+				for (const auto& hit : hits) {
+					hit_count += (hit ? 1u : 0u);
+				}
+			}
+			test::do_not_optimize(hit_count);
+		});
+		test::print_benchmark("  bvh::intersect(ray_packet<8>)", packet_ns, rays.size(), 0u, brute_force_ns * double(rays.size()));
+		
+		const auto for_each_ns = test::benchmark([&tree, &rays] {
+			uint32_t hit_count = 0u;
+			for (const auto& r : rays) {
+				tree.for_each_intersected(r, [&hit_count](const uint32_t) {
+					++hit_count;
+				});
+			}
+			test::do_not_optimize(hit_count);
+		});
+		test::print_benchmark("  bvh::for_each_intersected", for_each_ns, rays.size());
+	}
+	
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/math/bvh.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace fl;
+
+//! returns the entry distance of "r" into "box" if it is hit within [0, t_max], or +inf otherwise
+static float intersect_box(const bboxf& box, const ray& r, const float t_max) {
+	float t_near = 0.0f;
+	return (prepared_ray(r).intersect(box, t_max, t_near) ? t_near : std::numeric_limits<float>::infinity());
+}
+
+//! brute force reference: returns all boxes that are hit by "r"
+static std::vector<uint32_t> brute_force_intersected(const std::vector<bboxf>& boxes, const ray& r) {
+	std::vector<uint32_t> ret;
+	const prepared_ray pray(r);
+	for (uint32_t i = 0; i < uint32_t(boxes.size()); ++i) {
+		float t_near = 0.0f;
+		if (pray.intersect(boxes[i], ext::limits<float>::max, t_near)) {
+			ret.emplace_back(i);
+		}
+	}
+	return ret;
+}
+
+int main(int, char**) {
+	// rays with +/-0 direction components that start inside a box must hit it (at distance 0),
+	// in particular -0 must select the same near/far planes as its -inf inverse direction
+	{
+		const bboxf box { float3 { -1.0f }, float3 { 1.0f } };
+		for (const auto& dir : {
+			float3 { 1.0f, 0.0f, 0.0f }, float3 { 1.0f, -0.0f, 0.0f }, float3 { -1.0f, 0.0f, -0.0f },
+			float3 { -0.0f, -1.0f, -0.0f }, float3 { 0.0f, -0.0f, 1.0f }, float3 { -0.0f, -0.0f, -1.0f },
+		}) {
+			const ray r { float3 { 0.25f, -0.5f, 0.5f }, dir };
+			float t_near = -1.0f;
+			FLOOR_TEST_CHECK(prepared_ray(r).intersect(box, ext::limits<float>::max, t_near) && t_near == 0.0f);
+			
+			const auto boxes = bbox_batch<4u>::load(&box, 1u);
+			bbox_batch<4u>::simd_type t_near_batch;
+			FLOOR_TEST_CHECK(prepared_ray(r).intersect(boxes, ext::limits<float>::max, t_near_batch) == 0b1111u);
+			FLOOR_TEST_CHECK(ray_packet<4u>(&r, 1u).intersect(box) == 0b1u);
+			
+			// parallel to a slab, but outside of it -> miss
+			const ray r_outside { float3 { 0.25f, 2.0f, 2.0f }, dir };
+			FLOOR_TEST_CHECK(!prepared_ray(r_outside).intersect(box, ext::limits<float>::max, t_near));
+		}
+	}
+	
+	// BVH queries vs. brute force
+	{
+		std::mt19937 rng { 42u };
+		std::uniform_real_distribution<float> pos_dist { -50.0f, 50.0f };
+		std::uniform_real_distribution<float> size_dist { 0.1f, 2.0f };
+		std::vector<bboxf> boxes;
+		for (uint32_t i = 0; i < 2000u; ++i) {
+			const float3 pos { pos_dist(rng), pos_dist(rng), pos_dist(rng) };
+			boxes.emplace_back(pos, pos + float3 { size_dist(rng), size_dist(rng), size_dist(rng) });
+		}
+		const bvh tree(boxes);
+		FLOOR_TEST_CHECK(!tree.empty());
+		
+		std::vector<ray> rays;
+		for (uint32_t i = 0; i < 256u; ++i) {
+			float3 dir { pos_dist(rng), pos_dist(rng), pos_dist(rng) };
+			// every 4th ray: start inside a box and zero the direction components (every other one with -0)
+			float3 origin { pos_dist(rng), pos_dist(rng), pos_dist(rng) };
+			if (i % 4u == 0u) {
+				origin = boxes[i].center();
+				dir[(i / 4u) % 3u] = ((i / 4u) % 2u == 0u ? -0.0f : 0.0f);
+				dir[(i / 4u + 1u) % 3u] = ((i / 8u) % 2u == 0u ? -0.0f : 0.0f);
+			}
+			rays.emplace_back(origin, dir);
+		}
+		
+		for (uint32_t i = 0; i < uint32_t(rays.size()); ++i) {
+			const auto& r = rays[i];
+			const auto expected = brute_force_intersected(boxes, r);
+			std::vector<uint32_t> intersected;
+			tree.for_each_intersected(r, [&intersected](const uint32_t prim) {
+				intersected.emplace_back(prim);
+			});
+			std::ranges::sort(intersected);
+			FLOOR_TEST_CHECK(intersected == expected);
+			
+			// closest hit
+			float expected_dist = ext::limits<float>::max;
+			for (const auto prim : expected) {
+				expected_dist = std::min(expected_dist, intersect_box(boxes[prim], r, ext::limits<float>::max));
+			}
+			const auto hit = tree.intersect(r, [&boxes](const uint32_t prim, const ray& prim_ray, const float t_max) {
+				return intersect_box(boxes[prim], prim_ray, t_max);
+			});
+			FLOOR_TEST_CHECK(bool(hit) == !expected.empty());
+			FLOOR_TEST_CHECK(!hit || hit.distance == expected_dist);
+			if (i % 4u == 0u) {
+				// started inside box #i
+				FLOOR_TEST_CHECK(std::ranges::find(intersected, i) != intersected.end());
+				FLOOR_TEST_CHECK(hit && hit.distance == 0.0f);
+			}
+		}
+		
+		// packet queries must match single ray queries
+		for (uint32_t i = 0; i < uint32_t(rays.size()); i += 8u) {
+			const ray_packet<8u> packet(&rays[i], 8u);
+			std::array<bvh::hit_t, 8u> hits;
+			tree.intersect(packet, [&boxes](const uint32_t prim, const ray& prim_ray, const float t_max) {
+				return intersect_box(boxes[prim], prim_ray, t_max);
+			}, std::span<bvh::hit_t, 8u> { hits });
+			for (uint32_t j = 0; j < 8u; ++j) {
+				const auto hit = tree.intersect(rays[i + j], [&boxes](const uint32_t prim, const ray& prim_ray, const float t_max) {
+					return intersect_box(boxes[prim], prim_ray, t_max);
+				});
+				FLOOR_TEST_CHECK(bool(hits[j]) == bool(hit) && (!hit || hits[j].distance == hit.distance));
+			}
+		}
+	}
+	
+	return test::finish("bvh");
+}
@@ -0,0 +1,134 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/core/flat_map.hpp>
+#include <unordered_map>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <version>
+#if defined(__cpp_lib_flat_map)
+#include <flat_map>
+#endif
+
+using namespace fl;
+using namespace std::literals;
+
+//! transparent string hash so that std::unordered_map can also be queried with std::string_view keys
+struct string_hash {
+	using is_transparent = void;
+	size_t operator()(const std::string_view str) const {
+		return std::hash<std::string_view> {}(str);
+	}
+};
+
+//! creates "count" unique json-like member names (4 - 16 chars)
+static std::vector<std::string> make_string_keys(const size_t count, std::mt19937& rng) {
+	static constexpr const std::string_view chars { "abcdefghijklmnopqrstuvwxyz_0123456789" };
+	std::vector<std::string> keys;
+	keys.reserve(count);
+	while (keys.size() < count) {
+		std::string key(4u + rng() % 13u, ' ');
+		for (auto& ch : key) {
+			ch = chars[rng() % (chars.size() - 10u)]; // no digits
+		}
+		key += std::to_string(keys.size());
+		keys.emplace_back(std::move(key));
+	}
+	return keys;
+}
+
+//! builds a map with all "keys" via emplace() (in random key order) and looks up all keys (in another random order),
+//! prints the build and lookup timings relative to "baseline" (fl::flat_map)
+template <typename map_type, typename key_type, typename lookup_key_type>
+static std::pair<double, double> bench_map(const std::string_view name, const std::vector<key_type>& keys,
+										   const std::vector<lookup_key_type>& lookup_keys, const std::pair<double, double>& baseline) {
+	static constexpr const uint32_t iterations { 64u };
+	const auto build_ns = test::benchmark([&keys] {
+		for (uint32_t iter = 0; iter < iterations; ++iter) {
+			map_type map;
+			for (uint32_t i = 0; i < keys.size(); ++i) {
+				map.emplace(keys[i], i);
+			}
+			test::do_not_optimize(map);
+		}
+	});
+	
+	map_type map;
+	for (uint32_t i = 0; i < keys.size(); ++i) {
+		map.emplace(keys[i], i);
+	}
+	const auto lookup_ns = test::benchmark([&map, &lookup_keys] {
+		for (uint32_t iter = 0; iter < iterations; ++iter) {
+			uint32_t sum = 0;
+			for (const auto& key : lookup_keys) {
+				const auto iter = map.find(key);
+				sum += (iter != map.end() ? iter->second : 0u);
+			}
+			test::do_not_optimize(sum);
+		}
+	});
+	
+	test::print_benchmark(std::string(name) + " build", build_ns, iterations * keys.size(), 0u, baseline.first);
+	test::print_benchmark(std::string(name) + " lookup", lookup_ns, iterations * lookup_keys.size(), 0u, baseline.second);
+	return { build_ns, lookup_ns };
+}
+
+template <typename key_type, typename lookup_key_type>
+static void bench_size(const std::string_view key_name, const std::vector<key_type>& keys, const std::vector<lookup_key_type>& lookup_keys) {
+	std::printf("%.*s keys, %zu entries:\n", int(key_name.size()), key_name.data(), keys.size());
+	const auto baseline = bench_map<flat_map<key_type, uint32_t>>("  fl::flat_map", keys, lookup_keys, {});
+	if constexpr (std::is_same_v<key_type, std::string>) {
+		bench_map<std::unordered_map<key_type, uint32_t, string_hash, std::equal_to<>>>("  std::unordered_map", keys, lookup_keys, baseline);
+	} else {
+		bench_map<std::unordered_map<key_type, uint32_t>>("  std::unordered_map", keys, lookup_keys, baseline);
+	}
+	bench_map<std::map<key_type, uint32_t, std::less<>>>("  std::map", keys, lookup_keys, baseline);
+#if defined(__cpp_lib_flat_map)
+	bench_map<std::flat_map<key_type, uint32_t, std::less<>>>("  std::flat_map", keys, lookup_keys, baseline);
+#endif
+}
+
+int main(int, char**) {
+	std::printf("fl::flat_map vs. std maps (ns per emplace/find, speedup relative to fl::flat_map):\n");
+	std::mt19937 rng { 42u };
+	for (const size_t size : { 8uz, 32uz, 128uz, 1024uz }) {
+		// std::string keys, looked up via std::string_view (i.e. json object member lookup)
+		auto str_keys = make_string_keys(size, rng);
+		std::vector<std::string_view> str_lookup_keys;
+		for (uint32_t i = 0; i < 4096u; ++i) {
+			str_lookup_keys.emplace_back(str_keys[rng() % size]);
+		}
+		bench_size("std::string", str_keys, str_lookup_keys);
+		
+		// uint32_t keys
+		std::vector<uint32_t> int_keys;
+		for (uint32_t i = 0; i < size; ++i) {
+			int_keys.emplace_back(uint32_t(rng()));
+		}
+		std::vector<uint32_t> int_lookup_keys;
+		for (uint32_t i = 0; i < 4096u; ++i) {
+			int_lookup_keys.emplace_back(int_keys[rng() % size]);
+		}
+		bench_size("uint32_t", int_keys, int_lookup_keys);
+	}
+	return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/core/flat_map.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <random>
+
+using namespace fl;
+using namespace std::literals;
+
+int main(int, char**) {
+	// basic insertion, lookup and key order iteration
+	{
+		flat_map<std::string, int> fmap;
+		FLOOR_TEST_CHECK(fmap.empty());
+		FLOOR_TEST_CHECK(fmap.emplace("c"s, 3).second);
+		FLOOR_TEST_CHECK(fmap.emplace("a"s, 1).second);
+		FLOOR_TEST_CHECK(fmap.emplace("b"s, 2).second);
+		FLOOR_TEST_CHECK(!fmap.emplace("a"s, 42).second);
+		FLOOR_TEST_CHECK(fmap.at("a") == 1);
+		FLOOR_TEST_CHECK(!fmap.insert_or_assign("a"s, 10).second);
+		FLOOR_TEST_CHECK(fmap.at("a") == 10);
+		fmap["d"s] = 4;
+		FLOOR_TEST_CHECK(fmap.size() == 4u);
+		
+		// iteration is in key order, not insertion order
+		std::string keys;
+		for (const auto& entry : fmap) {
+			keys += entry.first;
+		}
+		FLOOR_TEST_CHECK(keys == "abcd");
+		
+		// heterogeneous lookup
+		FLOOR_TEST_CHECK(fmap.contains("b"sv));
+		FLOOR_TEST_CHECK(fmap.count("e"sv) == 0u);
+		FLOOR_TEST_CHECK(fmap.find("c"sv) != fmap.end() && fmap.find("c"sv)->second == 3);
+		FLOOR_TEST_CHECK(fmap.find("e"sv) == fmap.end());
+		
+		bool threw = false;
+		try {
+			(void)fmap.at("e"sv);
+		} catch (const std::out_of_range&) {
+			threw = true;
+		}
+		FLOOR_TEST_CHECK(threw);
+		
+		FLOOR_TEST_CHECK(fmap.erase("b"sv) == 1u);
+		FLOOR_TEST_CHECK(fmap.erase("b"sv) == 0u);
+		FLOOR_TEST_CHECK(fmap.size() == 3u && !fmap.contains("b"));
+	}
+	
+	// construction and insert_range(): duplicate keys keep the first entry
+	{
+		flat_map<int, int> fmap {{ 3, 30 }, { 1, 10 }, { 3, 31 }, { 2, 20 }};
+		FLOOR_TEST_CHECK(fmap.size() == 3u);
+		FLOOR_TEST_CHECK(fmap.at(3) == 30);
+		
+		const std::vector<std::pair<int, int>> more { { 5, 50 }, { 1, 11 }, { 4, 40 }, { 5, 51 } };
+		fmap.insert_range(more);
+		FLOOR_TEST_CHECK(fmap.size() == 5u);
+		FLOOR_TEST_CHECK(fmap.at(1) == 10);
+		FLOOR_TEST_CHECK(fmap.at(5) == 50);
+		int prev_key = 0;
+		for (const auto& entry : fmap) {
+			FLOOR_TEST_CHECK(entry.first > prev_key);
+			prev_key = entry.first;
+		}
+		
+		fmap.adopt_sorted({ { 7, 70 }, { 8, 80 } });
+		FLOOR_TEST_CHECK(fmap.size() == 2u && fmap.at(7) == 70 && fmap.at(8) == 80 && !fmap.contains(1));
+	}
+	
+	// random operations against std::map
+	{
+		std::mt19937 rng { 42u };
+		flat_map<uint32_t, uint32_t> fmap;
+		std::map<uint32_t, uint32_t> ref_map;
+		for (uint32_t i = 0; i < 20000u; ++i) {
+			const auto key = rng() % 512u;
+			const auto value = uint32_t(rng());
+			switch (rng() % 4u) {
+				case 0:
+					FLOOR_TEST_CHECK(fmap.emplace(key, value).second == ref_map.emplace(key, value).second);
+					break;
+				case 1:
+					FLOOR_TEST_CHECK(fmap.insert_or_assign(key, value).second == ref_map.insert_or_assign(key, value).second);
+					break;
+				case 2:
+					FLOOR_TEST_CHECK(fmap.erase(key) == ref_map.erase(key));
+					break;
+				default: {
+					const auto iter = fmap.find(key);
+					const auto ref_iter = ref_map.find(key);
+					FLOOR_TEST_CHECK((iter == fmap.end()) == (ref_iter == ref_map.end()));
+					if (iter != fmap.end() && ref_iter != ref_map.end()) {
+						FLOOR_TEST_CHECK(iter->second == ref_iter->second);
+					}
+					break;
+				}
+			}
+		}
+		FLOOR_TEST_CHECK(fmap.size() == ref_map.size());
+		FLOOR_TEST_CHECK(std::equal(fmap.begin(), fmap.end(), ref_map.begin(), ref_map.end(), [](const auto& lhs, const auto& rhs) {
+			return lhs.first == rhs.first && lhs.second == rhs.second;
+		}));
+	}
+	
+	return test::finish("flat_map");
+}
@@ -0,0 +1,93 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string_view>
+#include <algorithm>
+#include <limits>
+
+//! minimal helpers shared by all libfloor tests and benchmarks (-> tests/CMakeLists.txt):
+//!  * tests record failed checks via FLOOR_TEST_CHECK and return fl::test::finish() from main()
+//!  * benchmarks time ops via fl::test::benchmark() and print their results via fl::test::print_benchmark()
+namespace fl::test {
+
+//! amount of failed checks in the current test executable
+inline uint32_t failed_check_count { 0u };
+
+//! records a failed check if "cond" is false, returns "cond"
+inline bool check(const bool cond, const char* cond_str, const char* file, const int line) {
+	if (!cond) {
+		++failed_check_count;
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, cond_str);
+	}
+	return cond;
+}
+
+//! prints a summary and returns the exit code of the test executable
+inline int finish(const std::string_view test_name) {
+	if (failed_check_count > 0u) {
+		std::fprintf(stderr, "%.*s: %u check(s) failed\n", int(test_name.size()), test_name.data(), failed_check_count);
+		return EXIT_FAILURE;
+	}
+	std::printf("%.*s: all checks passed\n", int(test_name.size()), test_name.data());
+	return EXIT_SUCCESS;
+}
+
+//! prevents the compiler from optimizing away the computation of "val"
+template <typename T>
+inline void do_not_optimize(const T& val) {
+	asm volatile("" : : "r,m"(val) : "memory");
+}
+
+//! runs "func" once as a warm-up and then "runs" times, returns the fastest run in nanoseconds
+template <typename F>
+inline double benchmark(F&& func, const uint32_t runs = 10u) {
+	func();
+	auto best_time = std::numeric_limits<double>::max();
+	for (uint32_t run = 0; run < runs; ++run) {
+		const auto start_time = std::chrono::steady_clock::now();
+		func();
+		const auto end_time = std::chrono::steady_clock::now();
+		best_time = std::min(best_time, double(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count()));
+	}
+	return best_time;
+}
+
+//! prints a single benchmark result: time per op, and throughput if "bytes_per_op" is non-zero
+//! NOTE: "baseline_ns" is the time of the baseline implementation of this op (0 = this is the baseline)
+inline void print_benchmark(const std::string_view name, const double ns, const uint64_t ops, const uint64_t bytes_per_op = 0u,
+							const double baseline_ns = 0.0) {
+	std::printf("%-48.*s %12.2f ns/op", int(name.size()), name.data(), ns / double(ops));
+	if (bytes_per_op > 0u) {
+		std::printf(" %10.2f MiB/s", (double(bytes_per_op * ops) / (1024.0 * 1024.0)) / (ns * 1e-9));
+	}
+	if (baseline_ns > 0.0) {
+		std::printf(" %8.2fx", baseline_ns / ns);
+	}
+	std::printf("\n");
+}
+
+} // namespace fl::test
+
+// NOTE: variadic, so that conditions may contain unparenthesized commas (e.g. brace initializers)
+#define FLOOR_TEST_CHECK(...) fl::test::check((__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
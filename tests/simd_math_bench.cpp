@@ -0,0 +1,109 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/math/simd_math.hpp>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <string>
+
+using namespace fl;
+
+//! amount of inputs per function
+static constexpr const size_t input_count { 1u << 20u };
+
+//! times "simd_func" on SIMD vectors of "lane_count" vs. "scalar_func" on each element, prints the time per element
+template <uint32_t lane_count, typename simd_func_type, typename scalar_func_type>
+static void bench_func(const std::string& name, const std::vector<float>& xs, const std::vector<float>& ys,
+					   simd_func_type&& simd_func, scalar_func_type&& scalar_func) {
+	using simd_type = simd_vector_t<float, lane_count>;
+	std::vector<float> out(xs.size());
+	const auto scalar_ns = test::benchmark([&xs, &ys, &out, &scalar_func] {
+		for (size_t i = 0; i < xs.size(); ++i) {
+			out[i] = scalar_func(xs[i], ys[i]);
+		}
+		test::do_not_optimize(out.data());
+	});
+	const auto simd_ns = test::benchmark([&xs, &ys, &out, &simd_func] {
+		for (size_t i = 0; i + lane_count <= xs.size(); i += lane_count) {
+			simd_type x, y;
+			std::memcpy(&x, &xs[i], sizeof(simd_type));
+			std::memcpy(&y, &ys[i], sizeof(simd_type));
+			const simd_type res = simd_func(x, y);
+			std::memcpy(&out[i], &res, sizeof(simd_type));
+		}
+		test::do_not_optimize(out.data());
+	});
+	if (lane_count == 4u) {
+		test::print_benchmark("  " + name + " (std)", scalar_ns, xs.size());
+	}
+	test::print_benchmark("  " + name + " (simd, " + std::to_string(lane_count) + " lanes)", simd_ns, xs.size(), 0u, scalar_ns);
+}
+
+template <uint32_t lane_count>
+static void bench_lane_count(const std::vector<float>& xs, const std::vector<float>& ys, const std::vector<float>& pos_xs) {
+	using simd_type = simd_vector_t<float, lane_count>;
+	using enum simd_math_accuracy;
+	bench_func<lane_count>("rsqrt", pos_xs, ys, [](const simd_type& x, const simd_type&) { return simd::rsqrt(x); },
+						   [](const float x, const float) { return 1.0f / std::sqrt(x); });
+	bench_func<lane_count>("rsqrt fast", pos_xs, ys, [](const simd_type& x, const simd_type&) { return simd::rsqrt<fast>(x); },
+						   [](const float x, const float) { return 1.0f / std::sqrt(x); });
+	bench_func<lane_count>("exp", xs, ys, [](const simd_type& x, const simd_type&) { return simd::exp(x); },
+						   [](const float x, const float) { return std::exp(x); });
+	bench_func<lane_count>("exp fast", xs, ys, [](const simd_type& x, const simd_type&) { return simd::exp<fast>(x); },
+						   [](const float x, const float) { return std::exp(x); });
+	bench_func<lane_count>("log", pos_xs, ys, [](const simd_type& x, const simd_type&) { return simd::log(x); },
+						   [](const float x, const float) { return std::log(x); });
+	bench_func<lane_count>("log fast", pos_xs, ys, [](const simd_type& x, const simd_type&) { return simd::log<fast>(x); },
+						   [](const float x, const float) { return std::log(x); });
+	bench_func<lane_count>("sin", xs, ys, [](const simd_type& x, const simd_type&) { return simd::sin(x); },
+						   [](const float x, const float) { return std::sin(x); });
+	bench_func<lane_count>("sin fast", xs, ys, [](const simd_type& x, const simd_type&) { return simd::sin<fast>(x); },
+						   [](const float x, const float) { return std::sin(x); });
+	bench_func<lane_count>("cos", xs, ys, [](const simd_type& x, const simd_type&) { return simd::cos(x); },
+						   [](const float x, const float) { return std::cos(x); });
+	bench_func<lane_count>("atan2", xs, ys, [](const simd_type& y, const simd_type& x) { return simd::atan2(y, x); },
+						   [](const float y, const float x) { return std::atan2(y, x); });
+	bench_func<lane_count>("atan2 fast", xs, ys, [](const simd_type& y, const simd_type& x) { return simd::atan2<fast>(y, x); },
+						   [](const float y, const float x) { return std::atan2(y, x); });
+	bench_func<lane_count>("pow", pos_xs, ys, [](const simd_type& x, const simd_type& y) { return simd::pow(x, y); },
+						   [](const float x, const float y) { return std::pow(x, y); });
+	bench_func<lane_count>("pow fast", pos_xs, ys, [](const simd_type& x, const simd_type& y) { return simd::pow<fast>(x, y); },
+						   [](const float x, const float y) { return std::pow(x, y); });
+}
+
+int main(int, char**) {
+	std::mt19937 rng { 42u };
+	std::uniform_real_distribution<float> x_dist { -20.0f, 20.0f };
+	std::uniform_real_distribution<float> y_dist { -5.0f, 5.0f };
+	std::uniform_real_distribution<float> pos_dist { 0.001f, 100.0f };
+	std::vector<float> xs(input_count), ys(input_count), pos_xs(input_count);
+	for (size_t i = 0; i < input_count; ++i) {
+		xs[i] = x_dist(rng);
+		ys[i] = y_dist(rng);
+		pos_xs[i] = pos_dist(rng);
+	}
+	
+	std::printf("SIMD math vs. std (ns per element, speedup relative to std):\n");
+	bench_lane_count<4u>(xs, ys, pos_xs);
+	bench_lane_count<8u>(xs, ys, pos_xs);
+	bench_lane_count<16u>(xs, ys, pos_xs);
+	return 0;
+}
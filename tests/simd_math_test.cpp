@@ -0,0 +1,286 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+// NOTE: this must be compiled without -ffast-math (-> tests/CMakeLists.txt), so that libm and special value handling are exact
+
+#include "floor_test.hpp"
+#include <floor/math/simd_math.hpp>
+#include <cmath>
+#include <cstring>
+#include <bit>
+#include <limits>
+#include <random>
+#include <vector>
+#include <string>
+#include <tuple>
+#include <utility>
+
+using namespace fl;
+using namespace std::literals;
+
+//! amount of random inputs per function and lane count
+static constexpr const size_t sample_count { 1u << 20u };
+
+static constexpr const float inf { std::numeric_limits<float>::infinity() };
+static constexpr const float qnan { std::numeric_limits<float>::quiet_NaN() };
+
+//! returns the error of "val" relative to the exact result "ref" in ULPs of the float result,
+//! non-finite results must match exactly (returns 0 or inf)
+static double ulp_error(const float val, const double ref) {
+	if (std::isnan(ref) || std::isnan(val)) {
+		return (std::isnan(ref) && std::isnan(val) ? 0.0 : std::numeric_limits<double>::infinity());
+	}
+	if (std::isinf(float(ref)) || std::isinf(val)) {
+		return (float(ref) == val ? 0.0 : std::numeric_limits<double>::infinity());
+	}
+	// ULP size at "ref": 2^(e - 24) for ref = m * 2^e with m in [0.5, 1), denormals have a fixed ULP size of 2^-149
+	int exponent = 0;
+	(void)std::frexp(ref, &exponent);
+	const auto ulp = std::ldexp(1.0, std::max(exponent - 24, -149));
+	return std::abs(double(val) - ref) / ulp;
+}
+
+//! returns a random finite float (uniformly distributed bit patterns, i.e. covering all magnitudes)
+static float random_finite_float(std::mt19937& rng) {
+	for (;;) {
+		const auto val = std::bit_cast<float>(uint32_t(rng()));
+		if (std::isfinite(val)) {
+			return val;
+		}
+	}
+}
+
+//! max error tracking of a single function
+struct error_stats {
+	double max_ulp { 0.0 };
+	float max_x { 0.0f };
+	float max_y { 0.0f };
+	
+	void add(const double ulp, const float x, const float y = 0.0f) {
+		if (ulp > max_ulp || std::isnan(ulp)) {
+			max_ulp = ulp;
+			max_x = x;
+			max_y = y;
+		}
+	}
+};
+
+//! computes "simd_func" for all inputs (in SIMD vectors of "lane_count") and compares the results against "ref_func",
+//! checks that the max error is <= "max_ulp"
+template <uint32_t lane_count, typename simd_func_type, typename ref_func_type>
+static void check_ulp(const std::string& name, const std::vector<float>& xs, const std::vector<float>& ys,
+					  simd_func_type&& simd_func, ref_func_type&& ref_func, const double max_ulp) {
+	using simd_type = simd_vector_t<float, lane_count>;
+	error_stats stats;
+	for (size_t i = 0; i + lane_count <= xs.size(); i += lane_count) {
+		simd_type x, y;
+		std::memcpy(&x, &xs[i], sizeof(simd_type));
+		std::memcpy(&y, &ys[i], sizeof(simd_type));
+		const simd_type res = simd_func(x, y);
+		for (uint32_t lane = 0; lane < lane_count; ++lane) {
+			stats.add(ulp_error(res[lane], ref_func(double(xs[i + lane]), double(ys[i + lane]))), xs[i + lane], ys[i + lane]);
+		}
+	}
+	std::printf("%-34s N=%2u: max %6.3f ULP (bound %.1f) at (%.9g, %.9g)\n", name.c_str(), lane_count, stats.max_ulp, max_ulp,
+				double(stats.max_x), double(stats.max_y));
+	if (!FLOOR_TEST_CHECK(stats.max_ulp <= max_ulp)) {
+		std::fprintf(stderr, "\t%s exceeds its error bound\n", name.c_str());
+	}
+}
+
+//! generates "count" inputs via "gen(rng)", with the specified special values at the front
+template <typename gen_type>
+static std::vector<float> make_inputs(std::mt19937& rng, gen_type&& gen, const std::vector<float>& special_values = {}) {
+	std::vector<float> ret = special_values;
+	ret.reserve(sample_count);
+	while (ret.size() < sample_count) {
+		ret.emplace_back(gen(rng));
+	}
+	return ret;
+}
+
+template <uint32_t lane_count>
+static void test_lane_count() {
+	using simd_type = simd_vector_t<float, lane_count>;
+	using enum simd_math_accuracy;
+	std::mt19937 rng { 42u + lane_count };
+	const std::vector<float> zeros(sample_count, 0.0f);
+	
+	const auto uniform = [](const float min_val, const float max_val) {
+		return [dist = std::uniform_real_distribution<float>(min_val, max_val)](std::mt19937& gen) mutable {
+			return dist(gen);
+		};
+	};
+	
+	// rsqrt (fast: positive, normal and finite only)
+	{
+		const auto xs = make_inputs(rng, [](std::mt19937& gen) {
+			return std::abs(random_finite_float(gen));
+		}, { 0.0f, -0.0f, inf, -1.0f, qnan, 1.0f, 4.0f, 1e-45f });
+		check_ulp<lane_count>("rsqrt", xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::rsqrt(x);
+		}, [](const double x, const double) {
+			return 1.0 / std::sqrt(x);
+		}, 2.0);
+		const auto normal_xs = make_inputs(rng, [](std::mt19937& gen) {
+			return std::max(std::abs(random_finite_float(gen)), std::numeric_limits<float>::min());
+		});
+		check_ulp<lane_count>("rsqrt (fast)", normal_xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::rsqrt<fast>(x);
+		}, [](const double x, const double) {
+			return 1.0 / std::sqrt(x);
+		}, 3.0);
+	}
+	
+	// exp: full result range incl. overflow, denormal results and underflow
+	{
+		const auto xs = make_inputs(rng, uniform(-110.0f, 90.0f), { 0.0f, -0.0f, 1.0f, inf, -inf, qnan, 88.72f, 88.73f, -103.0f, -104.0f, -87.5f });
+		check_ulp<lane_count>("exp", xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::exp(x);
+		}, [](const double x, const double) {
+			return std::exp(x);
+		}, 1.0);
+		check_ulp<lane_count>("exp (fast)", xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::exp<fast>(x);
+		}, [](const double x, const double) {
+			return std::exp(x);
+		}, 3.0);
+	}
+	
+	// log: all positive floats (incl. denormals for precise) and special values
+	{
+		const auto xs = make_inputs(rng, [](std::mt19937& gen) {
+			return std::abs(random_finite_float(gen));
+		}, { 0.0f, -0.0f, 1.0f, inf, -inf, qnan, -1.0f, 1e-45f, 1e-40f });
+		check_ulp<lane_count>("log", xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::log(x);
+		}, [](const double x, const double) {
+			return std::log(x);
+		}, 1.0);
+		const auto normal_xs = make_inputs(rng, [](std::mt19937& gen) {
+			return std::max(std::abs(random_finite_float(gen)), std::numeric_limits<float>::min());
+		});
+		check_ulp<lane_count>("log (fast)", normal_xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::log<fast>(x);
+		}, [](const double x, const double) {
+			return std::log(x);
+		}, 1.0);
+	}
+	
+	// sin/cos: typical range, all finite floats, and the restricted range of the fast variant
+	{
+		const auto small_xs = make_inputs(rng, uniform(-32.0f, 32.0f), { 0.0f, -0.0f, inf, -inf, qnan, 3.14159265f, 1.57079633f });
+		const auto all_xs = make_inputs(rng, random_finite_float);
+		for (const auto& [xs, suffix] : { std::pair { &small_xs, " (|x| <= 32)" }, std::pair { &all_xs, " (all finite)" } }) {
+			check_ulp<lane_count>("sin"s + suffix, *xs, zeros, [](const simd_type& x, const simd_type&) {
+				return simd::sin(x);
+			}, [](const double x, const double) {
+				return std::sin(x);
+			}, 2.0);
+			check_ulp<lane_count>("cos"s + suffix, *xs, zeros, [](const simd_type& x, const simd_type&) {
+				return simd::cos(x);
+			}, [](const double x, const double) {
+				return std::cos(x);
+			}, 2.0);
+		}
+		const auto fast_xs = make_inputs(rng, uniform(-32.0f, 32.0f), { 0.0f, -0.0f, 3.14159265f, 1.57079633f });
+		check_ulp<lane_count>("sin (fast, |x| <= 32)", fast_xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::sin<fast>(x);
+		}, [](const double x, const double) {
+			return std::sin(x);
+		}, 2.0);
+		check_ulp<lane_count>("cos (fast, |x| <= 32)", fast_xs, zeros, [](const simd_type& x, const simd_type&) {
+			return simd::cos<fast>(x);
+		}, [](const double x, const double) {
+			return std::cos(x);
+		}, 2.0);
+	}
+	
+	// atan2: all finite floats, "unit" range and special values (zeros, inf, NaN)
+	{
+		static const std::vector<float> special_values { 0.0f, -0.0f, 1.0f, -1.0f, inf, -inf, qnan, 2.0f, -2.0f };
+		std::vector<float> special_ys, special_xs;
+		for (const auto y : special_values) {
+			for (const auto x : special_values) {
+				special_ys.emplace_back(y);
+				special_xs.emplace_back(x);
+			}
+		}
+		const auto ys = make_inputs(rng, random_finite_float, special_ys);
+		const auto xs = make_inputs(rng, random_finite_float, special_xs);
+		const auto unit_ys = make_inputs(rng, uniform(-10.0f, 10.0f));
+		const auto unit_xs = make_inputs(rng, uniform(-10.0f, 10.0f));
+		for (const auto& [y_vals, x_vals, suffix] : { std::tuple { &ys, &xs, "" }, std::tuple { &unit_ys, &unit_xs, " (|x|, |y| <= 10)" } }) {
+			check_ulp<lane_count>("atan2"s + suffix, *y_vals, *x_vals, [](const simd_type& y, const simd_type& x) {
+				return simd::atan2(y, x);
+			}, [](const double y, const double x) {
+				return std::atan2(y, x);
+			}, 1.0);
+			check_ulp<lane_count>("atan2 (fast)"s + suffix, *y_vals, *x_vals, [](const simd_type& y, const simd_type& x) {
+				return simd::atan2<fast>(y, x);
+			}, [](const double y, const double x) {
+				return std::atan2(y, x);
+			}, 3.0);
+		}
+	}
+	
+	// pow: positive x with exponents that cover the full result range, negative x with integer exponents and special values
+	{
+		static const std::vector<float> special_values { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 2.0f, -2.0f, 3.0f, -3.0f, inf, -inf, qnan };
+		std::vector<float> special_xs, special_ys;
+		for (const auto x : special_values) {
+			for (const auto y : special_values) {
+				special_xs.emplace_back(x);
+				special_ys.emplace_back(y);
+			}
+		}
+		const auto xs = make_inputs(rng, uniform(0.0f, 100.0f), special_xs);
+		const auto ys = make_inputs(rng, uniform(-25.0f, 25.0f), special_ys);
+		const auto neg_xs = make_inputs(rng, uniform(-10.0f, 0.0f));
+		const auto int_ys = make_inputs(rng, [](std::mt19937& gen) {
+			return float(int32_t(gen() % 61u) - 30);
+		});
+		const auto any_xs = make_inputs(rng, [](std::mt19937& gen) {
+			return std::abs(random_finite_float(gen));
+		});
+		const auto small_ys = make_inputs(rng, uniform(-2.0f, 2.0f));
+		for (const auto& [x_vals, y_vals, suffix] : {
+			std::tuple { &xs, &ys, "" },
+			std::tuple { &neg_xs, &int_ys, " (x < 0, integer y)" },
+			std::tuple { &any_xs, &small_ys, " (all finite x >= 0)" },
+		}) {
+			check_ulp<lane_count>("pow"s + suffix, *x_vals, *y_vals, [](const simd_type& x, const simd_type& y) {
+				return simd::pow(x, y);
+			}, [](const double x, const double y) {
+				return std::pow(x, y);
+			}, 1.0);
+			check_ulp<lane_count>("pow (fast)"s + suffix, *x_vals, *y_vals, [](const simd_type& x, const simd_type& y) {
+				return simd::pow<fast>(x, y);
+			}, [](const double x, const double y) {
+				return std::pow(x, y);
+			}, 3.0);
+		}
+	}
+}
+
+int main(int, char**) {
+	test_lane_count<4u>();
+	test_lane_count<8u>();
+	test_lane_count<16u>();
+	return test::finish("simd_math");
+}
@@ -0,0 +1,84 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/core/unicode.hpp>
+#include <string>
+#include <vector>
+
+using namespace fl;
+using namespace std::literals;
+
+//! builds a corpus of at least "size" bytes by repeating the specified samples
+static std::string make_corpus(const std::vector<std::string_view>& samples, const size_t size) {
+	std::string corpus;
+	corpus.reserve(size + 64u);
+	for (size_t i = 0; corpus.size() < size; ++i) {
+		corpus += samples[i % samples.size()];
+	}
+	return corpus;
+}
+
+int main(int, char**) {
+	static constexpr const size_t corpus_size { 8u * 1024u * 1024u };
+	const std::pair<std::string_view, std::string> corpora[] {
+		{ "ascii", make_corpus({
+			"The quick brown fox jumps over the lazy dog. ",
+			"{\"key\": \"value\", \"number\": 12345, \"list\": [1, 2, 3]}\n",
+		}, corpus_size) },
+		{ "latin-1", make_corpus({
+			"Grüße aus Köln, ça va? ",
+			"¡Señor, el niño está en el jardín! ",
+			"Æble, østers og ålegræs. ",
+		}, corpus_size) },
+		{ "cjk", make_corpus({
+			"日本語のテキストを検証します。",
+			"这是一个中文文本的例子。",
+			"한국어 텍스트입니다. ",
+		}, corpus_size) },
+		{ "emoji", make_corpus({
+			"😀😃😄😁😆😅🤣😂🙂🙃",
+			"🎉🚀🧪🌍🔥💡🐧🦀",
+		}, corpus_size) },
+		{ "mixed", make_corpus({
+			"The quick brown fox ",
+			"Grüße aus Köln ",
+			"日本語のテキスト ",
+			"emoji 😀🎉 ",
+			"{\"key\": \"value\"}\n",
+		}, corpus_size) },
+	};
+	
+	std::printf("strict utf-8 validation (validate_utf8) vs scalar validation (validate_utf8_string), %zu MiB per corpus:\n",
+				corpus_size / (1024u * 1024u));
+	for (const auto& [name, corpus] : corpora) {
+		const auto scalar_ns = test::benchmark([&corpus]() {
+			test::do_not_optimize(unicode::validate_utf8_string(corpus).first);
+		});
+		const auto validate_ns = test::benchmark([&corpus]() {
+			test::do_not_optimize(unicode::validate_utf8(corpus).first);
+		});
+		if (!unicode::validate_utf8(corpus).first || !unicode::validate_utf8_string(corpus).first) {
+			std::fprintf(stderr, "corpus \"%.*s\" is not valid utf-8\n", int(name.size()), name.data());
+			return EXIT_FAILURE;
+		}
+		test::print_benchmark(std::string(name) + ": validate_utf8_string", scalar_ns, 1u, corpus.size());
+		test::print_benchmark(std::string(name) + ": validate_utf8", validate_ns, 1u, corpus.size(), scalar_ns);
+	}
+	return EXIT_SUCCESS;
+}
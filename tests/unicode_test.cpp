@@ -0,0 +1,142 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/core/unicode.hpp>
+#include <string>
+#include <vector>
+#include <random>
+
+using namespace fl;
+using namespace std::literals;
+
+//! straightforward strict (RFC 3629) reference validator: returns <true, size> if valid,
+//! <false, offset of the first invalid code sequence> if invalid
+static std::pair<bool, size_t> reference_validate_utf8(const std::string_view str) {
+	for (size_t offset = 0; offset < str.size();) {
+		const auto byte_0 = uint32_t(uint8_t(str[offset]));
+		if (byte_0 < 0x80u) {
+			++offset;
+			continue;
+		}
+		uint32_t size = 0u, min_code = 0u, code = 0u;
+		if ((byte_0 & 0xE0u) == 0xC0u) {
+			size = 2u;
+			min_code = 0x80u;
+			code = byte_0 & 0x1Fu;
+		} else if ((byte_0 & 0xF0u) == 0xE0u) {
+			size = 3u;
+			min_code = 0x800u;
+			code = byte_0 & 0x0Fu;
+		} else if ((byte_0 & 0xF8u) == 0xF0u) {
+			size = 4u;
+			min_code = 0x10000u;
+			code = byte_0 & 0x07u;
+		} else {
+			return { false, offset };
+		}
+		if (offset + size > str.size()) {
+			return { false, offset };
+		}
+		for (uint32_t i = 1; i < size; ++i) {
+			const auto byte_i = uint32_t(uint8_t(str[offset + i]));
+			if ((byte_i & 0xC0u) != 0x80u) {
+				return { false, offset };
+			}
+			code = (code << 6u) | (byte_i & 0x3Fu);
+		}
+		if (code < min_code || code > 0x10FFFFu || (code >= 0xD800u && code <= 0xDFFFu)) {
+			return { false, offset };
+		}
+		offset += size;
+	}
+	return { true, str.size() };
+}
+
+//! checks that validate_utf8() and the reference validator agree on "str"
+static bool check_validation(const std::string_view str) {
+	const auto result = unicode::validate_utf8(str);
+	const auto expected = reference_validate_utf8(str);
+	return (FLOOR_TEST_CHECK(result.first == expected.first) &&
+			FLOOR_TEST_CHECK(result.second == expected.second));
+}
+
+int main(int, char**) {
+	// valid input of all code sequence sizes
+	static constexpr const std::string_view samples[] {
+		"plain ASCII text",
+		"Grüße aus Köln, ça va? ¡Señor!",
+		"日本語のテキストと中文文本",
+		"emoji: 😀🎉🚀🧪",
+		"mixed: abc ä 日本 😀 xyz",
+	};
+	for (const auto& sample : samples) {
+		FLOOR_TEST_CHECK(unicode::validate_utf8(sample) == std::make_pair(true, sample.size()));
+	}
+	FLOOR_TEST_CHECK(unicode::validate_utf8("") == std::make_pair(true, size_t(0)));
+	FLOOR_TEST_CHECK(unicode::is_ascii(samples[0]));
+	FLOOR_TEST_CHECK(!unicode::is_ascii(samples[1]));
+	
+	// invalid sequences at every position around the 16-byte block boundaries of the SIMD path
+	static constexpr const std::string_view invalid_sequences[] {
+		"\xC0\x80", // overlong 2-byte
+		"\xE0\x80\x80", // overlong 3-byte
+		"\xF0\x80\x80\x80", // overlong 4-byte
+		"\xED\xA0\x80", // surrogate
+		"\xF4\x90\x80\x80", // > U+10FFFF
+		"\xF5\x80\x80\x80", // invalid lead byte
+		"\xFF", // invalid byte
+		"\x80", // stray continuation byte
+		"\xE6\x97", // truncated 3-byte sequence
+		"\xF0\x9F\x98", // truncated 4-byte sequence
+		"\xC3\x28", // missing continuation byte
+	};
+	for (const auto& invalid_seq : invalid_sequences) {
+		for (size_t prefix_len = 0; prefix_len < 40u; ++prefix_len) {
+			for (const auto& filler : { "a"sv, "ä"sv, "日"sv }) {
+				std::string str;
+				while (str.size() < prefix_len) {
+					str += filler;
+				}
+				str += invalid_seq;
+				check_validation(str);
+				// with a valid suffix, the invalid sequence must not be at the end of the input
+				str += "suffix text that spans another block";
+				check_validation(str);
+			}
+		}
+	}
+	
+	// randomly corrupted mixed-script input
+	std::mt19937 rng(42u);
+	std::string mixed;
+	while (mixed.size() < 4096u) {
+		mixed += samples[rng() % std::size(samples)];
+	}
+	check_validation(mixed);
+	for (uint32_t iter = 0; iter < 2000u; ++iter) {
+		auto corrupted = mixed.substr(0, 16u + rng() % (mixed.size() - 16u));
+		const auto corruption_count = 1u + rng() % 3u;
+		for (uint32_t i = 0; i < corruption_count; ++i) {
+			corrupted[rng() % corrupted.size()] = char(rng() & 0xFFu);
+		}
+		check_validation(corrupted);
+	}
+	
+	return test::finish("unicode");
+}
@@ -0,0 +1,88 @@
+/*
+ *  Flo's Open libRary (floor)
+ *  Copyright (C) 2004 - 2026 Florian Ziesche
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; version 2 of the License only.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "floor_test.hpp"
+#include <floor/math/vector_batch.hpp>
+#include <vector>
+
+using namespace fl;
+
+//! epsilon for comparisons of computed vectors
+static constexpr const float eps { 1e-5f };
+
+int main(int, char**) {
+	using soa_type = soa_array<float3>;
+	static constexpr const size_t lane_count { soa_type::lane_count };
+	
+	// AoS <-> SoA round trip with a partial tail batch
+	{
+		std::vector<float3> vecs;
+		for (size_t i = 0; i < lane_count * 2u + 1u; ++i) {
+			vecs.emplace_back(float(i) + 1.0f, -float(i), float(i) * 0.5f);
+		}
+		const soa_type soa(vecs);
+		FLOOR_TEST_CHECK(soa.size() == vecs.size());
+		FLOOR_TEST_CHECK(soa.batch_count() == 3u);
+		const auto round_trip = soa.to_aos();
+		bool all_equal = true;
+		for (size_t i = 0; i < vecs.size(); ++i) {
+			all_equal &= round_trip[i].is_equal(vecs[i]);
+		}
+		FLOOR_TEST_CHECK(all_equal);
+		
+		// bounds must not include padding
+		const auto box = soa.bounds();
+		FLOOR_TEST_CHECK(box.min.is_equal(float3 { 1.0f, -float(vecs.size() - 1u), 0.0f }, eps));
+		FLOOR_TEST_CHECK(box.max.is_equal(float3 { float(vecs.size()), 0.0f, float(vecs.size() - 1u) * 0.5f }, eps));
+	}
+	
+	// padding lanes that are written by bulk ops (normalize() turns zero padding into NaN) must be zero once they are exposed
+	{
+		soa_type soa(lane_count - 1u);
+		for (size_t i = 0; i < soa.size(); ++i) {
+			soa.set(i, float3 { 3.0f, 0.0f, 4.0f });
+		}
+		soa.normalize();
+		for (size_t i = 0; i < soa.size(); ++i) {
+			FLOOR_TEST_CHECK(soa.get(i).is_equal(float3 { 0.6f, 0.0f, 0.8f }, eps));
+		}
+		
+		// grow by one -> new element is within the padded size
+		soa.resize(soa.size() + 1u);
+		FLOOR_TEST_CHECK(soa.get(soa.size() - 1u).is_equal(float3 { 0.0f, 0.0f, 0.0f }));
+		
+		// translate everything (incl. padding) -> grow beyond the padded size
+		soa.transform(matrix4f::translation(1.0f, 2.0f, 3.0f));
+		soa.resize(lane_count * 2u);
+		FLOOR_TEST_CHECK(soa.get(0).is_equal(float3 { 1.6f, 2.0f, 3.8f }, eps));
+		FLOOR_TEST_CHECK(soa.get(lane_count - 1u).is_equal(float3 { 1.0f, 2.0f, 3.0f }, eps));
+		for (size_t i = lane_count; i < soa.size(); ++i) {
+			FLOOR_TEST_CHECK(soa.get(i).is_equal(float3 { 0.0f, 0.0f, 0.0f }));
+		}
+		
+		// shrink and grow again
+		soa.normalize();
+		soa.resize(1u);
+		soa.resize(lane_count + 1u);
+		for (size_t i = 1; i < soa.size(); ++i) {
+			FLOOR_TEST_CHECK(soa.get(i).is_equal(float3 { 0.0f, 0.0f, 0.0f }));
+		}
+	}
+	
+	return test::finish("vector_batch");
+}